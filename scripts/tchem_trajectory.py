@@ -0,0 +1,82 @@
+"""Reader of binary trajectory files written by TChem::TrajectoryWriter.
+
+File layout (little-endian):
+  header : b"TCHEMTRJ", uint32 version, uint32 ncolumns,
+           ncolumns x (uint32 length, name)
+  chunks : uint64 nrows, float64 values[ncolumns][nrows]
+
+The chunks are memory mapped; no data is copied until they are concatenated.
+
+Usage:
+  import tchem_trajectory as tt
+  traj = tt.read('PFRSolution.bin')
+  T = traj['Temperature[K]']          # all chunks of a column
+  for chunk in traj.chunks: ...       # chunk[column, row]
+"""
+import mmap
+import struct
+import sys
+
+import numpy as np
+
+MAGIC = b"TCHEMTRJ"
+
+
+class Trajectory(object):
+    def __init__(self, filename):
+        self.filename = filename
+        with open(filename, "rb") as f:
+            self._mmap = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        buf = self._mmap
+        if buf[:8] != MAGIC:
+            raise ValueError("%s is not a TChem trajectory file" % filename)
+        self.version, ncolumns = struct.unpack_from("<II", buf, 8)
+        pos = 16
+        self.names = []
+        for _ in range(ncolumns):
+            (length,) = struct.unpack_from("<I", buf, pos)
+            pos += 4
+            self.names.append(buf[pos:pos + length].decode("utf-8"))
+            pos += length
+
+        self.chunks = []
+        size = len(buf)
+        while pos + 8 <= size:
+            (nrows,) = struct.unpack_from("<Q", buf, pos)
+            pos += 8
+            count = ncolumns * nrows
+            if pos + 8 * count > size:
+                break  # incomplete chunk at the end of a running simulation
+            values = np.frombuffer(buf, dtype="<f8", count=count, offset=pos)
+            self.chunks.append(values.reshape(ncolumns, nrows))
+            pos += 8 * count
+
+    def column(self, name):
+        """values of a column in all chunks"""
+        k = self.names.index(name)
+        if not self.chunks:
+            return np.empty(0)
+        return np.concatenate([chunk[k] for chunk in self.chunks])
+
+    def __getitem__(self, name):
+        return self.column(name)
+
+    def to_array(self):
+        """rows of all chunks as a (nrows, ncolumns) array"""
+        if not self.chunks:
+            return np.empty((0, len(self.names)))
+        return np.concatenate([chunk.T for chunk in self.chunks])
+
+
+def read(filename):
+    return Trajectory(filename)
+
+
+if __name__ == "__main__":
+    for filename in sys.argv[1:]:
+        traj = read(filename)
+        nrows = sum(chunk.shape[1] for chunk in traj.chunks)
+        print("%s: version %d, %d columns, %d chunks, %d rows"
+              % (filename, traj.version, len(traj.names), len(traj.chunks),
+                 nrows))
+        print(" ".join(traj.names))
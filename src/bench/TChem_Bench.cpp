@@ -0,0 +1,881 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#include "TChem_CommandLineParser.hpp"
+#include "TChem_EnthalpyMass.hpp"
+#include "TChem_IgnitionZeroD.hpp"
+#include "TChem_Jacobian.hpp"
+#include "TChem_KineticModelData.hpp"
+#include "TChem_NetProductionRatePerMass.hpp"
+#include "TChem_PlugFlowReactor.hpp"
+#include "TChem_SourceTerm.hpp"
+#include "TChem_ThermalProperties.hpp"
+#include "TChem_TransientContStirredTankReactor.hpp"
+#include "TChem_SampleFileReader.hpp"
+#include "TChem_Util.hpp"
+
+using ordinal_type = TChem::ordinal_type;
+using real_type = TChem::real_type;
+using time_advance_type = TChem::time_advance_type;
+
+using real_type_1d_view = TChem::real_type_1d_view;
+using real_type_2d_view = TChem::real_type_2d_view;
+using real_type_3d_view = TChem::real_type_3d_view;
+using time_advance_type_1d_view = TChem::time_advance_type_1d_view;
+
+using real_type_1d_view_host = TChem::real_type_1d_view_host;
+using real_type_2d_view_host = TChem::real_type_2d_view_host;
+
+using policy_type = typename TChem::UseThisTeamPolicy<TChem::exec_space>::type;
+
+namespace {
+
+/// one row of the benchmark results
+/// - an evaluation is a right hand side (or jacobian) of a sample for the
+///   kernel entry points and a time step of a sample for the integrators
+/// - gflops is an estimate from a simple operation count model
+struct BenchRecord
+{
+  std::string entry;
+  std::string mechanism;
+  ordinal_type concurrency;
+  ordinal_type batch_size;
+  ordinal_type team_size;
+  ordinal_type vector_size;
+  double seconds;
+  double samples_per_sec;
+  double evals_per_sec;
+  double gflops;
+};
+
+std::vector<std::string>
+splitList(const std::string& s, const char delim = ',')
+{
+  std::vector<std::string> r_val;
+  std::istringstream iss(s);
+  std::string token;
+  while (std::getline(iss, token, delim))
+    if (!token.empty())
+      r_val.push_back(token);
+  return r_val;
+}
+
+std::vector<ordinal_type>
+parseIntList(const std::string& s)
+{
+  std::vector<ordinal_type> r_val;
+  for (const auto& token : splitList(s))
+    r_val.push_back(std::atoi(token.c_str()));
+  return r_val;
+}
+
+bool
+isSelected(const std::vector<std::string>& list, const std::string& name)
+{
+  return list.empty() ||
+         std::find(list.begin(), list.end(), name) != list.end();
+}
+
+std::string
+getRecordKey(const std::string& entry,
+             const std::string& mechanism,
+             const ordinal_type concurrency,
+             const ordinal_type batch_size,
+             const ordinal_type team_size,
+             const ordinal_type vector_size)
+{
+  std::ostringstream oss;
+  oss << entry << ":" << mechanism << ":" << concurrency << ":" << batch_size
+      << ":" << team_size << ":" << vector_size;
+  return oss.str();
+}
+
+std::string
+getRecordKey(const BenchRecord& r)
+{
+  return getRecordKey(r.entry,
+                      r.mechanism,
+                      r.concurrency,
+                      r.batch_size,
+                      r.team_size,
+                      r.vector_size);
+}
+
+/// best of repeats after a warm up launch
+template<typename RunFunctorType>
+double
+measureSeconds(const ordinal_type repeats, const RunFunctorType& run)
+{
+  run();
+  Kokkos::fence();
+
+  Kokkos::Impl::Timer timer;
+  double r_val(std::numeric_limits<double>::max());
+  for (ordinal_type iter = 0; iter < repeats; ++iter) {
+    timer.reset();
+    run();
+    Kokkos::fence();
+    r_val = std::min(r_val, timer.seconds());
+  }
+  return r_val;
+}
+
+policy_type
+createPolicy(const ordinal_type nBatch,
+             const ordinal_type team_size,
+             const ordinal_type vector_size,
+             const ordinal_type per_team_extent)
+{
+  const auto exec_space_instance = TChem::exec_space();
+  policy_type policy(exec_space_instance, nBatch, Kokkos::AUTO());
+  if (team_size > 0 && vector_size > 0)
+    policy = policy_type(exec_space_instance, nBatch, team_size, vector_size);
+
+  const ordinal_type level = 1;
+  const ordinal_type per_team_scratch =
+    TChem::Scratch<real_type_1d_view>::shmem_size(per_team_extent);
+  policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+  return policy;
+}
+
+/// operation count model per sample; transcendental functions are counted
+/// as 20 flops
+/// - rates: gibbs energies of species, arrhenius rate constants,
+///   equilibrium constants, rates of progress and production rates
+/// - jacobian: rates and derivatives of the rates of progress with respect
+///   to the reactants and products of each reaction
+/// - thermo: NASA polynomials of cp, h and s and mixture averages
+struct FlopModel
+{
+  double rates;
+  double jacobian;
+  double thermo;
+
+  template<typename KineticModelConstDataType>
+  FlopModel(const KineticModelConstDataType& kmcd)
+  {
+    const auto reacNreac =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), kmcd.reacNreac);
+    const auto reacNprod =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), kmcd.reacNprod);
+    double nnz(0), nnz2(0);
+    for (ordinal_type i = 0; i < kmcd.nReac; ++i) {
+      const double k = reacNreac(i) + reacNprod(i);
+      nnz += k;
+      nnz2 += k * k;
+    }
+    thermo = 40.0 * kmcd.nSpec;
+    rates = thermo + 50.0 * kmcd.nReac + 4.0 * nnz;
+    jacobian = rates + 4.0 * nnz2;
+  }
+
+  /// a TrBDF2 step: three right hand sides and two stages with two newton
+  /// iterations, each of which evaluates the jacobian and factorizes it
+  static double getStepFlops(const double rhs,
+                             const double jac,
+                             const ordinal_type m)
+  {
+    const double factorize = 4.0 / 3.0 * double(m) * double(m) * double(m);
+    return 3.0 * rhs + 4.0 * (rhs + jac + factorize);
+  }
+};
+
+/// baseline results keyed by getRecordKey; samples/sec is compared
+std::map<std::string, double>
+readBaseline(const std::string& filename)
+{
+  std::map<std::string, double> r_val;
+  std::ifstream file(filename);
+  if (!file.is_open()) {
+    printf("Warning: tchem-bench cannot open baseline %s\n", filename.c_str());
+    return r_val;
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#' || line.compare(0, 5, "entry") == 0)
+      continue;
+    const auto tokens = splitList(line);
+    if (tokens.size() < 9)
+      continue;
+    /// entry, mechanism, exec_space, concurrency, batch, team, vector,
+    /// seconds, samples/sec, ...
+    const std::string key = getRecordKey(tokens[0],
+                                         tokens[1],
+                                         std::atoi(tokens[3].c_str()),
+                                         std::atoi(tokens[4].c_str()),
+                                         std::atoi(tokens[5].c_str()),
+                                         std::atoi(tokens[6].c_str()));
+    r_val[key] = std::atof(tokens[8].c_str());
+  }
+  return r_val;
+}
+
+void
+writeCSV(const std::string& filename,
+         const bool append,
+         const std::vector<BenchRecord>& records)
+{
+  bool write_header(true);
+  if (append) {
+    std::ifstream file(filename);
+    write_header = !file.is_open() || file.peek() == EOF;
+  }
+  FILE* fs = fopen(filename.c_str(), append ? "a" : "w");
+  if (fs == NULL) {
+    printf("Warning: tchem-bench cannot open %s\n", filename.c_str());
+    return;
+  }
+  if (write_header)
+    fprintf(fs,
+            "entry,mechanism,exec_space,concurrency,batch_size,team_size,"
+            "vector_size,seconds,samples_per_sec,evals_per_sec,gflops\n");
+  for (const auto& r : records)
+    fprintf(fs,
+            "%s,%s,%s,%d,%d,%d,%d,%e,%e,%e,%e\n",
+            r.entry.c_str(),
+            r.mechanism.c_str(),
+            TChem::exec_space::name(),
+            r.concurrency,
+            r.batch_size,
+            r.team_size,
+            r.vector_size,
+            r.seconds,
+            r.samples_per_sec,
+            r.evals_per_sec,
+            r.gflops);
+  fclose(fs);
+}
+
+void
+writeJSON(const std::string& filename, const std::vector<BenchRecord>& records)
+{
+  FILE* fs = fopen(filename.c_str(), "w");
+  if (fs == NULL) {
+    printf("Warning: tchem-bench cannot open %s\n", filename.c_str());
+    return;
+  }
+  fprintf(fs, "{\n");
+  fprintf(fs, "  \"exec_space\": \"%s\",\n", TChem::exec_space::name());
+  fprintf(fs,
+          "  \"concurrency\": %d,\n",
+          ordinal_type(TChem::exec_space().concurrency()));
+  fprintf(fs, "  \"results\": [\n");
+  for (size_t i = 0; i < records.size(); ++i) {
+    const auto& r = records[i];
+    fprintf(fs,
+            "    {\"entry\": \"%s\", \"mechanism\": \"%s\", "
+            "\"batch_size\": %d, \"team_size\": %d, \"vector_size\": %d, "
+            "\"seconds\": %e, \"samples_per_sec\": %e, "
+            "\"evals_per_sec\": %e, \"gflops\": %e}%s\n",
+            r.entry.c_str(),
+            r.mechanism.c_str(),
+            r.batch_size,
+            r.team_size,
+            r.vector_size,
+            r.seconds,
+            r.samples_per_sec,
+            r.evals_per_sec,
+            r.gflops,
+            (i + 1) < records.size() ? "," : "");
+  }
+  fprintf(fs, "  ]\n");
+  fprintf(fs, "}\n");
+  fclose(fs);
+}
+
+/// clone a state vector (and site fractions) of a sample over the batch
+real_type_2d_view
+createBatch(const std::string& label,
+            const real_type_1d_view_host& v_at_0,
+            const ordinal_type nBatch)
+{
+  real_type_2d_view r_val(label, nBatch, v_at_0.extent(0));
+  auto r_val_host = Kokkos::create_mirror_view(r_val);
+  for (ordinal_type i = 0; i < nBatch; ++i)
+    for (ordinal_type k = 0, kend = v_at_0.extent(0); k < kend; ++k)
+      r_val_host(i, k) = v_at_0(k);
+  Kokkos::deep_copy(r_val, r_val_host);
+  return r_val;
+}
+
+real_type_2d_view
+createTolTime(const ordinal_type m, const real_type atol, const real_type rtol)
+{
+  real_type_2d_view tol_time("tol time", m, 2);
+  auto tol_time_host = Kokkos::create_mirror_view(tol_time);
+  for (ordinal_type i = 0; i < m; ++i) {
+    tol_time_host(i, 0) = atol;
+    tol_time_host(i, 1) = rtol;
+  }
+  Kokkos::deep_copy(tol_time, tol_time_host);
+  return tol_time;
+}
+
+real_type_1d_view
+createTolNewton(const real_type atol, const real_type rtol)
+{
+  real_type_1d_view tol_newton("tol newton", 2);
+  auto tol_newton_host = Kokkos::create_mirror_view(tol_newton);
+  tol_newton_host(0) = atol;
+  tol_newton_host(1) = rtol;
+  Kokkos::deep_copy(tol_newton, tol_newton_host);
+  return tol_newton;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+  /// default inputs
+  std::string prefixPath("data/");
+  std::string gasMechanisms("gri3.0,isoOctane,CO");
+  std::string surfaceMechanisms("PT,X");
+  std::string entries("");
+  std::string batchSizes("1,64,1024");
+  std::string teamSizes("-1");
+  std::string vectorSizes("-1");
+  std::string outputCSV("tchem-bench.csv");
+  std::string outputJSON("tchem-bench.json");
+  std::string baselineFile("");
+  int repeats(3), num_time_steps(10);
+  real_type tolerance(0.1);
+  bool append(false);
+
+  /// parse command line arguments
+  TChem::CommandLineParser opts(
+    "This benchmark times the batch entry points over the bundled mechanisms "
+    "sweeping batch, team and vector sizes; use --kokkos-threads to change "
+    "the number of host threads");
+  opts.set_option<std::string>(
+    "prefixPath", "Path to the example data e.g., data/", &prefixPath);
+  opts.set_option<std::string>(
+    "gas-mechanisms",
+    "Comma separated gas mechanisms under ignition-zero-d/",
+    &gasMechanisms);
+  opts.set_option<std::string>(
+    "surface-mechanisms",
+    "Comma separated surface mechanisms under reaction-rates-surfaces/",
+    &surfaceMechanisms);
+  opts.set_option<std::string>(
+    "entries",
+    "Comma separated entry points e.g., Jacobian,IgnitionZeroD; all if empty",
+    &entries);
+  opts.set_option<std::string>(
+    "batch-sizes", "Comma separated batch sizes", &batchSizes);
+  opts.set_option<std::string>(
+    "team-sizes", "Comma separated team sizes; -1 is Kokkos::AUTO", &teamSizes);
+  opts.set_option<std::string>(
+    "vector-sizes",
+    "Comma separated vector sizes; -1 is Kokkos::AUTO",
+    &vectorSizes);
+  opts.set_option<int>(
+    "repeats", "Number of timed launches; the best is reported", &repeats);
+  opts.set_option<int>("time-steps",
+                       "Number of time steps per sample for the integrators",
+                       &num_time_steps);
+  opts.set_option<std::string>(
+    "output-csv", "Output csv file name; empty to skip", &outputCSV);
+  opts.set_option<std::string>(
+    "output-json", "Output json file name; empty to skip", &outputJSON);
+  opts.set_option<bool>(
+    "append", "If true, results are appended to the csv file", &append);
+  opts.set_option<std::string>(
+    "baseline", "Baseline csv file to compare samples/sec", &baselineFile);
+  opts.set_option<real_type>(
+    "tolerance",
+    "Relative slowdown against the baseline reported as a regression",
+    &tolerance);
+
+  const bool r_parse = opts.parse(argc, argv);
+  if (r_parse)
+    return 0; // print help return
+
+  ordinal_type num_regressions(0);
+  Kokkos::initialize(argc, argv);
+  {
+    const bool detail = false;
+
+    TChem::exec_space::print_configuration(std::cout, detail);
+    TChem::host_exec_space::print_configuration(std::cout, detail);
+
+    const auto entry_list = splitList(entries);
+    const auto batch_list = parseIntList(batchSizes);
+    const auto team_list = parseIntList(teamSizes);
+    const auto vector_list = parseIntList(vectorSizes);
+    const ordinal_type concurrency = TChem::exec_space().concurrency();
+
+    /// (team, vector) pairs; entry points without a policy interface run
+    /// only for the first pair and are recorded with Kokkos::AUTO
+    std::vector<std::pair<ordinal_type, ordinal_type>> policy_list;
+    for (const auto team_size : team_list)
+      for (const auto vector_size : vector_list)
+        policy_list.push_back(std::make_pair(team_size, vector_size));
+
+    std::vector<BenchRecord> records;
+    auto addRecord = [&](const std::string& entry,
+                         const std::string& mechanism,
+                         const ordinal_type nBatch,
+                         const ordinal_type team_size,
+                         const ordinal_type vector_size,
+                         const double seconds,
+                         const double evals_per_sample,
+                         const double flops_per_sample) {
+      BenchRecord r;
+      r.entry = entry;
+      r.mechanism = mechanism;
+      r.concurrency = concurrency;
+      r.batch_size = nBatch;
+      r.team_size = team_size;
+      r.vector_size = vector_size;
+      r.seconds = seconds;
+      r.samples_per_sec = double(nBatch) / seconds;
+      r.evals_per_sec = evals_per_sample * r.samples_per_sec;
+      r.gflops = flops_per_sample * r.samples_per_sec * 1e-9;
+      records.push_back(r);
+      printf("%-26s %-10s batch %6d team %3d vector %3d : %e [sec] %e "
+             "[samples/sec] %e [GFLOP/s]\n",
+             entry.c_str(),
+             mechanism.c_str(),
+             nBatch,
+             team_size,
+             vector_size,
+             seconds,
+             r.samples_per_sec,
+             r.gflops);
+    };
+
+    /// gas phase entry points
+    for (const auto& mechanism : splitList(gasMechanisms)) {
+      const std::string path(prefixPath + "ignition-zero-d/" + mechanism + "/");
+      TChem::KineticModelData kmd(path + "chem.inp", path + "therm.dat");
+      const auto kmcd = kmd.createConstData<TChem::exec_space>();
+      const FlopModel flops(kmcd);
+
+      const ordinal_type stateVecDim =
+        TChem::Impl::getStateVectorSize(kmcd.nSpec);
+
+      /// the first sample is cloned over the batch
+      real_type_1d_view_host state_at_0("state at 0", stateVecDim);
+      {
+        const auto speciesNamesHost =
+          Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                              kmcd.speciesNames);
+        const auto sMassHost =
+          Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), kmcd.sMass);
+        real_type_2d_view_host samples;
+        int nSample(0);
+        TChem::Test::readSample(path + "sample.dat",
+                                speciesNamesHost,
+                                sMassHost,
+                                kmcd.nSpec,
+                                stateVecDim,
+                                samples,
+                                nSample);
+        Kokkos::deep_copy(state_at_0,
+                          Kokkos::subview(samples, 0, Kokkos::ALL()));
+      }
+
+      using problem_type =
+        TChem::Impl::IgnitionZeroD_Problem<decltype(kmcd)>;
+      const ordinal_type m = problem_type::getNumberOfEquations(kmcd);
+      const double step_flops =
+        FlopModel::getStepFlops(flops.rates, flops.jacobian, m);
+
+      for (const auto nBatch : batch_list) {
+        const auto state = createBatch("StateVector", state_at_0, nBatch);
+
+        for (size_t ip = 0; ip < policy_list.size(); ++ip) {
+          const ordinal_type team_size = policy_list[ip].first,
+                             vector_size = policy_list[ip].second;
+
+          if (isSelected(entry_list, "NetProductionRatePerMass")) {
+            real_type_2d_view omega("NetProductionRatePerMass",
+                                    nBatch,
+                                    kmcd.nSpec);
+            auto policy = createPolicy(
+              nBatch,
+              team_size,
+              vector_size,
+              TChem::NetProductionRatePerMass::getWorkSpaceSize(kmcd));
+            const double seconds = measureSeconds(repeats, [&]() {
+              TChem::NetProductionRatePerMass::runDeviceBatch(
+                policy, state, omega, kmcd);
+            });
+            addRecord("NetProductionRatePerMass",
+                      mechanism,
+                      nBatch,
+                      team_size,
+                      vector_size,
+                      seconds,
+                      1,
+                      flops.rates);
+          }
+
+          if (isSelected(entry_list, "ThermalProperties")) {
+            real_type_2d_view CpMass("CpMass", nBatch, kmcd.nSpec);
+            real_type_1d_view CpMixMass("CpMixMass", nBatch);
+            real_type_2d_view CvMass("CvMass", nBatch, kmcd.nSpec);
+            real_type_1d_view CvMixMass("CvMixMass", nBatch);
+            real_type_2d_view EnthalpyMass("EnthalpyMass", nBatch, kmcd.nSpec);
+            real_type_1d_view EnthalpyMixMass("EnthalpyMixMass", nBatch);
+            real_type_2d_view EntropyMass("EntropyMass", nBatch, kmcd.nSpec);
+            real_type_1d_view EntropyMixMass("EntropyMixMass", nBatch);
+            real_type_2d_view InternalEnergyMass(
+              "InternalEnergyMass", nBatch, kmcd.nSpec);
+            real_type_1d_view InternalEnergyMixMass("InternalEnergyMixMass",
+                                                    nBatch);
+            auto policy =
+              createPolicy(nBatch,
+                           team_size,
+                           vector_size,
+                           TChem::ThermalProperties::getWorkSpaceSize(kmcd));
+            const double seconds = measureSeconds(repeats, [&]() {
+              TChem::ThermalProperties::runDeviceBatch(
+                policy,
+                TChem::ThermalProperties::All,
+                state,
+                CpMass,
+                CpMixMass,
+                CvMass,
+                CvMixMass,
+                EnthalpyMass,
+                EnthalpyMixMass,
+                EntropyMass,
+                EntropyMixMass,
+                InternalEnergyMass,
+                InternalEnergyMixMass,
+                kmcd);
+            });
+            addRecord("ThermalProperties",
+                      mechanism,
+                      nBatch,
+                      team_size,
+                      vector_size,
+                      seconds,
+                      1,
+                      flops.thermo);
+          }
+
+          /// these entry points only take the batch size
+          if (ip == 0 && isSelected(entry_list, "Jacobian")) {
+            real_type_3d_view jac("Jacobian", nBatch, stateVecDim, stateVecDim);
+            const double seconds = measureSeconds(repeats, [&]() {
+              TChem::Jacobian::runDeviceBatch(nBatch, state, jac, kmcd);
+            });
+            addRecord(
+              "Jacobian", mechanism, nBatch, -1, -1, seconds, 1, flops.jacobian);
+          }
+
+          if (ip == 0 && isSelected(entry_list, "SourceTerm")) {
+            real_type_2d_view source("SourceTerm", nBatch, kmcd.nSpec + 1);
+            const double seconds = measureSeconds(repeats, [&]() {
+              TChem::SourceTerm::runDeviceBatch(nBatch, state, source, kmcd);
+            });
+            addRecord("SourceTerm",
+                      mechanism,
+                      nBatch,
+                      -1,
+                      -1,
+                      seconds,
+                      1,
+                      flops.rates + flops.thermo);
+          }
+
+          if (isSelected(entry_list, "IgnitionZeroD")) {
+            const auto tol_newton = createTolNewton(1e-12, 1e-6);
+            const auto tol_time = createTolTime(
+              problem_type::getNumberOfTimeODEs(kmcd), 1e-12, 1e-4);
+            real_type_2d_view fac("fac", nBatch, m);
+
+            time_advance_type tadv_default;
+            tadv_default._tbeg = 0;
+            tadv_default._tend = 1;
+            tadv_default._dt = 1e-8;
+            tadv_default._dtmin = 1e-8;
+            tadv_default._dtmax = 1e-3;
+            tadv_default._max_num_newton_iterations = 100;
+            tadv_default._num_time_iterations_per_interval = num_time_steps;
+            time_advance_type_1d_view tadv("tadv", nBatch);
+            Kokkos::deep_copy(tadv, tadv_default);
+
+            real_type_1d_view t("time", nBatch), dt("delta time", nBatch);
+            real_type_2d_view state_out("StateVector out", nBatch, stateVecDim);
+
+            auto policy =
+              createPolicy(nBatch,
+                           team_size,
+                           vector_size,
+                           TChem::IgnitionZeroD::getWorkSpaceSize(kmcd));
+            const double seconds = measureSeconds(repeats, [&]() {
+              TChem::IgnitionZeroD::runDeviceBatch(policy,
+                                                   tol_newton,
+                                                   tol_time,
+                                                   fac,
+                                                   tadv,
+                                                   state,
+                                                   t,
+                                                   dt,
+                                                   state_out,
+                                                   kmcd);
+            });
+            addRecord("IgnitionZeroD",
+                      mechanism,
+                      nBatch,
+                      team_size,
+                      vector_size,
+                      seconds,
+                      num_time_steps,
+                      num_time_steps * step_flops);
+          }
+        }
+      }
+    }
+
+    /// gas and surface entry points
+    for (const auto& mechanism : splitList(surfaceMechanisms)) {
+      if (!isSelected(entry_list, "PlugFlowReactor") &&
+          !isSelected(entry_list, "TransientContStirredTankReactor"))
+        break;
+
+      const std::string path(prefixPath + "reaction-rates-surfaces/" +
+                             mechanism + "/");
+      TChem::KineticModelData kmdSurf(path + "chem.inp",
+                                      path + "therm.dat",
+                                      path + "chemSurf.inp",
+                                      path + "thermSurf.dat");
+      const auto kmcd = kmdSurf.createConstData<TChem::exec_space>();
+      const auto kmcdSurf = kmdSurf.createConstSurfData<TChem::exec_space>();
+      const FlopModel flops(kmcd), flopsSurf(kmcdSurf);
+
+      const ordinal_type stateVecDim =
+        TChem::Impl::getStateVectorSize(kmcd.nSpec);
+
+      real_type_1d_view_host state_at_0("state at 0", stateVecDim);
+      real_type_1d_view_host siteFraction_at_0("site fraction at 0",
+                                               kmcdSurf.nSpec);
+      TChem::Test::readStateVector(
+        path + "inputGas.dat", kmcd.nSpec, state_at_0);
+      TChem::Test::readSiteFraction(
+        path + "inputSurfGas.dat", kmcdSurf.nSpec, siteFraction_at_0);
+
+      const auto tol_newton = createTolNewton(1e-12, 1e-6);
+
+      time_advance_type tadv_default;
+      tadv_default._tbeg = 0;
+      tadv_default._tend = 1;
+      tadv_default._dt = 1e-10;
+      tadv_default._dtmin = 1e-10;
+      tadv_default._dtmax = 1e-6;
+      tadv_default._max_num_newton_iterations = 100;
+      tadv_default._num_time_iterations_per_interval = num_time_steps;
+
+      /// the jacobians of the reactors are numerical
+      const double rhs_flops = flops.rates + flops.thermo + flopsSurf.rates;
+
+      for (const auto nBatch : batch_list) {
+        const auto state = createBatch("StateVector", state_at_0, nBatch);
+        const auto siteFraction =
+          createBatch("SiteFraction", siteFraction_at_0, nBatch);
+
+        time_advance_type_1d_view tadv("tadv", nBatch);
+        real_type_1d_view t("time", nBatch), dt("delta time", nBatch);
+        real_type_2d_view state_out("StateVector out", nBatch, stateVecDim);
+        real_type_2d_view siteFraction_out(
+          "SiteFraction out", nBatch, kmcdSurf.nSpec);
+
+        for (const auto& p : policy_list) {
+          const ordinal_type team_size = p.first, vector_size = p.second;
+
+          if (isSelected(entry_list, "PlugFlowReactor")) {
+            using problem_type =
+              TChem::Impl::PlugFlowReactor_Problem<decltype(kmcd),
+                                                   decltype(kmcdSurf),
+                                                   TChem::pfr_data_type>;
+            const ordinal_type m =
+              problem_type::getNumberOfEquations(kmcd, kmcdSurf);
+            const auto tol_time = createTolTime(
+              problem_type::getNumberOfTimeODEs(kmcd), 1e-12, 1e-4);
+            real_type_2d_view fac("fac", nBatch, m);
+
+            TChem::pfr_data_type pfrd;
+            pfrd.Area = 0.00053;
+            pfrd.Pcat = 0.025977239243415308;
+
+            real_type_1d_view velocity("Velocity", nBatch),
+              velocity_out("Velocity out", nBatch);
+            Kokkos::deep_copy(velocity, 0.019);
+            Kokkos::deep_copy(tadv, tadv_default);
+
+            auto policy = createPolicy(
+              nBatch,
+              team_size,
+              vector_size,
+              TChem::PlugFlowReactor::getWorkSpaceSize(kmcd, kmcdSurf, pfrd));
+            const double seconds = measureSeconds(repeats, [&]() {
+              TChem::PlugFlowReactor::runDeviceBatch(policy,
+                                                     tol_newton,
+                                                     tol_time,
+                                                     fac,
+                                                     tadv,
+                                                     state,
+                                                     siteFraction,
+                                                     velocity,
+                                                     t,
+                                                     dt,
+                                                     state_out,
+                                                     siteFraction_out,
+                                                     velocity_out,
+                                                     kmcd,
+                                                     kmcdSurf,
+                                                     pfrd.Area,
+                                                     pfrd.Pcat);
+            });
+            const double step_flops =
+              FlopModel::getStepFlops(rhs_flops, m * rhs_flops, m);
+            addRecord("PlugFlowReactor",
+                      mechanism,
+                      nBatch,
+                      team_size,
+                      vector_size,
+                      seconds,
+                      num_time_steps,
+                      num_time_steps * step_flops);
+          }
+
+          if (isSelected(entry_list, "TransientContStirredTankReactor")) {
+            using cstr_data_type = TChem::cstr_data_type;
+            using problem_type =
+              TChem::Impl::TransientContStirredTankReactor_Problem<
+                decltype(kmcd),
+                decltype(kmcdSurf),
+                cstr_data_type>;
+            const ordinal_type m =
+              problem_type::getNumberOfEquations(kmcd, kmcdSurf);
+            const auto tol_time = createTolTime(
+              problem_type::getNumberOfTimeODEs(kmcd, kmcdSurf), 1e-12, 1e-4);
+            real_type_2d_view fac("fac", nBatch, m);
+
+            /// inlet condition is the first sample
+            cstr_data_type cstr;
+            cstr.mdotIn = 3.596978981250784e-06;
+            cstr.Vol = 0.00013470;
+            cstr.Acat = 0.0013074;
+            cstr.pressure = state_at_0(1);
+            cstr.Yi = real_type_1d_view("Mass fraction at inlet", kmcd.nSpec);
+            Kokkos::deep_copy(
+              cstr.Yi,
+              Kokkos::subview(
+                state,
+                0,
+                Kokkos::make_pair(ordinal_type(3), stateVecDim)));
+            {
+              real_type_2d_view EnthalpyMass("EnthalpyMass", 1, kmcd.nSpec);
+              real_type_1d_view EnthalpyMixMass("EnthalpyMixMass", 1);
+              TChem::EnthalpyMass::runDeviceBatch(TChem::exec_space(),
+                                                  -1,
+                                                  -1,
+                                                  1,
+                                                  state,
+                                                  EnthalpyMass,
+                                                  EnthalpyMixMass,
+                                                  kmcd);
+              const auto EnthalpyMixMass_host =
+                Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                    EnthalpyMixMass);
+              cstr.EnthalpyIn = EnthalpyMixMass_host(0);
+            }
+            Kokkos::deep_copy(tadv, tadv_default);
+
+            auto policy =
+              createPolicy(nBatch,
+                           team_size,
+                           vector_size,
+                           TChem::TransientContStirredTankReactor::
+                             getWorkSpaceSize(kmcd, kmcdSurf, cstr));
+            const double seconds = measureSeconds(repeats, [&]() {
+              TChem::TransientContStirredTankReactor::runDeviceBatch(
+                policy,
+                tol_newton,
+                tol_time,
+                fac,
+                tadv,
+                state,
+                siteFraction,
+                t,
+                dt,
+                state_out,
+                siteFraction_out,
+                kmcd,
+                kmcdSurf,
+                cstr);
+            });
+            const double step_flops =
+              FlopModel::getStepFlops(rhs_flops, m * rhs_flops, m);
+            addRecord("TransientContStirredTankReactor",
+                      mechanism,
+                      nBatch,
+                      team_size,
+                      vector_size,
+                      seconds,
+                      num_time_steps,
+                      num_time_steps * step_flops);
+          }
+        }
+      }
+    }
+
+    if (!outputCSV.empty())
+      writeCSV(outputCSV, append, records);
+    if (!outputJSON.empty())
+      writeJSON(outputJSON, records);
+
+    /// regression against a stored baseline
+    if (!baselineFile.empty()) {
+      const auto baseline = readBaseline(baselineFile);
+      ordinal_type num_compared(0);
+      printf("---------------------------------------------------\n");
+      printf("Comparison against baseline %s (tolerance %.2f)\n",
+             baselineFile.c_str(),
+             tolerance);
+      for (const auto& r : records) {
+        const auto it = baseline.find(getRecordKey(r));
+        if (it == baseline.end() || it->second <= 0)
+          continue;
+        const double ratio = r.samples_per_sec / it->second;
+        const bool regressed = ratio < (1 - tolerance);
+        ++num_compared;
+        num_regressions += regressed;
+        printf("%-26s %-10s batch %6d team %3d vector %3d : speedup %6.3f%s\n",
+               r.entry.c_str(),
+               r.mechanism.c_str(),
+               r.batch_size,
+               r.team_size,
+               r.vector_size,
+               ratio,
+               regressed ? "  REGRESSION" : "");
+      }
+      printf("%d of %d cases regressed\n", num_regressions, num_compared);
+    }
+  }
+  Kokkos::finalize();
+
+  return num_regressions > 0;
+}
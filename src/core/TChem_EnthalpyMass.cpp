@@ -26,36 +26,42 @@ namespace Impl {
 template<typename PolicyType,
          typename RealType0DViewType,
          typename RealType1DViewType,
-         typename RealType2DViewType,
+         typename RealType1DBatchViewType,
+         typename RealType2DBatchViewType,
          typename KineticModelConstType>
 void
 EnthalpyMass_TemplateRun( /// required template arguments
   const std::string& profile_name,
   const RealType0DViewType& dummy_0d,
+  const RealType1DViewType& dummy_1d,
   /// team size setting
   const PolicyType& policy,
-  const RealType2DViewType& state,
+  const RealType2DBatchViewType& state,
   // outputFile
-  const RealType2DViewType& EnthalpyMass,
-  const RealType1DViewType& EnthalpyMixMass,
+  const RealType2DBatchViewType& EnthalpyMass,
+  const RealType1DBatchViewType& EnthalpyMixMass,
   const KineticModelConstType& kmcd)
 {
   Kokkos::Profiling::pushRegion(profile_name);
   using policy_type = PolicyType;
   const ordinal_type level = 1; ///
   const ordinal_type per_team_extent = EnthalpyMass::getWorkSpaceSize(kmcd);
+  const ordinal_type per_team_extent_stage =
+    getBatchRowWorkSpaceSize(state) + getBatchRowWorkSpaceSize(EnthalpyMass);
 
   Kokkos::parallel_for(
     profile_name,
-    policy,
+    getBatchRowPolicy(policy, per_team_extent_stage),
     KOKKOS_LAMBDA(const typename policy_type::member_type& member) {
       const ordinal_type i = member.league_rank();
+      Scratch<RealType1DViewType> stage(member.team_scratch(level),
+                                        per_team_extent_stage);
+      auto wstage = stage.data();
       const RealType1DViewType state_at_i =
-        Kokkos::subview(state, i, Kokkos::ALL());
+        getBatchRow<RealType1DViewType>(member, state, i, true, wstage);
       const RealType1DViewType EnthalpyMass_at_i =
-        Kokkos::subview(EnthalpyMass, i, Kokkos::ALL());
-      const RealType0DViewType EnthalpyMixMass_at_i =
-        Kokkos::subview(EnthalpyMixMass, i);
+        getBatchRow<RealType1DViewType>(member, EnthalpyMass, i, false, wstage);
+      const RealType0DViewType EnthalpyMixMass_at_i(&EnthalpyMixMass(i));
       Scratch<RealType1DViewType> work(member.team_scratch(level),
                                        per_team_extent);
       auto w = (real_type*)work.data();
@@ -86,6 +92,7 @@ EnthalpyMass_TemplateRun( /// required template arguments
           sumHk);
 
         EnthalpyMixMass_at_i() = sumHk;
+        setBatchRow(member, EnthalpyMass_at_i, EnthalpyMass, i);
       }
     });
   Kokkos::Profiling::popRegion();
@@ -96,15 +103,16 @@ EnthalpyMass_TemplateRun( /// required template arguments
 void
 EnthalpyMass::runDeviceBatch( /// thread block size
   typename UseThisTeamPolicy<exec_space>::type& policy,
-  const real_type_2d_view& state,
+  const real_type_2d_stride_view& state,
   /// output
-  const real_type_2d_view& EnthalpyMass,
-  const real_type_1d_view& EnthalpyMixMass,
+  const real_type_2d_stride_view& EnthalpyMass,
+  const real_type_1d_stride_view& EnthalpyMixMass,
   /// const data from kinetic model
   const KineticModelConstDataDevice& kmcd)
 {
   Impl::EnthalpyMass_TemplateRun("TChem::EnthalpyMass::runDeviceBatch",
                                  real_type_0d_view(),
+                                 real_type_1d_view(),
                                  /// team policy
                                  policy,
                                  /// input
@@ -120,10 +128,10 @@ EnthalpyMass::runDeviceBatch( /// thread block size
   const ordinal_type& team_size,
   const ordinal_type& vector_size,
   const ordinal_type nBatch,
-  const real_type_2d_view& state,
+  const real_type_2d_stride_view& state,
   /// output
-  const real_type_2d_view& EnthalpyMass,
-  const real_type_1d_view& EnthalpyMixMass,
+  const real_type_2d_stride_view& EnthalpyMass,
+  const real_type_1d_stride_view& EnthalpyMixMass,
   /// const data from kinetic model
   const KineticModelConstDataDevice& kmcd)
 {
@@ -147,6 +155,7 @@ EnthalpyMass::runDeviceBatch( /// thread block size
 
   Impl::EnthalpyMass_TemplateRun("TChem::EnthalpyMass::runDeviceBatch",
                                  real_type_0d_view(),
+                                 real_type_1d_view(),
                                  /// team policy
                                  policy,
                                  /// input
@@ -159,15 +168,16 @@ EnthalpyMass::runDeviceBatch( /// thread block size
 void
 EnthalpyMass::runHostBatch( /// thread block size
   typename UseThisTeamPolicy<host_exec_space>::type& policy,
-  const real_type_2d_view_host& state,
+  const real_type_2d_stride_view_host& state,
   /// output
-  const real_type_2d_view_host& EnthalpyMass,
-  const real_type_1d_view_host& EnthalpyMixMass,
+  const real_type_2d_stride_view_host& EnthalpyMass,
+  const real_type_1d_stride_view_host& EnthalpyMixMass,
   /// const data from kinetic model
   const KineticModelConstDataHost& kmcd)
 {
   Impl::EnthalpyMass_TemplateRun("TChem::EnthalpyMass::runHostBatch",
                                  real_type_0d_view_host(),
+                                 real_type_1d_view_host(),
                                  /// team policy
                                  policy,
                                  /// input
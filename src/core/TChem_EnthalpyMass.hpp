@@ -38,10 +38,10 @@ struct EnthalpyMass
 
   static void runDeviceBatch( /// thread block size
     typename UseThisTeamPolicy<exec_space>::type& policy,
-    const real_type_2d_view& state,
+    const real_type_2d_stride_view& state,
     /// output
-    const real_type_2d_view& EnthalpyMass,
-    const real_type_1d_view& EnthalpyMixMass,
+    const real_type_2d_stride_view& EnthalpyMass,
+    const real_type_1d_stride_view& EnthalpyMixMass,
 
     /// const data from kinetic model
     const KineticModelConstDataDevice& kmcd);
@@ -52,10 +52,10 @@ struct EnthalpyMass
     const ordinal_type& team_size,
     const ordinal_type& vector_size,
     const ordinal_type nBatch,
-    const real_type_2d_view& state,
+    const real_type_2d_stride_view& state,
     /// output
-    const real_type_2d_view& EnthalpyMass,
-    const real_type_1d_view& EnthalpyMixMass,
+    const real_type_2d_stride_view& EnthalpyMass,
+    const real_type_1d_stride_view& EnthalpyMixMass,
 
     /// const data from kinetic model
     const KineticModelConstDataDevice& kmcd);
@@ -63,10 +63,10 @@ struct EnthalpyMass
  //
  static void runHostBatch( /// thread block size
    typename UseThisTeamPolicy<host_exec_space>::type& policy,
-   const real_type_2d_view_host& state,
+   const real_type_2d_stride_view_host& state,
    /// output
-   const real_type_2d_view_host& EnthalpyMass,
-   const real_type_1d_view_host& EnthalpyMixMass,
+   const real_type_2d_stride_view_host& EnthalpyMass,
+   const real_type_1d_stride_view_host& EnthalpyMixMass,
    /// const data from kinetic model
    const KineticModelConstDataHost& kmcd);
 };
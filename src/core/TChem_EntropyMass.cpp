@@ -26,18 +26,20 @@ namespace Impl {
 template<typename PolicyType,
          typename RealType0DViewType,
          typename RealType1DViewType,
-         typename RealType2DViewType,
+         typename RealType1DBatchViewType,
+         typename RealType2DBatchViewType,
          typename KineticModelConstType>
 void
 EntropyMass_TemplateRun( /// required template arguments
   const std::string& profile_name,
   const RealType0DViewType& dummy_0d,
+  const RealType1DViewType& dummy_1d,
   /// team size setting
   const PolicyType& policy,
-  const RealType2DViewType& state,
+  const RealType2DBatchViewType& state,
   // outputFile
-  const RealType2DViewType& EntropyMass,
-  const RealType1DViewType& EntropyMixMass,
+  const RealType2DBatchViewType& EntropyMass,
+  const RealType1DBatchViewType& EntropyMixMass,
   const KineticModelConstType& kmcd)
 {
   Kokkos::Profiling::pushRegion(profile_name);
@@ -45,18 +47,22 @@ EntropyMass_TemplateRun( /// required template arguments
 
   const ordinal_type level = 1;
   const ordinal_type per_team_extent = EntropyMass::getWorkSpaceSize(kmcd);
+  const ordinal_type per_team_extent_stage =
+    getBatchRowWorkSpaceSize(state) + getBatchRowWorkSpaceSize(EntropyMass);
 
   Kokkos::parallel_for(
     profile_name,
-    policy,
+    getBatchRowPolicy(policy, per_team_extent_stage),
     KOKKOS_LAMBDA(const typename policy_type::member_type& member) {
       const ordinal_type i = member.league_rank();
+      Scratch<RealType1DViewType> stage(member.team_scratch(level),
+                                        per_team_extent_stage);
+      auto wstage = stage.data();
       const RealType1DViewType state_at_i =
-        Kokkos::subview(state, i, Kokkos::ALL());
+        getBatchRow<RealType1DViewType>(member, state, i, true, wstage);
       const RealType1DViewType EntropyMass_at_i =
-        Kokkos::subview(EntropyMass, i, Kokkos::ALL());
-      const RealType0DViewType EntropyMixMass_at_i =
-        Kokkos::subview(EntropyMixMass, i);
+        getBatchRow<RealType1DViewType>(member, EntropyMass, i, false, wstage);
+      const RealType0DViewType EntropyMixMass_at_i(&EntropyMixMass(i));
       Scratch<RealType1DViewType> work(member.team_scratch(level),
                                        per_team_extent);
       auto w = (real_type*)work.data();
@@ -89,6 +95,7 @@ EntropyMass_TemplateRun( /// required template arguments
           sumSk);
 
         EntropyMixMass_at_i() = sumSk;
+        setBatchRow(member, EntropyMass_at_i, EntropyMass, i);
       }
     });
   Kokkos::Profiling::popRegion();
@@ -103,10 +110,10 @@ EntropyMass::runDeviceBatch( /// thread block size
   const ordinal_type vector_size,
   /// input
   const ordinal_type nBatch,
-  const real_type_2d_view& state,
+  const real_type_2d_stride_view& state,
   /// output
-  const real_type_2d_view& EntropyMass,
-  const real_type_1d_view& EntropyMixMass,
+  const real_type_2d_stride_view& EntropyMass,
+  const real_type_1d_stride_view& EntropyMixMass,
   /// const data from kinetic model
   const KineticModelConstDataDevice& kmcd)
 {
@@ -128,6 +135,7 @@ EntropyMass::runDeviceBatch( /// thread block size
 
   Impl::EntropyMass_TemplateRun("TChem::EntropyMass::runDeviceBatch",
                                  real_type_0d_view(),
+                                 real_type_1d_view(),
                                  /// team policy
                                  policy,
                                  state,
@@ -139,15 +147,16 @@ EntropyMass::runDeviceBatch( /// thread block size
 void
 EntropyMass::runDeviceBatch( /// thread block size
   typename UseThisTeamPolicy<exec_space>::type& policy,
-  const real_type_2d_view& state,
+  const real_type_2d_stride_view& state,
   /// output
-  const real_type_2d_view& EntropyMass,
-  const real_type_1d_view& EntropyMixMass,
+  const real_type_2d_stride_view& EntropyMass,
+  const real_type_1d_stride_view& EntropyMixMass,
   /// const data from kinetic model
   const KineticModelConstDataDevice& kmcd)
 {
   Impl::EntropyMass_TemplateRun("TChem::EntropyMass::runDeviceBatch",
                                  real_type_0d_view(),
+                                 real_type_1d_view(),
                                  /// team policy
                                  policy,
                                  state,
@@ -160,15 +169,16 @@ EntropyMass::runDeviceBatch( /// thread block size
 void
 EntropyMass::runHostBatch( /// thread block size
   typename UseThisTeamPolicy<host_exec_space>::type& policy,
-  const real_type_2d_view_host& state,
+  const real_type_2d_stride_view_host& state,
   /// output
-  const real_type_2d_view_host& EntropyMass,
-  const real_type_1d_view_host& EntropyMixMass,
+  const real_type_2d_stride_view_host& EntropyMass,
+  const real_type_1d_stride_view_host& EntropyMixMass,
   /// const data from kinetic model
   const KineticModelConstDataHost& kmcd)
 {
   Impl::EntropyMass_TemplateRun("TChem::EntropyMass::runHostBatch",
                                  real_type_0d_view_host(),
+                                 real_type_1d_view_host(),
                                  /// team policy
                                  policy,
                                  state,
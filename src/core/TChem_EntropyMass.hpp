@@ -42,30 +42,30 @@ struct EntropyMass
     const ordinal_type vector_size,
     /// input
     const ordinal_type nBatch,
-    const real_type_2d_view& state,
+    const real_type_2d_stride_view& state,
     /// output
-    const real_type_2d_view& EntropyMass,
-    const real_type_1d_view& EntropyMixMass,
+    const real_type_2d_stride_view& EntropyMass,
+    const real_type_1d_stride_view& EntropyMixMass,
 
     /// const data from kinetic model
     const KineticModelConstDataDevice& kmcd);
   //
   static void runDeviceBatch( /// thread block size
     typename UseThisTeamPolicy<exec_space>::type& policy,
-    const real_type_2d_view& state,
+    const real_type_2d_stride_view& state,
     /// output
-    const real_type_2d_view& EntropyMass,
-    const real_type_1d_view& EntropyMixMass,
+    const real_type_2d_stride_view& EntropyMass,
+    const real_type_1d_stride_view& EntropyMixMass,
 
     /// const data from kinetic model
     const KineticModelConstDataDevice& kmcd);
   //
   static void runHostBatch( /// thread block size
     typename UseThisTeamPolicy<host_exec_space>::type& policy,
-    const real_type_2d_view_host& state,
+    const real_type_2d_stride_view_host& state,
     /// output
-    const real_type_2d_view_host& EntropyMass,
-    const real_type_1d_view_host& EntropyMixMass,
+    const real_type_2d_stride_view_host& EntropyMass,
+    const real_type_1d_stride_view_host& EntropyMixMass,
     /// const data from kinetic model
     const KineticModelConstDataHost& kmcd);
 };
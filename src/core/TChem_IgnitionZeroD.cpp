@@ -37,7 +37,9 @@ template<typename PolicyType,
          typename RealType0DViewType,
          typename RealType1DViewType,
          typename RealType2DViewType,
-         typename KineticModelConstType>
+         typename RealType1DBatchViewType,
+         typename RealType2DBatchViewType,
+         typename KineticModelSelectorType>
 void
 IgnitionZeroD_TemplateRun( /// required template arguments
   const std::string& profile_name,
@@ -49,43 +51,52 @@ IgnitionZeroD_TemplateRun( /// required template arguments
   const RealType2DViewType& tol_time,
   const RealType2DViewType& fac,
   const TimeAdvance1DViewType& tadv,
-  const RealType2DViewType& state,
+  const RealType2DBatchViewType& state,
   /// output
-  const RealType1DViewType& t_out,
-  const RealType1DViewType& dt_out,
-  const RealType2DViewType& state_out,
-  /// const data from kinetic model
-  const KineticModelConstType& kmcd)
+  const RealType1DBatchViewType& t_out,
+  const RealType1DBatchViewType& dt_out,
+  const RealType2DBatchViewType& state_out,
+  /// const data from kinetic model; kmcd_of(i) is the model of sample i
+  const KineticModelSelectorType& kmcd_of,
+  const ordinal_type per_team_extent)
 {
   Kokkos::Profiling::pushRegion(profile_name);
   using policy_type = PolicyType;
+  using range_type = Kokkos::pair<ordinal_type, ordinal_type>;
+  using problem_type = Impl::IgnitionZeroD_Problem<
+    typename KineticModelSelectorType::kinetic_model_type>;
 
   const ordinal_type level = 1;
-  const ordinal_type per_team_extent = IgnitionZeroD::getWorkSpaceSize(kmcd);
 
   Kokkos::parallel_for(
     profile_name,
     policy,
     KOKKOS_LAMBDA(const typename policy_type::member_type& member) {
       const ordinal_type i = member.league_rank();
+      const auto& kmcd = kmcd_of(i);
+      const auto kmcd_at_i = Impl::getKineticModelAtSample(kmcd, i);
+      const ordinal_type m = problem_type::getNumberOfEquations(kmcd);
       const RealType1DViewType fac_at_i =
-        Kokkos::subview(fac, i, Kokkos::ALL());
+        Kokkos::subview(fac, i, range_type(0, m));
       const auto tadv_at_i = tadv(i);
       const real_type t_end = tadv_at_i._tend;
-      const RealType0DViewType t_out_at_i = Kokkos::subview(t_out, i);
+      const RealType0DViewType t_out_at_i(&t_out(i));
       if (t_out_at_i() < t_end) {
-      const RealType1DViewType state_at_i =
-        Kokkos::subview(state, i, Kokkos::ALL());
-      const RealType1DViewType state_out_at_i =
-        Kokkos::subview(state_out, i, Kokkos::ALL());
+      /// state vectors can be strided e.g., LayoutLeft batch; rows are
+      /// sized by the largest mechanism when mechanisms are mixed
+      const range_type range_state(0, Impl::getStateVectorSize(kmcd.nSpec));
+      const auto state_at_i = Kokkos::subview(state, i, range_state);
+      const auto state_out_at_i = Kokkos::subview(state_out, i, range_state);
+      using state_at_i_type =
+        decltype(Kokkos::subview(state, i, range_state));
 
-      const RealType0DViewType dt_out_at_i = Kokkos::subview(dt_out, i);
+      const RealType0DViewType dt_out_at_i(&dt_out(i));
       Scratch<RealType1DViewType> work(member.team_scratch(level),
                                        per_team_extent);
 
-      Impl::StateVector<RealType1DViewType> sv_at_i(kmcd.nSpec, state_at_i);
-      Impl::StateVector<RealType1DViewType> sv_out_at_i(kmcd.nSpec,
-                                                        state_out_at_i);
+      Impl::StateVector<state_at_i_type> sv_at_i(kmcd.nSpec, state_at_i);
+      Impl::StateVector<state_at_i_type> sv_out_at_i(kmcd.nSpec,
+                                                     state_out_at_i);
       TCHEM_CHECK_ERROR(!sv_at_i.isValid(),
                         "Error: input state vector is not valid");
       TCHEM_CHECK_ERROR(!sv_out_at_i.isValid(),
@@ -106,10 +117,8 @@ IgnitionZeroD_TemplateRun( /// required template arguments
 
         const RealType0DViewType temperature_out(sv_out_at_i.TemperaturePtr());
         const RealType0DViewType pressure_out(sv_out_at_i.PressurePtr());
-        const RealType1DViewType Ys_out = sv_out_at_i.MassFractions();
+        const auto Ys_out = sv_out_at_i.MassFractions();
 
-        const ordinal_type m = Impl::IgnitionZeroD_Problem<
-          KineticModelConstType>::getNumberOfEquations(kmcd);
         auto wptr = work.data();
         const RealType1DViewType vals(wptr, m);
         wptr += m;
@@ -144,7 +153,7 @@ IgnitionZeroD_TemplateRun( /// required template arguments
                                           pressure_out,
                                           vals,
                                           ww,
-                                          kmcd);
+                                          kmcd_at_i);
 
         member.team_barrier();
         Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
@@ -169,11 +178,11 @@ IgnitionZeroD::runHostBatch( /// input
   const real_type_2d_view_host& tol_time,
   const real_type_2d_view_host& fac,
   const time_advance_type_1d_view_host& tadv,
-  const real_type_2d_view_host& state,
+  const real_type_2d_stride_view_host& state,
   /// output
-  const real_type_1d_view_host& t_out,
-  const real_type_1d_view_host& dt_out,
-  const real_type_2d_view_host& state_out,
+  const real_type_1d_stride_view_host& t_out,
+  const real_type_1d_stride_view_host& dt_out,
+  const real_type_2d_stride_view_host& state_out,
   /// const data from kinetic model
   const KineticModelConstDataHost& kmcd)
 {
@@ -193,7 +202,8 @@ IgnitionZeroD::runHostBatch( /// input
     dt_out,
     state_out,
     /// const data of kinetic model
-    kmcd);
+    Impl::KineticModelSelector<KineticModelConstDataHost>(kmcd),
+    IgnitionZeroD::getWorkSpaceSize(kmcd));
 }
 
 void
@@ -204,11 +214,11 @@ IgnitionZeroD::runDeviceBatch( /// thread block size
   const real_type_2d_view& tol_time,
   const real_type_2d_view& fac,
   const time_advance_type_1d_view& tadv,
-  const real_type_2d_view& state,
+  const real_type_2d_stride_view& state,
   /// output
-  const real_type_1d_view& t_out,
-  const real_type_1d_view& dt_out,
-  const real_type_2d_view& state_out,
+  const real_type_1d_stride_view& t_out,
+  const real_type_1d_stride_view& dt_out,
+  const real_type_2d_stride_view& state_out,
   /// const data from kinetic model
   const KineticModelConstDataDevice& kmcd)
 {
@@ -228,7 +238,84 @@ IgnitionZeroD::runDeviceBatch( /// thread block size
     dt_out,
     state_out,
     /// const data of kinetic model
-    kmcd);
+    Impl::KineticModelSelector<KineticModelConstDataDevice>(kmcd),
+    IgnitionZeroD::getWorkSpaceSize(kmcd));
+}
+
+void
+IgnitionZeroD::runHostBatch( /// input
+  typename UseThisTeamPolicy<host_exec_space>::type& policy,
+  const real_type_1d_view_host& tol_newton,
+  const real_type_2d_view_host& tol_time,
+  const real_type_2d_view_host& fac,
+  const time_advance_type_1d_view_host& tadv,
+  const ordinal_type_1d_view_host& mechanism,
+  const real_type_2d_stride_view_host& state,
+  /// output
+  const real_type_1d_stride_view_host& t_out,
+  const real_type_1d_stride_view_host& dt_out,
+  const real_type_2d_stride_view_host& state_out,
+  /// const data from kinetic models
+  const KineticModelConstDataArrayHost& kmcds)
+{
+  IgnitionZeroD_TemplateRun( /// template arguments deduction
+    "TChem::IgnitionZeroD::runHostBatch::MixedMechanisms",
+    real_type_0d_view_host(),
+    /// team policy
+    policy,
+    /// input
+    tol_newton,
+    tol_time,
+    fac,
+    tadv,
+    state,
+    /// output
+    t_out,
+    dt_out,
+    state_out,
+    /// const data of kinetic models
+    Impl::KineticModelArraySelector<host_exec_space,
+                                    ordinal_type_1d_view_host>(kmcds,
+                                                               mechanism),
+    IgnitionZeroD::getWorkSpaceSize(kmcds));
+}
+
+void
+IgnitionZeroD::runDeviceBatch( /// thread block size
+  typename UseThisTeamPolicy<exec_space>::type& policy,
+  /// input
+  const real_type_1d_view& tol_newton,
+  const real_type_2d_view& tol_time,
+  const real_type_2d_view& fac,
+  const time_advance_type_1d_view& tadv,
+  const ordinal_type_1d_view& mechanism,
+  const real_type_2d_stride_view& state,
+  /// output
+  const real_type_1d_stride_view& t_out,
+  const real_type_1d_stride_view& dt_out,
+  const real_type_2d_stride_view& state_out,
+  /// const data from kinetic models
+  const KineticModelConstDataArrayDevice& kmcds)
+{
+  IgnitionZeroD_TemplateRun( /// template arguments deduction
+    "TChem::IgnitionZeroD::runDeviceBatch::MixedMechanisms",
+    real_type_0d_view(),
+    /// team policy
+    policy,
+    /// input
+    tol_newton,
+    tol_time,
+    fac,
+    tadv,
+    state,
+    /// output
+    t_out,
+    dt_out,
+    state_out,
+    /// const data of kinetic models
+    Impl::KineticModelArraySelector<exec_space, ordinal_type_1d_view>(
+      kmcds, mechanism),
+    IgnitionZeroD::getWorkSpaceSize(kmcds));
 }
 
 } // namespace TChem
@@ -40,12 +40,24 @@ struct IgnitionZeroD
               KineticModelConstDataType>::getNumberOfEquations(kmcd));
   }
 
+  /// the largest workspace over mechanisms mixed in a batch
+  template<typename SpT>
+  static inline ordinal_type getWorkSpaceSize(
+    const KineticModelConstDataArray<SpT>& kmcds)
+  {
+    return Impl::getMaxOverKineticModels(
+      kmcds, [](const KineticModelConstData<SpT>& kmcd) {
+        return getWorkSpaceSize(kmcd);
+      });
+  }
+
   /// tadv - an input structure for time marching
   /// state (nSpec+3) - initial condition of the state vector
   /// work - work space sized by getWorkSpaceSize
   /// t_out - time when this code exits
   /// state_out - final condition of the state vector (the same input state can
   /// be overwritten) kmcd - const data for kinetic model
+  /// state, t_out, dt_out and state_out can be in any layout
   static void runHostBatch( /// input
     typename UseThisTeamPolicy<host_exec_space>::type& policy,
     /// global tolerence parameters that governs all samples
@@ -54,11 +66,11 @@ struct IgnitionZeroD
     /// sample specific input
     const real_type_2d_view_host& fac,
     const time_advance_type_1d_view_host& tadv,
-    const real_type_2d_view_host& state,
+    const real_type_2d_stride_view_host& state,
     /// output
-    const real_type_1d_view_host& t_out,
-    const real_type_1d_view_host& dt_out,
-    const real_type_2d_view_host& state_out,
+    const real_type_1d_stride_view_host& t_out,
+    const real_type_1d_stride_view_host& dt_out,
+    const real_type_2d_stride_view_host& state_out,
     /// const data from kinetic model
     const KineticModelConstDataHost& kmcd);
 
@@ -70,13 +82,214 @@ struct IgnitionZeroD
     /// sample specific input
     const real_type_2d_view& fac,
     const time_advance_type_1d_view& tadv,
-    const real_type_2d_view& state,
+    const real_type_2d_stride_view& state,
     /// output
-    const real_type_1d_view& t_out,
-    const real_type_1d_view& dt_out,
-    const real_type_2d_view& state_out,
+    const real_type_1d_stride_view& t_out,
+    const real_type_1d_stride_view& dt_out,
+    const real_type_2d_stride_view& state_out,
     /// const data from kinetic model
     const KineticModelConstDataDevice& kmcd);
+
+  /// a batch mixing mechanisms; sample i uses kmcds(mechanism(i)). state
+  /// vectors are sized by the largest nSpec, fac and tol_time by the largest
+  /// number of equations and the policy scratch by getWorkSpaceSize(kmcds)
+  static void runHostBatch( /// input
+    typename UseThisTeamPolicy<host_exec_space>::type& policy,
+    /// global tolerence parameters that governs all samples
+    const real_type_1d_view_host& tol_newton,
+    const real_type_2d_view_host& tol_time,
+    /// sample specific input
+    const real_type_2d_view_host& fac,
+    const time_advance_type_1d_view_host& tadv,
+    const ordinal_type_1d_view_host& mechanism,
+    const real_type_2d_stride_view_host& state,
+    /// output
+    const real_type_1d_stride_view_host& t_out,
+    const real_type_1d_stride_view_host& dt_out,
+    const real_type_2d_stride_view_host& state_out,
+    /// const data from kinetic models
+    const KineticModelConstDataArrayHost& kmcds);
+
+  static void runDeviceBatch( /// thread block size
+    typename UseThisTeamPolicy<exec_space>::type& policy,
+    /// global tolerence parameters that governs all samples
+    const real_type_1d_view& tol_newton,
+    const real_type_2d_view& tol_time,
+    /// sample specific input
+    const real_type_2d_view& fac,
+    const time_advance_type_1d_view& tadv,
+    const ordinal_type_1d_view& mechanism,
+    const real_type_2d_stride_view& state,
+    /// output
+    const real_type_1d_stride_view& t_out,
+    const real_type_1d_stride_view& dt_out,
+    const real_type_2d_stride_view& state_out,
+    /// const data from kinetic models
+    const KineticModelConstDataArrayDevice& kmcds);
+
+  /// execution plan for repeated calls with the same batch size e.g.,
+  /// operator splitting; the team policy, tolerences and sample specific
+  /// arrays are created once and the time step size of a sample is carried
+  /// over to the next execution
+  template<typename SpT>
+  class Plan
+  {
+  public:
+    using policy_type = typename UseThisTeamPolicy<SpT>::type;
+    using kinetic_model_type = KineticModelConstData<SpT>;
+    using is_host_type = std::is_same<SpT, host_exec_space>;
+    using real_type_1d_view_type =
+      typename std::conditional<is_host_type::value,
+                                real_type_1d_view_host,
+                                real_type_1d_view>::type;
+    using real_type_2d_view_type =
+      typename std::conditional<is_host_type::value,
+                                real_type_2d_view_host,
+                                real_type_2d_view>::type;
+    using real_type_2d_stride_view_type =
+      typename std::conditional<is_host_type::value,
+                                real_type_2d_stride_view_host,
+                                real_type_2d_stride_view>::type;
+    using time_advance_type_1d_view_type =
+      typename std::conditional<is_host_type::value,
+                                time_advance_type_1d_view_host,
+                                time_advance_type_1d_view>::type;
+
+  private:
+    kinetic_model_type _kmcd;
+    SpT _exec_instance;
+    policy_type _policy;
+    ordinal_type _nBatch, _max_num_outer_iterations;
+
+    time_advance_type _tadv_default;
+
+    real_type_1d_view_type _tol_newton;
+    real_type_2d_view_type _tol_time, _fac;
+    time_advance_type_1d_view_type _tadv;
+    real_type_1d_view_type _t, _dt;
+
+    template<typename... Args>
+    static void run(std::true_type, Args&&... args)
+    {
+      runHostBatch(args...);
+    }
+    template<typename... Args>
+    static void run(std::false_type, Args&&... args)
+    {
+      runDeviceBatch(args...);
+    }
+
+  public:
+    /// tadv_default - _dt (initial), _dtmin, _dtmax and iteration counts;
+    ///   _tbeg and _tend are set by execute
+    /// max_num_outer_iterations - maximum number of batch launches per
+    ///   execute; each launch takes _num_time_iterations_per_interval steps
+    /// exec_instance - execution space instance where execute and
+    ///   resetTimeStepSize are enqueued e.g., a cuda stream; these do not
+    ///   fence other instances
+    Plan(const kinetic_model_type& kmcd,
+         const ordinal_type nBatch,
+         const real_type atol_newton,
+         const real_type rtol_newton,
+         const real_type atol_time,
+         const real_type rtol_time,
+         const time_advance_type& tadv_default,
+         const ordinal_type max_num_outer_iterations = 1000,
+         const SpT& exec_instance = SpT())
+      : _kmcd(kmcd)
+      , _exec_instance(exec_instance)
+      , _policy(exec_instance, nBatch, Kokkos::AUTO())
+      , _nBatch(nBatch)
+      , _max_num_outer_iterations(max_num_outer_iterations)
+      , _tadv_default(tadv_default)
+    {
+      using problem_type = Impl::IgnitionZeroD_Problem<kinetic_model_type>;
+      const ordinal_type m = problem_type::getNumberOfEquations(kmcd);
+
+      const ordinal_type level = 1;
+      const ordinal_type per_team_scratch =
+        Scratch<real_type_1d_view>::shmem_size(getWorkSpaceSize(kmcd));
+      _policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+      _tol_newton = real_type_1d_view_type("tol newton", 2);
+      _tol_time = real_type_2d_view_type(
+        "tol time", problem_type::getNumberOfTimeODEs(kmcd), 2);
+      _fac = real_type_2d_view_type("fac", nBatch, m);
+      _tadv = time_advance_type_1d_view_type("tadv", nBatch);
+      _t = real_type_1d_view_type("time", nBatch);
+      _dt = real_type_1d_view_type("delta time", nBatch);
+      {
+        auto tol_newton_host = Kokkos::create_mirror_view(_tol_newton);
+        auto tol_time_host = Kokkos::create_mirror_view(_tol_time);
+        tol_newton_host(0) = atol_newton;
+        tol_newton_host(1) = rtol_newton;
+        for (ordinal_type i = 0, iend = tol_time_host.extent(0); i < iend;
+             ++i) {
+          tol_time_host(i, 0) = atol_time;
+          tol_time_host(i, 1) = rtol_time;
+        }
+        Kokkos::deep_copy(_tol_newton, tol_newton_host);
+        Kokkos::deep_copy(_tol_time, tol_time_host);
+      }
+      Kokkos::deep_copy(_tadv, _tadv_default);
+      Kokkos::deep_copy(_dt, _tadv_default._dt);
+    }
+
+    /// the next execution starts from the initial time step size of
+    /// tadv_default e.g., when the batch is refilled with new samples
+    void resetTimeStepSize()
+    {
+      Kokkos::deep_copy(_exec_instance, _dt, _tadv_default._dt);
+    }
+
+    /// time step size of samples at the end of the last execution
+    real_type_1d_view_type getTimeStepSize() const { return _dt; }
+
+    /// advances the state of all samples by dt; the state is overwritten
+    void execute(const real_type_2d_stride_view_type& state, const real_type dt)
+    {
+      const auto tadv = _tadv;
+      const auto t = _t;
+      const auto dt_out = _dt;
+      const auto tadv_default = _tadv_default;
+      Kokkos::parallel_for(
+        Kokkos::RangePolicy<SpT>(_exec_instance, 0, _nBatch),
+        KOKKOS_LAMBDA(const ordinal_type& i) {
+          tadv(i)._tbeg = 0;
+          tadv(i)._tend = dt;
+          tadv(i)._dt = getValueInRange(
+            tadv_default._dtmin, tadv_default._dtmax, dt_out(i));
+          t(i) = 0;
+        });
+
+      for (ordinal_type iter = 0; iter < _max_num_outer_iterations; ++iter) {
+        run(is_host_type(),
+            _policy,
+            _tol_newton,
+            _tol_time,
+            _fac,
+            _tadv,
+            state,
+            _t,
+            _dt,
+            state,
+            _kmcd);
+
+        /// carry over time and dt computed in this launch
+        ordinal_type num_active(0);
+        Kokkos::parallel_reduce(
+          Kokkos::RangePolicy<SpT>(_exec_instance, 0, _nBatch),
+          KOKKOS_LAMBDA(const ordinal_type& i, ordinal_type& update) {
+            tadv(i)._tbeg = t(i);
+            tadv(i)._dt = dt_out(i);
+            update += (t(i) < dt);
+          },
+          num_active);
+        if (num_active == 0)
+          break;
+      }
+    }
+  };
 };
 
 } // namespace TChem
@@ -0,0 +1,230 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#include "TChem_Util.hpp"
+
+#include "TChem_IgnitionZeroDSensitivity.hpp"
+
+namespace TChem {
+
+template<typename PolicyType,
+         typename TimeAdvance1DViewType,
+         typename RealType0DViewType,
+         typename RealType1DViewType,
+         typename RealType2DViewType,
+         typename RealType3DViewType,
+         typename RealType1DBatchViewType,
+         typename RealType2DBatchViewType,
+         typename KineticModelConstType>
+void
+IgnitionZeroDSensitivity_TemplateRun( /// required template arguments
+  const std::string& profile_name,
+  const RealType0DViewType& dummy_0d,
+  /// team size setting
+  const PolicyType& policy,
+  /// input
+  const RealType1DViewType& tol_newton,
+  const RealType2DViewType& tol_time,
+  const RealType2DViewType& fac,
+  const TimeAdvance1DViewType& tadv,
+  const RealType2DBatchViewType& state,
+  /// output
+  const RealType1DBatchViewType& t_out,
+  const RealType1DBatchViewType& dt_out,
+  const RealType2DBatchViewType& state_out,
+  /// input/output
+  const RealType3DViewType& sens,
+  /// const data from kinetic model
+  const KineticModelConstType& kmcd)
+{
+  Kokkos::Profiling::pushRegion(profile_name);
+  using policy_type = PolicyType;
+  using problem_type = Impl::IgnitionZeroD_Problem<KineticModelConstType>;
+
+  const ordinal_type level = 1;
+  const ordinal_type per_team_extent =
+    IgnitionZeroDSensitivity::getWorkSpaceSize(kmcd);
+  const ordinal_type m = problem_type::getNumberOfEquations(kmcd);
+
+  Kokkos::parallel_for(
+    profile_name,
+    policy,
+    KOKKOS_LAMBDA(const typename policy_type::member_type& member) {
+      const ordinal_type i = member.league_rank();
+      const auto kmcd_at_i = Impl::getKineticModelAtSample(kmcd, i);
+      const RealType1DViewType fac_at_i =
+        Kokkos::subview(fac, i, Kokkos::ALL());
+      const auto tadv_at_i = tadv(i);
+      const real_type t_end = tadv_at_i._tend;
+      const RealType0DViewType t_out_at_i(&t_out(i));
+      if (t_out_at_i() < t_end) {
+        const auto state_at_i = Kokkos::subview(state, i, Kokkos::ALL());
+        const auto state_out_at_i =
+          Kokkos::subview(state_out, i, Kokkos::ALL());
+        const RealType2DViewType sens_at_i =
+          Kokkos::subview(sens, i, Kokkos::ALL(), Kokkos::ALL());
+        using state_at_i_type =
+          decltype(Kokkos::subview(state, i, Kokkos::ALL()));
+
+        const RealType0DViewType dt_out_at_i(&dt_out(i));
+        Scratch<RealType1DViewType> work(member.team_scratch(level),
+                                         per_team_extent);
+
+        Impl::StateVector<state_at_i_type> sv_at_i(kmcd.nSpec, state_at_i);
+        Impl::StateVector<state_at_i_type> sv_out_at_i(kmcd.nSpec,
+                                                       state_out_at_i);
+        TCHEM_CHECK_ERROR(!sv_at_i.isValid(),
+                          "Error: input state vector is not valid");
+        TCHEM_CHECK_ERROR(!sv_out_at_i.isValid(),
+                          "Error: input state vector is not valid");
+
+        const auto temperature = sv_at_i.Temperature();
+        const auto pressure = sv_at_i.Pressure();
+        const auto Ys = sv_at_i.MassFractions();
+
+        const RealType0DViewType temperature_out(sv_out_at_i.TemperaturePtr());
+        const RealType0DViewType pressure_out(sv_out_at_i.PressurePtr());
+        const auto Ys_out = sv_out_at_i.MassFractions();
+
+        auto wptr = work.data();
+        const RealType1DViewType vals(wptr, m);
+        wptr += m;
+        const RealType1DViewType ww(wptr,
+                                    work.extent(0) - (wptr - work.data()));
+
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const ordinal_type& k) {
+                               vals(k) = k == 0 ? temperature : Ys(k - 1);
+                             });
+        member.team_barrier();
+
+        Impl::IgnitionZeroD::team_invoke(
+          member,
+          tadv_at_i._max_num_newton_iterations,
+          tadv_at_i._num_time_iterations_per_interval,
+          tol_newton,
+          tol_time,
+          fac_at_i,
+          tadv_at_i._dt,
+          tadv_at_i._dtmin,
+          tadv_at_i._dtmax,
+          tadv_at_i._tbeg,
+          t_end,
+          pressure,
+          vals,
+          t_out_at_i,
+          dt_out_at_i,
+          pressure_out,
+          vals,
+          sens_at_i,
+          ww,
+          kmcd_at_i);
+
+        member.team_barrier();
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const ordinal_type& k) {
+                               if (k == 0) {
+                                 temperature_out() = vals(0);
+                               } else {
+                                 Ys_out(k - 1) = vals(k);
+                               }
+                             });
+        member.team_barrier();
+      }
+    });
+  Kokkos::Profiling::popRegion();
+}
+
+void
+IgnitionZeroDSensitivity::runHostBatch( /// input
+  typename UseThisTeamPolicy<host_exec_space>::type& policy,
+  const real_type_1d_view_host& tol_newton,
+  const real_type_2d_view_host& tol_time,
+  const real_type_2d_view_host& fac,
+  const time_advance_type_1d_view_host& tadv,
+  const real_type_2d_stride_view_host& state,
+  /// output
+  const real_type_1d_stride_view_host& t_out,
+  const real_type_1d_stride_view_host& dt_out,
+  const real_type_2d_stride_view_host& state_out,
+  /// input/output
+  const real_type_3d_view_host& sens,
+  /// const data from kinetic model
+  const KineticModelConstDataHost& kmcd)
+{
+  IgnitionZeroDSensitivity_TemplateRun( /// template arguments deduction
+    "TChem::IgnitionZeroDSensitivity::runHostBatch",
+    real_type_0d_view_host(),
+    /// team policy
+    policy,
+    /// input
+    tol_newton,
+    tol_time,
+    fac,
+    tadv,
+    state,
+    /// output
+    t_out,
+    dt_out,
+    state_out,
+    sens,
+    /// const data of kinetic model
+    kmcd);
+}
+
+void
+IgnitionZeroDSensitivity::runDeviceBatch( /// thread block size
+  typename UseThisTeamPolicy<exec_space>::type& policy,
+  /// input
+  const real_type_1d_view& tol_newton,
+  const real_type_2d_view& tol_time,
+  const real_type_2d_view& fac,
+  const time_advance_type_1d_view& tadv,
+  const real_type_2d_stride_view& state,
+  /// output
+  const real_type_1d_stride_view& t_out,
+  const real_type_1d_stride_view& dt_out,
+  const real_type_2d_stride_view& state_out,
+  /// input/output
+  const real_type_3d_view& sens,
+  /// const data from kinetic model
+  const KineticModelConstDataDevice& kmcd)
+{
+  IgnitionZeroDSensitivity_TemplateRun( /// template arguments deduction
+    "TChem::IgnitionZeroDSensitivity::runDeviceBatch",
+    real_type_0d_view(),
+    /// team policy
+    policy,
+    /// input
+    tol_newton,
+    tol_time,
+    fac,
+    tadv,
+    state,
+    /// output
+    t_out,
+    dt_out,
+    state_out,
+    sens,
+    /// const data of kinetic model
+    kmcd);
+}
+
+} // namespace TChem
@@ -0,0 +1,89 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_IGNITION_ZEROD_SENSITIVITY_HPP__
+#define __TCHEM_IGNITION_ZEROD_SENSITIVITY_HPP__
+
+#include "TChem_KineticModelData.hpp"
+#include "TChem_Util.hpp"
+
+#include "TChem_IgnitionZeroD.hpp"
+
+namespace TChem {
+
+/// IgnitionZeroD with forward sensitivities of the solution with respect to
+/// ln A of each reaction. the sensitivity equations dS/dt = J S + df/dp are
+/// integrated alongside the state with a staggered corrector that reuses the
+/// newton iteration matrix of each TrBDF2 stage
+struct IgnitionZeroDSensitivity
+{
+  template<typename KineticModelConstDataType>
+  static inline ordinal_type getWorkSpaceSize(
+    const KineticModelConstDataType& kmcd)
+  {
+    return (IgnitionZeroD::getWorkSpaceSize(kmcd) +
+            Impl::IgnitionZeroD::getSensitivityWorkSpaceSize(kmcd));
+  }
+
+  /// sens (nBatch, kmcd.nReac, kmcd.nSpec + 1) - input at the beginning
+  ///   (zero for a new problem) and output at t_out; sens(i,j,0) is the
+  ///   derivative of the temperature of sample i with respect to ln A of
+  ///   reaction j and sens(i,j,k+1) is the derivative of the mass fraction
+  ///   of species k. the other arguments are the same as IgnitionZeroD
+  static void runHostBatch( /// input
+    typename UseThisTeamPolicy<host_exec_space>::type& policy,
+    /// global tolerence parameters that governs all samples
+    const real_type_1d_view_host& tol_newton,
+    const real_type_2d_view_host& tol_time,
+    /// sample specific input
+    const real_type_2d_view_host& fac,
+    const time_advance_type_1d_view_host& tadv,
+    const real_type_2d_stride_view_host& state,
+    /// output
+    const real_type_1d_stride_view_host& t_out,
+    const real_type_1d_stride_view_host& dt_out,
+    const real_type_2d_stride_view_host& state_out,
+    /// input/output
+    const real_type_3d_view_host& sens,
+    /// const data from kinetic model
+    const KineticModelConstDataHost& kmcd);
+
+  static void runDeviceBatch( /// thread block size
+    typename UseThisTeamPolicy<exec_space>::type& policy,
+    /// global tolerence parameters that governs all samples
+    const real_type_1d_view& tol_newton,
+    const real_type_2d_view& tol_time,
+    /// sample specific input
+    const real_type_2d_view& fac,
+    const time_advance_type_1d_view& tadv,
+    const real_type_2d_stride_view& state,
+    /// output
+    const real_type_1d_stride_view& t_out,
+    const real_type_1d_stride_view& dt_out,
+    const real_type_2d_stride_view& state_out,
+    /// input/output
+    const real_type_3d_view& sens,
+    /// const data from kinetic model
+    const KineticModelConstDataDevice& kmcd);
+};
+
+} // namespace TChem
+
+#endif
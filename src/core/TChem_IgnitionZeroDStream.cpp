@@ -0,0 +1,225 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#include <thread>
+
+#include "TChem_IgnitionZeroDStream.hpp"
+#include "TChem_SampleFileReader.hpp"
+#include "TChem_TrajectoryWriter.hpp"
+
+namespace TChem {
+
+IgnitionZeroDStream::IgnitionZeroDStream(
+  const KineticModelConstDataDevice& kmcd,
+  const KineticModelConstDataHost& kmcd_host,
+  const ordinal_type chunk_size,
+  const real_type atol_newton,
+  const real_type rtol_newton,
+  const real_type atol_time,
+  const real_type rtol_time,
+  const time_advance_type& tadv_default,
+  const ordinal_type max_num_outer_iterations)
+  : _kmcd(kmcd)
+  , _kmcd_host(kmcd_host)
+  , _chunk_size(chunk_size)
+  , _atol_newton(atol_newton)
+  , _rtol_newton(rtol_newton)
+  , _atol_time(atol_time)
+  , _rtol_time(rtol_time)
+  , _tadv_default(tadv_default)
+  , _max_num_outer_iterations(max_num_outer_iterations)
+{}
+
+IgnitionZeroDStream::Statistics
+IgnitionZeroDStream::run(const std::string& sampleFile,
+                         const std::string& outputFile,
+                         const real_type tend)
+{
+  Statistics stats = { 0, 0, 0, 0, 0, 0 };
+
+  const Test::SampleFileReader reader(sampleFile);
+  if (!reader.isOpen()) {
+    printf("IgnitionZeroDStream: Could not open %s\n", sampleFile.c_str());
+    return stats;
+  }
+
+  const ordinal_type nSamples = reader.getNumberOfSamples();
+  const ordinal_type nChunk = std::min(_chunk_size, nSamples);
+  if (nChunk <= 0)
+    return stats;
+  const ordinal_type nChunks = (nSamples + nChunk - 1) / nChunk;
+  stats._num_samples = nSamples;
+  stats._num_chunks = nChunks;
+
+  const ordinal_type nSpec = _kmcd_host.nSpec;
+  const ordinal_type stateVecDim = Impl::getStateVectorSize(nSpec);
+
+  /// temperature, pressure and mass fractions; resolved once
+  std::vector<ordinal_type> columns, indx;
+  Test::getSampleColumns(reader.getVariableNames(),
+                         _kmcd_host.speciesNames,
+                         nSpec,
+                         2,
+                         3,
+                         columns,
+                         indx);
+  if (columns.size() >= 2) {
+    columns[0] = 2;
+    columns[1] = 1;
+  }
+
+  /// parse k-th chunk into s and set the density; rows beyond the last
+  /// sample are padded with the first sample of the chunk. This is called
+  /// from a std::thread and does not launch kokkos kernels.
+  const auto sMass = _kmcd_host.sMass;
+  auto load = [&, sMass](const ordinal_type k,
+                         const real_type_2d_view_pinned& s) {
+    const ordinal_type row_begin = k * nChunk;
+    const ordinal_type n = std::min(nChunk, nSamples - row_begin);
+    const real_type_2d_view_pinned s_n(s.data(), n, stateVecDim);
+    reader.read(columns, s_n, row_begin, false);
+
+    const real_type Runiv = RUNIV * 1.0e3;
+    for (ordinal_type i = 0; i < n; ++i) {
+      real_type Ysum(0);
+      for (ordinal_type sp = 0; sp < ordinal_type(indx.size()); ++sp)
+        Ysum += s(i, indx[sp] + 3) / sMass(indx[sp]);
+      s(i, 0) = s(i, 1) / (Runiv * Ysum * s(i, 2));
+    }
+    for (ordinal_type i = n; i < nChunk; ++i)
+      for (ordinal_type j = 0; j < stateVecDim; ++j)
+        s(i, j) = s(0, j);
+    return n;
+  };
+
+  /// double buffers for load and compute; rows of the chunk in a buffer
+  real_type_2d_view_pinned state_in[2] = {
+    real_type_2d_view_pinned("state in 0", nChunk, stateVecDim),
+    real_type_2d_view_pinned("state in 1", nChunk, stateVecDim)
+  };
+  real_type_2d_view state[2] = {
+    real_type_2d_view("state 0", nChunk, stateVecDim),
+    real_type_2d_view("state 1", nChunk, stateVecDim)
+  };
+  ordinal_type n_in[2] = { 0, 0 };
+  real_type_2d_view_pinned state_out("state out", nChunk, stateVecDim);
+  real_type_1d_view_pinned t_out("t out", nChunk);
+  real_type_1d_view_pinned dt_out("dt out", nChunk);
+
+  /// integration and copies of the next chunk are issued on separate
+  /// instances; neither waits for the other
+#if defined(KOKKOS_ENABLE_CUDA)
+  cudaStream_t compute_stream, copy_stream;
+  cudaStreamCreate(&compute_stream);
+  cudaStreamCreate(&copy_stream);
+  const exec_space compute_space(compute_stream);
+  const exec_space copy_space(copy_stream);
+#else
+  const exec_space compute_space;
+  const exec_space copy_space;
+#endif
+
+  IgnitionZeroD::Plan<exec_space> plan(_kmcd,
+                                       nChunk,
+                                       _atol_newton,
+                                       _rtol_newton,
+                                       _atol_time,
+                                       _rtol_time,
+                                       _tadv_default,
+                                       _max_num_outer_iterations,
+                                       compute_space);
+
+  std::vector<std::string> names = { "iter", "t", "dt" };
+  TrajectoryWriter::addStateVectorNames(
+    names, _kmcd_host.speciesNames, nSpec);
+  TrajectoryWriter writer(outputFile, names, true);
+
+  Kokkos::Impl::Timer timer;
+
+  n_in[0] = load(0, state_in[0]);
+  Kokkos::deep_copy(copy_space, state[0], state_in[0]);
+  copy_space.fence();
+
+  /// chunk k + 1 is parsed while chunk k is copied
+  std::thread loader;
+  if (1 < nChunks)
+    loader = std::thread([&]() { n_in[1] = load(1, state_in[1]); });
+
+  for (ordinal_type k = 0; k < nChunks; ++k) {
+    const ordinal_type cur = k % 2, next = (k + 1) % 2;
+
+    /// 1. issue the copy of the next chunk before the current chunk is
+    ///    integrated; state[next] is free as its chunk was written
+    timer.reset();
+    if (loader.joinable()) {
+      loader.join();
+      Kokkos::deep_copy(copy_space, state[next], state_in[next]);
+    }
+    stats._t_load_wait += timer.seconds();
+    const ordinal_type n_cur = n_in[cur];
+
+    /// 2. parse the chunk after next into the buffer of the current chunk,
+    ///    which was copied to the device in the previous iteration
+    if (k + 2 < nChunks)
+      loader = std::thread(
+        [&, k, cur]() { n_in[cur] = load(k + 2, state_in[cur]); });
+
+    /// 3. integrate the current chunk
+    timer.reset();
+    plan.resetTimeStepSize();
+    plan.execute(state[cur], tend);
+    compute_space.fence();
+    stats._t_compute += timer.seconds();
+
+    /// 4. write the current chunk; failed samples have a negative dt, their
+    ///    state is not advanced and they are written with t = 0
+    timer.reset();
+    Kokkos::deep_copy(compute_space, state_out, state[cur]);
+    Kokkos::deep_copy(compute_space, dt_out, plan.getTimeStepSize());
+    compute_space.fence();
+    for (ordinal_type i = 0; i < n_cur; ++i) {
+      const bool is_failed = dt_out(i) < 0;
+      t_out(i) = is_failed ? real_type(0) : tend;
+      stats._num_failures += is_failed;
+    }
+    const real_type_2d_view_pinned state_out_n(
+      state_out.data(), n_cur, stateVecDim);
+    writer.append(k,
+                  real_type_1d_view_pinned(t_out.data(), n_cur),
+                  real_type_1d_view_pinned(dt_out.data(), n_cur),
+                  state_out_n,
+                  real_type_2d_view_pinned(),
+                  real_type_1d_view_pinned());
+    stats._t_write += timer.seconds();
+
+    /// the next chunk is on the device before it is integrated
+    copy_space.fence();
+  }
+  writer.close();
+
+#if defined(KOKKOS_ENABLE_CUDA)
+  cudaStreamDestroy(compute_stream);
+  cudaStreamDestroy(copy_stream);
+#endif
+
+  return stats;
+}
+
+} // namespace TChem
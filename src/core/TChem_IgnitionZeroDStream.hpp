@@ -0,0 +1,100 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_IGNITION_ZEROD_STREAM_HPP__
+#define __TCHEM_IGNITION_ZEROD_STREAM_HPP__
+
+#include "TChem_KineticModelData.hpp"
+#include "TChem_Util.hpp"
+
+#include "TChem_IgnitionZeroD.hpp"
+
+namespace TChem {
+
+/// Out-of-core streaming driver of the constant pressure ignition
+/// - samples in a sample file (readSample format) are advanced to tend in
+///   chunks of a fixed number of samples; memory is bounded by the chunk
+///   size regardless of the number of samples
+/// - three stages overlap: the next chunk is copied on an execution space
+///   instance and the one after it is parsed on a host thread while the
+///   current chunk is integrated on another instance, and the previous
+///   chunk is written by the background thread of TrajectoryWriter
+/// - host buffers are pinned when the device is CUDA
+class IgnitionZeroDStream
+{
+public:
+#if defined(KOKKOS_ENABLE_CUDA)
+  using host_pinned_space = Kokkos::CudaHostPinnedSpace;
+#else
+  using host_pinned_space = Kokkos::HostSpace;
+#endif
+  using real_type_1d_view_pinned =
+    Kokkos::View<real_type*, Kokkos::LayoutRight, host_pinned_space>;
+  using real_type_2d_view_pinned =
+    Kokkos::View<real_type**, Kokkos::LayoutRight, host_pinned_space>;
+
+  struct Statistics
+  {
+    ordinal_type _num_samples;
+    ordinal_type _num_chunks;
+    /// samples whose time integration failed
+    ordinal_type _num_failures;
+    /// time spent in integration, waiting for the loader and writing
+    real_type _t_compute;
+    real_type _t_load_wait;
+    real_type _t_write;
+  };
+
+private:
+  KineticModelConstDataDevice _kmcd;
+  KineticModelConstDataHost _kmcd_host;
+
+  ordinal_type _chunk_size;
+  real_type _atol_newton, _rtol_newton, _atol_time, _rtol_time;
+  time_advance_type _tadv_default;
+  ordinal_type _max_num_outer_iterations;
+
+public:
+  /// kmcd, kmcd_host - const data for kinetic model on device and host;
+  ///   kmcd_host provides species names and molecular weights to the reader
+  /// chunk_size - number of samples integrated in a launch
+  /// tadv_default - _dt, _dtmin, _dtmax and iteration counts
+  IgnitionZeroDStream(const KineticModelConstDataDevice& kmcd,
+                      const KineticModelConstDataHost& kmcd_host,
+                      const ordinal_type chunk_size,
+                      const real_type atol_newton,
+                      const real_type rtol_newton,
+                      const real_type atol_time,
+                      const real_type rtol_time,
+                      const time_advance_type& tadv_default,
+                      const ordinal_type max_num_outer_iterations = 1000);
+
+  /// advances all samples in sampleFile to tend and appends the final states
+  /// to outputFile in the TrajectoryWriter format; the iter column is the
+  /// chunk index. Failed samples are written with t = 0 and dt = -1 and are
+  /// counted in Statistics::_num_failures
+  Statistics run(const std::string& sampleFile,
+                 const std::string& outputFile,
+                 const real_type tend);
+};
+
+} // namespace TChem
+
+#endif
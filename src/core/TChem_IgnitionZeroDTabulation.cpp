@@ -0,0 +1,501 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#include "TChem_Util.hpp"
+
+#include "TChem_IgnitionZeroDTabulation.hpp"
+
+namespace TChem {
+
+IgnitionZeroDTabulation::IgnitionZeroDTabulation(
+  const KineticModelConstDataHost& kmcd,
+  const real_type_1d_view_host& tol_newton,
+  const real_type_2d_view_host& tol_time,
+  const time_advance_type& tadv,
+  const real_type tol_isat,
+  const ordinal_type max_num_records)
+  : _kmcd(kmcd)
+  , _tol_newton(tol_newton)
+  , _tol_time(tol_time)
+  , _tol_isat(tol_isat)
+  /// bound of the EOA in directions where the sensitivity vanishes
+  , _max_radius(0.1)
+  , _max_num_records(max_num_records)
+  , _tadv_default(tadv)
+  , _num_queries(0)
+  , _num_retrieves(0)
+  , _num_grows(0)
+  , _num_adds(0)
+  , _num_direct_evaluations(0)
+  , _num_failures(0)
+{}
+
+void
+IgnitionZeroDTabulation::getVariables(const real_type_1d_view_host& state,
+                                      real_type* phi) const
+{
+  Impl::StateVector<real_type_1d_view_host> sv(_kmcd.nSpec, state);
+  const auto Ys = sv.MassFractions();
+  phi[0] = sv.Temperature();
+  phi[1] = sv.Pressure();
+  for (ordinal_type k = 0; k < _kmcd.nSpec; ++k)
+    phi[k + 2] = Ys(k);
+}
+
+ordinal_type
+IgnitionZeroDTabulation::findLeafRecord(const real_type dt,
+                                        const real_type* phi) const
+{
+  const auto it = _roots.find(dt);
+  if (it == _roots.end())
+    return -1;
+
+  const ordinal_type n = getNumberOfVariables();
+  ordinal_type node = it->second;
+  while (_nodes[node]._record < 0) {
+    const auto& nd = _nodes[node];
+    real_type vphi(0);
+    for (ordinal_type j = 0; j < n; ++j)
+      vphi += nd._v[j] * phi[j];
+    node = vphi > nd._a ? nd._right : nd._left;
+  }
+  return _nodes[node]._record;
+}
+
+real_type
+IgnitionZeroDTabulation::computeEllipsoidNorm(const Record& rec,
+                                              const real_type* phi) const
+{
+  const ordinal_type n = getNumberOfVariables();
+  std::vector<real_type> x(n);
+  for (ordinal_type j = 0; j < n; ++j)
+    x[j] = (phi[j] - rec._phi[j]) / rec._s[j];
+
+  real_type norm(0);
+  for (ordinal_type j = 0; j < n; ++j) {
+    real_type Mx(0);
+    for (ordinal_type l = 0; l < n; ++l)
+      Mx += rec._M[j * n + l] * x[l];
+    norm += x[j] * Mx;
+  }
+  return norm;
+}
+
+void
+IgnitionZeroDTabulation::computeLinearApproximation(const Record& rec,
+                                                    const real_type* phi,
+                                                    real_type* psi) const
+{
+  const ordinal_type n = getNumberOfVariables();
+  std::vector<real_type> x(n);
+  for (ordinal_type j = 0; j < n; ++j)
+    x[j] = (phi[j] - rec._phi[j]) / rec._s[j];
+
+  for (ordinal_type j = 0; j < n; ++j) {
+    real_type Ax(0);
+    for (ordinal_type l = 0; l < n; ++l)
+      Ax += rec._A[j * n + l] * x[l];
+    psi[j] = rec._psi[j] + rec._s[j] * Ax;
+  }
+}
+
+real_type
+IgnitionZeroDTabulation::computeError(const Record& rec,
+                                      const real_type* phi,
+                                      const real_type* psi) const
+{
+  const ordinal_type n = getNumberOfVariables();
+  std::vector<real_type> psi_linear(n);
+  computeLinearApproximation(rec, phi, psi_linear.data());
+
+  real_type err(0);
+  for (ordinal_type j = 0; j < n; ++j) {
+    const real_type e = (psi[j] - psi_linear[j]) / rec._s[j];
+    err += e * e;
+  }
+  return ats<real_type>::sqrt(err);
+}
+
+void
+IgnitionZeroDTabulation::growEllipsoid(Record& rec, const real_type* phi)
+{
+  const ordinal_type n = getNumberOfVariables();
+  std::vector<real_type> x(n), Mx(n, real_type(0));
+  for (ordinal_type j = 0; j < n; ++j)
+    x[j] = (phi[j] - rec._phi[j]) / rec._s[j];
+
+  real_type r2(0);
+  for (ordinal_type j = 0; j < n; ++j) {
+    for (ordinal_type l = 0; l < n; ++l)
+      Mx[j] += rec._M[j * n + l] * x[l];
+    r2 += x[j] * Mx[j];
+  }
+
+  /// the point is already covered
+  if (r2 <= real_type(1))
+    return;
+
+  /// shrink the EOA along M x so that x lies on its boundary; directions
+  /// conjugate to x are unchanged and the old EOA is contained
+  const real_type alpha = (real_type(1) - real_type(1) / r2) / r2;
+  for (ordinal_type j = 0; j < n; ++j)
+    for (ordinal_type l = 0; l < n; ++l)
+      rec._M[j * n + l] -= alpha * Mx[j] * Mx[l];
+}
+
+void
+IgnitionZeroDTabulation::addRecord(const real_type dt, Record&& rec)
+{
+  const ordinal_type n = getNumberOfVariables();
+  const ordinal_type rid = _records.size();
+  _records.push_back(std::move(rec));
+
+  const ordinal_type leaf = _nodes.size();
+  _nodes.push_back(
+    Node{ -1, -1, rid, std::vector<real_type>(), real_type(0) });
+
+  const auto it = _roots.find(dt);
+  if (it == _roots.end()) {
+    _roots[dt] = leaf;
+    return;
+  }
+
+  /// find the leaf node where the new record falls
+  const real_type* phi = _records[rid]._phi.data();
+  ordinal_type node = it->second;
+  while (_nodes[node]._record < 0) {
+    real_type vphi(0);
+    for (ordinal_type j = 0; j < n; ++j)
+      vphi += _nodes[node]._v[j] * phi[j];
+    node = vphi > _nodes[node]._a ? _nodes[node]._right : _nodes[node]._left;
+  }
+
+  /// the leaf becomes a branch cut by the plane bisecting two records
+  const auto& old_rec = _records[_nodes[node]._record];
+  std::vector<real_type> v(n);
+  real_type a(0);
+  for (ordinal_type j = 0; j < n; ++j) {
+    const real_type s2 = old_rec._s[j] * old_rec._s[j];
+    v[j] = (phi[j] - old_rec._phi[j]) / s2;
+    a += v[j] * (phi[j] + old_rec._phi[j]) / real_type(2);
+  }
+
+  const ordinal_type left = _nodes.size();
+  const ordinal_type old_rid = _nodes[node]._record;
+  _nodes.push_back(
+    Node{ -1, -1, old_rid, std::vector<real_type>(), real_type(0) });
+
+  auto& branch = _nodes[node];
+  branch._left = left;
+  branch._right = leaf;
+  branch._record = -1;
+  branch._v = std::move(v);
+  branch._a = a;
+}
+
+void
+IgnitionZeroDTabulation::integrate(const real_type dt,
+                                   const real_type_2d_view_host& state,
+                                   std::vector<ordinal_type>& is_failed)
+{
+  const ordinal_type nBatch = state.extent(0);
+  is_failed.assign(nBatch, 0);
+  if (nBatch == 0)
+    return;
+
+  using policy_type = typename UseThisTeamPolicy<host_exec_space>::type;
+  using problem_type = Impl::IgnitionZeroD_Problem<KineticModelConstDataHost>;
+
+  policy_type policy(host_exec_space(), nBatch, Kokkos::AUTO());
+
+  const ordinal_type level = 1;
+  const ordinal_type per_team_extent = IgnitionZeroD::getWorkSpaceSize(_kmcd);
+  const ordinal_type per_team_scratch =
+    Scratch<real_type_1d_view_host>::shmem_size(per_team_extent);
+  policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+  real_type_1d_view_host t("time", nBatch);
+  real_type_1d_view_host dt_out("delta time", nBatch);
+  real_type_2d_view_host fac(
+    "fac", nBatch, problem_type::getNumberOfEquations(_kmcd));
+
+  time_advance_type tadv_default = _tadv_default;
+  tadv_default._tbeg = real_type(0);
+  tadv_default._tend = dt;
+  tadv_default._dt = std::min(tadv_default._dt, dt);
+
+  time_advance_type_1d_view_host tadv("tadv", nBatch);
+  Kokkos::deep_copy(tadv, tadv_default);
+
+  const ordinal_type max_num_outer_iterations(1000);
+  bool done(false);
+  for (ordinal_type iter = 0; iter < max_num_outer_iterations && !done;
+       ++iter) {
+    IgnitionZeroD::runHostBatch(policy,
+                                _tol_newton,
+                                _tol_time,
+                                fac,
+                                tadv,
+                                state,
+                                t,
+                                dt_out,
+                                state,
+                                _kmcd);
+
+    done = true;
+    for (ordinal_type i = 0; i < nBatch; ++i) {
+      /// the time integrator returns dt_out = -1 and a zero state on failure;
+      /// a zero time step keeps the failed sample idle in later launches
+      is_failed[i] |= (dt_out(i) < real_type(0));
+      tadv(i)._tbeg = is_failed[i] ? dt : t(i);
+      tadv(i)._dt = is_failed[i] ? real_type(0) : dt_out(i);
+      done &= (is_failed[i] || !(t(i) < dt));
+    }
+  }
+  TCHEM_CHECK_ERROR(!done,
+                    "Error: IgnitionZeroDTabulation direct integration does "
+                    "not reach the end of the time step");
+}
+
+ordinal_type
+IgnitionZeroDTabulation::runHostBatch(const real_type dt,
+                                      const real_type_2d_view_host& state,
+                                      const real_type_2d_view_host& state_out)
+{
+  return runHostBatch(dt, state, state_out, ordinal_type_1d_view_host());
+}
+
+ordinal_type
+IgnitionZeroDTabulation::runHostBatch(const real_type dt,
+                                      const real_type_2d_view_host& state,
+                                      const real_type_2d_view_host& state_out,
+                                      const ordinal_type_1d_view_host& status)
+{
+  const ordinal_type nBatch = state.extent(0);
+  const ordinal_type n = getNumberOfVariables();
+  const ordinal_type m = state.extent(1);
+
+  _num_queries += nBatch;
+  if (status.extent(0) > 0)
+    Kokkos::deep_copy(status, 0);
+
+  auto setState = [&](const real_type_1d_view_host& state_at_i,
+                      const real_type density,
+                      const real_type* psi) {
+    Impl::StateVector<real_type_1d_view_host> sv(_kmcd.nSpec, state_at_i);
+    const auto Ys = sv.MassFractions();
+    sv.Density() = density;
+    sv.Temperature() = psi[0];
+    sv.Pressure() = psi[1];
+    for (ordinal_type k = 0; k < _kmcd.nSpec; ++k)
+      Ys(k) = psi[k + 2];
+  };
+
+  /// 1. retrieve
+  std::vector<ordinal_type> is_retrieved(nBatch, 0);
+  {
+    std::shared_lock<std::shared_timed_mutex> lock(_mutex);
+    Kokkos::parallel_for(
+      "TChem::IgnitionZeroDTabulation::retrieve",
+      Kokkos::RangePolicy<host_exec_space>(0, nBatch),
+      [&](const ordinal_type& i) {
+        const auto state_at_i = Kokkos::subview(state, i, Kokkos::ALL());
+        std::vector<real_type> phi(n), psi(n);
+        getVariables(state_at_i, phi.data());
+
+        const ordinal_type r = findLeafRecord(dt, phi.data());
+        if (r >= 0 &&
+            computeEllipsoidNorm(_records[r], phi.data()) <= real_type(1)) {
+          computeLinearApproximation(_records[r], phi.data(), psi.data());
+          setState(Kokkos::subview(state_out, i, Kokkos::ALL()),
+                   state(i, 0),
+                   psi.data());
+          is_retrieved[i] = 1;
+        }
+      });
+  }
+
+  std::vector<ordinal_type> miss;
+  for (ordinal_type i = 0; i < nBatch; ++i)
+    if (!is_retrieved[i])
+      miss.push_back(i);
+  const ordinal_type nMiss = miss.size();
+  _num_retrieves += (nBatch - nMiss);
+  if (nMiss == 0)
+    return 0;
+
+  /// 2. direct integration of the missed queries
+  real_type_2d_view_host direct("direct", nMiss, m);
+  for (ordinal_type l = 0; l < nMiss; ++l)
+    for (ordinal_type k = 0; k < m; ++k)
+      direct(l, k) = state(miss[l], k);
+  std::vector<ordinal_type> is_failed;
+  integrate(dt, direct, is_failed);
+  _num_direct_evaluations += nMiss;
+
+  /// failed samples are neither tabulated nor written to state_out
+  ordinal_type nFail(0);
+  for (ordinal_type l = 0; l < nMiss; ++l) {
+    if (is_failed[l]) {
+      ++nFail;
+      if (status.extent(0) > 0)
+        status(miss[l]) = 1;
+    }
+  }
+  _num_failures += nFail;
+
+  /// 3. grow EOA or collect the queries to be added
+  std::vector<std::vector<real_type>> phi_add, psi_add;
+  std::vector<real_type> density_add;
+  {
+    std::unique_lock<std::shared_timed_mutex> lock(_mutex);
+    for (ordinal_type l = 0; l < nMiss; ++l) {
+      if (is_failed[l])
+        continue;
+      const ordinal_type i = miss[l];
+      std::vector<real_type> phi(n), psi(n);
+      getVariables(Kokkos::subview(state, i, Kokkos::ALL()), phi.data());
+      getVariables(Kokkos::subview(direct, l, Kokkos::ALL()), psi.data());
+
+      const ordinal_type r = findLeafRecord(dt, phi.data());
+      if (r >= 0 &&
+          computeError(_records[r], phi.data(), psi.data()) <= _tol_isat) {
+        growEllipsoid(_records[r], phi.data());
+        ++_num_grows;
+      } else if (ordinal_type(_records.size() + phi_add.size()) <
+                 _max_num_records) {
+        density_add.push_back(state(i, 0));
+        phi_add.push_back(phi);
+        psi_add.push_back(psi);
+      }
+      setState(Kokkos::subview(state_out, i, Kokkos::ALL()),
+               state(i, 0),
+               psi.data());
+    }
+  }
+
+  const ordinal_type nAdd = phi_add.size();
+  if (nAdd == 0)
+    return nFail;
+
+  /// 4. sensitivity by forward differences; h_j = delta s_j
+  const real_type delta(1e-4);
+  real_type_2d_view_host perturbed("perturbed", nAdd * n, m);
+  for (ordinal_type a = 0; a < nAdd; ++a) {
+    const real_type s[2] = { phi_add[a][0], phi_add[a][1] };
+    for (ordinal_type j = 0; j < n; ++j) {
+      std::vector<real_type> phi(phi_add[a]);
+      phi[j] += delta * (j < 2 ? s[j] : real_type(1));
+      setState(Kokkos::subview(perturbed, a * n + j, Kokkos::ALL()),
+               density_add[a],
+               phi.data());
+    }
+  }
+  std::vector<ordinal_type> is_perturbed_failed;
+  integrate(dt, perturbed, is_perturbed_failed);
+  _num_direct_evaluations += nAdd * n;
+
+  {
+    std::unique_lock<std::shared_timed_mutex> lock(_mutex);
+    for (ordinal_type a = 0; a < nAdd; ++a) {
+      if (ordinal_type(_records.size()) >= _max_num_records)
+        break;
+
+      /// the sensitivity is not available
+      bool is_sensitivity_failed(false);
+      for (ordinal_type l = 0; l < n; ++l)
+        is_sensitivity_failed |= bool(is_perturbed_failed[a * n + l]);
+      if (is_sensitivity_failed)
+        continue;
+
+      Record rec;
+      rec._phi = phi_add[a];
+      rec._psi = psi_add[a];
+      rec._s.assign(n, real_type(1));
+      rec._s[0] = phi_add[a][0];
+      rec._s[1] = phi_add[a][1];
+      rec._A.assign(n * n, real_type(0));
+      rec._M.assign(n * n, real_type(0));
+
+      /// scaled sensitivity, A_jl = (dpsi_j / s_j) / (h_l / s_l)
+      std::vector<real_type> psi(n);
+      for (ordinal_type l = 0; l < n; ++l) {
+        getVariables(Kokkos::subview(perturbed, a * n + l, Kokkos::ALL()),
+                     psi.data());
+        for (ordinal_type j = 0; j < n; ++j)
+          rec._A[j * n + l] = (psi[j] - rec._psi[j]) / rec._s[j] / delta;
+      }
+
+      /// initial EOA, M = A^T A / tol^2 + I / r^2
+      const real_type tol2 = _tol_isat * _tol_isat;
+      const real_type r2 = _max_radius * _max_radius;
+      for (ordinal_type j = 0; j < n; ++j) {
+        for (ordinal_type l = 0; l < n; ++l) {
+          real_type AtA(0);
+          for (ordinal_type k = 0; k < n; ++k)
+            AtA += rec._A[k * n + j] * rec._A[k * n + l];
+          rec._M[j * n + l] =
+            AtA / tol2 + (j == l ? real_type(1) / r2 : real_type(0));
+        }
+      }
+
+      addRecord(dt, std::move(rec));
+      ++_num_adds;
+    }
+  }
+  return nFail;
+}
+
+ordinal_type
+IgnitionZeroDTabulation::getNumberOfRecords() const
+{
+  std::shared_lock<std::shared_timed_mutex> lock(_mutex);
+  return _records.size();
+}
+
+IgnitionZeroDTabulation::Statistics
+IgnitionZeroDTabulation::getStatistics() const
+{
+  Statistics stat;
+  stat._num_queries = _num_queries;
+  stat._num_retrieves = _num_retrieves;
+  stat._num_grows = _num_grows;
+  stat._num_adds = _num_adds;
+  stat._num_direct_evaluations = _num_direct_evaluations;
+  stat._num_failures = _num_failures;
+  return stat;
+}
+
+void
+IgnitionZeroDTabulation::showStatistics(std::ostream& os) const
+{
+  const auto stat = getStatistics();
+  os << "IgnitionZeroDTabulation\n"
+     << "  # of records            = " << getNumberOfRecords() << "\n"
+     << "  # of queries            = " << stat._num_queries << "\n"
+     << "  # of retrieves          = " << stat._num_retrieves << "\n"
+     << "  # of grows              = " << stat._num_grows << "\n"
+     << "  # of adds               = " << stat._num_adds << "\n"
+     << "  # of direct evaluations = " << stat._num_direct_evaluations
+     << "\n"
+     << "  # of failures           = " << stat._num_failures << "\n";
+}
+
+} // namespace TChem
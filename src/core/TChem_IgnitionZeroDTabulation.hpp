@@ -0,0 +1,162 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_IGNITION_ZEROD_TABULATION_HPP__
+#define __TCHEM_IGNITION_ZEROD_TABULATION_HPP__
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+
+#include "TChem_KineticModelData.hpp"
+#include "TChem_Util.hpp"
+
+#include "TChem_IgnitionZeroD.hpp"
+
+namespace TChem {
+
+/// In situ adaptive tabulation (ISAT) of the constant pressure ignition
+/// - Pope, Combust. Theory Modelling 1 (1997)
+/// - a record maps phi0 = (T, p, Ys) to psi0 = phi(dt) with the sensitivity
+///   A = dpsi/dphi and an ellipsoid of accuracy (EOA) { x : x^T M x <= 1 }
+/// - all quantities are scaled by (T0, p0, 1, ..., 1) of the record
+/// - a query inside the EOA of its leaf record is retrieved by the linear
+///   approximation psi0 + A (phi - phi0); otherwise the state is integrated
+///   directly and the EOA is grown when the linear approximation is within
+///   the tolerance, or a new record is added
+/// - records are searched with a binary tree of cutting planes, one tree per
+///   time step size; the table is guarded by a shared mutex so that host
+///   threads can query it concurrently
+class IgnitionZeroDTabulation
+{
+public:
+  struct Statistics
+  {
+    ordinal_type _num_queries;
+    ordinal_type _num_retrieves;
+    ordinal_type _num_grows;
+    ordinal_type _num_adds;
+    ordinal_type _num_direct_evaluations;
+    ordinal_type _num_failures;
+  };
+
+private:
+  struct Record
+  {
+    /// (nSpec+2) in the original units and the scale of the record
+    std::vector<real_type> _phi, _psi, _s;
+    /// (nSpec+2) x (nSpec+2) row major; scaled sensitivity and EOA
+    std::vector<real_type> _A, _M;
+  };
+
+  struct Node
+  {
+    /// leaf if record >= 0
+    ordinal_type _left, _right, _record;
+    /// cutting plane, v^T phi > a goes to right
+    std::vector<real_type> _v;
+    real_type _a;
+  };
+
+  KineticModelConstDataHost _kmcd;
+
+  real_type_1d_view_host _tol_newton;
+  real_type_2d_view_host _tol_time;
+
+  real_type _tol_isat, _max_radius;
+  ordinal_type _max_num_records;
+
+  time_advance_type _tadv_default;
+
+  /// dt -> root node index
+  std::map<real_type, ordinal_type> _roots;
+  std::vector<Node> _nodes;
+  std::vector<Record> _records;
+
+  mutable std::shared_timed_mutex _mutex;
+
+  std::atomic<ordinal_type> _num_queries, _num_retrieves, _num_grows,
+    _num_adds, _num_direct_evaluations, _num_failures;
+
+  ordinal_type getNumberOfVariables() const { return _kmcd.nSpec + 2; }
+
+  /// phi = (T, p, Ys) from a state vector
+  void getVariables(const real_type_1d_view_host& state,
+                    real_type* phi) const;
+
+  ordinal_type findLeafRecord(const real_type dt, const real_type* phi) const;
+
+  /// returns x^T M x where x is scaled phi - phi0
+  real_type computeEllipsoidNorm(const Record& rec, const real_type* phi) const;
+
+  /// psi = psi0 + A (phi - phi0) in the original units
+  void computeLinearApproximation(const Record& rec,
+                                  const real_type* phi,
+                                  real_type* psi) const;
+
+  /// scaled distance of psi from the linear approximation
+  real_type computeError(const Record& rec,
+                         const real_type* phi,
+                         const real_type* psi) const;
+
+  /// M = M - (1 - 1/r^2) (M x)(M x)^T / r^2 with r^2 = x^T M x
+  void growEllipsoid(Record& rec, const real_type* phi);
+
+  void addRecord(const real_type dt, Record&& rec);
+
+  /// direct integration of states from 0 to dt; is_failed(i) is set when
+  /// the time integrator fails and the state of the sample is invalid
+  void integrate(const real_type dt,
+                 const real_type_2d_view_host& state,
+                 std::vector<ordinal_type>& is_failed);
+
+public:
+  /// kmcd - const data for kinetic model
+  /// tol_newton, tol_time - tolerence for direct integration
+  /// tadv - _dt, _dtmin, _dtmax and iteration counts for direct integration
+  /// tol_isat - error tolerence of the linear approximation
+  /// max_num_records - table is not grown beyond this number of records
+  IgnitionZeroDTabulation(const KineticModelConstDataHost& kmcd,
+                          const real_type_1d_view_host& tol_newton,
+                          const real_type_2d_view_host& tol_time,
+                          const time_advance_type& tadv,
+                          const real_type tol_isat,
+                          const ordinal_type max_num_records);
+
+  /// advance state by dt; the same input state can be overwritten
+  /// - returns the number of samples whose direct integration fails; the
+  ///   state_out of those samples is not written and status(i) is set to 1
+  ///   (status is optional and 0 for the other samples)
+  ordinal_type runHostBatch(const real_type dt,
+                            const real_type_2d_view_host& state,
+                            const real_type_2d_view_host& state_out);
+  ordinal_type runHostBatch(const real_type dt,
+                            const real_type_2d_view_host& state,
+                            const real_type_2d_view_host& state_out,
+                            const ordinal_type_1d_view_host& status);
+
+  ordinal_type getNumberOfRecords() const;
+  Statistics getStatistics() const;
+  void showStatistics(std::ostream& os) const;
+};
+
+} // namespace TChem
+
+#endif
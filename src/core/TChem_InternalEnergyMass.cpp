@@ -26,18 +26,20 @@ namespace Impl {
 template<typename PolicyType,
          typename RealType0DViewType,
          typename RealType1DViewType,
-         typename RealType2DViewType,
+         typename RealType1DBatchViewType,
+         typename RealType2DBatchViewType,
          typename KineticModelConstType>
 void
 InternalEnergyMass_TemplateRun( /// required template arguments
   const std::string& profile_name,
   const RealType0DViewType& dummy_0d,
+  const RealType1DViewType& dummy_1d,
   /// team size setting
   const PolicyType& policy,
-  const RealType2DViewType& state,
+  const RealType2DBatchViewType& state,
   // outputFile
-  const RealType2DViewType& InternalEnergyMass,
-  const RealType1DViewType& InternalEnergyMixMass,
+  const RealType2DBatchViewType& InternalEnergyMass,
+  const RealType1DBatchViewType& InternalEnergyMixMass,
   const KineticModelConstType& kmcd)
 {
   Kokkos::Profiling::pushRegion(profile_name);
@@ -45,18 +47,25 @@ InternalEnergyMass_TemplateRun( /// required template arguments
 
   const ordinal_type level = 1;
   const ordinal_type per_team_extent = InternalEnergyMass::getWorkSpaceSize(kmcd);
+  const ordinal_type per_team_extent_stage =
+    getBatchRowWorkSpaceSize(state) +
+    getBatchRowWorkSpaceSize(InternalEnergyMass);
 
   Kokkos::parallel_for(
     profile_name,
-    policy,
+    getBatchRowPolicy(policy, per_team_extent_stage),
     KOKKOS_LAMBDA(const typename policy_type::member_type& member) {
       const ordinal_type i = member.league_rank();
+      Scratch<RealType1DViewType> stage(member.team_scratch(level),
+                                        per_team_extent_stage);
+      auto wstage = stage.data();
       const RealType1DViewType state_at_i =
-        Kokkos::subview(state, i, Kokkos::ALL());
+        getBatchRow<RealType1DViewType>(member, state, i, true, wstage);
       const RealType1DViewType InternalEnergyMass_at_i =
-        Kokkos::subview(InternalEnergyMass, i, Kokkos::ALL());
-      const RealType0DViewType InternalEnergyMixMass_at_i =
-        Kokkos::subview(InternalEnergyMixMass, i);
+        getBatchRow<RealType1DViewType>(
+          member, InternalEnergyMass, i, false, wstage);
+      const RealType0DViewType InternalEnergyMixMass_at_i(
+        &InternalEnergyMixMass(i));
       Scratch<RealType1DViewType> work(member.team_scratch(level),
                                        per_team_extent);
       auto w = (real_type*)work.data();
@@ -88,6 +97,7 @@ InternalEnergyMass_TemplateRun( /// required template arguments
           sumUk);
 
         InternalEnergyMixMass_at_i() = sumUk;
+        setBatchRow(member, InternalEnergyMass_at_i, InternalEnergyMass, i);
       }
     });
   Kokkos::Profiling::popRegion();
@@ -102,10 +112,10 @@ InternalEnergyMass::runDeviceBatch( /// thread block size
   const ordinal_type vector_size,
   /// input
   const ordinal_type nBatch,
-  const real_type_2d_view& state,
+  const real_type_2d_stride_view& state,
   /// output
-  const real_type_2d_view& InternalEnergyMass,
-  const real_type_1d_view& InternalEnergyMixMass,
+  const real_type_2d_stride_view& InternalEnergyMass,
+  const real_type_1d_stride_view& InternalEnergyMixMass,
   /// const data from kinetic model
   const KineticModelConstDataDevice& kmcd)
 {
@@ -128,6 +138,7 @@ InternalEnergyMass::runDeviceBatch( /// thread block size
 
   Impl::InternalEnergyMass_TemplateRun("TChem::InternalEnergyMass::runDeviceBatch",
                                  real_type_0d_view(),
+                                 real_type_1d_view(),
                                  /// team policy
                                  policy,
                                  state,
@@ -139,16 +150,17 @@ InternalEnergyMass::runDeviceBatch( /// thread block size
 void
 InternalEnergyMass::runDeviceBatch( /// thread block size
   typename UseThisTeamPolicy<exec_space>::type& policy,
-  const real_type_2d_view& state,
+  const real_type_2d_stride_view& state,
   /// output
-  const real_type_2d_view& InternalEnergyMass,
-  const real_type_1d_view& InternalEnergyMixMass,
+  const real_type_2d_stride_view& InternalEnergyMass,
+  const real_type_1d_stride_view& InternalEnergyMixMass,
   /// const data from kinetic model
   const KineticModelConstDataDevice& kmcd)
 {
 
   Impl::InternalEnergyMass_TemplateRun("TChem::InternalEnergyMass::runDeviceBatch",
                                  real_type_0d_view(),
+                                 real_type_1d_view(),
                                  /// team policy
                                  policy,
                                  state,
@@ -160,16 +172,17 @@ InternalEnergyMass::runDeviceBatch( /// thread block size
 void
 InternalEnergyMass::runHostBatch( /// thread block size
   typename UseThisTeamPolicy<host_exec_space>::type& policy,
-  const real_type_2d_view_host& state,
+  const real_type_2d_stride_view_host& state,
   /// output
-  const real_type_2d_view_host& InternalEnergyMass,
-  const real_type_1d_view_host& InternalEnergyMixMass,
+  const real_type_2d_stride_view_host& InternalEnergyMass,
+  const real_type_1d_stride_view_host& InternalEnergyMixMass,
   /// const data from kinetic model
   const KineticModelConstDataHost& kmcd)
 {
 
   Impl::InternalEnergyMass_TemplateRun("TChem::InternalEnergyMass::runHostBatch",
                                  real_type_0d_view_host(),
+                                 real_type_1d_view_host(),
                                  /// team policy
                                  policy,
                                  state,
@@ -42,30 +42,30 @@ struct InternalEnergyMass
     const ordinal_type vector_size,
     /// input
     const ordinal_type nBatch,
-    const real_type_2d_view& state,
+    const real_type_2d_stride_view& state,
     /// output
-    const real_type_2d_view& InternalEnergyMass,
-    const real_type_1d_view& InternalEnergyMixMass,
+    const real_type_2d_stride_view& InternalEnergyMass,
+    const real_type_1d_stride_view& InternalEnergyMixMass,
 
     /// const data from kinetic model
     const KineticModelConstDataDevice& kmcd);
   //
   static void runDeviceBatch( /// thread block size
     typename UseThisTeamPolicy<exec_space>::type& policy,
-    const real_type_2d_view& state,
+    const real_type_2d_stride_view& state,
     /// output
-    const real_type_2d_view& InternalEnergyMass,
-    const real_type_1d_view& InternalEnergyMixMass,
+    const real_type_2d_stride_view& InternalEnergyMass,
+    const real_type_1d_stride_view& InternalEnergyMixMass,
 
     /// const data from kinetic model
     const KineticModelConstDataDevice& kmcd);
   //
   static void runHostBatch( /// thread block size
     typename UseThisTeamPolicy<host_exec_space>::type& policy,
-    const real_type_2d_view_host& state,
+    const real_type_2d_stride_view_host& state,
     /// output
-    const real_type_2d_view_host& InternalEnergyMass,
-    const real_type_1d_view_host& InternalEnergyMixMass,
+    const real_type_2d_stride_view_host& InternalEnergyMass,
+    const real_type_1d_stride_view_host& InternalEnergyMixMass,
 
     /// const data from kinetic model
     const KineticModelConstDataHost& kmcd);
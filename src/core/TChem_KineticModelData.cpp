@@ -21,6 +21,9 @@ Sandia National Laboratories, Livermore, CA, USA
 #include "TChem_KineticModelData.hpp"
 #include "TC_kmodint.hpp"
 
+#include "TChem_Impl_Gk.hpp"
+#include "TChem_Impl_KForwardReverse.hpp"
+
 namespace TChem {
 
 KineticModelData::KineticModelData(const std::string& mechfile,
@@ -408,6 +411,12 @@ KineticModelData::allocateViewsSurf(FILE* errfile)
       do_not_init_tag("KMD::TCsurf_isDup_"), TCsurf_Nreac_);
     TCsurf_isStick_ = ordinal_type_1d_dual_view(
       do_not_init_tag("KMD::TCsurf_isStick_"), TCsurf_Nreac_);
+    TCsurf_stickFac_ = real_type_1d_dual_view(
+      do_not_init_tag("KMD::TCsurf_stickFac_"), TCsurf_Nreac_);
+    TCsurf_kcFac_ = real_type_1d_dual_view(
+      do_not_init_tag("KMD::TCsurf_kcFac_"), TCsurf_Nreac_);
+    TCsurf_kcNuSum_ = ordinal_type_1d_dual_view(
+      do_not_init_tag("KMD::TCsurf_kcNuSum_"), TCsurf_Nreac_);
     // stoichiometric matrix only gas species
     vski_ = ordinal_type_2d_dual_view(
       do_not_init_tag("KMD::stoichiometric_matrix_gas"), nSpec_, TCsurf_Nreac_);
@@ -524,6 +533,9 @@ KineticModelData::syncSurfToDevice()
 {
 
   TCsurf_isStick_.sync_device();
+  TCsurf_stickFac_.sync_device();
+  TCsurf_kcFac_.sync_device();
+  TCsurf_kcNuSum_.sync_device();
   TCsurf_isDup_.sync_device();
   TCsurf_reacArhenFor_.sync_device();
   TCsurf_reacNuki_.sync_device();
@@ -1872,10 +1884,55 @@ KineticModelData::initChemSurf()
         }
       }
     }
+
+    // sticking coefficient and equilibrium constant factors that do not
+    // depend on temperature (eq 16.117 and 16.105 chapter 16 Robert J. Kee)
+    auto sMassHost = sMass_.view_host();
+    auto TCsurf_stickFacHost = TCsurf_stickFac_.view_host();
+    auto TCsurf_kcFacHost = TCsurf_kcFac_.view_host();
+    auto TCsurf_kcNuSumHost = TCsurf_kcNuSum_.view_host();
+    const ordinal_type joff = TCsurf_maxSpecInReac_ / 2;
+    for (ordinal_type i = 0; i < TCsurf_Nreac_; i++) {
+      real_type Wk(0);
+      ordinal_type m(0);
+      for (ordinal_type j = 0; j < TCsurf_reacNreacHost(i); j++) {
+        if (TCsurf_reacSsrfHost(i, j) == 1) {
+          m += std::abs(TCsurf_reacNukiHost(i, j));
+        } else if (TCsurf_reacSsrfHost(i, j) == 0) {
+          Wk = sMassHost(TCsurf_reacSidxHost(i, j));
+        }
+      }
+      TCsurf_stickFacHost(i) =
+        TCsurf_isStickHost(i) == 1
+          ? std::sqrt(Rcgs_ / (DPI * Wk)) / std::pow(TCsurf_siteden_, m)
+          : real_type(1);
+
+      ordinal_type nusum(0), nusum2(0);
+      for (ordinal_type j = 0; j < TCsurf_reacNreacHost(i); j++) {
+        if (TCsurf_reacSsrfHost(i, j) == 0) {
+          nusum += TCsurf_reacNukiHost(i, j);
+        } else if (TCsurf_reacSsrfHost(i, j) == 1) {
+          nusum2 += TCsurf_reacNukiHost(i, j);
+        }
+      }
+      for (ordinal_type j = 0; j < TCsurf_reacNprodHost(i); j++) {
+        if (TCsurf_reacSsrfHost(i, j + joff) == 0) {
+          nusum += TCsurf_reacNukiHost(i, j + joff);
+        } else if (TCsurf_reacSsrfHost(i, j + joff) == 1) {
+          nusum2 += TCsurf_reacNukiHost(i, j + joff);
+        }
+      }
+      TCsurf_kcNuSumHost(i) = nusum;
+      TCsurf_kcFacHost(i) = std::pow(ATMPA * real_type(10) / Rcgs_, nusum) *
+                            std::pow(TCsurf_siteden_, nusum2);
+    }
   }
 
   /// Raise modify flags for all modified dual views
   TCsurf_isStick_.modify_host();
+  TCsurf_stickFac_.modify_host();
+  TCsurf_kcFac_.modify_host();
+  TCsurf_kcNuSum_.modify_host();
   TCsurf_isDup_.modify_host();
   TCsurf_reacArhenFor_.modify_host();
   TCsurf_reacNuki_.modify_host();
@@ -1904,4 +1961,162 @@ KineticModelData::initChemSurf()
   return (0);
 }
 
+/// kfor and krev at 1/T = xmin + k h for k in [0, kfor.extent(0))
+static void
+KineticModelData_EvaluateRateConstants(
+  const KineticModelConstDataHost& kmcd,
+  const real_type xmin,
+  const real_type h,
+  const real_type_2d_view_host& kfor,
+  const real_type_2d_view_host& krev)
+{
+  using policy_type = typename UseThisTeamPolicy<host_exec_space>::type;
+
+  const ordinal_type level = 1;
+  const ordinal_type per_team_extent = 3 * kmcd.nSpec + 2 * kmcd.nReac;
+  const ordinal_type per_team_scratch =
+    Scratch<real_type_1d_view_host>::shmem_size(per_team_extent);
+
+  policy_type policy(kfor.extent(0), Kokkos::AUTO());
+  policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+  Kokkos::parallel_for(
+    "TChem::KineticModelData::buildRateConstantTable",
+    policy,
+    [=](const typename policy_type::member_type& member) {
+      const ordinal_type k = member.league_rank();
+      const real_type t = real_type(1) / (xmin + k * h);
+
+      Scratch<real_type_1d_view_host> work(member.team_scratch(level),
+                                           per_team_extent);
+      auto w = work.data();
+      auto gk = real_type_1d_view_host(w, kmcd.nSpec);
+      w += kmcd.nSpec;
+      auto hks = real_type_1d_view_host(w, kmcd.nSpec);
+      w += kmcd.nSpec;
+      auto cpks = real_type_1d_view_host(w, kmcd.nSpec);
+      w += kmcd.nSpec;
+      auto iter = real_type_1d_view_host(w, 2 * kmcd.nReac);
+      w += 2 * kmcd.nReac;
+
+      auto kfor_at_k = real_type_1d_view_host(&kfor(k, 0), kmcd.nReac);
+      auto krev_at_k = real_type_1d_view_host(&krev(k, 0), kmcd.nReac);
+
+      Impl::Gk::team_invoke(member, t, gk, hks, cpks, kmcd);
+      member.team_barrier();
+      Impl::KForwardReverse::team_invoke(
+        member, t, ATMPA, gk, kfor_at_k, krev_at_k, iter, kmcd);
+    });
+}
+
+void
+KineticModelData::buildRateConstantTable()
+{
+  const ordinal_type max_num_intervals(1 << 14);
+
+  /// const data without the table
+  lnKTableMask_ = ordinal_type_1d_dual_view();
+  lnKforTable_ = real_type_2d_dual_view();
+  lnKrevTable_ = real_type_2d_dual_view();
+  auto kmcd = createConstData<host_exec_space>();
+
+  const ordinal_type nReac = kmcd.nReac;
+  if (nReac == 0)
+    return;
+
+  const real_type xmin = real_type(1) / kmcd.TthrmMax,
+                  xmax = real_type(1) / kmcd.TthrmMin;
+
+  /// plog reactions depend on pressure and are evaluated directly
+  std::vector<bool> is_plog(nReac, false);
+  {
+    const auto reacPlogIdx = reacPlogIdx_.view_host();
+    for (ordinal_type i = 0; i < nPlogReac_; ++i)
+      is_plog[reacPlogIdx(i)] = true;
+  }
+
+  ordinal_type n = lnKTableNumIntervals_ < 3 ? 3 : lnKTableNumIntervals_;
+  for (;; n *= 2) {
+    /// even points are the grid; odd points are the interval midpoints
+    const real_type h = (xmax - xmin) / real_type(n);
+    real_type_2d_view_host kfor("kfor", 2 * n + 1, nReac);
+    real_type_2d_view_host krev("krev", 2 * n + 1, nReac);
+    KineticModelData_EvaluateRateConstants(kmcd, xmin, h / 2, kfor, krev);
+
+    lnKTableMask_ =
+      ordinal_type_1d_dual_view(do_not_init_tag("KMD::lnKTableMask_"), nReac);
+    lnKforTable_ = real_type_2d_dual_view(
+      do_not_init_tag("KMD::lnKforTable_"), n + 1, nReac);
+    lnKrevTable_ = real_type_2d_dual_view(
+      do_not_init_tag("KMD::lnKrevTable_"), n + 1, nReac);
+
+    auto mask = lnKTableMask_.view_host();
+    auto lnkf = lnKforTable_.view_host();
+    auto lnkr = lnKrevTable_.view_host();
+
+    /// tabulate reactions with positive and finite rate constants
+    lnKTableComplete_ = true;
+    for (ordinal_type i = 0; i < nReac; ++i) {
+      bool kf_positive(!is_plog[i]), kr_positive(true), kr_zero(true);
+      for (ordinal_type k = 0; k < 2 * n + 1; ++k) {
+        kf_positive &= kfor(k, i) > 0 && std::isfinite(kfor(k, i));
+        kr_positive &= krev(k, i) > 0 && std::isfinite(krev(k, i));
+        kr_zero &= krev(k, i) == 0;
+      }
+      mask(i) = kf_positive ? (kr_positive ? 2 : kr_zero ? 1 : 0) : 0;
+      lnKTableComplete_ &= mask(i) > 0;
+      for (ordinal_type k = 0; k <= n; ++k) {
+        lnkf(k, i) = mask(i) > 0 ? std::log(kfor(2 * k, i)) : real_type(0);
+        lnkr(k, i) = mask(i) > 1 ? std::log(krev(2 * k, i)) : real_type(0);
+      }
+    }
+
+    /// interpolation error at the midpoints
+    lnKTableInvTMin_ = xmin;
+    lnKTableDeltaInvT_ = h;
+    kmcd.lnKTableInvTMin = xmin;
+    kmcd.lnKTableDeltaInvT = h;
+    kmcd.lnKTableMask = mask;
+    kmcd.lnKforTable = lnkf;
+    kmcd.lnKrevTable = lnkr;
+
+    lnKTableError_ = 0;
+    for (ordinal_type k = 0; k < n; ++k) {
+      const real_type t = real_type(1) / (xmin + (k + real_type(0.5)) * h);
+      ordinal_type j;
+      real_type w[4];
+      Impl::KForwardReverseTable::getWeights(t, kmcd, j, w);
+      for (ordinal_type i = 0; i < nReac; ++i) {
+        if (mask(i) > 0) {
+          real_type kf, kr;
+          Impl::KForwardReverseTable::serial_invoke(i, j, w, kmcd, kf, kr);
+          lnKTableError_ = std::max(
+            lnKTableError_, std::abs(std::log(kf / kfor(2 * k + 1, i))));
+          if (mask(i) > 1)
+            lnKTableError_ = std::max(
+              lnKTableError_, std::abs(std::log(kr / krev(2 * k + 1, i))));
+        }
+      }
+    }
+
+    if (lnKTableError_ <= lnKTableMaxError_ || 2 * n > max_num_intervals)
+      break;
+  }
+
+  if (lnKTableError_ > lnKTableMaxError_)
+    printf("Warning: KineticModelData, rate constant table with %d intervals "
+           "has interpolation error %e larger than %e\n",
+           n,
+           lnKTableError_,
+           lnKTableMaxError_);
+
+  lnKTableMask_.modify_host();
+  lnKforTable_.modify_host();
+  lnKrevTable_.modify_host();
+
+  lnKTableMask_.sync_device();
+  lnKforTable_.sync_device();
+  lnKrevTable_.sync_device();
+}
+
 } // namespace TChem
@@ -178,10 +178,127 @@ public:
   kmcd_real_type_3d_view cppol;
   // kmcd_real_type_3d_view spec9trng;
   // kmcd_real_type_3d_view spec9coefs;
+
+  /// dynamic adaptive chemistry with directed relation graph (DRG)
+  /// - disabled when drgThreshold is negative
+  /// - reacActive is a per-sample mask of active reactions set in team
+  ///   scratch; when it is empty, all reactions are active
+  real_type drgThreshold = real_type(-1);
+  real_type drgTargetMassFraction = real_type(1e-3);
+  kmcd_ordinal_type_1d_view reacActive;
+
+  /// relative temperature difference below which memoized rate constants
+  /// are reused (Impl::KForwardReverseMemo); zero requires the same
+  /// temperature
+  real_type memoRtol = real_type(0);
+
+  /// tabulated ln kfor and ln krev (nGrid, nReac) on a uniform grid of 1/T
+  /// starting at lnKTableInvTMin = 1/TthrmMax; see setRateConstantTable
+  /// - empty tables evaluate the rate constants directly
+  /// - lnKTableMask(i) is zero for reactions that are not tabulated
+  /// - lnKTableComplete is true when all reactions are tabulated so the
+  ///   gibbs energies are not needed within the table range
+  real_type lnKTableInvTMin;
+  real_type lnKTableDeltaInvT;
+  bool lnKTableComplete;
+  kmcd_ordinal_type_1d_view lnKTableMask;
+  kmcd_real_type_2d_view lnKforTable;
+  kmcd_real_type_2d_view lnKrevTable;
+
+  /// per-sample perturbation of Arrhenius parameters for uncertainty
+  /// quantification; one copy of the mechanism serves the whole ensemble
+  /// - sampleLogAFactor(s,i) is added to ln A and sampleEaShift(s,i) to the
+  ///   activation temperature Ea/R of reaction i in sample s; the same
+  ///   factor scales falloff limits and given reverse parameters so that
+  ///   falloff and equilibrium are not changed
+  /// - both are (nBatch x nReac) and optional; batch drivers select the row
+  ///   of a sample in reacLogAFactor and reacEaShift
+  kmcd_real_type_2d_view sampleLogAFactor;
+  kmcd_real_type_2d_view sampleEaShift;
+  kmcd_real_type_1d_view reacLogAFactor;
+  kmcd_real_type_1d_view reacEaShift;
 };
 using KineticModelConstDataHost = KineticModelConstData<host_exec_space>;
 using KineticModelConstDataDevice = KineticModelConstData<exec_space>;
 
+/// kinetic models of a batch mixing mechanisms; sample i uses
+/// kmcds(mechanism(i)). the array holds unmanaged views and the
+/// KineticModelData objects that created them must outlive it
+template<typename SpT>
+using KineticModelConstDataArray =
+  Kokkos::View<KineticModelConstData<SpT>*, SpT>;
+using KineticModelConstDataArrayHost =
+  KineticModelConstDataArray<host_exec_space>;
+using KineticModelConstDataArrayDevice = KineticModelConstDataArray<exec_space>;
+
+template<typename SpT>
+inline KineticModelConstDataArray<SpT>
+createConstDataArray(const std::vector<KineticModelConstData<SpT>>& kmcds)
+{
+  KineticModelConstDataArray<SpT> r("KineticModelConstDataArray",
+                                    kmcds.size());
+  auto r_host = Kokkos::create_mirror_view(r);
+  for (ordinal_type i = 0, iend = kmcds.size(); i < iend; ++i)
+    r_host(i) = kmcds[i];
+  Kokkos::deep_copy(r, r_host);
+  return r;
+}
+
+namespace Impl {
+/// kinetic model of sample i; a single mechanism for all samples
+template<typename KineticModelConstDataType>
+struct KineticModelSelector
+{
+  using kinetic_model_type = KineticModelConstDataType;
+  kinetic_model_type _kmcd;
+
+  KineticModelSelector(const kinetic_model_type& kmcd)
+    : _kmcd(kmcd)
+  {}
+
+  KOKKOS_INLINE_FUNCTION
+  const kinetic_model_type& operator()(const ordinal_type) const
+  {
+    return _kmcd;
+  }
+};
+
+/// kinetic model of sample i; mechanisms are selected per sample
+template<typename SpT, typename OrdinalType1DViewType>
+struct KineticModelArraySelector
+{
+  using kinetic_model_type = KineticModelConstData<SpT>;
+  KineticModelConstDataArray<SpT> _kmcds;
+  OrdinalType1DViewType _mechanism;
+
+  KineticModelArraySelector(const KineticModelConstDataArray<SpT>& kmcds,
+                            const OrdinalType1DViewType& mechanism)
+    : _kmcds(kmcds)
+    , _mechanism(mechanism)
+  {}
+
+  KOKKOS_INLINE_FUNCTION
+  const kinetic_model_type& operator()(const ordinal_type i) const
+  {
+    return _kmcds(_mechanism(i));
+  }
+};
+
+/// largest f(kmcd) over the mechanisms e.g., workspace size
+template<typename SpT, typename FunctorType>
+inline ordinal_type
+getMaxOverKineticModels(const KineticModelConstDataArray<SpT>& kmcds,
+                        const FunctorType& f)
+{
+  const auto kmcds_host =
+    Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), kmcds);
+  ordinal_type r(0);
+  for (ordinal_type i = 0, iend = kmcds_host.extent(0); i < iend; ++i)
+    r = std::max(r, ordinal_type(f(kmcds_host(i))));
+  return r;
+}
+} // namespace Impl
+
 template<typename SpT>
 struct KineticSurfModelConstData
 {
@@ -249,6 +366,17 @@ public:
   kmcd_ordinal_type_2d_view vki;
   kmcd_ordinal_type_2d_view vsurfki;
 
+  /// per reaction factors fixed by the mechanism
+  /// - stickFac: sqrt(Rcgs/(2 pi Wk)) / sitedensity^m of sticking reactions
+  /// - kcFac: (ATMPA*10/Rcgs)^nusum * sitedensity^nusum2 of reversible ones
+  /// - kcNuSum: sum of gas stoichiometric coefficients, nusum
+  kmcd_real_type_1d_view stickFac;
+  kmcd_real_type_1d_view kcFac;
+  kmcd_ordinal_type_1d_view kcNuSum;
+
+  /// see KineticModelConstData::memoRtol
+  real_type memoRtol = real_type(0);
+
   real_type TChem_reltol;
   real_type TChem_abstol;
 };
@@ -451,12 +579,34 @@ public:
   /* is reaction a duplicate ? */
   ordinal_type_1d_dual_view TCsurf_isDup_, TCsurf_isStick_;
 
+  /* precomputed sticking and equilibrium constant factors */
+  real_type_1d_dual_view TCsurf_stickFac_, TCsurf_kcFac_;
+  ordinal_type_1d_dual_view TCsurf_kcNuSum_;
+
   ordinal_type_2d_dual_view vski_;
   ordinal_type_2d_dual_view vsurfki_;
 
   void syncSurfToDevice();
   void allocateViewsSurf(FILE* errfile);
 
+  /* dynamic adaptive chemistry (DRG) */
+  real_type drgThreshold_ = real_type(-1);
+  real_type drgTargetMassFraction_ = real_type(1e-3);
+
+  /* memoized rate constants */
+  real_type memoRtol_ = real_type(0);
+
+  /* tabulated rate constants */
+  bool lnKTableRequested_ = false;
+  ordinal_type lnKTableNumIntervals_ = 0;
+  real_type lnKTableMaxError_ = real_type(1e-6), lnKTableError_ = real_type(0);
+  real_type lnKTableInvTMin_ = real_type(0), lnKTableDeltaInvT_ = real_type(0);
+  bool lnKTableComplete_ = false;
+  ordinal_type_1d_dual_view lnKTableMask_;
+  real_type_2d_dual_view lnKforTable_, lnKrevTable_;
+
+  void buildRateConstantTable();
+
 public:
   KineticModelData(const std::string& mechfile, const std::string& thermofile);
 
@@ -473,6 +623,53 @@ public:
   ordinal_type initChem();
   ordinal_type initChemSurf();
 
+  /// enable dynamic adaptive chemistry; species are kept when their DRG
+  /// interaction coefficient with target species (mass fraction larger than
+  /// target_mass_fraction) exceeds threshold. a negative threshold disables
+  /// the reduction
+  void setDirectedRelationGraph(const real_type threshold,
+                                const real_type target_mass_fraction)
+  {
+    drgThreshold_ = threshold;
+    drgTargetMassFraction_ = target_mass_fraction;
+  }
+
+  /// gas and surface rate constants memoized within a sample are reused
+  /// when the temperature changes by less than rtol relative to the
+  /// memoized one e.g., temperature columns of a numerical jacobian. the
+  /// default zero reuses them only at the same temperature and keeps the
+  /// results bit-identical; set before createConstData
+  void setKForwardReverseMemoTolerance(const real_type rtol)
+  {
+    memoRtol_ = rtol;
+  }
+
+  /// tabulate ln kfor and ln krev of pressure independent reactions on a
+  /// uniform grid of 1/T over [TthrmMin, TthrmMax]; within the range the
+  /// rate constants are interpolated instead of evaluated. the table is built
+  /// by the next createConstData; starting from num_intervals, the grid is
+  /// refined until the interpolation error of ln k at the interval midpoints
+  /// is below max_error. zero intervals disables the table
+  void setRateConstantTable(const ordinal_type num_intervals,
+                            const real_type max_error = real_type(1e-6))
+  {
+    lnKTableRequested_ = num_intervals > 0;
+    lnKTableNumIntervals_ = num_intervals;
+    lnKTableMaxError_ = max_error;
+    if (!lnKTableRequested_) {
+      lnKTableMask_ = ordinal_type_1d_dual_view();
+      lnKforTable_ = real_type_2d_dual_view();
+      lnKrevTable_ = real_type_2d_dual_view();
+    }
+  }
+
+  /// number of intervals and the max interpolation error of the built table
+  ordinal_type getRateConstantTableNumIntervals() const
+  {
+    return lnKforTable_.extent(0) > 0 ? lnKforTable_.extent(0) - 1 : 0;
+  }
+  real_type getRateConstantTableError() const { return lnKTableError_; }
+
   /// copy only things needed; we need to review what is actually needed for
   /// computations
   template<typename SpT>
@@ -584,6 +781,22 @@ public:
     // data.spec9coefs = spec9coefs_.template view<SpT>();
     // data.sNames = sNames_.template view<SpT>();
 
+    data.drgThreshold = drgThreshold_;
+    data.drgTargetMassFraction = drgTargetMassFraction_;
+    data.memoRtol = memoRtol_;
+
+    if (lnKTableRequested_) {
+      /// the table is built with const data without the table
+      lnKTableRequested_ = false;
+      buildRateConstantTable();
+    }
+    data.lnKTableInvTMin = lnKTableInvTMin_;
+    data.lnKTableDeltaInvT = lnKTableDeltaInvT_;
+    data.lnKTableComplete = lnKTableComplete_;
+    data.lnKTableMask = lnKTableMask_.template view<SpT>();
+    data.lnKforTable = lnKforTable_.template view<SpT>();
+    data.lnKrevTable = lnKrevTable_.template view<SpT>();
+
     return data;
   }
 
@@ -632,6 +845,12 @@ public:
     data.vki = vski_.template view<SpT>();
     data.vsurfki = vsurfki_.template view<SpT>();
 
+    data.stickFac = TCsurf_stickFac_.template view<SpT>();
+    data.kcFac = TCsurf_kcFac_.template view<SpT>();
+    data.kcNuSum = TCsurf_kcNuSum_.template view<SpT>();
+
+    data.memoRtol = memoRtol_;
+
     return data;
   }
 };
@@ -0,0 +1,301 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_MATH_HPP__
+#define __TCHEM_MATH_HPP__
+
+#include "TChem_Util.hpp"
+
+namespace TChem {
+
+///
+/// Transcendental functions of the kinetics kernels
+///
+/// ats<T>::exp, log and pow become scalar libm calls on host, which keeps
+/// the compiler from vectorizing the reaction loops. For double on host,
+/// Math<double> evaluates them with range reduction and polynomials only
+/// (no calls and no data dependent branches) so that a loop calling them
+/// is vectorized. The relative error of exp and log is a few ulps; special
+/// values (inf, nan, zero, subnormal) follow libm. pow evaluates
+/// exp(y log|x|) and the rounding error of log is amplified by |y log x|
+/// e.g., about 1e-14 relative for |y log x| ~ 70. Integer exponents with
+/// |y| < 16 are products of x instead, which are exact when the
+/// intermediate powers are representable e.g., (-2)^3 and 10^2.
+///
+/// Device code and -D TCHEM_ENABLE_MATH_USE_LIBM=ON use ats<T>, which is
+/// useful to validate results against libm.
+///
+template<typename T>
+struct Math
+{
+  KOKKOS_FORCEINLINE_FUNCTION static T exp(const T x)
+  {
+    return ats<T>::exp(x);
+  }
+  KOKKOS_FORCEINLINE_FUNCTION static T log(const T x)
+  {
+    return ats<T>::log(x);
+  }
+  KOKKOS_FORCEINLINE_FUNCTION static T log10(const T x)
+  {
+    return ats<T>::log10(x);
+  }
+  KOKKOS_FORCEINLINE_FUNCTION static T pow(const T x, const T y)
+  {
+    return ats<T>::pow(x, y);
+  }
+};
+
+#if !defined(TCHEM_ENABLE_MATH_USE_LIBM)
+template<>
+struct Math<double>
+{
+private:
+  KOKKOS_FORCEINLINE_FUNCTION static double asDouble(const int64_t i)
+  {
+    double d;
+    memcpy(&d, &i, sizeof(double));
+    return d;
+  }
+  KOKKOS_FORCEINLINE_FUNCTION static int64_t asInt(const double d)
+  {
+    int64_t i;
+    memcpy(&i, &d, sizeof(double));
+    return i;
+  }
+
+  /// exp for |x| within the normal range; no special values
+  KOKKOS_FORCEINLINE_FUNCTION static double expKernel(const double x)
+  {
+    const double log2e = 1.4426950408889634074;
+    const double ln2_hi = 6.93147180369123816490e-01,
+                 ln2_lo = 1.90821492927058770002e-10;
+
+    /// x = k ln2 + r, |r| <= ln2/2
+    const double kd = ::floor(x * log2e + 0.5);
+    const double r = (x - kd * ln2_hi) - kd * ln2_lo;
+
+    /// e^r with the Taylor series to r^13; the truncation is below 1e-17
+    double p = 1.0 / 6227020800.0;
+    p = p * r + 1.0 / 479001600.0;
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    /// 2^k in two factors so that k in [-1075, 1024] does not overflow the
+    /// exponent bits and the result underflows gradually
+    const int k = int(kd);
+    const int k1 = k / 2, k2 = k - k1;
+    const double s1 = asDouble(int64_t(k1 + 1023) << 52),
+                 s2 = asDouble(int64_t(k2 + 1023) << 52);
+    return p * s1 * s2;
+  }
+
+  /// log of a positive normal or subnormal x; no special values
+  KOKKOS_FORCEINLINE_FUNCTION static double logKernel(const double x)
+  {
+    const double ln2_hi = 6.93147180369123816490e-01,
+                 ln2_lo = 1.90821492927058770002e-10;
+    const double sqrt2 = 1.41421356237309504880;
+    const double dbl_min = 2.2250738585072014e-308,
+                 two54 = 18014398509481984.0;
+
+    /// subnormals are scaled into the normal range
+    const bool is_subnormal = x < dbl_min;
+    const double xs = is_subnormal ? x * two54 : x;
+
+    /// x = m 2^e, m in [sqrt(2)/2, sqrt(2))
+    const int64_t bits = asInt(xs);
+    int e = int((bits >> 52) & 0x7ff) - 1023 - (is_subnormal ? 54 : 0);
+    double m = asDouble((bits & 0x000fffffffffffffLL) | 0x3ff0000000000000LL);
+    const bool is_large = m > sqrt2;
+    m = is_large ? 0.5 * m : m;
+    e = is_large ? e + 1 : e;
+
+    /// log(m) = 2 atanh(f), f = (m-1)/(m+1), |f| <= 0.1716
+    const double f = (m - 1.0) / (m + 1.0);
+    const double s = f * f;
+    double p = 1.0 / 21.0;
+    p = p * s + 1.0 / 19.0;
+    p = p * s + 1.0 / 17.0;
+    p = p * s + 1.0 / 15.0;
+    p = p * s + 1.0 / 13.0;
+    p = p * s + 1.0 / 11.0;
+    p = p * s + 1.0 / 9.0;
+    p = p * s + 1.0 / 7.0;
+    p = p * s + 1.0 / 5.0;
+    p = p * s + 1.0 / 3.0;
+    p = p * s;
+
+    const double ed = double(e);
+    return ed * ln2_hi + ((2.0 * f + 2.0 * f * p) + ed * ln2_lo);
+  }
+
+public:
+  KOKKOS_FORCEINLINE_FUNCTION static double exp(const double x)
+  {
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
+    return ats<double>::exp(x);
+#else
+    const double xmax = 709.782712893383973096,
+                 xmin = -745.133219101941108420;
+    /// nan is replaced so that the kernel sees a finite value
+    const double xc = x < xmax ? (x > xmin ? x : xmin) : xmax;
+    const double y = expKernel(xc);
+    return (x != x ? x
+                   : x > xmax ? ats<double>::infinity() : x < xmin ? 0.0 : y);
+#endif
+  }
+
+  KOKKOS_FORCEINLINE_FUNCTION static double log(const double x)
+  {
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
+    return ats<double>::log(x);
+#else
+    const bool is_finite_positive = x > 0.0 && x <= ats<double>::max();
+    const double y = logKernel(is_finite_positive ? x : 1.0);
+    return (is_finite_positive
+              ? y
+              : x == 0.0 ? -ats<double>::infinity()
+                         : x > 0.0 ? x : ats<double>::nan());
+#endif
+  }
+
+  KOKKOS_FORCEINLINE_FUNCTION static double log10(const double x)
+  {
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
+    return ats<double>::log10(x);
+#else
+    const double log10e = 0.43429448190325182765;
+    return log(x) * log10e;
+#endif
+  }
+
+  /// x^n for an integer y = n with |n| < 16 by repeated squaring; the
+  /// fixed trip count keeps the selects branch free
+  KOKKOS_FORCEINLINE_FUNCTION static double powSmallInteger(const double x,
+                                                            const double y)
+  {
+    const double ay = y < 0.0 ? -y : y;
+    const int n = ay < 16.0 ? int(ay) : 0;
+    double p(1), b(x);
+    for (int bit = 0; bit < 4; ++bit) {
+      p = ((n >> bit) & 1) ? p * b : p;
+      b *= b;
+    }
+    return y < 0.0 ? 1.0 / p : p;
+  }
+
+  /// x^y; integer powers of negative x are supported as in libm
+  KOKKOS_FORCEINLINE_FUNCTION static double pow(const double x,
+                                                const double y)
+  {
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
+    return ats<double>::pow(x, y);
+#else
+    const double ax = x < 0.0 ? -x : x;
+    const double z = exp(y * log(ax));
+
+    const bool is_integer = ::floor(y) == y;
+    const bool is_odd = is_integer && ::floor(0.5 * y) != 0.5 * y;
+    const bool is_small_integer = is_integer && (y < 0.0 ? -y : y) < 16.0;
+    const double zs = (x < 0.0 && is_odd) ? -z : z;
+    return (y == 0.0 ? 1.0
+                     : is_small_integer
+                         ? powSmallInteger(x, y)
+                         : (x < 0.0 && !is_integer) ? ats<double>::nan() : zs);
+#endif
+  }
+};
+#endif
+
+///
+/// Batched variants on arrays e.g., exponents of all reactions; the team
+/// vector range is vectorized on host with Math<double>
+///
+struct MathBatch
+{
+  /// y(i) = exp(x(i)); x and y can be the same
+  template<typename MemberType, typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_exp(const MemberType& member,
+                                              const RealType1DViewType& x,
+                                              const RealType1DViewType& y)
+  {
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, x.extent(0)),
+                         [&](const ordinal_type& i) {
+                           y(i) = Math<real_type>::exp(x(i));
+                         });
+  }
+
+  /// y(i) = log(x(i)); x and y can be the same
+  template<typename MemberType, typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_log(const MemberType& member,
+                                              const RealType1DViewType& x,
+                                              const RealType1DViewType& y)
+  {
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, x.extent(0)),
+                         [&](const ordinal_type& i) {
+                           y(i) = Math<real_type>::log(x(i));
+                         });
+  }
+
+  /// z(i) = x(i)^y(i); x and z can be the same
+  template<typename MemberType, typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_pow(const MemberType& member,
+                                              const RealType1DViewType& x,
+                                              const RealType1DViewType& y,
+                                              const RealType1DViewType& z)
+  {
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, x.extent(0)),
+                         [&](const ordinal_type& i) {
+                           z(i) = Math<real_type>::pow(x(i), y(i));
+                         });
+  }
+
+  /// serial variants on contiguous arrays of length n
+  KOKKOS_INLINE_FUNCTION static void serial_exp(const ordinal_type n,
+                                                const real_type* x,
+                                                /* */ real_type* y)
+  {
+    for (ordinal_type i = 0; i < n; ++i)
+      y[i] = Math<real_type>::exp(x[i]);
+  }
+
+  KOKKOS_INLINE_FUNCTION static void serial_log(const ordinal_type n,
+                                                const real_type* x,
+                                                /* */ real_type* y)
+  {
+    for (ordinal_type i = 0; i < n; ++i)
+      y[i] = Math<real_type>::log(x[i]);
+  }
+};
+
+} // namespace TChem
+
+#endif
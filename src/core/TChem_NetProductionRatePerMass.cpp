@@ -26,100 +26,231 @@ Sandia National Laboratories, Livermore, CA, USA
 
 namespace TChem {
 
+namespace Impl {
+template<typename PolicyType,
+         typename RealType1DViewType,
+         typename RealType2DBatchViewType,
+         typename KineticModelSelectorType>
 void
-NetProductionRatePerMass::runHostBatch( /// input
-  const ordinal_type nBatch,
-  const real_type_2d_view_host& state,
+NetProductionRatePerMass_TemplateRun( /// required template arguments
+  const std::string& profile_name,
+  const RealType1DViewType& dummy_1d,
+  /// team size setting
+  const PolicyType& policy,
+  const RealType2DBatchViewType& state,
   /// output
-  const real_type_2d_view_host& omega,
-  /// const data from kinetic model
-  const KineticModelConstDataHost& kmcd)
+  const RealType2DBatchViewType& omega,
+  /// const data from kinetic model; kmcd_of(i) is the model of sample i
+  const KineticModelSelectorType& kmcd_of,
+  const ordinal_type per_team_extent)
 {
-  Kokkos::Profiling::pushRegion("TChem::NetProductionRatePerMass::runHostBatch");
-  using policy_type = Kokkos::TeamPolicy<host_exec_space>;
+  Kokkos::Profiling::pushRegion(profile_name);
+  using policy_type = PolicyType;
 
   const ordinal_type level = 1;
-  const ordinal_type per_team_extent = getWorkSpaceSize(kmcd);
-  const ordinal_type per_team_scratch =
-    Scratch<real_type_1d_view>::shmem_size(per_team_extent);
 
-  // policy_type policy(nBatch); // error
-  policy_type policy(nBatch, Kokkos::AUTO()); // fine
-  // policy_type policy(nBatch, Kokkos::AUTO(), Kokkos::AUTO()); // error
-  policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+  /// strided rows are staged in scratch
+  const ordinal_type per_team_extent_stage =
+    getBatchRowWorkSpaceSize(state) + getBatchRowWorkSpaceSize(omega);
   Kokkos::parallel_for(
-    "TChem::NetProductionRatePerMass::runHostBatch",
-    policy,
+    profile_name,
+    getBatchRowPolicy(policy, per_team_extent_stage),
     KOKKOS_LAMBDA(const typename policy_type::member_type& member) {
       const ordinal_type i = member.league_rank();
-      const real_type_1d_view_host state_at_i =
-        Kokkos::subview(state, i, Kokkos::ALL());
-      const real_type_1d_view_host omega_at_i =
-        Kokkos::subview(omega, i, Kokkos::ALL());
-      Scratch<real_type_1d_view_host> work(member.team_scratch(level),
-                                           per_team_extent);
-
-      const Impl::StateVector<real_type_1d_view_host> sv_at_i(kmcd.nSpec,
-                                                              state_at_i);
+      const auto& kmcd = kmcd_of(i);
+      const auto kmcd_at_i = Impl::getKineticModelAtSample(kmcd, i);
+      Scratch<RealType1DViewType> stage(member.team_scratch(level),
+                                        per_team_extent_stage);
+      auto wstage = stage.data();
+      const RealType1DViewType state_row =
+        getBatchRow<RealType1DViewType>(member, state, i, true, wstage);
+      const RealType1DViewType omega_row =
+        getBatchRow<RealType1DViewType>(member, omega, i, false, wstage);
+
+      /// rows are sized by the largest mechanism when mechanisms are mixed
+      const RealType1DViewType state_at_i(
+        state_row.data(), Impl::getStateVectorSize(kmcd.nSpec));
+      const RealType1DViewType omega_at_i(omega_row.data(), kmcd.nSpec);
+      Kokkos::parallel_for(
+        Kokkos::TeamVectorRange(
+          member, kmcd.nSpec, ordinal_type(omega_row.extent(0))),
+        [&](const ordinal_type& k) { omega_row(k) = 0; });
+      Scratch<RealType1DViewType> work(member.team_scratch(level),
+                                       per_team_extent);
+
+      const Impl::StateVector<RealType1DViewType> sv_at_i(kmcd.nSpec,
+                                                          state_at_i);
       TCHEM_CHECK_ERROR(!sv_at_i.isValid(),
                         "Error: input state vector is not valid");
       {
         const real_type t = sv_at_i.Temperature();
         const real_type p = sv_at_i.Pressure();
-        const real_type_1d_view_host Xc = sv_at_i.MassFractions();
+        const RealType1DViewType Xc = sv_at_i.MassFractions();
         Impl::ReactionRates ::team_invoke(
-          member, t, p, Xc, omega_at_i, work, kmcd);
+          member, t, p, Xc, omega_at_i, work, kmcd_at_i);
+        setBatchRow(member, omega_row, omega, i);
       }
     });
   Kokkos::Profiling::popRegion();
 }
 
+} // namespace Impl
+
+void
+NetProductionRatePerMass::runHostBatch( /// input
+  const ordinal_type nBatch,
+  const real_type_2d_stride_view_host& state,
+  /// output
+  const real_type_2d_stride_view_host& omega,
+  /// const data from kinetic model
+  const KineticModelConstDataHost& kmcd)
+{
+  using policy_type = typename UseThisTeamPolicy<host_exec_space>::type;
+
+  const ordinal_type level = 1;
+  const ordinal_type per_team_extent = getWorkSpaceSize(kmcd);
+  const ordinal_type per_team_scratch =
+    Scratch<real_type_1d_view>::shmem_size(per_team_extent);
+
+  policy_type policy(nBatch, Kokkos::AUTO());
+  policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+  runHostBatch(policy, state, omega, kmcd);
+}
+
+void
+NetProductionRatePerMass::runHostBatch( /// input
+  typename UseThisTeamPolicy<host_exec_space>::type& policy,
+  const real_type_2d_stride_view_host& state,
+  /// output
+  const real_type_2d_stride_view_host& omega,
+  /// const data from kinetic model
+  const KineticModelConstDataHost& kmcd)
+{
+  Impl::NetProductionRatePerMass_TemplateRun(
+    "TChem::NetProductionRatePerMass::runHostBatch",
+    real_type_1d_view_host(),
+    /// team policy
+    policy,
+    state,
+    omega,
+    Impl::KineticModelSelector<KineticModelConstDataHost>(kmcd),
+    getWorkSpaceSize(kmcd));
+}
+
 void
 NetProductionRatePerMass::runDeviceBatch( /// input
   const ordinal_type nBatch,
-  const real_type_2d_view& state,
+  const real_type_2d_stride_view& state,
   /// output
-  const real_type_2d_view& omega,
+  const real_type_2d_stride_view& omega,
   /// const data from kinetic model
   const KineticModelConstDataDevice& kmcd)
 {
-  Kokkos::Profiling::pushRegion("TChem::NetProductionRatePerMass::runDeviceBatch");
-  using policy_type = Kokkos::TeamPolicy<exec_space>;
+  using policy_type = typename UseThisTeamPolicy<exec_space>::type;
 
   const ordinal_type level = 1;
   const ordinal_type per_team_extent = getWorkSpaceSize(kmcd);
   const ordinal_type per_team_scratch =
     Scratch<real_type_1d_view>::shmem_size(per_team_extent);
 
-  // policy_type policy(nBatch); // error
-  policy_type policy(nBatch, Kokkos::AUTO()); // fine
-  // policy_type policy(nBatch, Kokkos::AUTO(), Kokkos::AUTO()); // error
+  policy_type policy(nBatch, Kokkos::AUTO());
   policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
-  Kokkos::parallel_for(
+
+  runDeviceBatch(policy, state, omega, kmcd);
+}
+
+void
+NetProductionRatePerMass::runDeviceBatch( /// input
+  typename UseThisTeamPolicy<exec_space>::type& policy,
+  const real_type_2d_stride_view& state,
+  /// output
+  const real_type_2d_stride_view& omega,
+  /// const data from kinetic model
+  const KineticModelConstDataDevice& kmcd)
+{
+  Impl::NetProductionRatePerMass_TemplateRun(
     "TChem::NetProductionRatePerMass::runDeviceBatch",
+    real_type_1d_view(),
+    /// team policy
     policy,
-    KOKKOS_LAMBDA(const typename policy_type::member_type& member) {
-      const ordinal_type i = member.league_rank();
-      const real_type_1d_view state_at_i =
-        Kokkos::subview(state, i, Kokkos::ALL());
-      const real_type_1d_view omega_at_i =
-        Kokkos::subview(omega, i, Kokkos::ALL());
-      Scratch<real_type_1d_view> work(member.team_scratch(level),
-                                      per_team_extent);
-
-      const Impl::StateVector<real_type_1d_view> sv_at_i(kmcd.nSpec,
-                                                         state_at_i);
-      TCHEM_CHECK_ERROR(!sv_at_i.isValid(),
-                        "Error: input state vector is not valid");
-      {
-        const real_type t = sv_at_i.Temperature();
-        const real_type p = sv_at_i.Pressure();
-        const real_type_1d_view Xc = sv_at_i.MassFractions();
-        Impl::ReactionRates ::team_invoke(
-          member, t, p, Xc, omega_at_i, work, kmcd);
-      }
+    state,
+    omega,
+    Impl::KineticModelSelector<KineticModelConstDataDevice>(kmcd),
+    getWorkSpaceSize(kmcd));
+}
+
+template<typename SpT>
+static ordinal_type
+getMaxWorkSpaceSizeOfMechanisms(const KineticModelConstDataArray<SpT>& kmcds)
+{
+  return Impl::getMaxOverKineticModels(
+    kmcds, [](const KineticModelConstData<SpT>& kmcd) {
+      return NetProductionRatePerMass::getWorkSpaceSize(kmcd);
     });
-  Kokkos::Profiling::popRegion();
+}
+
+void
+NetProductionRatePerMass::runHostBatch( /// input
+  const ordinal_type_1d_view_host& mechanism,
+  const real_type_2d_stride_view_host& state,
+  /// output
+  const real_type_2d_stride_view_host& omega,
+  /// const data from kinetic models
+  const KineticModelConstDataArrayHost& kmcds)
+{
+  using policy_type = typename UseThisTeamPolicy<host_exec_space>::type;
+
+  const ordinal_type level = 1;
+  const ordinal_type per_team_extent = getMaxWorkSpaceSizeOfMechanisms(kmcds);
+  const ordinal_type per_team_scratch =
+    Scratch<real_type_1d_view>::shmem_size(per_team_extent);
+
+  policy_type policy(mechanism.extent(0), Kokkos::AUTO());
+  policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+  Impl::NetProductionRatePerMass_TemplateRun(
+    "TChem::NetProductionRatePerMass::runHostBatch::MixedMechanisms",
+    real_type_1d_view_host(),
+    /// team policy
+    policy,
+    state,
+    omega,
+    Impl::KineticModelArraySelector<host_exec_space,
+                                    ordinal_type_1d_view_host>(kmcds,
+                                                               mechanism),
+    per_team_extent);
+}
+
+void
+NetProductionRatePerMass::runDeviceBatch( /// input
+  const ordinal_type_1d_view& mechanism,
+  const real_type_2d_stride_view& state,
+  /// output
+  const real_type_2d_stride_view& omega,
+  /// const data from kinetic models
+  const KineticModelConstDataArrayDevice& kmcds)
+{
+  using policy_type = typename UseThisTeamPolicy<exec_space>::type;
+
+  const ordinal_type level = 1;
+  const ordinal_type per_team_extent = getMaxWorkSpaceSizeOfMechanisms(kmcds);
+  const ordinal_type per_team_scratch =
+    Scratch<real_type_1d_view>::shmem_size(per_team_extent);
+
+  policy_type policy(mechanism.extent(0), Kokkos::AUTO());
+  policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+  Impl::NetProductionRatePerMass_TemplateRun(
+    "TChem::NetProductionRatePerMass::runDeviceBatch::MixedMechanisms",
+    real_type_1d_view(),
+    /// team policy
+    policy,
+    state,
+    omega,
+    Impl::KineticModelArraySelector<exec_space, ordinal_type_1d_view>(
+      kmcds, mechanism),
+    per_team_extent);
 }
 
 } // namespace TChem
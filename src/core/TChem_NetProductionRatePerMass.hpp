@@ -38,19 +38,107 @@ struct NetProductionRatePerMass
 
   static void runHostBatch( /// input
     const ordinal_type nBatch,
-    const real_type_2d_view_host& state,
+    const real_type_2d_stride_view_host& state,
     /// output
-    const real_type_2d_view_host& omega,
+    const real_type_2d_stride_view_host& omega,
+    /// const data from kinetic model
+    const KineticModelConstDataHost& kmcd);
+
+  static void runHostBatch( /// thread block size
+    typename UseThisTeamPolicy<host_exec_space>::type& policy,
+    const real_type_2d_stride_view_host& state,
+    /// output
+    const real_type_2d_stride_view_host& omega,
     /// const data from kinetic model
     const KineticModelConstDataHost& kmcd);
 
   static void runDeviceBatch( /// input
     const ordinal_type nBatch,
-    const real_type_2d_view& state,
+    const real_type_2d_stride_view& state,
+    /// output
+    const real_type_2d_stride_view& omega,
+    /// const data from kinetic model
+    const KineticModelConstDataDevice& kmcd);
+
+  static void runDeviceBatch( /// thread block size
+    typename UseThisTeamPolicy<exec_space>::type& policy,
+    const real_type_2d_stride_view& state,
     /// output
-    const real_type_2d_view& omega,
+    const real_type_2d_stride_view& omega,
     /// const data from kinetic model
     const KineticModelConstDataDevice& kmcd);
+
+  /// a batch mixing mechanisms; sample i uses kmcds(mechanism(i)). state and
+  /// omega are sized by the largest nSpec and trailing entries of omega
+  /// beyond the nSpec of the sample mechanism are set to zero
+  static void runHostBatch( /// input
+    const ordinal_type_1d_view_host& mechanism,
+    const real_type_2d_stride_view_host& state,
+    /// output
+    const real_type_2d_stride_view_host& omega,
+    /// const data from kinetic models
+    const KineticModelConstDataArrayHost& kmcds);
+
+  static void runDeviceBatch( /// input
+    const ordinal_type_1d_view& mechanism,
+    const real_type_2d_stride_view& state,
+    /// output
+    const real_type_2d_stride_view& omega,
+    /// const data from kinetic models
+    const KineticModelConstDataArrayDevice& kmcds);
+
+  /// execution plan for repeated calls with the same batch size; the team
+  /// policy and its scratch size are set once when the plan is constructed
+  template<typename SpT>
+  class Plan
+  {
+  public:
+    using policy_type = typename UseThisTeamPolicy<SpT>::type;
+    using kinetic_model_type = KineticModelConstData<SpT>;
+    using is_host_type = std::is_same<SpT, host_exec_space>;
+    using real_type_2d_view_type =
+      typename std::conditional<is_host_type::value,
+                                real_type_2d_stride_view_host,
+                                real_type_2d_stride_view>::type;
+
+  private:
+    kinetic_model_type _kmcd;
+    policy_type _policy;
+
+    template<typename... Args>
+    static void run(std::true_type, Args&&... args)
+    {
+      runHostBatch(args...);
+    }
+    template<typename... Args>
+    static void run(std::false_type, Args&&... args)
+    {
+      runDeviceBatch(args...);
+    }
+
+  public:
+    /// team_size and vector_size are used when both are positive
+    Plan(const kinetic_model_type& kmcd,
+         const ordinal_type nBatch,
+         const ordinal_type team_size = -1,
+         const ordinal_type vector_size = -1)
+      : _kmcd(kmcd)
+      , _policy(SpT(), nBatch, Kokkos::AUTO())
+    {
+      if (team_size > 0 && vector_size > 0)
+        _policy = policy_type(SpT(), nBatch, team_size, vector_size);
+      const ordinal_type level = 1;
+      const ordinal_type per_team_scratch =
+        Scratch<real_type_1d_view>::shmem_size(getWorkSpaceSize(kmcd));
+      _policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+    }
+
+    void execute(const real_type_2d_view_type& state,
+                 const real_type_2d_view_type& omega)
+    {
+      run(is_host_type(), _policy, state, omega, _kmcd);
+    }
+  };
 };
 
 } // namespace TChem
@@ -29,9 +29,9 @@ namespace TChem {
 void
 NetProductionRatePerMole::runHostBatch( /// input
   const ordinal_type nBatch,
-  const real_type_2d_view_host& state,
+  const real_type_2d_stride_view_host& state,
   /// output
-  const real_type_2d_view_host& omega,
+  const real_type_2d_stride_view_host& omega,
   /// const data from kinetic model
   const KineticModelConstDataHost& kmcd)
 {
@@ -47,15 +47,24 @@ NetProductionRatePerMole::runHostBatch( /// input
   policy_type policy(nBatch, Kokkos::AUTO()); // fine
   // policy_type policy(nBatch, Kokkos::AUTO(), Kokkos::AUTO()); // error
   policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+  /// strided rows are staged in scratch
+  const ordinal_type per_team_extent_stage =
+    Impl::getBatchRowWorkSpaceSize(state) +
+    Impl::getBatchRowWorkSpaceSize(omega);
   Kokkos::parallel_for(
     "TChem::NetProductionRatePerMole::runHostBatch",
-    policy,
+    Impl::getBatchRowPolicy(policy, per_team_extent_stage),
     KOKKOS_LAMBDA(const typename policy_type::member_type& member) {
       const ordinal_type i = member.league_rank();
+      const auto kmcd_at_i = Impl::getKineticModelAtSample(kmcd, i);
+      Scratch<real_type_1d_view_host> stage(member.team_scratch(level),
+                                            per_team_extent_stage);
+      auto wstage = stage.data();
       const real_type_1d_view_host state_at_i =
-        Kokkos::subview(state, i, Kokkos::ALL());
+        Impl::getBatchRow<real_type_1d_view_host>(member, state, i, true, wstage);
       const real_type_1d_view_host omega_at_i =
-        Kokkos::subview(omega, i, Kokkos::ALL());
+        Impl::getBatchRow<real_type_1d_view_host>(member, omega, i, false, wstage);
       Scratch<real_type_1d_view_host> work(member.team_scratch(level),
                                            per_team_extent);
 
@@ -68,7 +77,8 @@ NetProductionRatePerMole::runHostBatch( /// input
         const real_type p = sv_at_i.Pressure();
         const real_type_1d_view_host Xc = sv_at_i.MassFractions();
         Impl::ReactionRates ::team_invoke(
-          member, t, p, Xc, omega_at_i, work, kmcd);
+          member, t, p, Xc, omega_at_i, work, kmcd_at_i);
+        Impl::setBatchRow(member, omega_at_i, omega, i);
       }
     });
   Kokkos::Profiling::popRegion();
@@ -77,9 +87,9 @@ NetProductionRatePerMole::runHostBatch( /// input
 void
 NetProductionRatePerMole::runDeviceBatch( /// input
   const ordinal_type nBatch,
-  const real_type_2d_view& state,
+  const real_type_2d_stride_view& state,
   /// output
-  const real_type_2d_view& omega,
+  const real_type_2d_stride_view& omega,
   /// const data from kinetic model
   const KineticModelConstDataDevice& kmcd)
 {
@@ -95,15 +105,24 @@ NetProductionRatePerMole::runDeviceBatch( /// input
   policy_type policy(nBatch, Kokkos::AUTO()); // fine
   // policy_type policy(nBatch, Kokkos::AUTO(), Kokkos::AUTO()); // error
   policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+  /// strided rows are staged in scratch
+  const ordinal_type per_team_extent_stage =
+    Impl::getBatchRowWorkSpaceSize(state) +
+    Impl::getBatchRowWorkSpaceSize(omega);
   Kokkos::parallel_for(
     "TChem::NetProductionRatePerMole::runDeviceBatch",
-    policy,
+    Impl::getBatchRowPolicy(policy, per_team_extent_stage),
     KOKKOS_LAMBDA(const typename policy_type::member_type& member) {
       const ordinal_type i = member.league_rank();
+      const auto kmcd_at_i = Impl::getKineticModelAtSample(kmcd, i);
+      Scratch<real_type_1d_view> stage(member.team_scratch(level),
+                                       per_team_extent_stage);
+      auto wstage = stage.data();
       const real_type_1d_view state_at_i =
-        Kokkos::subview(state, i, Kokkos::ALL());
+        Impl::getBatchRow<real_type_1d_view>(member, state, i, true, wstage);
       const real_type_1d_view omega_at_i =
-        Kokkos::subview(omega, i, Kokkos::ALL());
+        Impl::getBatchRow<real_type_1d_view>(member, omega, i, false, wstage);
       Scratch<real_type_1d_view> work(member.team_scratch(level),
                                       per_team_extent);
 
@@ -116,7 +135,7 @@ NetProductionRatePerMole::runDeviceBatch( /// input
         const real_type p = sv_at_i.Pressure();
         const real_type_1d_view Xc = sv_at_i.MassFractions();
         Impl::ReactionRates ::team_invoke(
-          member, t, p, Xc, omega_at_i, work, kmcd);
+          member, t, p, Xc, omega_at_i, work, kmcd_at_i);
 
         //
         member.team_barrier();
@@ -127,6 +146,7 @@ NetProductionRatePerMole::runDeviceBatch( /// input
           [&](const ordinal_type& k) {
             omega_at_i(k) /=kmcd.sMass(k);
           });
+        Impl::setBatchRow(member, omega_at_i, omega, i);
       }
     });
   Kokkos::Profiling::popRegion();
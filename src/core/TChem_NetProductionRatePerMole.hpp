@@ -38,17 +38,17 @@ struct NetProductionRatePerMole
 
   static void runHostBatch( /// input
     const ordinal_type nBatch,
-    const real_type_2d_view_host& state,
+    const real_type_2d_stride_view_host& state,
     /// output
-    const real_type_2d_view_host& omega,
+    const real_type_2d_stride_view_host& omega,
     /// const data from kinetic model
     const KineticModelConstDataHost& kmcd);
 
   static void runDeviceBatch( /// input
     const ordinal_type nBatch,
-    const real_type_2d_view& state,
+    const real_type_2d_stride_view& state,
     /// output
-    const real_type_2d_view& omega,
+    const real_type_2d_stride_view& omega,
     /// const data from kinetic model
     const KineticModelConstDataDevice& kmcd);
 };
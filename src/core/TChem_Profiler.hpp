@@ -0,0 +1,278 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_PROFILER_HPP__
+#define __TCHEM_PROFILER_HPP__
+
+#include "TChem_Util.hpp"
+
+#if defined(TCHEM_ENABLE_PROFILING)
+#include <chrono>
+#include <deque>
+#include <mutex>
+#endif
+
+namespace TChem {
+
+///
+/// Kernels timed by TCHEM_PROFILE_TEAM_SCOPE; times are inclusive
+/// e.g., ReactionRates includes Thermo, RateConstants, Falloff and
+/// RateOfProgress
+///
+struct ProfilerRegion
+{
+  enum : ordinal_type
+  {
+    Thermo = 0,
+    RateConstants,
+    Falloff,
+    RateOfProgress,
+    ReactionRates,
+    Jacobian,
+    ProblemFunction,
+    ProblemJacobian,
+    Factorization,
+    NewtonSolver,
+    TimeStepController,
+    NumRegions
+  };
+
+  static const char* getName(const ordinal_type region)
+  {
+    static const char* names[NumRegions] = { "Thermo",
+                                             "RateConstants",
+                                             "Falloff",
+                                             "RateOfProgress",
+                                             "ReactionRates",
+                                             "Jacobian",
+                                             "ProblemFunction",
+                                             "ProblemJacobian",
+                                             "Factorization",
+                                             "NewtonSolver",
+                                             "TimeStepController" };
+    return (region >= 0 && region < NumRegions) ? names[region] : "Unknown";
+  }
+};
+
+#if defined(TCHEM_ENABLE_PROFILING)
+
+///
+/// In-process collector of the kernel timers
+/// - each host thread accumulates into its own slot so the timers do not
+///   synchronize; slots are owned by the collector and summed on report
+/// - the summary is printed at exit when any timer is recorded; when the
+///   environment variable TCHEM_PROFILE_JSON is set, the summary is also
+///   written to the json file it names
+/// - device kernels are not timed
+///
+class Profiler
+{
+public:
+  struct Slot
+  {
+    unsigned long long count[ProfilerRegion::NumRegions];
+    unsigned long long nanoseconds[ProfilerRegion::NumRegions];
+  };
+
+  struct Summary
+  {
+    unsigned long long count;
+    double seconds;
+  };
+
+private:
+  std::mutex _mutex;
+  std::deque<Slot> _slots;
+
+  Profiler() = default;
+
+public:
+  Profiler(const Profiler&) = delete;
+  Profiler& operator=(const Profiler&) = delete;
+
+  ~Profiler()
+  {
+    bool recorded(false);
+    const auto summary = getSummary();
+    for (const auto& s : summary)
+      recorded |= s.count > 0;
+    if (!recorded)
+      return;
+
+    report(stdout);
+    const char* json = std::getenv("TCHEM_PROFILE_JSON");
+    if (json != NULL && json[0] != '\0')
+      writeJSON(json);
+  }
+
+  static Profiler& getInstance()
+  {
+    static Profiler profiler;
+    return profiler;
+  }
+
+  static unsigned long long getTimeNanoseconds()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+  }
+
+  Slot* getThreadSlot()
+  {
+    thread_local Slot* slot = NULL;
+    if (slot == NULL) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _slots.push_back(Slot());
+      slot = &_slots.back();
+      for (ordinal_type i = 0; i < ProfilerRegion::NumRegions; ++i) {
+        slot->count[i] = 0;
+        slot->nanoseconds[i] = 0;
+      }
+    }
+    return slot;
+  }
+
+  void record(const ordinal_type region, const unsigned long long ns)
+  {
+    Slot* slot = getThreadSlot();
+    ++slot->count[region];
+    slot->nanoseconds[region] += ns;
+  }
+
+  /// call after Kokkos::fence; timers running concurrently are not included
+  std::vector<Summary> getSummary()
+  {
+    std::vector<Summary> r_val(ProfilerRegion::NumRegions, Summary{ 0, 0 });
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& slot : _slots)
+      for (ordinal_type i = 0; i < ProfilerRegion::NumRegions; ++i) {
+        r_val[i].count += slot.count[i];
+        r_val[i].seconds += double(slot.nanoseconds[i]) * 1e-9;
+      }
+    return r_val;
+  }
+
+  void reset()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& slot : _slots)
+      for (ordinal_type i = 0; i < ProfilerRegion::NumRegions; ++i) {
+        slot.count[i] = 0;
+        slot.nanoseconds[i] = 0;
+      }
+  }
+
+  /// times are summed over teams i.e., cpu time of the teams
+  void report(FILE* fs)
+  {
+    const auto summary = getSummary();
+    fprintf(fs, "---------------------------------------------------\n");
+    fprintf(fs, "TChem profiler (inclusive time summed over teams)\n");
+    fprintf(fs,
+            "%-20s %14s %14s %14s\n",
+            "region",
+            "calls",
+            "time [sec]",
+            "time/call [us]");
+    for (ordinal_type i = 0; i < ProfilerRegion::NumRegions; ++i) {
+      const auto& s = summary[i];
+      if (s.count == 0)
+        continue;
+      fprintf(fs,
+              "%-20s %14llu %14.6e %14.6e\n",
+              ProfilerRegion::getName(i),
+              s.count,
+              s.seconds,
+              s.seconds / double(s.count) * 1e6);
+    }
+    fprintf(fs, "---------------------------------------------------\n");
+  }
+
+  void writeJSON(const std::string& filename)
+  {
+    FILE* fs = fopen(filename.c_str(), "w");
+    if (fs == NULL) {
+      printf("Warning: Profiler cannot open %s\n", filename.c_str());
+      return;
+    }
+    const auto summary = getSummary();
+    fprintf(fs, "{\n  \"regions\": [\n");
+    for (ordinal_type i = 0; i < ProfilerRegion::NumRegions; ++i) {
+      const auto& s = summary[i];
+      fprintf(fs,
+              "    {\"name\": \"%s\", \"calls\": %llu, \"seconds\": %e}%s\n",
+              ProfilerRegion::getName(i),
+              s.count,
+              s.seconds,
+              (i + 1) < ProfilerRegion::NumRegions ? "," : "");
+    }
+    fprintf(fs, "  ]\n}\n");
+    fclose(fs);
+  }
+};
+
+///
+/// Scoped timer recorded by the team leader; no-op on device
+///
+struct ProfilerTeamScope
+{
+#if !defined(__CUDA_ARCH__) && !defined(__HIP_DEVICE_COMPILE__)
+  ordinal_type _region;
+  unsigned long long _begin;
+#endif
+
+  template<typename MemberType>
+  KOKKOS_INLINE_FUNCTION ProfilerTeamScope(const MemberType& member,
+                                           const ordinal_type region)
+  {
+#if !defined(__CUDA_ARCH__) && !defined(__HIP_DEVICE_COMPILE__)
+    _region = member.team_rank() == 0 ? region : -1;
+    _begin = _region < 0 ? 0 : Profiler::getTimeNanoseconds();
+#endif
+  }
+
+  KOKKOS_INLINE_FUNCTION ~ProfilerTeamScope()
+  {
+#if !defined(__CUDA_ARCH__) && !defined(__HIP_DEVICE_COMPILE__)
+    if (_region >= 0)
+      Profiler::getInstance().record(
+        _region, Profiler::getTimeNanoseconds() - _begin);
+#endif
+  }
+};
+
+#define TCHEM_PROFILE_CONCAT_DETAIL(a, b) a##b
+#define TCHEM_PROFILE_CONCAT(a, b) TCHEM_PROFILE_CONCAT_DETAIL(a, b)
+#define TCHEM_PROFILE_TEAM_SCOPE(member, region)                               \
+  const TChem::ProfilerTeamScope TCHEM_PROFILE_CONCAT(tchem_profile_scope_,    \
+                                                      __LINE__)(               \
+    member, TChem::ProfilerRegion::region)
+
+#else
+
+/// profiling is disabled; the macro expands to nothing
+#define TCHEM_PROFILE_TEAM_SCOPE(member, region)
+
+#endif
+
+} // namespace TChem
+
+#endif
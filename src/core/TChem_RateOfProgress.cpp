@@ -30,10 +30,10 @@ namespace TChem {
 void
 RateOfProgress::runDeviceBatch( /// input
   const ordinal_type nBatch,
-  const real_type_2d_view& state,
+  const real_type_2d_stride_view& state,
   /// output
-  const real_type_2d_view& RoPFor,
-  const real_type_2d_view& RoPRev,
+  const real_type_2d_stride_view& RoPFor,
+  const real_type_2d_stride_view& RoPRev,
   /// const data from kinetic model
   const KineticModelConstDataDevice& kmcd)
 {
@@ -49,17 +49,27 @@ RateOfProgress::runDeviceBatch( /// input
   policy_type policy(nBatch, Kokkos::AUTO()); // fine
   // policy_type policy(nBatch, Kokkos::AUTO(), Kokkos::AUTO()); // error
   policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+  /// strided rows are staged in scratch
+  const ordinal_type per_team_extent_stage =
+    Impl::getBatchRowWorkSpaceSize(state) +
+    Impl::getBatchRowWorkSpaceSize(RoPFor) +
+    Impl::getBatchRowWorkSpaceSize(RoPRev);
   Kokkos::parallel_for(
     "TChem::RateOfProgress::runDeviceBatch",
-    policy,
+    Impl::getBatchRowPolicy(policy, per_team_extent_stage),
     KOKKOS_LAMBDA(const typename policy_type::member_type& member) {
       const ordinal_type i = member.league_rank();
+      const auto kmcd_at_i = Impl::getKineticModelAtSample(kmcd, i);
+      Scratch<real_type_1d_view> stage(member.team_scratch(level),
+                                       per_team_extent_stage);
+      auto wstage = stage.data();
       const real_type_1d_view state_at_i =
-        Kokkos::subview(state, i, Kokkos::ALL());
+        Impl::getBatchRow<real_type_1d_view>(member, state, i, true, wstage);
       const real_type_1d_view RoPFor_at_i =
-        Kokkos::subview(RoPFor, i, Kokkos::ALL());
+        Impl::getBatchRow<real_type_1d_view>(member, RoPFor, i, false, wstage);
       const real_type_1d_view RoPRev_at_i =
-        Kokkos::subview(RoPRev, i, Kokkos::ALL());
+        Impl::getBatchRow<real_type_1d_view>(member, RoPRev, i, false, wstage);
 
       Scratch<real_type_1d_view> work(member.team_scratch(level),
                                       per_team_extent);
@@ -74,7 +84,9 @@ RateOfProgress::runDeviceBatch( /// input
         const real_type_1d_view Ys = sv_at_i.MassFractions();
 
         Impl::RateOfProgressInd ::team_invoke(
-          member, t, p, Ys, RoPFor_at_i, RoPRev_at_i, work, kmcd);
+          member, t, p, Ys, RoPFor_at_i, RoPRev_at_i, work, kmcd_at_i);
+        Impl::setBatchRow(member, RoPFor_at_i, RoPFor, i);
+        Impl::setBatchRow(member, RoPRev_at_i, RoPRev, i);
       }
     });
   Kokkos::Profiling::popRegion();
@@ -37,10 +37,10 @@ struct RateOfProgress
 
   static void runDeviceBatch( /// input
     const ordinal_type nBatch,
-    const real_type_2d_view& state,
+    const real_type_2d_stride_view& state,
     /// output
-    const real_type_2d_view& RoPFor,
-    const real_type_2d_view& RoPRev,
+    const real_type_2d_stride_view& RoPFor,
+    const real_type_2d_stride_view& RoPRev,
     /// const data from kinetic model
     const KineticModelConstDataDevice& kmcd);
 };
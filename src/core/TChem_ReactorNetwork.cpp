@@ -0,0 +1,560 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#include "TChem_Util.hpp"
+
+#include "TChem_IgnitionZeroD.hpp"
+#include "TChem_ReactorNetwork.hpp"
+#include "TChem_SurfaceSteadyState.hpp"
+#include "TChem_ThermalProperties.hpp"
+
+namespace TChem {
+
+static inline typename UseThisTeamPolicy<exec_space>::type
+ReactorNetwork_CreatePolicy(const ordinal_type nBatch,
+                            const ordinal_type per_team_extent)
+{
+  typename UseThisTeamPolicy<exec_space>::type policy(
+    exec_space(), nBatch, Kokkos::AUTO());
+  const ordinal_type level = 1;
+  const ordinal_type per_team_scratch =
+    Scratch<real_type_1d_view>::shmem_size(per_team_extent);
+  policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+  return policy;
+}
+
+static inline void
+ReactorNetwork_CreateTolerence(const real_type atol_newton,
+                               const real_type rtol_newton,
+                               const real_type atol_time,
+                               const real_type rtol_time,
+                               const ordinal_type num_time_odes,
+                               real_type_1d_view& tol_newton,
+                               real_type_2d_view& tol_time)
+{
+  tol_newton = real_type_1d_view("tol newton", 2);
+  tol_time = real_type_2d_view("tol time", num_time_odes, 2);
+
+  auto tol_newton_host = Kokkos::create_mirror_view(tol_newton);
+  auto tol_time_host = Kokkos::create_mirror_view(tol_time);
+  tol_newton_host(0) = atol_newton;
+  tol_newton_host(1) = rtol_newton;
+  for (ordinal_type i = 0; i < num_time_odes; ++i) {
+    tol_time_host(i, 0) = atol_time;
+    tol_time_host(i, 1) = rtol_time;
+  }
+  Kokkos::deep_copy(tol_newton, tol_newton_host);
+  Kokkos::deep_copy(tol_time, tol_time_host);
+}
+
+/// starts a stage at zero and returns the time advance array; samples that
+/// failed in an earlier stage start at tend and are skipped by the launches
+static inline time_advance_type_1d_view
+ReactorNetwork_CreateTimeAdvance(const ordinal_type nBatch,
+                                 const time_advance_type& tadv_default,
+                                 const real_type tend,
+                                 const ordinal_type_1d_view& status,
+                                 real_type_1d_view& t,
+                                 real_type_1d_view& dt)
+{
+  time_advance_type tadv_stage = tadv_default;
+  tadv_stage._tbeg = 0;
+  tadv_stage._tend = tend;
+
+  time_advance_type_1d_view tadv("tadv", nBatch);
+  Kokkos::deep_copy(tadv, tadv_stage);
+
+  t = real_type_1d_view("time", nBatch);
+  dt = real_type_1d_view("delta time", nBatch);
+  Kokkos::deep_copy(dt, tadv_stage._dt);
+
+  const auto t_stage = t;
+  Kokkos::parallel_for(
+    "TChem::ReactorNetwork::CreateTimeAdvance",
+    Kokkos::RangePolicy<exec_space>(0, nBatch),
+    KOKKOS_LAMBDA(const ordinal_type& i) {
+      t_stage(i) = status(i) < 0 ? real_type(0) : tend;
+    });
+
+  return tadv;
+}
+
+/// carries over time and dt computed in the last launch and returns the
+/// number of samples that have not reached tend. a failed time integration
+/// (t = tend, dt = -1 and a zero state) marks the sample failed at stage s
+static inline ordinal_type
+ReactorNetwork_CarryOver(const time_advance_type_1d_view& tadv,
+                         const real_type_1d_view& t,
+                         const real_type_1d_view& dt,
+                         const real_type tend,
+                         const ordinal_type s,
+                         const ordinal_type_1d_view& status)
+{
+  ordinal_type num_active(0);
+  Kokkos::parallel_reduce(
+    "TChem::ReactorNetwork::CarryOver",
+    Kokkos::RangePolicy<exec_space>(0, tadv.extent(0)),
+    KOKKOS_LAMBDA(const ordinal_type& i, ordinal_type& update) {
+      if (dt(i) < 0 && status(i) < 0)
+        status(i) = s;
+      tadv(i)._tbeg = t(i);
+      tadv(i)._dt = dt(i);
+      update += (t(i) < tend);
+    },
+    num_active);
+  return num_active;
+}
+
+/// failed samples carry a zero state and mass flow rate to the next stage
+static inline void
+ReactorNetwork_ClearFailedSamples(const real_type_2d_view& state,
+                                  const real_type_1d_view& mdot,
+                                  const ordinal_type_1d_view& status)
+{
+  const ordinal_type stateVecDim = state.extent(1);
+  Kokkos::parallel_for(
+    "TChem::ReactorNetwork::ClearFailedSamples",
+    Kokkos::RangePolicy<exec_space>(0, state.extent(0)),
+    KOKKOS_LAMBDA(const ordinal_type& i) {
+      if (status(i) >= 0) {
+        for (ordinal_type k = 0; k < stateVecDim; ++k)
+          state(i, k) = 0;
+        mdot(i) = 0;
+      }
+    });
+}
+
+static inline void
+ReactorNetwork_SteadyStateSiteFractions(
+  const KineticModelConstDataDevice& kmcd,
+  const KineticSurfModelConstDataDevice& kmcdSurf,
+  const ordinal_type s,
+  const real_type_2d_view& state,
+  const real_type_2d_view& zSurf,
+  const ordinal_type_1d_view& status)
+{
+  const ordinal_type nBatch = state.extent(0);
+  auto policy = ReactorNetwork_CreatePolicy(
+    nBatch, SurfaceSteadyState::getWorkSpaceSize(kmcd, kmcdSurf));
+
+  real_type_1d_view tol_newton("tol newton surface", 2);
+  {
+    auto tol_newton_host = Kokkos::create_mirror_view(tol_newton);
+    tol_newton_host(0) = 1e-12;
+    tol_newton_host(1) = 1e-8;
+    Kokkos::deep_copy(tol_newton, tol_newton_host);
+  }
+  real_type_2d_view fac("fac surface", nBatch, kmcdSurf.nSpec);
+  ordinal_type_1d_view iter_count("iter count surface", nBatch);
+  ordinal_type_1d_view status_surface("status surface", nBatch);
+
+  const ordinal_type max_num_iterations(1000);
+  const real_type dt_init(1e-10), dt_max(1e3);
+  SurfaceSteadyState::runDeviceBatch(policy,
+                                     tol_newton,
+                                     max_num_iterations,
+                                     dt_init,
+                                     dt_max,
+                                     state,
+                                     zSurf,
+                                     zSurf,
+                                     fac,
+                                     iter_count,
+                                     status_surface,
+                                     kmcd,
+                                     kmcdSurf);
+
+  /// the stage cannot start from site fractions that did not converge
+  Kokkos::parallel_for(
+    "TChem::ReactorNetwork::SteadyStateSiteFractions::Status",
+    Kokkos::RangePolicy<exec_space>(0, nBatch),
+    KOKKOS_LAMBDA(const ordinal_type& i) {
+      if (status(i) < 0 &&
+          status_surface(i) != SurfaceSteadyState::status_type::Converged)
+        status(i) = s;
+    });
+}
+
+static void
+ReactorNetwork_AdvanceIgnitionZeroD(
+  const KineticModelConstDataDevice& kmcd,
+  const ordinal_type max_num_outer_iterations,
+  const real_type_1d_view& tol_newton,
+  const real_type_2d_view& tol_time,
+  const time_advance_type& tadv_default,
+  const ordinal_type s,
+  const ReactorNetworkStage& stage,
+  const real_type_2d_view& state,
+  const ordinal_type_1d_view& status)
+{
+  using problem_type = Impl::IgnitionZeroD_Problem<KineticModelConstDataDevice>;
+
+  const ordinal_type nBatch = state.extent(0);
+
+  auto policy =
+    ReactorNetwork_CreatePolicy(nBatch, IgnitionZeroD::getWorkSpaceSize(kmcd));
+  real_type_2d_view fac("fac", nBatch, problem_type::getNumberOfEquations(kmcd));
+
+  real_type_1d_view t, dt;
+  auto tadv = ReactorNetwork_CreateTimeAdvance(
+    nBatch, tadv_default, stage.tend, status, t, dt);
+
+  for (ordinal_type iter = 0; iter < max_num_outer_iterations; ++iter) {
+    IgnitionZeroD::runDeviceBatch(
+      policy, tol_newton, tol_time, fac, tadv, state, t, dt, state, kmcd);
+    if (ReactorNetwork_CarryOver(tadv, t, dt, stage.tend, s, status) == 0)
+      break;
+  }
+}
+
+static void
+ReactorNetwork_AdvancePlugFlowReactor(
+  const KineticModelConstDataDevice& kmcd,
+  const KineticSurfModelConstDataDevice& kmcdSurf,
+  const ordinal_type max_num_outer_iterations,
+  const real_type_1d_view& tol_newton,
+  const real_type_2d_view& tol_time,
+  const time_advance_type& tadv_default,
+  const ordinal_type s,
+  const ReactorNetworkStage& stage,
+  const real_type_2d_view& state,
+  const real_type_1d_view& mdot,
+  const ordinal_type_1d_view& status)
+{
+  using problem_type =
+    Impl::PlugFlowReactor_Problem<KineticModelConstDataDevice,
+                                  KineticSurfModelConstDataDevice,
+                                  pfr_data_type>;
+
+  const ordinal_type nBatch = state.extent(0);
+  const real_type Area = stage.Area;
+  const auto zSurf = stage.zSurf;
+
+  /// inlet velocity from the mass flow rate of the sample
+  real_type_1d_view velocity("velocity", nBatch);
+  Kokkos::parallel_for(
+    "TChem::ReactorNetwork::PlugFlowReactor::Inlet",
+    Kokkos::RangePolicy<exec_space>(0, nBatch),
+    KOKKOS_LAMBDA(const ordinal_type& i) {
+      velocity(i) = status(i) < 0 ? mdot(i) / (state(i, 0) * Area) : 0;
+    });
+
+  if (stage.steady_state_site_fractions)
+    ReactorNetwork_SteadyStateSiteFractions(
+      kmcd, kmcdSurf, s, state, zSurf, status);
+
+  pfr_data_type pfrd;
+  pfrd.Area = stage.Area;
+  pfrd.Pcat = stage.Pcat;
+
+  auto policy = ReactorNetwork_CreatePolicy(
+    nBatch, PlugFlowReactor::getWorkSpaceSize(kmcd, kmcdSurf, pfrd));
+  real_type_2d_view fac(
+    "fac", nBatch, problem_type::getNumberOfEquations(kmcd, kmcdSurf));
+
+  real_type_1d_view t, dt;
+  auto tadv = ReactorNetwork_CreateTimeAdvance(
+    nBatch, tadv_default, stage.tend, status, t, dt);
+
+  for (ordinal_type iter = 0; iter < max_num_outer_iterations; ++iter) {
+    PlugFlowReactor::runDeviceBatch(policy,
+                                    tol_newton,
+                                    tol_time,
+                                    fac,
+                                    tadv,
+                                    state,
+                                    zSurf,
+                                    velocity,
+                                    t,
+                                    dt,
+                                    state,
+                                    zSurf,
+                                    velocity,
+                                    kmcd,
+                                    kmcdSurf,
+                                    stage.Area,
+                                    stage.Pcat);
+    if (ReactorNetwork_CarryOver(tadv, t, dt, stage.tend, s, status) == 0)
+      break;
+  }
+
+  /// surface reactions exchange mass with the gas
+  Kokkos::parallel_for(
+    "TChem::ReactorNetwork::PlugFlowReactor::Outlet",
+    Kokkos::RangePolicy<exec_space>(0, nBatch),
+    KOKKOS_LAMBDA(const ordinal_type& i) {
+      mdot(i) = state(i, 0) * velocity(i) * Area;
+    });
+}
+
+static void
+ReactorNetwork_AdvanceTransientContStirredTankReactor(
+  const KineticModelConstDataDevice& kmcd,
+  const KineticSurfModelConstDataDevice& kmcdSurf,
+  const ordinal_type max_num_outer_iterations,
+  const real_type_1d_view& tol_newton,
+  const real_type_2d_view& tol_time,
+  const time_advance_type& tadv_default,
+  const ordinal_type s,
+  const ReactorNetworkStage& stage,
+  const real_type_2d_view& state,
+  const real_type_1d_view& mdot,
+  const ordinal_type_1d_view& status)
+{
+  using problem_type =
+    Impl::TransientContStirredTankReactor_Problem<
+      KineticModelConstDataDevice,
+      KineticSurfModelConstDataDevice,
+      cstr_data_type>;
+
+  const ordinal_type nBatch = state.extent(0);
+  const auto zSurf = stage.zSurf;
+
+  /// the outlet of the previous stage is the inlet of the sample
+  real_type_2d_view Yi("mass fraction at inlet", nBatch, kmcd.nSpec);
+  real_type_1d_view EnthalpyIn("enthalpy at inlet", nBatch);
+  Kokkos::deep_copy(
+    Yi,
+    Kokkos::subview(
+      state, Kokkos::ALL(), Kokkos::pair<ordinal_type, ordinal_type>(
+                              3, 3 + kmcd.nSpec)));
+  {
+    auto policy = ReactorNetwork_CreatePolicy(
+      nBatch, ThermalProperties::getWorkSpaceSize(kmcd));
+    ThermalProperties::runDeviceBatch(policy,
+                                      ThermalProperties::EnthalpyMixture,
+                                      state,
+                                      real_type_2d_view(),
+                                      real_type_1d_view(),
+                                      real_type_2d_view(),
+                                      real_type_1d_view(),
+                                      real_type_2d_view(),
+                                      EnthalpyIn,
+                                      real_type_2d_view(),
+                                      real_type_1d_view(),
+                                      real_type_2d_view(),
+                                      real_type_1d_view(),
+                                      kmcd);
+  }
+
+  if (stage.steady_state_site_fractions)
+    ReactorNetwork_SteadyStateSiteFractions(
+      kmcd, kmcdSurf, s, state, zSurf, status);
+
+  /// inlet of cstr is replaced by the sample specific inlet
+  cstr_data_type cstr;
+  cstr.mdotIn = 0;
+  cstr.Vol = stage.Vol;
+  cstr.Acat = stage.Acat;
+  cstr.pressure = 0;
+  cstr.EnthalpyIn = 0;
+
+  auto policy = ReactorNetwork_CreatePolicy(
+    nBatch,
+    TransientContStirredTankReactor::getWorkSpaceSize(kmcd, kmcdSurf, cstr));
+  real_type_2d_view fac(
+    "fac", nBatch, problem_type::getNumberOfEquations(kmcd, kmcdSurf));
+
+  real_type_1d_view t, dt;
+  auto tadv = ReactorNetwork_CreateTimeAdvance(
+    nBatch, tadv_default, stage.tend, status, t, dt);
+
+  for (ordinal_type iter = 0; iter < max_num_outer_iterations; ++iter) {
+    TransientContStirredTankReactor::runDeviceBatch(policy,
+                                                    tol_newton,
+                                                    tol_time,
+                                                    fac,
+                                                    tadv,
+                                                    state,
+                                                    zSurf,
+                                                    mdot,
+                                                    Yi,
+                                                    EnthalpyIn,
+                                                    t,
+                                                    dt,
+                                                    state,
+                                                    zSurf,
+                                                    kmcd,
+                                                    kmcdSurf,
+                                                    cstr);
+    if (ReactorNetwork_CarryOver(tadv, t, dt, stage.tend, s, status) == 0)
+      break;
+  }
+
+  /// the reactor is at constant pressure; density follows the outlet
+  /// temperature and composition
+  const ordinal_type nSpec = kmcd.nSpec;
+  const auto sMass = kmcd.sMass;
+  const real_type Runiv = kmcd.Runiv;
+  Kokkos::parallel_for(
+    "TChem::ReactorNetwork::TransientContStirredTankReactor::Outlet",
+    Kokkos::RangePolicy<exec_space>(0, nBatch),
+    KOKKOS_LAMBDA(const ordinal_type& i) {
+      if (status(i) < 0) {
+        real_type Ysum(0);
+        for (ordinal_type k = 0; k < nSpec; ++k)
+          Ysum += state(i, k + 3) / sMass(k);
+        state(i, 0) = state(i, 1) / (Runiv * Ysum * state(i, 2));
+      }
+    });
+}
+
+ReactorNetwork::ReactorNetwork(const KineticModelConstDataDevice& kmcd,
+                               const KineticSurfModelConstDataDevice& kmcdSurf,
+                               const ordinal_type nBatch,
+                               const real_type atol_newton,
+                               const real_type rtol_newton,
+                               const real_type atol_time,
+                               const real_type rtol_time,
+                               const time_advance_type& tadv_default,
+                               const ordinal_type max_num_outer_iterations)
+  : _kmcd(kmcd)
+  , _kmcdSurf(kmcdSurf)
+  , _nBatch(nBatch)
+  , _max_num_outer_iterations(max_num_outer_iterations)
+  , _atol_newton(atol_newton)
+  , _rtol_newton(rtol_newton)
+  , _atol_time(atol_time)
+  , _rtol_time(rtol_time)
+  , _tadv_default(tadv_default)
+{}
+
+ordinal_type
+ReactorNetwork::addStage(const ReactorNetworkStage& stage)
+{
+  const bool is_surface_stage =
+    stage.type == ReactorNetworkStage::PlugFlowReactor ||
+    stage.type == ReactorNetworkStage::TransientContStirredTankReactor;
+  TCHEM_CHECK_ERROR(stage.type < ReactorNetworkStage::IgnitionZeroD ||
+                      stage.type >
+                        ReactorNetworkStage::TransientContStirredTankReactor,
+                    "Error: ReactorNetwork stage type is not valid");
+  TCHEM_CHECK_ERROR(is_surface_stage &&
+                      (ordinal_type(stage.zSurf.extent(0)) != _nBatch ||
+                       ordinal_type(stage.zSurf.extent(1)) != _kmcdSurf.nSpec),
+                    "Error: ReactorNetwork stage site fractions are not "
+                    "sized by nBatch x kmcdSurf.nSpec");
+
+  _stages.push_back(stage);
+  _outlets.push_back(real_type_2d_view(
+    "outlet state", _nBatch, Impl::getStateVectorSize(_kmcd.nSpec)));
+  return _stages.size() - 1;
+}
+
+void
+ReactorNetwork::execute(const real_type_2d_view& state,
+                        const real_type_1d_view& mdot,
+                        const ordinal_type_1d_view& status)
+{
+  TCHEM_CHECK_ERROR(ordinal_type(status.extent(0)) != _nBatch,
+                    "Error: ReactorNetwork status is not sized by nBatch");
+
+  Kokkos::Profiling::pushRegion("TChem::ReactorNetwork::execute");
+  Kokkos::deep_copy(status, -1);
+  for (ordinal_type s = 0, send = _stages.size(); s < send; ++s) {
+    const auto& stage = _stages[s];
+    switch (stage.type) {
+      case ReactorNetworkStage::IgnitionZeroD: {
+        using problem_type =
+          Impl::IgnitionZeroD_Problem<KineticModelConstDataDevice>;
+        real_type_1d_view tol_newton;
+        real_type_2d_view tol_time;
+        ReactorNetwork_CreateTolerence(_atol_newton,
+                                       _rtol_newton,
+                                       _atol_time,
+                                       _rtol_time,
+                                       problem_type::getNumberOfTimeODEs(_kmcd),
+                                       tol_newton,
+                                       tol_time);
+        ReactorNetwork_AdvanceIgnitionZeroD(_kmcd,
+                                            _max_num_outer_iterations,
+                                            tol_newton,
+                                            tol_time,
+                                            _tadv_default,
+                                            s,
+                                            stage,
+                                            state,
+                                            status);
+        break;
+      }
+      case ReactorNetworkStage::PlugFlowReactor: {
+        using problem_type =
+          Impl::PlugFlowReactor_Problem<KineticModelConstDataDevice,
+                                        KineticSurfModelConstDataDevice,
+                                        pfr_data_type>;
+        real_type_1d_view tol_newton;
+        real_type_2d_view tol_time;
+        ReactorNetwork_CreateTolerence(_atol_newton,
+                                       _rtol_newton,
+                                       _atol_time,
+                                       _rtol_time,
+                                       problem_type::getNumberOfTimeODEs(_kmcd),
+                                       tol_newton,
+                                       tol_time);
+        ReactorNetwork_AdvancePlugFlowReactor(_kmcd,
+                                              _kmcdSurf,
+                                              _max_num_outer_iterations,
+                                              tol_newton,
+                                              tol_time,
+                                              _tadv_default,
+                                              s,
+                                              stage,
+                                              state,
+                                              mdot,
+                                              status);
+        break;
+      }
+      case ReactorNetworkStage::TransientContStirredTankReactor: {
+        using problem_type = Impl::TransientContStirredTankReactor_Problem<
+          KineticModelConstDataDevice,
+          KineticSurfModelConstDataDevice,
+          cstr_data_type>;
+        real_type_1d_view tol_newton;
+        real_type_2d_view tol_time;
+        ReactorNetwork_CreateTolerence(
+          _atol_newton,
+          _rtol_newton,
+          _atol_time,
+          _rtol_time,
+          problem_type::getNumberOfTimeODEs(_kmcd, _kmcdSurf),
+          tol_newton,
+          tol_time);
+        ReactorNetwork_AdvanceTransientContStirredTankReactor(
+          _kmcd,
+          _kmcdSurf,
+          _max_num_outer_iterations,
+          tol_newton,
+          tol_time,
+          _tadv_default,
+          s,
+          stage,
+          state,
+          mdot,
+          status);
+        break;
+      }
+    }
+    ReactorNetwork_ClearFailedSamples(state, mdot, status);
+    Kokkos::deep_copy(_outlets[s], state);
+  }
+  Kokkos::Profiling::popRegion();
+}
+
+} // namespace TChem
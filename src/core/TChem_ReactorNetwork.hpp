@@ -0,0 +1,132 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_REACTOR_NETWORK_HPP__
+#define __TCHEM_REACTOR_NETWORK_HPP__
+
+#include "TChem_KineticModelData.hpp"
+#include "TChem_Util.hpp"
+
+#include "TChem_PlugFlowReactor.hpp"
+#include "TChem_TransientContStirredTankReactor.hpp"
+
+namespace TChem {
+
+/// a reactor in a network; the outlet of a stage is the inlet of the next
+struct ReactorNetworkStage
+{
+  enum : ordinal_type
+  {
+    IgnitionZeroD = 0,
+    PlugFlowReactor = 1,
+    TransientContStirredTankReactor = 2
+  };
+
+  ordinal_type type;
+  /// end of the stage; residence time [s] of IgnitionZeroD, time [s] the
+  /// stirred tank is advanced to and length [m] of the plug flow reactor
+  real_type tend;
+  /// plug flow reactor; cross sectional area [m2] and catalytic perimeter [m]
+  real_type Area, Pcat;
+  /// stirred tank; volume [m3] and catalytic area [m2]
+  real_type Vol, Acat;
+  /// initial site fractions (nBatch, kmcdSurf.nSpec); PlugFlowReactor and
+  /// TransientContStirredTankReactor only. the view is advanced in place
+  real_type_2d_view zSurf;
+  /// if true, the site fractions are replaced by the steady state for the
+  /// inlet gas (SurfaceSteadyState) before the stage is advanced
+  bool steady_state_site_fractions;
+
+  ReactorNetworkStage()
+    : type(IgnitionZeroD)
+    , tend(0)
+    , Area(0)
+    , Pcat(0)
+    , Vol(0)
+    , Acat(0)
+    , zSurf()
+    , steady_state_site_fractions(true)
+  {}
+};
+
+/// Series of reactors advanced for a batch of operating conditions; a stage
+/// advances all samples in batched launches and the outlet state is handed
+/// to the next stage in device memory
+/// - the state vector is (density, pressure, temperature, mass fractions)
+///   and the mass flow rate [kg/s] of a sample is carried between stages
+/// - stirred tank stages use the outlet of the previous stage as the inlet
+///   of the sample and as the initial reactor content
+class ReactorNetwork
+{
+private:
+  KineticModelConstDataDevice _kmcd;
+  KineticSurfModelConstDataDevice _kmcdSurf;
+  ordinal_type _nBatch, _max_num_outer_iterations;
+  real_type _atol_newton, _rtol_newton, _atol_time, _rtol_time;
+  time_advance_type _tadv_default;
+
+  std::vector<ReactorNetworkStage> _stages;
+  std::vector<real_type_2d_view> _outlets;
+
+public:
+  /// tadv_default - _dt (initial), _dtmin, _dtmax and iteration counts used
+  ///   by all stages; _tbeg and _tend are set by the stage
+  /// max_num_outer_iterations - maximum number of batch launches per stage
+  ReactorNetwork(const KineticModelConstDataDevice& kmcd,
+                 const KineticSurfModelConstDataDevice& kmcdSurf,
+                 const ordinal_type nBatch,
+                 const real_type atol_newton,
+                 const real_type rtol_newton,
+                 const real_type atol_time,
+                 const real_type rtol_time,
+                 const time_advance_type& tadv_default,
+                 const ordinal_type max_num_outer_iterations = 1000);
+
+  /// appends a stage and returns its index
+  ordinal_type addStage(const ReactorNetworkStage& stage);
+
+  ordinal_type getNumberOfStages() const { return _stages.size(); }
+
+  const ReactorNetworkStage& getStage(const ordinal_type s) const
+  {
+    return _stages[s];
+  }
+
+  /// outlet state vectors (nBatch, stateVecDim) of a stage after execute
+  real_type_2d_view getOutletState(const ordinal_type s) const
+  {
+    return _outlets[s];
+  }
+
+  /// state (nBatch, stateVecDim) - inlet of the first stage; overwritten by
+  ///   the outlet of the last stage
+  /// mdot (nBatch) - inlet mass flow rate; overwritten by the outlet
+  /// status (nBatch) - -1 when the sample passes all stages; otherwise the
+  ///   first stage where the time integration or the steady state site
+  ///   fractions fail. later stages skip the sample and its state and mass
+  ///   flow rate are zero from that stage on
+  void execute(const real_type_2d_view& state,
+               const real_type_1d_view& mdot,
+               const ordinal_type_1d_view& status);
+};
+
+} // namespace TChem
+
+#endif
@@ -0,0 +1,131 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+/// memory mapped files
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "TChem_SampleFileReader.hpp"
+
+namespace TChem {
+namespace Test {
+
+ordinal_type
+SampleFileReader::countLines(const char* begin, const char* end)
+{
+  ordinal_type n(0);
+  for (const char* p = begin; p < end; p = nextLine(p, end)) {
+    const char* q = p;
+    while (q < end && isBlank(*q))
+      ++q;
+    n += (q < end && *q != '\n');
+  }
+  return n;
+}
+
+SampleFileReader::SampleFileReader(const std::string& filename)
+  : _filename(filename)
+  , _data(nullptr)
+  , _size(0)
+  , _mapped(false)
+{
+#if defined(__unix__) || defined(__APPLE__)
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    struct stat sb;
+    if (fstat(fd, &sb) == 0 && sb.st_size > 0) {
+      void* ptr = mmap(nullptr, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (ptr != MAP_FAILED) {
+        _data = static_cast<const char*>(ptr);
+        _size = sb.st_size;
+        _mapped = true;
+        madvise(ptr, _size, MADV_SEQUENTIAL);
+      }
+    }
+    close(fd);
+  }
+#endif
+  if (!_mapped) {
+    std::ifstream file(filename, std::ios::binary);
+    if (file.is_open()) {
+      _buffer.assign(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+      _data = _buffer.data();
+      _size = _buffer.size();
+    }
+  }
+  if (_data == nullptr)
+    return;
+
+  const char* end = _data + _size;
+
+  /// header
+  const char* body = nextLine(_data, end);
+  {
+    std::istringstream iss(std::string(_data, body));
+    std::string varname;
+    while (iss >> varname)
+      _varnames.push_back(varname);
+  }
+
+  /// line aligned chunks
+  const ordinal_type nChunks =
+    std::max(1, 4 * ordinal_type(host_exec_space::concurrency()));
+  const size_t nBody = end - body;
+  _chunks.push_back(body);
+  for (ordinal_type c = 1; c < nChunks; ++c) {
+    const char* p = body + (nBody * c) / nChunks;
+    p = p > body && *(p - 1) == '\n' ? p : nextLine(p, end);
+    if (p > _chunks.back())
+      _chunks.push_back(p);
+  }
+  _chunks.push_back(end);
+
+  /// sample offsets of chunks
+  const ordinal_type n = _chunks.size() - 1;
+  _offsets.assign(n + 1, 0);
+  {
+    const auto chunks = _chunks.data();
+    const auto offsets = _offsets.data();
+    Kokkos::parallel_for(
+      Kokkos::RangePolicy<host_exec_space>(0, n),
+      [=](const ordinal_type& c) {
+        offsets[c + 1] = countLines(chunks[c], chunks[c + 1]);
+      });
+    Kokkos::fence();
+  }
+  for (ordinal_type c = 0; c < n; ++c)
+    _offsets[c + 1] += _offsets[c];
+}
+
+SampleFileReader::~SampleFileReader()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  if (_mapped)
+    munmap(const_cast<char*>(_data), _size);
+#endif
+}
+
+} // namespace Test
+} // namespace TChem
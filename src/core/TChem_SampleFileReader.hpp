@@ -0,0 +1,344 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_SAMPLE_FILE_READER_HPP__
+#define __TCHEM_SAMPLE_FILE_READER_HPP__
+
+#include "TChem_Util.hpp"
+
+namespace TChem {
+namespace Test {
+
+///
+/// Sample file reader
+/// - the first line lists variable names and each following line holds
+///   one sample
+/// - the file is memory mapped and split into line aligned chunks; the
+///   chunks are counted and parsed in parallel with the host exec space
+/// - host only; readSample, readSurfaceSample and readInput below use it
+///
+class SampleFileReader
+{
+private:
+  std::string _filename;
+  const char* _data;
+  size_t _size;
+  bool _mapped;
+  std::vector<char> _buffer;
+
+  std::vector<std::string> _varnames;
+  std::vector<const char*> _chunks;
+  std::vector<ordinal_type> _offsets;
+
+  static bool isBlank(const char c)
+  {
+    return c == ' ' || c == '\t' || c == '\r';
+  }
+
+  /// pointer to the beginning of the next line
+  static const char* nextLine(const char* p, const char* end)
+  {
+    while (p < end && *p != '\n')
+      ++p;
+    return p < end ? p + 1 : end;
+  }
+
+  /// number of samples in [begin, end); blank lines are ignored
+  static ordinal_type countLines(const char* begin, const char* end);
+
+public:
+  SampleFileReader(const std::string& filename);
+  ~SampleFileReader();
+
+  SampleFileReader(const SampleFileReader&) = delete;
+  SampleFileReader& operator=(const SampleFileReader&) = delete;
+
+  bool isOpen() const { return _data != nullptr; }
+  const std::vector<std::string>& getVariableNames() const
+  {
+    return _varnames;
+  }
+  ordinal_type getNumberOfSamples() const
+  {
+    return _offsets.empty() ? 0 : _offsets.back();
+  }
+
+  /// parse samples [row_begin, row_begin + values.extent(0)) in chunk c;
+  /// returns the number of samples that do not have columns.size() values
+  template<typename RealType2DViewHostType>
+  static ordinal_type parseChunk(const char* begin,
+                                 const char* end,
+                                 const ordinal_type offset,
+                                 const ordinal_type* columns,
+                                 const ordinal_type nVars,
+                                 const ordinal_type row_begin,
+                                 const RealType2DViewHostType& values)
+  {
+    const ordinal_type row_end = row_begin + values.extent(0);
+    ordinal_type err(0), i(offset);
+    for (const char* p = begin; p < end && i < row_end;) {
+      const bool is_active = i >= row_begin;
+      ordinal_type j(0);
+      while (p < end && *p != '\n') {
+        while (p < end && isBlank(*p))
+          ++p;
+        if (p == end || *p == '\n')
+          break;
+        /// copy the token as the mapped file is not null terminated
+        char token[64];
+        ordinal_type len(0);
+        while (p < end && !isBlank(*p) && *p != '\n') {
+          if (len < 63)
+            token[len++] = *p;
+          ++p;
+        }
+        token[len] = '\0';
+        if (is_active && j < nVars && columns[j] >= 0)
+          values(i - row_begin, columns[j]) = std::strtod(token, nullptr);
+        ++j;
+      }
+      p = nextLine(p, end);
+      if (j > 0) {
+        err += is_active && (j != nVars);
+        ++i;
+      }
+    }
+    return err;
+  }
+
+  /// values(i,columns[j]) = j-th value of (row_begin+i)-th sample;
+  /// columns[j] < 0 skips the variable. Samples beyond values.extent(0) are
+  /// not read. Chunks are parsed in parallel with the host exec space unless
+  /// is_parallel is false e.g., when it is called from a std::thread.
+  template<typename RealType2DViewHostType>
+  void read(const std::vector<ordinal_type>& columns,
+            const RealType2DViewHostType& values,
+            const ordinal_type row_begin = 0,
+            const bool is_parallel = true) const
+  {
+    const ordinal_type n = _chunks.size() - 1;
+    if (n <= 0)
+      return;
+
+    const ordinal_type nVars = columns.size();
+    const ordinal_type row_end = row_begin + values.extent(0);
+    const auto chunks = _chunks.data();
+    const auto offsets = _offsets.data();
+    const auto cols = columns.data();
+    ordinal_type nErrors(0);
+    if (is_parallel) {
+      Kokkos::parallel_reduce(
+        Kokkos::RangePolicy<host_exec_space>(0, n),
+        [=](const ordinal_type& c, ordinal_type& err) {
+          if (offsets[c + 1] > row_begin && offsets[c] < row_end)
+            err += parseChunk(chunks[c],
+                              chunks[c + 1],
+                              offsets[c],
+                              cols,
+                              nVars,
+                              row_begin,
+                              values);
+        },
+        nErrors);
+    } else {
+      for (ordinal_type c = 0; c < n; ++c)
+        if (offsets[c + 1] > row_begin && offsets[c] < row_end)
+          nErrors += parseChunk(chunks[c],
+                                chunks[c + 1],
+                                offsets[c],
+                                cols,
+                                nVars,
+                                row_begin,
+                                values);
+    }
+    if (nErrors > 0)
+      printf("SampleFileReader: %d samples in %s do not have %d values\n",
+             nErrors,
+             _filename.c_str(),
+             nVars);
+  }
+};
+
+/// destination columns of the variables in a sample file; T and P are the
+/// first two variables and the others are species names
+template<typename StringViewHostType>
+static inline void
+getSampleColumns(const std::vector<std::string>& varnames,
+                 const StringViewHostType& speciesNamesHost,
+                 const ordinal_type& nSpec,
+                 const ordinal_type& first,
+                 const ordinal_type& offset,
+                 std::vector<ordinal_type>& columns,
+                 std::vector<ordinal_type>& indx)
+{
+  columns.assign(varnames.size(), -1);
+  indx.clear();
+  for (ordinal_type sp = first; sp < ordinal_type(varnames.size()); sp++) {
+    for (ordinal_type i = 0; i < nSpec; i++) {
+      if (strncmp(&speciesNamesHost(i, 0),
+                  (varnames[sp]).c_str(),
+                  LENGTHOFSPECNAME) == 0) {
+        columns[sp] = i + offset;
+        indx.push_back(i);
+        printf("species %s index %d \n", &speciesNamesHost(i, 0), i);
+        break;
+      }
+    }
+  }
+}
+
+template<typename StringViewHostType,
+         typename RealType2DViewHostType,
+         typename KCMDRealType1DViewHostType>
+static inline void
+readSample(const std::string& filename,
+           const StringViewHostType& speciesNamesHost,
+           const KCMDRealType1DViewHostType& sMass,
+           const ordinal_type& nSpec,
+           const ordinal_type& stateVecDim,
+           RealType2DViewHostType& state_host,
+           int& nBatch)
+{
+  const SampleFileReader reader(filename);
+  if (!reader.isOpen()) {
+    printf("readSample : Could not open %s -> Abort !\n", filename.c_str());
+    exit(1);
+  }
+  printf("readSample: Reading gas samples from %s\n", filename.c_str());
+
+  // temperature, pressure and mass fractions
+  std::vector<ordinal_type> columns, indx;
+  getSampleColumns(
+    reader.getVariableNames(), speciesNamesHost, nSpec, 2, 3, columns, indx);
+  if (columns.size() >= 2) {
+    columns[0] = 2;
+    columns[1] = 1;
+  }
+
+  nBatch = reader.getNumberOfSamples();
+  printf("Number of samples %d\n", nBatch);
+  /// input: state vectors: temperature, pressure and concentration
+  state_host = RealType2DViewHostType("StateVector", nBatch, stateVecDim);
+  reader.read(columns, state_host);
+
+  //
+  // 3. compute density
+
+  Kokkos::parallel_for(
+    Kokkos::RangePolicy<TChem::host_exec_space>(0, nBatch),
+    [&](const ordinal_type& i) {
+      const real_type_1d_view_host state_at_i =
+        Kokkos::subview(state_host, i, Kokkos::ALL());
+      //
+      const Impl::StateVector<real_type_1d_view_host> sv_at_i(nSpec,
+                                                              state_at_i);
+      const auto Ys = sv_at_i.MassFractions();
+      real_type Ysum(0);
+      for (ordinal_type sp = 0; sp < indx.size(); sp++)
+        Ysum += Ys(indx[sp]) / sMass(indx[sp]);
+
+      const real_type Runiv = RUNIV * 1.0e3;
+      sv_at_i.Density() =
+        sv_at_i.Pressure() / (Runiv * Ysum * sv_at_i.Temperature());
+    });
+}
+
+template<typename StringViewHostType, typename RealType2DViewHostType>
+static inline void
+readSurfaceSample(const std::string& filename,
+                  const StringViewHostType& speciesNamesHost,
+                  const ordinal_type& nSpec,
+                  RealType2DViewHostType& sitefraction_host,
+                  int& nBatch)
+{
+  const SampleFileReader reader(filename);
+  if (!reader.isOpen()) {
+    printf("readSurfaceSample: Could not open %s -> Abort !\n", filename.c_str());
+    exit(1);
+  }
+  printf("readSurfaceSample: Reading surface samples from %s\n", filename.c_str());
+
+  // site fractions
+  std::vector<ordinal_type> columns, indx;
+  getSampleColumns(
+    reader.getVariableNames(), speciesNamesHost, nSpec, 0, 0, columns, indx);
+
+  nBatch = reader.getNumberOfSamples();
+  printf("Number of samples %d\n", nBatch);
+  /// input: state vectors: temperature, pressure and concentration
+  sitefraction_host =
+    RealType2DViewHostType("Site fraction host", nBatch, nSpec);
+  reader.read(columns, sitefraction_host);
+}
+
+template<typename StringViewHostType,
+         typename RealType1DViewHostType,
+         typename KCMDRealType1DViewHostType>
+static inline void
+readInput(const std::string& filename,
+          const ordinal_type& nSpec,
+          const StringViewHostType& speciesNamesHost,
+          const KCMDRealType1DViewHostType& sMass,
+          const RealType1DViewHostType& stateVector)
+{
+  // read input file that contains: T, P and some species
+  // T P IC8H18 O2 N2 AR
+  // compute density and set state vector.
+
+  // 1.  get data from file
+  const SampleFileReader reader(filename);
+  std::vector<ordinal_type> columns, indx;
+  getSampleColumns(
+    reader.getVariableNames(), speciesNamesHost, nSpec, 2, 3, columns, indx);
+  if (columns.size() >= 2) {
+    columns[0] = 2;
+    columns[1] = 1;
+  }
+
+  const ordinal_type nBatch = reader.getNumberOfSamples();
+  printf("Number of samples %d\n", nBatch);
+
+  // 2. fill state vector with the first sample
+  Impl::StateVector<RealType1DViewHostType> sv(nSpec, stateVector);
+
+  if (sv.isValid()) {
+    real_type_2d_view_host first("first sample", 1, stateVector.extent(0));
+    for (ordinal_type k = 0, kend = stateVector.extent(0); k < kend; ++k)
+      first(0, k) = stateVector(k);
+    reader.read(columns, first);
+    for (ordinal_type k = 0, kend = stateVector.extent(0); k < kend; ++k)
+      stateVector(k) = first(0, k);
+  } else {
+    std::logic_error("Error: stateVector is not valid");
+  }
+  // 3. compute density
+  const auto Ys = sv.MassFractions();
+  real_type Ysum(0);
+  for (ordinal_type sp = 0; sp < indx.size(); sp++)
+    Ysum += Ys(indx[sp]) / sMass(indx[sp]);
+
+  const real_type Runiv = RUNIV * 1.0e3;
+  sv.Density() = sv.Pressure() / (Runiv * Ysum * sv.Temperature());
+}
+
+} // namespace Test
+} // namespace TChem
+
+#endif
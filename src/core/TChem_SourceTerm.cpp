@@ -25,9 +25,9 @@ namespace TChem {
 void
 SourceTerm::runDeviceBatch( /// input
   const ordinal_type nBatch,
-  const real_type_2d_view& state,
+  const real_type_2d_stride_view& state,
   /// output
-  const real_type_2d_view& SourceTerm,
+  const real_type_2d_stride_view& SourceTerm,
   /// const data from kinetic model
   const KineticModelConstDataDevice& kmcd)
 {
@@ -43,15 +43,24 @@ SourceTerm::runDeviceBatch( /// input
   policy_type policy(nBatch, Kokkos::AUTO()); // fine
   // policy_type policy(nBatch, Kokkos::AUTO(), Kokkos::AUTO()); // error
   policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+  /// strided rows are staged in scratch
+  const ordinal_type per_team_extent_stage =
+    Impl::getBatchRowWorkSpaceSize(state) +
+    Impl::getBatchRowWorkSpaceSize(SourceTerm);
   Kokkos::parallel_for(
     "TChem::SourceTerm::runDeviceBatch",
-    policy,
+    Impl::getBatchRowPolicy(policy, per_team_extent_stage),
     KOKKOS_LAMBDA(const typename policy_type::member_type& member) {
       const ordinal_type i = member.league_rank();
+      const auto kmcd_at_i = Impl::getKineticModelAtSample(kmcd, i);
+      Scratch<real_type_1d_view> stage(member.team_scratch(level),
+                                       per_team_extent_stage);
+      auto wstage = stage.data();
       const real_type_1d_view state_at_i =
-        Kokkos::subview(state, i, Kokkos::ALL());
-      const real_type_1d_view SourceTerm_at_i =
-        Kokkos::subview(SourceTerm, i, Kokkos::ALL());
+        Impl::getBatchRow<real_type_1d_view>(member, state, i, true, wstage);
+      const real_type_1d_view SourceTerm_at_i = Impl::getBatchRow<
+        real_type_1d_view>(member, SourceTerm, i, false, wstage);
 
       Scratch<real_type_1d_view> work(member.team_scratch(level),
                                       per_team_extent);
@@ -66,7 +75,8 @@ SourceTerm::runDeviceBatch( /// input
         const real_type_1d_view Ys = sv_at_i.MassFractions();
 
         Impl::SourceTerm ::team_invoke(
-          member, t, p, Ys, SourceTerm_at_i, work, kmcd);
+          member, t, p, Ys, SourceTerm_at_i, work, kmcd_at_i);
+        Impl::setBatchRow(member, SourceTerm_at_i, SourceTerm, i);
       }
     });
   Kokkos::Profiling::popRegion();
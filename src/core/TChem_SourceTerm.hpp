@@ -38,9 +38,9 @@ struct SourceTerm
 
   static void runDeviceBatch( /// input
     const ordinal_type nBatch,
-    const real_type_2d_view& state,
+    const real_type_2d_stride_view& state,
     /// output
-    const real_type_2d_view& SourceTerm,
+    const real_type_2d_stride_view& SourceTerm,
     /// const data from kinetic model
     const KineticModelConstDataDevice& kmcd);
 };
@@ -26,17 +26,19 @@ namespace Impl {
 template<typename PolicyType,
          typename RealType0DViewType,
          typename RealType1DViewType,
-         typename RealType2DViewType,
+         typename RealType1DBatchViewType,
+         typename RealType2DBatchViewType,
          typename KineticModelConstType>
 void
 SpecificHeatCapacityConsVolumePerMass_TemplateRun( /// required template arguments
   const std::string& profile_name,
   const RealType0DViewType& dummy_0d,
+  const RealType1DViewType& dummy_1d,
   /// team size setting
   const PolicyType& policy,
-  const RealType2DViewType& state,
+  const RealType2DBatchViewType& state,
   // outputFile
-  const RealType1DViewType& CvMixMass,
+  const RealType1DBatchViewType& CvMixMass,
   const KineticModelConstType& kmcd)
 {
   Kokkos::Profiling::pushRegion(profile_name);
@@ -44,20 +46,24 @@ SpecificHeatCapacityConsVolumePerMass_TemplateRun( /// required template argumen
   const ordinal_type level = 1; ///
   const ordinal_type per_team_extent =
     SpecificHeatCapacityConsVolumePerMass::getWorkSpaceSize(kmcd);
+  const ordinal_type per_team_extent_stage = getBatchRowWorkSpaceSize(state);
 
   Kokkos::parallel_for(
     profile_name,
-    policy,
+    getBatchRowPolicy(policy, per_team_extent_stage),
     KOKKOS_LAMBDA(const typename policy_type::member_type& member) {
       const ordinal_type i = member.league_rank();
+      Scratch<RealType1DViewType> stage(member.team_scratch(level),
+                                        per_team_extent_stage);
+      auto wstage = stage.data();
       const RealType1DViewType state_at_i =
-        Kokkos::subview(state, i, Kokkos::ALL());
+        getBatchRow<RealType1DViewType>(member, state, i, true, wstage);
       Scratch<RealType1DViewType> work(member.team_scratch(level),
                                          per_team_extent);
       auto w = (real_type*)work.data();
       auto cpks = RealType1DViewType(w, kmcd.nSpec);
       w += kmcd.nSpec;
-      const RealType0DViewType CvMixMass_at_i = Kokkos::subview(CvMixMass, i);
+      const RealType0DViewType CvMixMass_at_i(&CvMixMass(i));
 
       const Impl::StateVector<RealType1DViewType> sv_at_i(kmcd.nSpec,
                                                           state_at_i);
@@ -90,9 +96,9 @@ SpecificHeatCapacityConsVolumePerMass::runDeviceBatch( /// thread block size
   const ordinal_type vector_size,
   /// input
   const ordinal_type nBatch,
-  const real_type_2d_view& state,
+  const real_type_2d_stride_view& state,
   /// output
-  const real_type_1d_view& CvMixMass,
+  const real_type_1d_stride_view& CvMixMass,
   /// const data from kinetic model
   const KineticModelConstDataDevice& kmcd)
 {
@@ -116,6 +122,7 @@ SpecificHeatCapacityConsVolumePerMass::runDeviceBatch( /// thread block size
   Impl::SpecificHeatCapacityConsVolumePerMass_TemplateRun(
     "TChem::SpecificHeatCapacityConsVolumePerMass::runDeviceBatch",
     real_type_0d_view(),
+    real_type_1d_view(),
     /// team policy
     policy,
     state,
@@ -127,9 +134,9 @@ SpecificHeatCapacityConsVolumePerMass::runDeviceBatch( /// thread block size
 void
 SpecificHeatCapacityConsVolumePerMass::runDeviceBatch( /// thread block size
   typename UseThisTeamPolicy<exec_space>::type& policy,
-  const real_type_2d_view& state,
+  const real_type_2d_stride_view& state,
   /// output
-  const real_type_1d_view& CvMixMass,
+  const real_type_1d_stride_view& CvMixMass,
   /// const data from kinetic model
   const KineticModelConstDataDevice& kmcd)
 {
@@ -137,6 +144,7 @@ SpecificHeatCapacityConsVolumePerMass::runDeviceBatch( /// thread block size
   Impl::SpecificHeatCapacityConsVolumePerMass_TemplateRun(
     "TChem::SpecificHeatCapacityConsVolumePerMass::runDeviceBatch",
     real_type_0d_view(),
+    real_type_1d_view(),
     /// team policy
     policy,
     state,
@@ -147,9 +155,9 @@ SpecificHeatCapacityConsVolumePerMass::runDeviceBatch( /// thread block size
 void
 SpecificHeatCapacityConsVolumePerMass::runHostBatch( /// thread block size
   typename UseThisTeamPolicy<host_exec_space>::type& policy,
-  const real_type_2d_view_host& state,
+  const real_type_2d_stride_view_host& state,
   /// output
-  const real_type_1d_view_host& CvMixMass,
+  const real_type_1d_stride_view_host& CvMixMass,
   /// const data from kinetic model
   const KineticModelConstDataHost& kmcd)
 {
@@ -157,6 +165,7 @@ SpecificHeatCapacityConsVolumePerMass::runHostBatch( /// thread block size
   Impl::SpecificHeatCapacityConsVolumePerMass_TemplateRun(
     "TChem::SpecificHeatCapacityConsVolumePerMass::runHostBatch",
     real_type_0d_view_host(),
+    real_type_1d_view_host(),
     /// team policy
     policy,
     state,
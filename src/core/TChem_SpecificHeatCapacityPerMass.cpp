@@ -26,33 +26,42 @@ namespace Impl {
 template<typename PolicyType,
          typename RealType0DViewType,
          typename RealType1DViewType,
-         typename RealType2DViewType,
+         typename RealType1DBatchViewType,
+         typename RealType2DBatchViewType,
          typename KineticModelConstType>
 void
 SpecificHeatCapacityPerMass_TemplateRun( /// required template arguments
   const std::string& profile_name,
   const RealType0DViewType& dummy_0d,
+  const RealType1DViewType& dummy_1d,
   /// team size setting
   const PolicyType& policy,
-  const RealType2DViewType& state,
+  const RealType2DBatchViewType& state,
   // outputFile
-  const RealType2DViewType& CpMass,
-  const RealType1DViewType& CpMixMass,
+  const RealType2DBatchViewType& CpMass,
+  const RealType1DBatchViewType& CpMixMass,
   const KineticModelConstType& kmcd)
 {
   Kokkos::Profiling::pushRegion(profile_name);
   using policy_type = PolicyType;
 
+  const ordinal_type level = 1;
+  const ordinal_type per_team_extent_stage =
+    getBatchRowWorkSpaceSize(state) + getBatchRowWorkSpaceSize(CpMass);
+
   Kokkos::parallel_for(
     profile_name,
-    policy,
+    getBatchRowPolicy(policy, per_team_extent_stage),
     KOKKOS_LAMBDA(const typename policy_type::member_type& member) {
       const ordinal_type i = member.league_rank();
+      Scratch<RealType1DViewType> stage(member.team_scratch(level),
+                                        per_team_extent_stage);
+      auto wstage = stage.data();
       const RealType1DViewType state_at_i =
-        Kokkos::subview(state, i, Kokkos::ALL());
+        getBatchRow<RealType1DViewType>(member, state, i, true, wstage);
       const RealType1DViewType CpMass_at_i =
-        Kokkos::subview(CpMass, i, Kokkos::ALL());
-      const RealType0DViewType CpMixMass_at_i = Kokkos::subview(CpMixMass, i);
+        getBatchRow<RealType1DViewType>(member, CpMass, i, false, wstage);
+      const RealType0DViewType CpMixMass_at_i(&CpMixMass(i));
 
       const Impl::StateVector<RealType1DViewType> sv_at_i(kmcd.nSpec,
                                                           state_at_i);
@@ -65,6 +74,7 @@ SpecificHeatCapacityPerMass_TemplateRun( /// required template arguments
 
         CpMixMass_at_i() =
           Impl::CpMixMs ::team_invoke(member, t, Ys, CpMass_at_i, kmcd);
+        setBatchRow(member, CpMass_at_i, CpMass, i);
       }
     });
   Kokkos::Profiling::popRegion();
@@ -75,10 +85,10 @@ SpecificHeatCapacityPerMass_TemplateRun( /// required template arguments
 void
 SpecificHeatCapacityPerMass::runDeviceBatch( /// thread block size
   typename UseThisTeamPolicy<exec_space>::type& policy,
-  const real_type_2d_view& state,
+  const real_type_2d_stride_view& state,
   /// output
-  const real_type_2d_view& CpMass,
-  const real_type_1d_view& CpMixMass,
+  const real_type_2d_stride_view& CpMass,
+  const real_type_1d_stride_view& CpMixMass,
   /// const data from kinetic model
   const KineticModelConstDataDevice& kmcd)
 {
@@ -86,6 +96,7 @@ SpecificHeatCapacityPerMass::runDeviceBatch( /// thread block size
   Impl::SpecificHeatCapacityPerMass_TemplateRun(
     "TChem::SpecificHeatCapacityPerMass::runDeviceBatch",
     real_type_0d_view(),
+    real_type_1d_view(),
     /// team policy
     policy,
     state,
@@ -97,10 +108,10 @@ SpecificHeatCapacityPerMass::runDeviceBatch( /// thread block size
 void
 SpecificHeatCapacityPerMass::runHostBatch( /// thread block size
   typename UseThisTeamPolicy<host_exec_space>::type& policy,
-  const real_type_2d_view_host& state,
+  const real_type_2d_stride_view_host& state,
   /// output
-  const real_type_2d_view_host& CpMass,
-  const real_type_1d_view_host& CpMixMass,
+  const real_type_2d_stride_view_host& CpMass,
+  const real_type_1d_stride_view_host& CpMixMass,
   /// const data from kinetic model
   const KineticModelConstDataHost& kmcd)
 {
@@ -108,6 +119,7 @@ SpecificHeatCapacityPerMass::runHostBatch( /// thread block size
   Impl::SpecificHeatCapacityPerMass_TemplateRun(
     "TChem::SpecificHeatCapacityPerMass::runDeviceBatch",
     real_type_0d_view_host(),
+    real_type_1d_view_host(),
     /// team policy
     policy,
     state,
@@ -36,20 +36,20 @@ struct SpecificHeatCapacityPerMass
 
   static void runDeviceBatch( /// thread block size
     typename UseThisTeamPolicy<exec_space>::type& policy,
-    const real_type_2d_view& state,
+    const real_type_2d_stride_view& state,
     /// output
-    const real_type_2d_view& CpMass,
-    const real_type_1d_view& CpMixMass,
+    const real_type_2d_stride_view& CpMass,
+    const real_type_1d_stride_view& CpMixMass,
     /// const data from kinetic model
     const KineticModelConstDataDevice& kmcd);
 
   //
   static void runHostBatch( /// thread block size
     typename UseThisTeamPolicy<host_exec_space>::type& policy,
-    const real_type_2d_view_host& state,
+    const real_type_2d_stride_view_host& state,
     /// output
-    const real_type_2d_view_host& CpMass,
-    const real_type_1d_view_host& CpMixMass,
+    const real_type_2d_stride_view_host& CpMass,
+    const real_type_1d_stride_view_host& CpMixMass,
     /// const data from kinetic model
     const KineticModelConstDataHost& kmcd);
 };
@@ -0,0 +1,72 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_SURFACE_STEADY_STATE_HPP__
+#define __TCHEM_SURFACE_STEADY_STATE_HPP__
+
+#include "TChem_KineticModelData.hpp"
+#include "TChem_Util.hpp"
+
+#include "TChem_Impl_SurfaceSteadyState.hpp"
+
+namespace TChem {
+
+struct SurfaceSteadyState
+{
+  using status_type = Impl::SurfaceSteadyStateStatus;
+
+  template<typename KineticModelConstDataType,
+           typename KineticSurfModelConstDataType>
+  static inline ordinal_type getWorkSpaceSize(
+    const KineticModelConstDataType& kmcd,
+    const KineticSurfModelConstDataType& kmcdSurf)
+  {
+    return Impl::SurfaceSteadyState::getWorkSpaceSize(kmcd, kmcdSurf);
+  }
+
+  /// tol_newton (2) - absolute and relative tolerence of the site fractions
+  /// dt_init - initial pseudo time step of the continuation
+  /// dt_max - pseudo time step from which plain newton steps are taken
+  /// state (nBatch, nSpec+3) - frozen gas phase
+  /// zSurf, Z_out (nBatch, kmcdSurf.nSpec) - initial guess and steady state
+  ///   site fractions; they can be the same view
+  /// iter_count, status (nBatch) - number of iterations and the convergence
+  ///   status (SurfaceSteadyState::status_type) of each sample
+  static void runDeviceBatch( /// input
+    const typename TChem::UseThisTeamPolicy<TChem::exec_space>::type& policy,
+    const real_type_1d_view& tol_newton,
+    const ordinal_type max_num_iterations,
+    const real_type dt_init,
+    const real_type dt_max,
+    const real_type_2d_view& state,
+    const real_type_2d_view& zSurf,
+    /// output
+    const real_type_2d_view& Z_out,
+    const real_type_2d_view& fac,
+    const ordinal_type_1d_view& iter_count,
+    const ordinal_type_1d_view& status,
+    /// const data from kinetic model
+    const KineticModelConstDataDevice& kmcd,
+    const KineticSurfModelConstDataDevice& kmcdSurf);
+};
+
+} // namespace TChem
+
+#endif
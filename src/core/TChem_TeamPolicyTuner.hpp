@@ -0,0 +1,271 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_TEAM_POLICY_TUNER_HPP__
+#define __TCHEM_TEAM_POLICY_TUNER_HPP__
+
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include "TChem_KineticModelData.hpp"
+#include "TChem_Util.hpp"
+
+namespace TChem {
+
+///
+/// Team policy tuner
+/// - times a short calibration batch for candidate (team_size, vector_size)
+///   pairs and keeps the fastest one
+/// - the winner is appended to a cache file keyed by the entry point name,
+///   the mechanism hash, the host name and the execution space; later runs
+///   read the file and skip the calibration
+/// - team_size = -1 means Kokkos::AUTO
+/// - the run functor launches a batch entry point with the given policy,
+///   e.g., [&](policy_type& p) { runDeviceBatch(p, state, omega, kmcd); };
+///   it is called with the calibration league size and should not modify
+///   its input in place
+///
+class TeamPolicyTuner
+{
+public:
+  struct Entry
+  {
+    ordinal_type team_size;
+    ordinal_type vector_size;
+    double seconds;
+  };
+
+private:
+  std::string _filename;
+  std::map<std::string, Entry> _cache;
+  ordinal_type _calibration_batch_size;
+  ordinal_type _num_repeats;
+  bool _verbose;
+
+public:
+  TeamPolicyTuner(const std::string& filename = "tchem-tuning.dat",
+                  const ordinal_type calibration_batch_size = 256,
+                  const ordinal_type num_repeats = 3,
+                  const bool verbose = false)
+    : _filename(filename)
+    , _calibration_batch_size(calibration_batch_size)
+    , _num_repeats(num_repeats)
+    , _verbose(verbose)
+  {
+    load();
+  }
+
+  /// read the cache file; later entries overwrite earlier ones
+  void load()
+  {
+    std::ifstream file(_filename);
+    if (!file.is_open())
+      return;
+    std::string line;
+    while (std::getline(file, line)) {
+      if (line.empty() || line[0] == '#')
+        continue;
+      std::istringstream iss(line);
+      std::string key;
+      Entry entry;
+      if (iss >> key >> entry.team_size >> entry.vector_size >> entry.seconds)
+        _cache[key] = entry;
+    }
+  }
+
+  /// append an entry to the cache file
+  void save(const std::string& key, const Entry& entry)
+  {
+    _cache[key] = entry;
+    std::ofstream file(_filename, std::ios::app);
+    if (!file.is_open()) {
+      printf("Warning: TeamPolicyTuner cannot open %s\n", _filename.c_str());
+      return;
+    }
+    file << key << " " << entry.team_size << " " << entry.vector_size << " "
+         << std::scientific << entry.seconds << "\n";
+  }
+
+  static std::string getHostName()
+  {
+#if defined(__unix__) || defined(__APPLE__)
+    char name[256] = {};
+    if (gethostname(name, sizeof(name) - 1) == 0 && name[0] != '\0')
+      return std::string(name);
+#endif
+    return std::string("unknown");
+  }
+
+  /// FNV-1a hash of the mechanism size, species masses, forward Arrhenius
+  /// parameters and stoichiometric coefficients
+  template<typename SpT>
+  static std::string getMechanismHash(const KineticModelConstData<SpT>& kmcd)
+  {
+    unsigned long long h = 14695981039346656037ULL;
+    auto hash = [&h](const void* ptr, const size_t n) {
+      const unsigned char* c = static_cast<const unsigned char*>(ptr);
+      for (size_t i = 0; i < n; ++i) {
+        h ^= c[i];
+        h *= 1099511628211ULL;
+      }
+    };
+    hash(&kmcd.nSpec, sizeof(kmcd.nSpec));
+    hash(&kmcd.nReac, sizeof(kmcd.nReac));
+
+    const auto sMass =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), kmcd.sMass);
+    const auto reacArhenFor = Kokkos::create_mirror_view_and_copy(
+      Kokkos::HostSpace(), kmcd.reacArhenFor);
+    const auto reacNuki =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), kmcd.reacNuki);
+    for (ordinal_type i = 0, iend = sMass.extent(0); i < iend; ++i)
+      hash(&sMass(i), sizeof(real_type));
+    for (ordinal_type i = 0, iend = reacArhenFor.extent(0); i < iend; ++i)
+      for (ordinal_type j = 0, jend = reacArhenFor.extent(1); j < jend; ++j)
+        hash(&reacArhenFor(i, j), sizeof(real_type));
+    for (ordinal_type i = 0, iend = reacNuki.extent(0); i < iend; ++i)
+      for (ordinal_type j = 0, jend = reacNuki.extent(1); j < jend; ++j)
+        hash(&reacNuki(i, j), sizeof(ordinal_type));
+
+    std::ostringstream oss;
+    oss << std::hex << std::setw(16) << std::setfill('0') << h;
+    return oss.str();
+  }
+
+  template<typename SpT>
+  static std::string getKey(const std::string& name,
+                            const KineticModelConstData<SpT>& kmcd)
+  {
+    std::string key =
+      name + ":" + getMechanismHash(kmcd) + ":" + getHostName() + ":" +
+      SpT::name();
+    std::replace(key.begin(), key.end(), ' ', '_');
+    return key;
+  }
+
+  /// candidate (team_size, vector_size) pairs
+  template<typename SpT>
+  static std::vector<std::pair<ordinal_type, ordinal_type>> getCandidates()
+  {
+    std::vector<std::pair<ordinal_type, ordinal_type>> r;
+    r.push_back(std::make_pair(-1, 1));
+    if (std::is_same<SpT, host_exec_space>::value) {
+      const ordinal_type concurrency = SpT::concurrency();
+      for (ordinal_type team = 1; team <= 8 && team <= concurrency; team *= 2)
+        r.push_back(std::make_pair(team, 1));
+    } else {
+      for (ordinal_type vector = 1; vector <= 32; vector *= 2) {
+        r.push_back(std::make_pair(-1, vector));
+        for (ordinal_type threads = 64; threads <= 256; threads *= 2)
+          r.push_back(std::make_pair(threads / vector, vector));
+      }
+    }
+    return r;
+  }
+
+  template<typename SpT>
+  static typename UseThisTeamPolicy<SpT>::type createPolicy(
+    const ordinal_type league_size,
+    const ordinal_type team_size,
+    const ordinal_type vector_size,
+    const ordinal_type per_team_scratch)
+  {
+    using policy_type = typename UseThisTeamPolicy<SpT>::type;
+    policy_type policy(SpT(), league_size, Kokkos::AUTO(), vector_size);
+    if (team_size > 0)
+      policy = policy_type(SpT(), league_size, team_size, vector_size);
+    const ordinal_type level = 1;
+    policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+    return policy;
+  }
+
+  /// return a tuned policy of league size nBatch; the candidates are timed
+  /// when the cache has no entry for this entry point and mechanism
+  template<typename SpT, typename RunType>
+  typename UseThisTeamPolicy<SpT>::type getPolicy(
+    const std::string& name,
+    const KineticModelConstData<SpT>& kmcd,
+    const ordinal_type nBatch,
+    const ordinal_type per_team_scratch,
+    const RunType& run)
+  {
+    using policy_type = typename UseThisTeamPolicy<SpT>::type;
+
+    const std::string key = getKey(name, kmcd);
+    const auto it = _cache.find(key);
+    if (it != _cache.end()) {
+      if (_verbose)
+        printf("TeamPolicyTuner: %s team size %d vector size %d (cached)\n",
+               key.c_str(),
+               it->second.team_size,
+               it->second.vector_size);
+      return createPolicy<SpT>(nBatch,
+                               it->second.team_size,
+                               it->second.vector_size,
+                               per_team_scratch);
+    }
+
+    const ordinal_type nCalibration = std::min(nBatch, _calibration_batch_size);
+    Entry best = { -1, 1, std::numeric_limits<double>::max() };
+
+    Kokkos::Impl::Timer timer;
+    for (const auto& candidate : getCandidates<SpT>()) {
+      double t_min = std::numeric_limits<double>::max();
+      try {
+        policy_type policy = createPolicy<SpT>(
+          nCalibration, candidate.first, candidate.second, per_team_scratch);
+        /// warm up
+        run(policy);
+        Kokkos::fence();
+        for (ordinal_type iter = 0; iter < _num_repeats; ++iter) {
+          timer.reset();
+          run(policy);
+          Kokkos::fence();
+          t_min = std::min(t_min, timer.seconds());
+        }
+      } catch (const std::exception&) {
+        /// the candidate is not valid for this device e.g., too large team
+        continue;
+      }
+      if (_verbose)
+        printf("TeamPolicyTuner: %s team size %d vector size %d %e [sec]\n",
+               key.c_str(),
+               candidate.first,
+               candidate.second,
+               t_min);
+      if (t_min < best.seconds) {
+        best.team_size = candidate.first;
+        best.vector_size = candidate.second;
+        best.seconds = t_min;
+      }
+    }
+    save(key, best);
+
+    return createPolicy<SpT>(
+      nBatch, best.team_size, best.vector_size, per_team_scratch);
+  }
+};
+
+} // namespace TChem
+
+#endif
@@ -0,0 +1,217 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#include "TChem_ThermalProperties.hpp"
+
+namespace TChem {
+
+namespace Impl {
+template<typename PolicyType,
+         typename RealType0DViewType,
+         typename RealType1DViewType,
+         typename RealType1DBatchViewType,
+         typename RealType2DBatchViewType,
+         typename KineticModelConstType>
+void
+ThermalProperties_TemplateRun( /// required template arguments
+  const std::string& profile_name,
+  const RealType0DViewType& dummy_0d,
+  const RealType1DViewType& dummy_1d,
+  /// team size setting
+  const PolicyType& policy,
+  const ordinal_type mask,
+  const RealType2DBatchViewType& state,
+  /// output
+  const RealType2DBatchViewType& CpMass,
+  const RealType1DBatchViewType& CpMixMass,
+  const RealType2DBatchViewType& CvMass,
+  const RealType1DBatchViewType& CvMixMass,
+  const RealType2DBatchViewType& EnthalpyMass,
+  const RealType1DBatchViewType& EnthalpyMixMass,
+  const RealType2DBatchViewType& EntropyMass,
+  const RealType1DBatchViewType& EntropyMixMass,
+  const RealType2DBatchViewType& InternalEnergyMass,
+  const RealType1DBatchViewType& InternalEnergyMixMass,
+  const KineticModelConstType& kmcd)
+{
+  Kokkos::Profiling::pushRegion(profile_name);
+  using policy_type = PolicyType;
+
+  const ordinal_type level = 1;
+  const ordinal_type per_team_extent =
+    ThermalProperties::getWorkSpaceSize(kmcd);
+
+  /// strided rows are staged in scratch
+  const ordinal_type per_team_extent_stage =
+    getBatchRowWorkSpaceSize(state) + getBatchRowWorkSpaceSize(CpMass) +
+    getBatchRowWorkSpaceSize(CvMass) + getBatchRowWorkSpaceSize(EnthalpyMass) +
+    getBatchRowWorkSpaceSize(EntropyMass) +
+    getBatchRowWorkSpaceSize(InternalEnergyMass);
+
+  Kokkos::parallel_for(
+    profile_name,
+    getBatchRowPolicy(policy, per_team_extent_stage),
+    KOKKOS_LAMBDA(const typename policy_type::member_type& member) {
+      const ordinal_type i = member.league_rank();
+
+      Scratch<RealType1DViewType> stage(member.team_scratch(level),
+                                        per_team_extent_stage);
+      auto wstage = stage.data();
+
+      /// outputs not requested are empty
+      auto species_at_i = [&](const RealType2DBatchViewType& v) {
+        return getBatchRow<RealType1DViewType>(member, v, i, false, wstage);
+      };
+      auto mixture_at_i = [&](const RealType1DBatchViewType& v) {
+        return v.extent(0) > 0 ? RealType0DViewType(&v(i))
+                               : RealType0DViewType();
+      };
+
+      const RealType1DViewType state_at_i =
+        getBatchRow<RealType1DViewType>(member, state, i, true, wstage);
+      const RealType1DViewType CpMass_at_i = species_at_i(CpMass),
+                               CvMass_at_i = species_at_i(CvMass),
+                               EnthalpyMass_at_i = species_at_i(EnthalpyMass),
+                               EntropyMass_at_i = species_at_i(EntropyMass),
+                               InternalEnergyMass_at_i =
+                                 species_at_i(InternalEnergyMass);
+
+      Scratch<RealType1DViewType> work(member.team_scratch(level),
+                                       per_team_extent);
+
+      const Impl::StateVector<RealType1DViewType> sv_at_i(kmcd.nSpec,
+                                                          state_at_i);
+      TCHEM_CHECK_ERROR(!sv_at_i.isValid(),
+                        "Error: input state vector is not valid");
+      {
+        const real_type t = sv_at_i.Temperature();
+        const RealType1DViewType Ys = sv_at_i.MassFractions();
+
+        Impl::ThermalProperties::team_invoke(
+          member,
+          mask,
+          t,
+          Ys,
+          CpMass_at_i,
+          mixture_at_i(CpMixMass),
+          CvMass_at_i,
+          mixture_at_i(CvMixMass),
+          EnthalpyMass_at_i,
+          mixture_at_i(EnthalpyMixMass),
+          EntropyMass_at_i,
+          mixture_at_i(EntropyMixMass),
+          InternalEnergyMass_at_i,
+          mixture_at_i(InternalEnergyMixMass),
+          work,
+          kmcd);
+
+        setBatchRow(member, CpMass_at_i, CpMass, i);
+        setBatchRow(member, CvMass_at_i, CvMass, i);
+        setBatchRow(member, EnthalpyMass_at_i, EnthalpyMass, i);
+        setBatchRow(member, EntropyMass_at_i, EntropyMass, i);
+        setBatchRow(member, InternalEnergyMass_at_i, InternalEnergyMass, i);
+      }
+    });
+  Kokkos::Profiling::popRegion();
+}
+
+} // namespace Impl
+
+void
+ThermalProperties::runDeviceBatch( /// thread block size
+  typename UseThisTeamPolicy<exec_space>::type& policy,
+  const ordinal_type mask,
+  const real_type_2d_stride_view& state,
+  /// output
+  const real_type_2d_stride_view& CpMass,
+  const real_type_1d_stride_view& CpMixMass,
+  const real_type_2d_stride_view& CvMass,
+  const real_type_1d_stride_view& CvMixMass,
+  const real_type_2d_stride_view& EnthalpyMass,
+  const real_type_1d_stride_view& EnthalpyMixMass,
+  const real_type_2d_stride_view& EntropyMass,
+  const real_type_1d_stride_view& EntropyMixMass,
+  const real_type_2d_stride_view& InternalEnergyMass,
+  const real_type_1d_stride_view& InternalEnergyMixMass,
+  /// const data from kinetic model
+  const KineticModelConstDataDevice& kmcd)
+{
+  Impl::ThermalProperties_TemplateRun(
+    "TChem::ThermalProperties::runDeviceBatch",
+    real_type_0d_view(),
+    real_type_1d_view(),
+    /// team policy
+    policy,
+    mask,
+    state,
+    CpMass,
+    CpMixMass,
+    CvMass,
+    CvMixMass,
+    EnthalpyMass,
+    EnthalpyMixMass,
+    EntropyMass,
+    EntropyMixMass,
+    InternalEnergyMass,
+    InternalEnergyMixMass,
+    kmcd);
+}
+
+void
+ThermalProperties::runHostBatch( /// thread block size
+  typename UseThisTeamPolicy<host_exec_space>::type& policy,
+  const ordinal_type mask,
+  const real_type_2d_stride_view_host& state,
+  /// output
+  const real_type_2d_stride_view_host& CpMass,
+  const real_type_1d_stride_view_host& CpMixMass,
+  const real_type_2d_stride_view_host& CvMass,
+  const real_type_1d_stride_view_host& CvMixMass,
+  const real_type_2d_stride_view_host& EnthalpyMass,
+  const real_type_1d_stride_view_host& EnthalpyMixMass,
+  const real_type_2d_stride_view_host& EntropyMass,
+  const real_type_1d_stride_view_host& EntropyMixMass,
+  const real_type_2d_stride_view_host& InternalEnergyMass,
+  const real_type_1d_stride_view_host& InternalEnergyMixMass,
+  /// const data from kinetic model
+  const KineticModelConstDataHost& kmcd)
+{
+  Impl::ThermalProperties_TemplateRun(
+    "TChem::ThermalProperties::runHostBatch",
+    real_type_0d_view_host(),
+    real_type_1d_view_host(),
+    /// team policy
+    policy,
+    mask,
+    state,
+    CpMass,
+    CpMixMass,
+    CvMass,
+    CvMixMass,
+    EnthalpyMass,
+    EnthalpyMixMass,
+    EntropyMass,
+    EntropyMixMass,
+    InternalEnergyMass,
+    InternalEnergyMixMass,
+    kmcd);
+}
+
+} // namespace TChem
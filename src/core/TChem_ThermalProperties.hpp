@@ -0,0 +1,83 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_THERMAL_PROPERTIES_HPP__
+#define __TCHEM_THERMAL_PROPERTIES_HPP__
+
+#include "TChem_KineticModelData.hpp"
+#include "TChem_Util.hpp"
+
+#include "TChem_Impl_ThermalProperties.hpp"
+
+namespace TChem {
+
+/// Fused evaluation of mass based cp, cv, h, s and u of species and mixture;
+/// mask is a combination of ThermalProperties::CpSpecies, CpMixture, ...,
+/// or ThermalProperties::All. Outputs not selected by the mask are not
+/// accessed and can be empty views. Batch views can be in any layout.
+struct ThermalProperties : public Impl::ThermalPropertiesMask
+{
+  template<typename KineticModelConstDataType>
+  static inline ordinal_type getWorkSpaceSize(
+    const KineticModelConstDataType& kmcd)
+  {
+    return Impl::ThermalProperties::getWorkSpaceSize(kmcd);
+  }
+
+  static void runDeviceBatch( /// thread block size
+    typename UseThisTeamPolicy<exec_space>::type& policy,
+    const ordinal_type mask,
+    const real_type_2d_stride_view& state,
+    /// output
+    const real_type_2d_stride_view& CpMass,
+    const real_type_1d_stride_view& CpMixMass,
+    const real_type_2d_stride_view& CvMass,
+    const real_type_1d_stride_view& CvMixMass,
+    const real_type_2d_stride_view& EnthalpyMass,
+    const real_type_1d_stride_view& EnthalpyMixMass,
+    const real_type_2d_stride_view& EntropyMass,
+    const real_type_1d_stride_view& EntropyMixMass,
+    const real_type_2d_stride_view& InternalEnergyMass,
+    const real_type_1d_stride_view& InternalEnergyMixMass,
+    /// const data from kinetic model
+    const KineticModelConstDataDevice& kmcd);
+
+  static void runHostBatch( /// thread block size
+    typename UseThisTeamPolicy<host_exec_space>::type& policy,
+    const ordinal_type mask,
+    const real_type_2d_stride_view_host& state,
+    /// output
+    const real_type_2d_stride_view_host& CpMass,
+    const real_type_1d_stride_view_host& CpMixMass,
+    const real_type_2d_stride_view_host& CvMass,
+    const real_type_1d_stride_view_host& CvMixMass,
+    const real_type_2d_stride_view_host& EnthalpyMass,
+    const real_type_1d_stride_view_host& EnthalpyMixMass,
+    const real_type_2d_stride_view_host& EntropyMass,
+    const real_type_1d_stride_view_host& EntropyMixMass,
+    const real_type_2d_stride_view_host& InternalEnergyMass,
+    const real_type_1d_stride_view_host& InternalEnergyMixMass,
+    /// const data from kinetic model
+    const KineticModelConstDataHost& kmcd);
+};
+
+} // namespace TChem
+
+#endif
@@ -0,0 +1,161 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#include "TChem_TrajectoryWriter.hpp"
+
+namespace TChem {
+
+namespace Impl {
+static inline bool
+isLittleEndian()
+{
+  const uint16_t one(1);
+  return *reinterpret_cast<const unsigned char*>(&one) == 1;
+}
+
+/// write n values of size sizeof(T) in little-endian byte order
+template<typename T>
+static inline void
+writeLittleEndian(FILE* fout, const T* values, const size_t n)
+{
+  if (isLittleEndian()) {
+    fwrite(values, sizeof(T), n, fout);
+  } else {
+    unsigned char buf[sizeof(T)];
+    for (size_t i = 0; i < n; ++i) {
+      const unsigned char* c =
+        reinterpret_cast<const unsigned char*>(values + i);
+      for (size_t j = 0; j < sizeof(T); ++j)
+        buf[j] = c[sizeof(T) - 1 - j];
+      fwrite(buf, sizeof(T), 1, fout);
+    }
+  }
+}
+} // namespace Impl
+
+TrajectoryWriter::TrajectoryWriter(const std::string& filename,
+                                   const std::vector<std::string>& names,
+                                   const bool use_background_thread)
+  : _fout(fopen(filename.c_str(), "wb"))
+  , _filename(filename)
+  , _ncolumns(names.size())
+  , _use_background_thread(use_background_thread)
+  , _done(false)
+{
+  if (_fout == nullptr) {
+    printf("TrajectoryWriter: Could not open %s\n", filename.c_str());
+    return;
+  }
+  writeHeader(names);
+  if (_use_background_thread)
+    _thread = std::thread(&TrajectoryWriter::run, this);
+}
+
+TrajectoryWriter::~TrajectoryWriter()
+{
+  close();
+}
+
+void
+TrajectoryWriter::writeHeader(const std::vector<std::string>& names)
+{
+  const char magic[8] = { 'T', 'C', 'H', 'E', 'M', 'T', 'R', 'J' };
+  fwrite(magic, 1, 8, _fout);
+  const uint32_t v(version), n(names.size());
+  Impl::writeLittleEndian(_fout, &v, 1);
+  Impl::writeLittleEndian(_fout, &n, 1);
+  for (const auto& name : names) {
+    const uint32_t len(name.size());
+    Impl::writeLittleEndian(_fout, &len, 1);
+    fwrite(name.data(), 1, len, _fout);
+  }
+}
+
+void
+TrajectoryWriter::writeChunk(const Chunk& chunk)
+{
+  Impl::writeLittleEndian(_fout, &chunk.nrows, 1);
+  Impl::writeLittleEndian(_fout, chunk.values.data(), chunk.values.size());
+}
+
+void
+TrajectoryWriter::run()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true) {
+    _cv.wait(lock, [this]() { return _done || !_queue.empty(); });
+    if (_queue.empty() && _done)
+      break;
+    /// the chunk stays in the queue while it is written so that flush
+    /// waits for it
+    const Chunk& chunk = _queue.front();
+    lock.unlock();
+    writeChunk(chunk);
+    lock.lock();
+    _queue.pop_front();
+    _cv.notify_all();
+  }
+}
+
+void
+TrajectoryWriter::push(Chunk&& chunk)
+{
+  if (_fout == nullptr)
+    return;
+  if (_use_background_thread) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _queue.push_back(std::move(chunk));
+    }
+    _cv.notify_all();
+  } else {
+    writeChunk(chunk);
+  }
+}
+
+void
+TrajectoryWriter::flush()
+{
+  if (_use_background_thread) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cv.wait(lock, [this]() { return _queue.empty(); });
+  }
+  if (_fout != nullptr)
+    fflush(_fout);
+}
+
+void
+TrajectoryWriter::close()
+{
+  if (_use_background_thread && _thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _done = true;
+    }
+    _cv.notify_all();
+    _thread.join();
+  }
+  if (_fout != nullptr) {
+    fclose(_fout);
+    _fout = nullptr;
+  }
+}
+
+} // namespace TChem
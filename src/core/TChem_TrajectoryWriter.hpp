@@ -0,0 +1,162 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_TRAJECTORY_WRITER_HPP__
+#define __TCHEM_TRAJECTORY_WRITER_HPP__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "TChem_Util.hpp"
+
+namespace TChem {
+
+///
+/// Binary trajectory writer
+/// - little-endian columnar file; all values are stored as float64
+/// - header: "TCHEMTRJ", uint32 version, uint32 number of columns and, for
+///   each column, uint32 name length followed by the name
+/// - each append writes a chunk: uint64 number of rows followed by the
+///   columns of the chunk, one after another
+/// - with a background thread, append packs the chunk and returns; the
+///   thread writes chunks in order
+/// - scripts/tchem_trajectory.py reads the file with numpy memmap
+///
+class TrajectoryWriter
+{
+public:
+  static constexpr uint32_t version = 1;
+
+private:
+  struct Chunk
+  {
+    uint64_t nrows;
+    std::vector<double> values;
+  };
+
+  FILE* _fout;
+  std::string _filename;
+  ordinal_type _ncolumns;
+
+  bool _use_background_thread;
+  bool _done;
+  std::thread _thread;
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::deque<Chunk> _queue;
+
+  void writeHeader(const std::vector<std::string>& names);
+  void writeChunk(const Chunk& chunk);
+  void run();
+  void push(Chunk&& chunk);
+
+public:
+  /// names are the column names in the order of append e.g., iter, t, dt,
+  /// state vector, site fractions and velocity
+  TrajectoryWriter(const std::string& filename,
+                   const std::vector<std::string>& names,
+                   const bool use_background_thread = false);
+  ~TrajectoryWriter();
+
+  TrajectoryWriter(const TrajectoryWriter&) = delete;
+  TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+
+  ordinal_type getNumberOfColumns() const { return _ncolumns; }
+
+  /// wait until queued chunks are written
+  void flush();
+  void close();
+
+  /// column names of density, pressure, temperature and species
+  template<typename StringViewHostType>
+  static void addStateVectorNames(std::vector<std::string>& names,
+                                  const StringViewHostType& speciesNamesHost,
+                                  const ordinal_type nSpec)
+  {
+    names.push_back("Density[kg/m3]");
+    names.push_back("Pressure[Pascal]");
+    names.push_back("Temperature[K]");
+    addSpeciesNames(names, speciesNamesHost, nSpec);
+  }
+
+  template<typename StringViewHostType>
+  static void addSpeciesNames(std::vector<std::string>& names,
+                              const StringViewHostType& speciesNamesHost,
+                              const ordinal_type nSpec)
+  {
+    for (ordinal_type k = 0; k < nSpec; ++k)
+      names.push_back(std::string(&speciesNamesHost(k, 0)));
+  }
+
+  /// append a chunk of samples; siteFraction and velocity can be empty
+  template<typename RealType1DViewHostType, typename RealType2DViewHostType>
+  void append(const ordinal_type iter,
+              const RealType1DViewHostType& t,
+              const RealType1DViewHostType& dt,
+              const RealType2DViewHostType& state,
+              const RealType2DViewHostType& siteFraction,
+              const RealType1DViewHostType& velocity)
+  {
+    const ordinal_type nrows = state.extent(0);
+    const ordinal_type nstate = state.extent(1);
+    const ordinal_type nsite =
+      siteFraction.extent(0) > 0 ? siteFraction.extent(1) : 0;
+    const ordinal_type nvel = velocity.extent(0) > 0;
+    if (3 + nstate + nsite + nvel != _ncolumns) {
+      printf("TrajectoryWriter: %d columns are appended to %s of %d\n",
+             3 + nstate + nsite + nvel,
+             _filename.c_str(),
+             _ncolumns);
+      return;
+    }
+
+    Chunk chunk;
+    chunk.nrows = nrows;
+    chunk.values.resize(size_t(_ncolumns) * nrows);
+    double* p = chunk.values.data();
+    for (ordinal_type i = 0; i < nrows; ++i)
+      p[i] = iter;
+    p += nrows;
+    for (ordinal_type i = 0; i < nrows; ++i)
+      p[i] = t(i);
+    p += nrows;
+    for (ordinal_type i = 0; i < nrows; ++i)
+      p[i] = dt(i);
+    p += nrows;
+    for (ordinal_type k = 0; k < nstate; ++k, p += nrows)
+      for (ordinal_type i = 0; i < nrows; ++i)
+        p[i] = state(i, k);
+    for (ordinal_type k = 0; k < nsite; ++k, p += nrows)
+      for (ordinal_type i = 0; i < nrows; ++i)
+        p[i] = siteFraction(i, k);
+    if (nvel)
+      for (ordinal_type i = 0; i < nrows; ++i)
+        p[i] = velocity(i);
+
+    push(std::move(chunk));
+  }
+};
+
+} // namespace TChem
+
+#endif
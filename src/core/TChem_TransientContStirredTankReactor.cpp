@@ -46,6 +46,10 @@ TransientContStirredTankReactor_TemplateRun( /// required template arguments
   const TimeAdvance1DViewType& tadv,
   const RealType2DViewType& state,
   const RealType2DViewType& zSurf,
+  /// sample specific inlet; cstr is used when these are empty
+  const RealType1DViewType& mdotIn,
+  const RealType2DViewType& Yi,
+  const RealType1DViewType& EnthalpyIn,
   /// output
   const RealType1DViewType& t_out,
   const RealType1DViewType& dt_out,
@@ -84,74 +88,85 @@ TransientContStirredTankReactor_TemplateRun( /// required template arguments
         Kokkos::subview(state, i, Kokkos::ALL());
       const RealType0DViewType t_out_at_i = Kokkos::subview(t_out, i);
       const RealType0DViewType dt_out_at_i = Kokkos::subview(dt_out, i);
-      // site fraction
-      const RealType1DViewType Zs_at_i =
-        Kokkos::subview(zSurf, i, Kokkos::ALL());
-
-      Scratch<RealType1DViewType> work(member.team_scratch(level),
-                                       per_team_extent);
-
-      Impl::StateVector<RealType1DViewType> sv_at_i(kmcd.nSpec, state_at_i);
-      TCHEM_CHECK_ERROR(!sv_at_i.isValid(),
-                        "Error: input state vector is not valid");
-      {
-        const ordinal_type max_num_newton_iterations =
-          tadv_at_i._max_num_newton_iterations;
-        const ordinal_type max_num_time_iterations =
-          tadv_at_i._num_time_iterations_per_interval;
-
-        const real_type dt_in = tadv_at_i._dt, dt_min = tadv_at_i._dtmin,
-                        dt_max = tadv_at_i._dtmax;
-        const real_type t_beg = tadv_at_i._tbeg, t_end = tadv_at_i._tend;
-
-        const real_type temperature = sv_at_i.Temperature();
-        const real_type pressure = sv_at_i.Pressure();
-        const real_type density = sv_at_i.Density();
-        const RealType1DViewType Ys = sv_at_i.MassFractions();
-
-        const RealType0DViewType temperature_out(sv_at_i.TemperaturePtr());
-        const RealType0DViewType pressure_out(sv_at_i.PressurePtr());
-        const RealType0DViewType density_out(sv_at_i.DensityPtr());
-        const RealType1DViewType Ys_out = Ys;
-
-        const RealType1DViewType Zs_out_at_i = Zs_at_i;
-
-        auto wptr = work.data();
-        const RealType1DViewType vals(wptr, m);
-        wptr += m;
-        const RealType1DViewType ww(wptr,
-                                    work.extent(0) - (wptr - work.data()));
-
-        TChem::TransientContStirredTankReactor::packToValues(
-          member, temperature, Ys, Zs_at_i, vals);
-
-        member.team_barrier();
-        TChem::Impl::TransientContStirredTankReactor ::team_invoke(member,
-                                                   max_num_newton_iterations,
-                                                   max_num_time_iterations,
-                                                   tol_newton,
-                                                   tol_time,
-                                                   fac_at_i,
-                                                   dt_in,
-                                                   dt_min,
-                                                   dt_max,
-                                                   t_beg,
-                                                   t_end,
-                                                   vals,
-                                                   t_out_at_i,
-                                                   dt_out_at_i,
+      /// samples at the end of the interval are not advanced
+      if (t_out_at_i() < tadv_at_i._tend) {
+        // site fraction
+        const RealType1DViewType Zs_at_i =
+          Kokkos::subview(zSurf, i, Kokkos::ALL());
+
+        Scratch<RealType1DViewType> work(member.team_scratch(level),
+                                         per_team_extent);
+
+        Impl::StateVector<RealType1DViewType> sv_at_i(kmcd.nSpec, state_at_i);
+        TCHEM_CHECK_ERROR(!sv_at_i.isValid(),
+                          "Error: input state vector is not valid");
+
+        TransientContStirredTankReactorConstDataType cstr_at_i = cstr;
+        if (Yi.extent(0) > 0) {
+          cstr_at_i.mdotIn = mdotIn(i);
+          cstr_at_i.Yi = Kokkos::subview(Yi, i, Kokkos::ALL());
+          cstr_at_i.EnthalpyIn = EnthalpyIn(i);
+          cstr_at_i.pressure = sv_at_i.Pressure();
+        }
+        {
+          const ordinal_type max_num_newton_iterations =
+            tadv_at_i._max_num_newton_iterations;
+          const ordinal_type max_num_time_iterations =
+            tadv_at_i._num_time_iterations_per_interval;
+
+          const real_type dt_in = tadv_at_i._dt, dt_min = tadv_at_i._dtmin,
+                          dt_max = tadv_at_i._dtmax;
+          const real_type t_beg = tadv_at_i._tbeg, t_end = tadv_at_i._tend;
+
+          const real_type temperature = sv_at_i.Temperature();
+          const real_type pressure = sv_at_i.Pressure();
+          const real_type density = sv_at_i.Density();
+          const RealType1DViewType Ys = sv_at_i.MassFractions();
+
+          const RealType0DViewType temperature_out(sv_at_i.TemperaturePtr());
+          const RealType0DViewType pressure_out(sv_at_i.PressurePtr());
+          const RealType0DViewType density_out(sv_at_i.DensityPtr());
+          const RealType1DViewType Ys_out = Ys;
+
+          const RealType1DViewType Zs_out_at_i = Zs_at_i;
+
+          auto wptr = work.data();
+          const RealType1DViewType vals(wptr, m);
+          wptr += m;
+          const RealType1DViewType ww(wptr,
+                                      work.extent(0) - (wptr - work.data()));
+
+          TChem::TransientContStirredTankReactor::packToValues(
+            member, temperature, Ys, Zs_at_i, vals);
+
+          member.team_barrier();
+          TChem::Impl::TransientContStirredTankReactor ::team_invoke(member,
+                                                     max_num_newton_iterations,
+                                                     max_num_time_iterations,
+                                                     tol_newton,
+                                                     tol_time,
+                                                     fac_at_i,
+                                                     dt_in,
+                                                     dt_min,
+                                                     dt_max,
+                                                     t_beg,
+                                                     t_end,
+                                                     vals,
+                                                     t_out_at_i,
+                                                     dt_out_at_i,
+                                                     vals,
+                                                     ww, // work
+                                                     kmcd,
+                                                     kmcdSurf,
+                                                     cstr_at_i);
+
+          member.team_barrier();
+          TChem::TransientContStirredTankReactor::unpackFromValues(member,
                                                    vals,
-                                                   ww, // work
-                                                   kmcd,
-                                                   kmcdSurf,
-                                                   cstr);
-
-        member.team_barrier();
-        TChem::TransientContStirredTankReactor::unpackFromValues(member,
-                                                 vals,
-                                                 temperature_out,
-                                                 Ys_out,
-                                                 Zs_out_at_i);
+                                                   temperature_out,
+                                                   Ys_out,
+                                                   Zs_out_at_i);
+        }
       }
     });
   Kokkos::Profiling::popRegion();
@@ -190,6 +205,59 @@ TransientContStirredTankReactor::runDeviceBatch( /// thread block size
     tadv,
     state,
     zSurf,
+    real_type_1d_view(),
+    real_type_2d_view(),
+    real_type_1d_view(),
+    /// output
+    t_out,
+    dt_out,
+    state_out,
+    Z_out,
+    /// const data of kinetic model
+    kmcd,
+    kmcdSurf,
+    cstr);
+}
+
+void
+TransientContStirredTankReactor::runDeviceBatch( /// thread block size
+  typename UseThisTeamPolicy<exec_space>::type& policy,
+  /// input
+  const real_type_1d_view& tol_newton,
+  const real_type_2d_view& tol_time,
+  const real_type_2d_view& fac,
+  const time_advance_type_1d_view& tadv,
+  const real_type_2d_view& state,
+  const real_type_2d_view& zSurf,
+  const real_type_1d_view& mdotIn,
+  const real_type_2d_view& Yi,
+  const real_type_1d_view& EnthalpyIn,
+  /// output
+  const real_type_1d_view& t_out,
+  const real_type_1d_view& dt_out,
+  const real_type_2d_view& state_out,
+  const real_type_2d_view& Z_out,
+  /// const data from kinetic model
+  const KineticModelConstDataDevice& kmcd,
+  const KineticSurfModelConstDataDevice& kmcdSurf,
+  const cstr_data_type& cstr)
+{
+
+  TransientContStirredTankReactor_TemplateRun( /// template arguments deduction
+    "TChem::TransientContStirredTankReactor::runDeviceBatch::SampleInlet",
+    real_type_0d_view(),
+    /// team policy
+    policy,
+    /// input
+    tol_newton,
+    tol_time,
+    fac,
+    tadv,
+    state,
+    zSurf,
+    mdotIn,
+    Yi,
+    EnthalpyIn,
     /// output
     t_out,
     dt_out,
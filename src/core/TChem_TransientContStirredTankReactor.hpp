@@ -124,7 +124,10 @@ struct TransientContStirredTankReactor
   /// tadv - an input structure for time marching
   /// state (nSpec+3) - initial condition of the state vector
   /// work - work space sized by getWorkSpaceSize
-  /// t_out - time when this code exits
+  /// t_out - time when this code exits; samples which have reached
+  ///   tadv._tend (t_out >= tadv._tend on input) are no longer advanced and
+  ///   their state, site fractions, t_out and dt_out are left as they are.
+  ///   Reset t_out (e.g., to tadv._tbeg) before a new interval is started
   /// state_out - final condition of the state vector (the same input state can
   /// be overwritten) kmcd - const data for kinetic model
 
@@ -147,6 +150,32 @@ struct TransientContStirredTankReactor
     const KineticModelConstDataDevice& kmcd,
     const KineticSurfModelConstDataDevice& kmcdSurf,
     const cstr_data_type& cstr);
+
+  /// the same as above with a sample specific inlet; mdotIn (nBatch),
+  /// Yi (nBatch, nSpec) and EnthalpyIn (nBatch) replace the inlet of cstr
+  /// and the reactor pressure is taken from the state vector of the sample
+  static void runDeviceBatch( /// thread block size
+    typename UseThisTeamPolicy<exec_space>::type& policy,
+    /// input
+    const real_type_1d_view& tol_newton,
+    const real_type_2d_view& tol_time,
+    /// sample specific input
+    const real_type_2d_view& fac,
+    const time_advance_type_1d_view& tadv,
+    const real_type_2d_view& state,
+    const real_type_2d_view& zSurf,
+    const real_type_1d_view& mdotIn,
+    const real_type_2d_view& Yi,
+    const real_type_1d_view& EnthalpyIn,
+    /// output
+    const real_type_1d_view& t_out,
+    const real_type_1d_view& dt_out,
+    const real_type_2d_view& state_out,
+    const real_type_2d_view& Z_out,
+    /// const data from kinetic model
+    const KineticModelConstDataDevice& kmcd,
+    const KineticSurfModelConstDataDevice& kmcdSurf,
+    const cstr_data_type& cstr);
 };
 
 } // namespace TChem
@@ -0,0 +1,403 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#include "TChem_Util.hpp"
+
+#include "TChem_Impl_MolarWeights.hpp"
+#include "TChem_TransientContStirredTankReactorSteadyState.hpp"
+
+namespace TChem {
+
+/// vals (temperature, Ys, Zs) to a state vector at cstr.pressure
+template<typename MemberType,
+         typename RealType1DViewType,
+         typename StateViewType,
+         typename SiteFractionViewType,
+         typename KineticModelConstType>
+KOKKOS_INLINE_FUNCTION void
+TransientContStirredTankReactorSteadyState_UnpackState(
+  const MemberType& member,
+  const RealType1DViewType& vals,
+  const real_type& pressure,
+  const StateViewType& state_out,
+  const SiteFractionViewType& Z_out,
+  const KineticModelConstType& kmcd)
+{
+  Impl::StateVector<StateViewType> sv_out(kmcd.nSpec, state_out);
+  const auto Ys = sv_out.MassFractions();
+  Kokkos::parallel_for(Kokkos::TeamVectorRange(member, kmcd.nSpec),
+                       [&](const ordinal_type& k) { Ys(k) = vals(k + 1); });
+  Kokkos::parallel_for(
+    Kokkos::TeamVectorRange(member, ordinal_type(Z_out.extent(0))),
+    [&](const ordinal_type& k) { Z_out(k) = vals(k + kmcd.nSpec + 1); });
+  member.team_barrier();
+
+  const real_type Wmix = Impl::MolarWeights::team_invoke(member, Ys, kmcd);
+  Kokkos::single(Kokkos::PerTeam(member), [&]() {
+    sv_out.Temperature() = vals(0);
+    sv_out.Pressure() = pressure;
+    sv_out.Density() = pressure * Wmix / kmcd.Runiv / vals(0);
+  });
+  member.team_barrier();
+}
+
+template<typename PolicyType,
+         typename RealType1DViewType,
+         typename RealType2DViewType,
+         typename OrdinalType1DViewType,
+         typename KineticModelConstType,
+         typename KineticSurfModelConstData,
+         typename TransientContStirredTankReactorConstDataType>
+void
+TransientContStirredTankReactorSteadyState_TemplateRun(
+  const std::string& profile_name,
+  /// team size setting
+  const PolicyType& policy,
+  // inputs
+  const RealType1DViewType& tol_newton,
+  const ordinal_type max_num_iterations,
+  const real_type dt_init,
+  const real_type dt_max,
+  const RealType2DViewType& fac,
+  const RealType2DViewType& state,
+  const RealType2DViewType& zSurf,
+  /// output
+  const RealType2DViewType& state_out,
+  const RealType2DViewType& Z_out,
+  const OrdinalType1DViewType& iter_count,
+  const OrdinalType1DViewType& status,
+  /// const data from kinetic model
+  const KineticModelConstType& kmcd,
+  const KineticSurfModelConstData& kmcdSurf,
+  const TransientContStirredTankReactorConstDataType& cstr)
+{
+  Kokkos::Profiling::pushRegion(profile_name);
+  using policy_type = PolicyType;
+
+  const ordinal_type level = 1;
+  const ordinal_type m = Impl::TransientContStirredTankReactor_Problem<
+    KineticModelConstType,
+    KineticSurfModelConstData,
+    TransientContStirredTankReactorConstDataType>::
+    getNumberOfEquations(kmcd, kmcdSurf);
+  const ordinal_type per_team_extent =
+    TransientContStirredTankReactorSteadyState::getWorkSpaceSize(
+      kmcd, kmcdSurf, cstr);
+
+  Kokkos::parallel_for(
+    profile_name,
+    policy,
+    KOKKOS_LAMBDA(const typename policy_type::member_type& member) {
+      const ordinal_type i = member.league_rank();
+      const RealType1DViewType fac_at_i =
+        Kokkos::subview(fac, i, Kokkos::ALL());
+      const RealType1DViewType state_at_i =
+        Kokkos::subview(state, i, Kokkos::ALL());
+      const RealType1DViewType Zs_at_i =
+        Kokkos::subview(zSurf, i, Kokkos::ALL());
+      const RealType1DViewType state_out_at_i =
+        Kokkos::subview(state_out, i, Kokkos::ALL());
+      const RealType1DViewType Zs_out_at_i =
+        Kokkos::subview(Z_out, i, Kokkos::ALL());
+
+      Scratch<RealType1DViewType> work(member.team_scratch(level),
+                                       per_team_extent);
+
+      Impl::StateVector<RealType1DViewType> sv_at_i(kmcd.nSpec, state_at_i);
+      TCHEM_CHECK_ERROR(!sv_at_i.isValid(),
+                        "Error: input state vector is not valid");
+      {
+        const real_type temperature = sv_at_i.Temperature();
+        const RealType1DViewType Ys = sv_at_i.MassFractions();
+
+        auto wptr = work.data();
+        const RealType1DViewType vals(wptr, m);
+        wptr += m;
+        const RealType1DViewType ww(wptr,
+                                    work.extent(0) - (wptr - work.data()));
+
+        TChem::TransientContStirredTankReactor::packToValues(
+          member, temperature, Ys, Zs_at_i, vals);
+
+        ordinal_type iter_count_at_i(0), status_at_i(0);
+        Impl::TransientContStirredTankReactorSteadyState::team_invoke(
+          member,
+          tol_newton(0),
+          tol_newton(1),
+          max_num_iterations,
+          dt_init,
+          dt_max,
+          fac_at_i,
+          vals,
+          iter_count_at_i,
+          status_at_i,
+          ww,
+          kmcd,
+          kmcdSurf,
+          cstr);
+
+        /// samples that do not converge leave the output untouched
+        if (status_at_i == Impl::SteadyStateSolverStatus::Converged)
+          TransientContStirredTankReactorSteadyState_UnpackState(
+            member, vals, cstr.pressure, state_out_at_i, Zs_out_at_i, kmcd);
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          iter_count(i) = iter_count_at_i;
+          status(i) = status_at_i;
+        });
+      }
+    });
+  Kokkos::Profiling::popRegion();
+}
+
+template<typename PolicyType,
+         typename RealType1DViewType,
+         typename RealType2DViewType,
+         typename RealType3DViewType,
+         typename OrdinalType1DViewType,
+         typename KineticModelConstType,
+         typename KineticSurfModelConstData,
+         typename TransientContStirredTankReactorConstDataType>
+void
+TransientContStirredTankReactorSteadyState_TemplateRunContinuation(
+  const std::string& profile_name,
+  /// team size setting
+  const PolicyType& policy,
+  // inputs
+  const RealType1DViewType& tol_newton,
+  const ordinal_type max_num_iterations,
+  const real_type dt_init,
+  const real_type dt_max,
+  const real_type ds,
+  const real_type ds_max,
+  const RealType2DViewType& fac,
+  const RealType2DViewType& state,
+  const RealType2DViewType& zSurf,
+  /// output
+  const RealType3DViewType& vals_path,
+  const RealType3DViewType& state_path,
+  const RealType3DViewType& Z_path,
+  const RealType2DViewType& mdot_path,
+  const OrdinalType1DViewType& num_steps_out,
+  const OrdinalType1DViewType& status,
+  /// const data from kinetic model
+  const KineticModelConstType& kmcd,
+  const KineticSurfModelConstData& kmcdSurf,
+  const TransientContStirredTankReactorConstDataType& cstr)
+{
+  Kokkos::Profiling::pushRegion(profile_name);
+  using policy_type = PolicyType;
+
+  const ordinal_type level = 1;
+  const ordinal_type m = Impl::TransientContStirredTankReactor_Problem<
+    KineticModelConstType,
+    KineticSurfModelConstData,
+    TransientContStirredTankReactorConstDataType>::
+    getNumberOfEquations(kmcd, kmcdSurf);
+  const ordinal_type per_team_extent =
+    TransientContStirredTankReactorSteadyState::getWorkSpaceSize(
+      kmcd, kmcdSurf, cstr);
+
+  Kokkos::parallel_for(
+    profile_name,
+    policy,
+    KOKKOS_LAMBDA(const typename policy_type::member_type& member) {
+      const ordinal_type i = member.league_rank();
+      const RealType1DViewType fac_at_i =
+        Kokkos::subview(fac, i, Kokkos::ALL());
+      const RealType1DViewType state_at_i =
+        Kokkos::subview(state, i, Kokkos::ALL());
+      const RealType1DViewType Zs_at_i =
+        Kokkos::subview(zSurf, i, Kokkos::ALL());
+      const RealType2DViewType vals_path_at_i =
+        Kokkos::subview(vals_path, i, Kokkos::ALL(), Kokkos::ALL());
+      const RealType1DViewType mdot_path_at_i =
+        Kokkos::subview(mdot_path, i, Kokkos::ALL());
+
+      Scratch<RealType1DViewType> work(member.team_scratch(level),
+                                       per_team_extent);
+
+      Impl::StateVector<RealType1DViewType> sv_at_i(kmcd.nSpec, state_at_i);
+      TCHEM_CHECK_ERROR(!sv_at_i.isValid(),
+                        "Error: input state vector is not valid");
+      {
+        const real_type temperature = sv_at_i.Temperature();
+        const RealType1DViewType Ys = sv_at_i.MassFractions();
+
+        auto wptr = work.data();
+        const RealType1DViewType vals(wptr, m);
+        wptr += m;
+        const RealType1DViewType ww(wptr,
+                                    work.extent(0) - (wptr - work.data()));
+
+        TChem::TransientContStirredTankReactor::packToValues(
+          member, temperature, Ys, Zs_at_i, vals);
+
+        ordinal_type num_steps_out_at_i(0), status_at_i(0);
+        Impl::TransientContStirredTankReactorSteadyState::
+          team_invoke_continuation(member,
+                                   tol_newton(0),
+                                   tol_newton(1),
+                                   max_num_iterations,
+                                   dt_init,
+                                   dt_max,
+                                   ds,
+                                   ds_max,
+                                   fac_at_i,
+                                   vals,
+                                   vals_path_at_i,
+                                   mdot_path_at_i,
+                                   num_steps_out_at_i,
+                                   status_at_i,
+                                   ww,
+                                   kmcd,
+                                   kmcdSurf,
+                                   cstr);
+
+        for (ordinal_type step = 0; step < num_steps_out_at_i; ++step) {
+          const RealType1DViewType vals_at_step =
+            Kokkos::subview(vals_path, i, step, Kokkos::ALL());
+          const RealType1DViewType state_at_step =
+            Kokkos::subview(state_path, i, step, Kokkos::ALL());
+          const RealType1DViewType Z_at_step =
+            Kokkos::subview(Z_path, i, step, Kokkos::ALL());
+          TransientContStirredTankReactorSteadyState_UnpackState(
+            member,
+            vals_at_step,
+            cstr.pressure,
+            state_at_step,
+            Z_at_step,
+            kmcd);
+        }
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          num_steps_out(i) = num_steps_out_at_i;
+          status(i) = status_at_i;
+        });
+      }
+    });
+  Kokkos::Profiling::popRegion();
+}
+
+void
+TransientContStirredTankReactorSteadyState::runDeviceBatch(
+  typename UseThisTeamPolicy<exec_space>::type& policy,
+  /// input
+  const real_type_1d_view& tol_newton,
+  const ordinal_type max_num_iterations,
+  const real_type dt_init,
+  const real_type dt_max,
+  const real_type_2d_view& fac,
+  const real_type_2d_view& state,
+  const real_type_2d_view& zSurf,
+  /// output
+  const real_type_2d_view& state_out,
+  const real_type_2d_view& Z_out,
+  const ordinal_type_1d_view& iter_count,
+  const ordinal_type_1d_view& status,
+  /// const data from kinetic model
+  const KineticModelConstDataDevice& kmcd,
+  const KineticSurfModelConstDataDevice& kmcdSurf,
+  const cstr_data_type& cstr)
+{
+  TransientContStirredTankReactorSteadyState_TemplateRun(
+    "TChem::TransientContStirredTankReactorSteadyState::runDeviceBatch",
+    /// team policy
+    policy,
+    /// input
+    tol_newton,
+    max_num_iterations,
+    dt_init,
+    dt_max,
+    fac,
+    state,
+    zSurf,
+    /// output
+    state_out,
+    Z_out,
+    iter_count,
+    status,
+    /// const data of kinetic model
+    kmcd,
+    kmcdSurf,
+    cstr);
+}
+
+void
+TransientContStirredTankReactorSteadyState::runDeviceBatchContinuation(
+  typename UseThisTeamPolicy<exec_space>::type& policy,
+  /// input
+  const real_type_1d_view& tol_newton,
+  const ordinal_type max_num_iterations,
+  const real_type dt_init,
+  const real_type dt_max,
+  const real_type ds,
+  const real_type ds_max,
+  const real_type_2d_view& fac,
+  const real_type_2d_view& state,
+  const real_type_2d_view& zSurf,
+  /// output
+  const real_type_3d_view& state_path,
+  const real_type_3d_view& Z_path,
+  const real_type_2d_view& mdot_path,
+  const ordinal_type_1d_view& num_steps_out,
+  const ordinal_type_1d_view& status,
+  /// const data from kinetic model
+  const KineticModelConstDataDevice& kmcd,
+  const KineticSurfModelConstDataDevice& kmcdSurf,
+  const cstr_data_type& cstr)
+{
+  /// solution path in the problem layout; too large for team scratch
+  const ordinal_type m = Impl::TransientContStirredTankReactor_Problem<
+    KineticModelConstDataDevice,
+    KineticSurfModelConstDataDevice,
+    cstr_data_type>::getNumberOfEquations(kmcd, kmcdSurf);
+  real_type_3d_view vals_path(do_not_init_tag("vals path"),
+                              state_path.extent(0),
+                              state_path.extent(1),
+                              m);
+
+  TransientContStirredTankReactorSteadyState_TemplateRunContinuation(
+    "TChem::TransientContStirredTankReactorSteadyState::"
+    "runDeviceBatchContinuation",
+    /// team policy
+    policy,
+    /// input
+    tol_newton,
+    max_num_iterations,
+    dt_init,
+    dt_max,
+    ds,
+    ds_max,
+    fac,
+    state,
+    zSurf,
+    /// output
+    vals_path,
+    state_path,
+    Z_path,
+    mdot_path,
+    num_steps_out,
+    status,
+    /// const data of kinetic model
+    kmcd,
+    kmcdSurf,
+    cstr);
+}
+
+} // namespace TChem
@@ -0,0 +1,118 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_TRANSIENT_CONT_STIRRED_TANK_REACTOR_STEADY_STATE_HPP__
+#define __TCHEM_TRANSIENT_CONT_STIRRED_TANK_REACTOR_STEADY_STATE_HPP__
+
+#include "TChem_KineticModelData.hpp"
+#include "TChem_Util.hpp"
+
+#include "TChem_TransientContStirredTankReactor.hpp"
+#include "TChem_Impl_TransientContStirredTankReactorSteadyState.hpp"
+
+namespace TChem {
+
+/// Steady state solutions of the stirred tank reactor without time marching
+struct TransientContStirredTankReactorSteadyState
+{
+  using status_type = Impl::SteadyStateSolverStatus;
+
+  template<typename KineticModelConstDataType,
+           typename KineticSurfModelConstDataType,
+           typename TransientContStirredTankReactorConstDataType>
+  static inline ordinal_type getWorkSpaceSize(
+    const KineticModelConstDataType& kmcd,
+    const KineticSurfModelConstDataType& kmcdSurf,
+    const TransientContStirredTankReactorConstDataType& cstr)
+  {
+    return (Impl::TransientContStirredTankReactorSteadyState::getWorkSpaceSize(
+              kmcd, kmcdSurf, cstr) +
+            Impl::TransientContStirredTankReactor_Problem<
+              KineticModelConstDataType,
+              KineticSurfModelConstDataType,
+              TransientContStirredTankReactorConstDataType>::
+              getNumberOfEquations(kmcd, kmcdSurf));
+  }
+
+  /// tol_newton (2) - absolute and relative tolerence
+  /// max_num_iterations - maximum number of newton iterations
+  /// dt_init, dt_max - initial pseudo time step and the pseudo time step
+  ///   from which plain newton steps are taken
+  /// state, zSurf - initial guess of the state vector and site fractions
+  /// state_out, Z_out - steady state; density is consistent with
+  ///   cstr.pressure (the same input views can be used). Rows of samples
+  ///   whose status is not Converged are not written
+  /// iter_count, status (nBatch) - number of iterations and status_type
+  static void runDeviceBatch( /// thread block size
+    typename UseThisTeamPolicy<exec_space>::type& policy,
+    /// input
+    const real_type_1d_view& tol_newton,
+    const ordinal_type max_num_iterations,
+    const real_type dt_init,
+    const real_type dt_max,
+    const real_type_2d_view& fac,
+    const real_type_2d_view& state,
+    const real_type_2d_view& zSurf,
+    /// output
+    const real_type_2d_view& state_out,
+    const real_type_2d_view& Z_out,
+    const ordinal_type_1d_view& iter_count,
+    const ordinal_type_1d_view& status,
+    /// const data from kinetic model
+    const KineticModelConstDataDevice& kmcd,
+    const KineticSurfModelConstDataDevice& kmcdSurf,
+    const cstr_data_type& cstr);
+
+  /// residence time sweep with pseudo arc-length continuation starting from
+  /// the steady state at cstr.mdotIn
+  /// ds - initial arc-length step; positive increases residence time
+  /// ds_max - maximum arc-length step
+  /// state_path (nBatch, num_steps, stateVecDim) - steady states on the path
+  /// Z_path (nBatch, num_steps, kmcdSurf.nSpec) - site fractions on the path
+  /// mdot_path (nBatch, num_steps) - inlet mass flow rate of the points
+  /// num_steps_out (nBatch) - number of points computed; less than
+  ///   num_steps when the continuation fails (see status)
+  static void runDeviceBatchContinuation( /// thread block size
+    typename UseThisTeamPolicy<exec_space>::type& policy,
+    /// input
+    const real_type_1d_view& tol_newton,
+    const ordinal_type max_num_iterations,
+    const real_type dt_init,
+    const real_type dt_max,
+    const real_type ds,
+    const real_type ds_max,
+    const real_type_2d_view& fac,
+    const real_type_2d_view& state,
+    const real_type_2d_view& zSurf,
+    /// output
+    const real_type_3d_view& state_path,
+    const real_type_3d_view& Z_path,
+    const real_type_2d_view& mdot_path,
+    const ordinal_type_1d_view& num_steps_out,
+    const ordinal_type_1d_view& status,
+    /// const data from kinetic model
+    const KineticModelConstDataDevice& kmcd,
+    const KineticSurfModelConstDataDevice& kmcdSurf,
+    const cstr_data_type& cstr);
+};
+
+} // namespace TChem
+
+#endif
@@ -29,12 +29,15 @@ Sandia National Laboratories, Livermore, CA, USA
 #include <memory>
 #include <random>
 #include <set>
+#include <sstream>
 #include <string>
 #include <tuple>
 #include <vector>
 
 #include <cassert>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <limits>
 
@@ -288,6 +291,22 @@ using ordinal_type_3d_view_host = typename ordinal_type_3d_dual_view::t_host;
 template<int S>
 using string_type_1d_view_host = typename string_type_1d_dual_view<S>::t_host;
 
+/// batch views in an arbitrary layout; a state batch of an application code
+/// is often species major (LayoutLeft) and it is passed to the batch
+/// interfaces without transposing it
+using real_type_1d_stride_dual_view =
+  Kokkos::DualView<real_type*, Kokkos::LayoutStride, exec_space>;
+using real_type_2d_stride_dual_view =
+  Kokkos::DualView<real_type**, Kokkos::LayoutStride, exec_space>;
+
+using real_type_1d_stride_view = typename real_type_1d_stride_dual_view::t_dev;
+using real_type_2d_stride_view = typename real_type_2d_stride_dual_view::t_dev;
+
+using real_type_1d_stride_view_host =
+  typename real_type_1d_stride_dual_view::t_host;
+using real_type_2d_stride_view_host =
+  typename real_type_2d_stride_dual_view::t_host;
+
 /// utility function
 using do_not_init_tag = std::string; // Kokkos::ViewAllocateWithoutInitializing;
                                      // // currently not working
@@ -619,6 +638,110 @@ wrapStateVectorView(const ordinal_type nSpec, const RealType1DView& v)
   return StateVector<RealType1DView>(nSpec, v);
 }
 
+/// a row of a batch view of any layout is used as a contiguous vector;
+/// a strided row (e.g., LayoutLeft batch) is staged in team workspace
+template<typename RealType2DViewType>
+static inline ordinal_type
+getBatchRowWorkSpaceSize(const RealType2DViewType& A)
+{
+  return (A.extent(0) > 0 && A.extent(1) > 0 && A.stride(1) != 1)
+           ? A.extent(1)
+           : 0;
+}
+
+/// team policy extending the level 1 scratch for the staged rows
+template<typename PolicyType>
+static inline PolicyType
+getBatchRowPolicy(const PolicyType& policy,
+                  const ordinal_type per_team_extent_stage)
+{
+  PolicyType r(policy);
+  if (per_team_extent_stage > 0)
+    r.set_scratch_size(1,
+                       Kokkos::PerTeam(policy.team_scratch_size(1) +
+                                       Scratch<real_type_1d_view>::shmem_size(
+                                         per_team_extent_stage)));
+  return r;
+}
+
+/// returns the i-th row of A; w is the workspace pointer advanced by the
+/// staged row, which is filled with A(i,:) if copy_in is true
+template<typename RealType1DViewType,
+         typename MemberType,
+         typename RealType2DViewType>
+KOKKOS_INLINE_FUNCTION static RealType1DViewType
+getBatchRow(const MemberType& member,
+            const RealType2DViewType& A,
+            const ordinal_type i,
+            const bool copy_in,
+            real_type*& w)
+{
+  const ordinal_type n = A.extent(1);
+  if (A.extent(0) == 0 || n == 0)
+    return RealType1DViewType();
+  if (A.stride(1) == 1)
+    return RealType1DViewType(&A(i, 0), n);
+
+  const RealType1DViewType r(w, n);
+  w += n;
+  if (copy_in) {
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, n),
+                         [&](const ordinal_type& k) { r(k) = A(i, k); });
+    member.team_barrier();
+  }
+  return r;
+}
+
+/// writes back a row obtained from getBatchRow when it is staged
+template<typename MemberType,
+         typename RealType1DViewType,
+         typename RealType2DViewType>
+KOKKOS_INLINE_FUNCTION static void
+setBatchRow(const MemberType& member,
+            const RealType1DViewType& r,
+            const RealType2DViewType& A,
+            const ordinal_type i)
+{
+  const ordinal_type n = A.extent(1);
+  if (A.extent(0) > 0 && n > 0 && A.stride(1) != 1) {
+    member.team_barrier();
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, n),
+                         [&](const ordinal_type& k) { A(i, k) = r(k); });
+  }
+}
+
+/// kinetic model of sample i; the rows of the per-sample Arrhenius
+/// perturbation are selected when they are given
+template<typename KineticModelConstDataType>
+KOKKOS_INLINE_FUNCTION KineticModelConstDataType
+getKineticModelAtSample(const KineticModelConstDataType& kmcd,
+                        const ordinal_type i)
+{
+  using view_type = decltype(kmcd.reacLogAFactor);
+  KineticModelConstDataType kmcd_at_i = kmcd;
+  if (kmcd.sampleLogAFactor.extent(0) > 0)
+    kmcd_at_i.reacLogAFactor =
+      view_type(&kmcd.sampleLogAFactor(i, 0), kmcd.nReac);
+  if (kmcd.sampleEaShift.extent(0) > 0)
+    kmcd_at_i.reacEaShift = view_type(&kmcd.sampleEaShift(i, 0), kmcd.nReac);
+  return kmcd_at_i;
+}
+
+/// multiplier exp(dlnA - dEa/(R T)) of the rate constants of reaction i
+template<typename KineticModelConstDataType>
+KOKKOS_INLINE_FUNCTION real_type
+getArrheniusPerturbation(const KineticModelConstDataType& kmcd,
+                         const ordinal_type i,
+                         const real_type t_1)
+{
+  real_type lnf(0);
+  if (kmcd.reacLogAFactor.extent(0) > 0)
+    lnf += kmcd.reacLogAFactor(i);
+  if (kmcd.reacEaShift.extent(0) > 0)
+    lnf -= kmcd.reacEaShift(i) * t_1;
+  return lnf == real_type(0) ? real_type(1) : ats<real_type>::exp(lnf);
+}
+
 } // namespace Impl
 
 ///
@@ -687,267 +810,6 @@ read1DVector(const std::string& filename,
   }
 }
 
-template<typename StringViewHostType,
-         typename RealType2DViewHostType,
-         typename KCMDRealType1DViewHostType>
-static inline void
-readSample(const std::string& filename,
-           const StringViewHostType& speciesNamesHost,
-           const KCMDRealType1DViewHostType& sMass,
-           const ordinal_type& nSpec,
-           const ordinal_type& stateVecDim,
-           RealType2DViewHostType& state_host,
-           int& nBatch)
-{
-
-  //
-  std::ifstream file(filename);
-  std::vector<std::string> varnames;
-  std::vector<real_type> values;
-  if (file.is_open()) {
-
-    printf("readSample: Reading gas samples from %s\n", filename.c_str());
-
-    // read header of file and save variable name in vector
-    std::string line;
-    std::getline(file, line);
-    std::istringstream iss(line);
-    std::string delimiter = " ";
-
-    size_t pos = 0;
-    std::string token;
-    while ((pos = line.find(delimiter)) != std::string::npos) {
-      varnames.push_back(line.substr(0, pos));
-      line.erase(0, pos + delimiter.length());
-    }
-    varnames.push_back(line);
-    // for (auto i = varnames.begin(); i != varnames.end(); ++i)
-    //   std::cout << *i << "\n";
-    // read values
-    real_type value;
-    while (file >> value) {
-      values.push_back(value);
-    }
-  } else{
-    printf("readSample : Could not open %s -> Abort !\n", filename.c_str());
-    exit(1);
-  }
-
-  file.close();
-
-  std::vector<ordinal_type> indx;
-  for (ordinal_type sp = 0; sp < varnames.size(); sp++) {
-    for (ordinal_type i = 0; i < nSpec; i++) {
-      if (strncmp(&speciesNamesHost(i, 0),
-                  (varnames[sp]).c_str(),
-                  LENGTHOFSPECNAME) == 0) {
-        indx.push_back(i);
-        printf("species %s index %d \n", &speciesNamesHost(i, 0), i);
-      }
-    }
-  }
-
-  nBatch = values.size() / varnames.size();
-  const ordinal_type nVars = varnames.size();
-  printf("Number of samples %d\n", nBatch);
-  /// input: state vectors: temperature, pressure and concentration
-  state_host = RealType2DViewHostType("StateVector", nBatch, stateVecDim);
-  /// create a mirror view to store input from a file
-  // state_host = Kokkos::create_mirror_view(state);
-
-  Kokkos::parallel_for(Kokkos::RangePolicy<TChem::host_exec_space>(0, nBatch),
-                       [state_host,nVars,&values,&indx](const ordinal_type& i) {
-                         // density is set to zero
-
-                         state_host(i, 1) = values[i * nVars + 1]; // pressure
-                         state_host(i, 2) = values[i * nVars]; // temperatures
-
-                         // mass fractions
-                         for (ordinal_type sp = 0; sp < indx.size(); sp++) {
-                           state_host(i, indx[sp] + 3) =
-                             values[i * nVars + 2 + sp];
-                         }
-                       });
-
-  //
-  // 3. compute density
-
-  Kokkos::parallel_for(
-    Kokkos::RangePolicy<TChem::host_exec_space>(0, nBatch),
-    [&](const ordinal_type& i) {
-      const real_type_1d_view_host state_at_i =
-        Kokkos::subview(state_host, i, Kokkos::ALL());
-      //
-      const Impl::StateVector<real_type_1d_view_host> sv_at_i(nSpec,
-                                                              state_at_i);
-      const auto Ys = sv_at_i.MassFractions();
-      real_type Ysum(0);
-      for (ordinal_type sp = 0; sp < indx.size(); sp++)
-        Ysum += Ys(indx[sp]) / sMass(indx[sp]);
-
-      const real_type Runiv = RUNIV * 1.0e3;
-      sv_at_i.Density() =
-        sv_at_i.Pressure() / (Runiv * Ysum * sv_at_i.Temperature());
-    });
-}
-
-template<typename StringViewHostType, typename RealType2DViewHostType>
-static inline void
-readSurfaceSample(const std::string& filename,
-                  const StringViewHostType& speciesNamesHost,
-                  const ordinal_type& nSpec,
-                  RealType2DViewHostType& sitefraction_host,
-                  int& nBatch)
-{
-
-  //
-  std::ifstream file(filename);
-  std::vector<std::string> varnames;
-  std::vector<real_type> values;
-  if (file.is_open()) {
-
-    printf("readSurfaceSample: Reading surface samples from %s\n", filename.c_str());
-
-    // read header of file and save variable name in vector
-    std::string line;
-    std::getline(file, line);
-    std::istringstream iss(line);
-    std::string delimiter = " ";
-
-    size_t pos = 0;
-    std::string token;
-    while ((pos = line.find(delimiter)) != std::string::npos) {
-      varnames.push_back(line.substr(0, pos));
-      line.erase(0, pos + delimiter.length());
-    }
-    varnames.push_back(line);
-    // for (auto i = varnames.begin(); i != varnames.end(); ++i)
-    //   std::cout << *i << "\n";
-    // read values
-    real_type value;
-    while (file >> value) {
-      values.push_back(value);
-    }
-  } else{
-    printf("readSurfaceSample: Could not open %s -> Abort !\n", filename.c_str());
-    exit(1);
-  }
-  file.close();
-
-  std::vector<ordinal_type> indx;
-  for (ordinal_type sp = 0; sp < varnames.size(); sp++) {
-    for (ordinal_type i = 0; i < nSpec; i++) {
-      if (strncmp(&speciesNamesHost(i, 0),
-                  (varnames[sp]).c_str(),
-                  LENGTHOFSPECNAME) == 0) {
-        indx.push_back(i);
-        printf("species %s index %d \n", &speciesNamesHost(i, 0), i);
-      }
-    }
-  }
-
-  nBatch = values.size() / varnames.size();
-  const ordinal_type nVars = varnames.size();
-  printf("Number of samples %d\n", nBatch);
-  /// input: state vectors: temperature, pressure and concentration
-  sitefraction_host =
-    RealType2DViewHostType("Site fraction host", nBatch, nSpec);
-  /// create a mirror view to store input from a file
-  // sitefraction_host = Kokkos::create_mirror_view(state);
-
-  Kokkos::parallel_for(Kokkos::RangePolicy<TChem::host_exec_space>(0, nBatch),
-                       [sitefraction_host,nVars,&values,&indx](const ordinal_type& i) {
-                         // mass fractions
-                         for (ordinal_type sp = 0; sp < indx.size(); sp++) {
-                           sitefraction_host(i, indx[sp]) =
-                             values[i * nVars + sp];
-                         }
-                       });
-}
-
-template<typename StringViewHostType,
-         typename RealType1DViewHostType,
-         typename KCMDRealType1DViewHostType>
-static inline void
-readInput(const std::string& filename,
-          const ordinal_type& nSpec,
-          const StringViewHostType& speciesNamesHost,
-          const KCMDRealType1DViewHostType& sMass,
-          const RealType1DViewHostType& stateVector)
-{
-  // read input file that contains: T, P and some species
-  // T P IC8H18 O2 N2 AR
-  // compute density and set state vector.
-
-  // 1.  get data from file
-  std::ifstream file(filename);
-  std::vector<std::string> varnames;
-  std::vector<real_type> values;
-  if (file.is_open()) {
-
-    // read header of file and save variable name in vector
-    std::string line;
-    std::getline(file, line);
-    std::istringstream iss(line);
-    std::string delimiter = " ";
-
-    size_t pos = 0;
-    std::string token;
-    while ((pos = line.find(delimiter)) != std::string::npos) {
-      varnames.push_back(line.substr(0, pos));
-      line.erase(0, pos + delimiter.length());
-    }
-    varnames.push_back(line);
-    // for (auto i = varnames.begin(); i != varnames.end(); ++i)
-    //         std::cout << *i << "\n";
-    // read values
-    real_type value;
-    while (file >> value) {
-      values.push_back(value);
-    }
-  }
-  file.close();
-
-  std::vector<ordinal_type> indx;
-  for (ordinal_type sp = 0; sp < varnames.size(); sp++) {
-    for (ordinal_type i = 0; i < nSpec; i++) {
-      if (strncmp(&speciesNamesHost(i, 0),
-                  (varnames[sp]).c_str(),
-                  LENGTHOFSPECNAME) == 0) {
-        indx.push_back(i);
-        printf("species %s index %d \n", &speciesNamesHost(i, 0), i);
-      }
-    }
-  }
-
-  const ordinal_type nBatch = values.size() / varnames.size();
-  const ordinal_type nVars = varnames.size();
-  printf("Number of samples %d\n", nBatch);
-
-  // 2. fill state vector with previews data
-  Impl::StateVector<RealType1DViewHostType> sv(nSpec, stateVector);
-
-  if (sv.isValid()) {
-    sv.Temperature() = values[0]; // temperature
-    sv.Pressure() = values[1];    // pressure
-    // sv.Density()
-    const auto Ys = sv.MassFractions();
-    for (ordinal_type sp = 0; sp < indx.size(); sp++)
-      Ys(indx[sp]) = values[sp + 2];
-
-  } else {
-    std::logic_error("Error: stateVector is not valid");
-  }
-  // 3. compute density
-  const auto Ys = sv.MassFractions();
-  real_type Ysum(0);
-  for (ordinal_type sp = 0; sp < indx.size(); sp++)
-    Ysum += Ys(indx[sp]) / sMass(indx[sp]);
-
-  const real_type Runiv = RUNIV * 1.0e3;
-  sv.Density() = sv.Pressure() / (Runiv * Ysum * sv.Temperature());
-}
-
 template<typename RealType1DViewHostType>
 static inline void
 readStateVector(const std::string& filename,
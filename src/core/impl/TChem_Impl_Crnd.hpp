@@ -21,6 +21,8 @@ Sandia National Laboratories, Livermore, CA, USA
 #ifndef __TCHEM_IMPL_CRND_HPP__
 #define __TCHEM_IMPL_CRND_HPP__
 
+#include "TChem_Math.hpp"
+#include "TChem_Profiler.hpp"
 #include "TChem_Util.hpp"
 
 namespace TChem {
@@ -49,9 +51,11 @@ struct Crnd
     /// const input from kinetic model
     const KineticModelConstDataType& kmcd)
   {
+    TCHEM_PROFILE_TEAM_SCOPE(member, Falloff);
+
     const real_type one(1), zero(0);
     const real_type t_1 = one / t;
-    const real_type tln = ats<real_type>::log(t);
+    const real_type tln = Math<real_type>::log(t);
 
     Kokkos::single(Kokkos::PerTeam(member), [&]() {
       /// compute iterators
@@ -65,6 +69,11 @@ struct Crnd
 
     Kokkos::parallel_for(
       Kokkos::TeamVectorRange(member, kmcd.nReac), [&](const ordinal_type& i) {
+        /// inactive reaction in the reduced mechanism
+        if (kmcd.reacActive.extent(0) > 0 && !kmcd.reacActive(i)) {
+          Crnd(i) = real_type(0);
+          return;
+        }
         Crnd(i) = concM(i);
         const ordinal_type ipfal = ipfals(i);
         if (ipfal < kmcd.nFallReac) {
@@ -72,16 +81,18 @@ struct Crnd
 
             real_type Pr(0);
             auto rp = Kokkos::subview(kmcd.reacPpar, ipfal, Kokkos::ALL());
+            /// kfor is perturbed; the other limit is scaled by the same factor
+            const real_type kfac = getArrheniusPerturbation(kmcd, i, t_1);
 
             if (kmcd.reacPlohi(ipfal) == 0) {
               /* LOW reaction */
               const real_type k0 =
-                rp(0) * ats<real_type>::exp(rp(1) * tln - rp(2) * t_1);
+                kfac * rp(0) * Math<real_type>::exp(rp(1) * tln - rp(2) * t_1);
               Pr = k0 / kfor(i);
             } else {
               /* HIGH reaction */
               const real_type kinf =
-                rp(0) * ats<real_type>::exp(rp(1) * tln - rp(2) * t_1);
+                kfac * rp(0) * Math<real_type>::exp(rp(1) * tln - rp(2) * t_1);
               Pr = kfor(i) / kinf;
             }
             Pr *= (kmcd.reacPspec(ipfal) >= 0 ? concX(kmcd.reacPspec(ipfal))
@@ -89,16 +100,16 @@ struct Crnd
             Crnd(i) = Pr / (one + Pr); /* At least Lindemann form */
 
             const real_type logPr =
-              ats<real_type>::log10(Pr > TCSMALL ? Pr : TCSMALL);
+              Math<real_type>::log10(Pr > TCSMALL ? Pr : TCSMALL);
 
             /// SRI form
             if (kmcd.reacPtype(ipfal) == 2) {
               const real_type Xpres = one / (one + logPr * logPr);
               const real_type Ffac =
-                ats<real_type>::pow(rp(3) * ats<real_type>::exp(-rp(4) * t_1) +
-                                      ats<real_type>::exp(-t / rp(5)),
+                Math<real_type>::pow(rp(3) * Math<real_type>::exp(-rp(4) * t_1) +
+                                      Math<real_type>::exp(-t / rp(5)),
                                     Xpres) *
-                rp(6) * ats<real_type>::pow(t, rp(7));
+                rp(6) * Math<real_type>::pow(t, rp(7));
               Crnd(i) *= Ffac;
             } /* done with SRI form */
             /// TROE form
@@ -109,19 +120,19 @@ struct Crnd
               // zero) Fc +=      rp(3) *exp(-t/rp(5)) ;
 
               const real_type Fc =
-                ((1.0 - rp(3)) * ats<real_type>::exp(-t / rp(4)) +
-                 rp(3) * ats<real_type>::exp(-t / rp(5)) +
-                 (kmcd.reacPtype(ipfal) == 4 ? ats<real_type>::exp(-rp(6) * t_1)
+                ((1.0 - rp(3)) * Math<real_type>::exp(-t / rp(4)) +
+                 rp(3) * Math<real_type>::exp(-t / rp(5)) +
+                 (kmcd.reacPtype(ipfal) == 4 ? Math<real_type>::exp(-rp(6) * t_1)
                                              : zero));
 
-              const real_type logFc = ats<real_type>::log10(Fc);
+              const real_type logFc = Math<real_type>::log10(Fc);
               const real_type Atroe = logPr - 0.40 - 0.67 * logFc;
               const real_type Btroe = 0.75 - 1.27 * logFc - 0.14 * Atroe;
               const real_type Atroe_Btroe = Atroe / Btroe;
               const real_type logFfac =
                 logFc / (one + Atroe_Btroe * Atroe_Btroe);
               const real_type Ffac =
-                ats<real_type>::pow(real_type(10), logFfac);
+                Math<real_type>::pow(real_type(10), logFfac);
 
               Crnd(i) *= Ffac;
             } /* done with Troe form */
@@ -203,7 +214,7 @@ struct CrndDerivative
 
     const real_type two(2), one(1), zero(0);
     const real_type t_1 = one / t;
-    const real_type tln = ats<real_type>::log(t);
+    const real_type tln = Math<real_type>::log(t);
 
 #if defined(TCHEM_ENABLE_SERIAL_TEST_OUTPUT) && !defined(__CUDA_ARCH__)
     const ordinal_type itbdy_prev = itbdy;
@@ -222,6 +233,13 @@ struct CrndDerivative
     }
     member.team_barrier();
 
+    /// inactive reaction in the reduced mechanism; advance the iterators only
+    if (kmcd.reacActive.extent(0) > 0 && !kmcd.reacActive(ireac)) {
+      itbdy += (itbdy < kmcd.nThbReac) && (kmcd.reacTbdy(itbdy) == ireac);
+      ipfal += (ipfal < kmcd.nFallReac) && (kmcd.reacPfal(ipfal) == ireac);
+      return;
+    }
+
     ///
     /// Third-body reactions
     ///
@@ -252,15 +270,18 @@ struct CrndDerivative
         auto rp = Kokkos::subview(kmcd.reacPpar, ipfal, Kokkos::ALL());
         auto ra = Kokkos::subview(kmcd.reacArhenFor, ireac, Kokkos::ALL());
 
+        /// kfor includes the per sample perturbation; it cancels in Pr and
+        /// its temperature derivative
+        const real_type kfac = getArrheniusPerturbation(kmcd, ireac, t_1);
         if (kmcd.reacPlohi(ipfal) == 0) {
           /* LOW reaction */
           const real_type k0 =
-            rp(0) * ats<real_type>::exp(rp(1) * tln - rp(2) * t_1);
+            kfac * rp(0) * Math<real_type>::exp(rp(1) * tln - rp(2) * t_1);
           Pr = k0 / kfor(ireac);
         } else {
           /* HIGH reaction */
           const real_type kinf =
-            rp(0) * ats<real_type>::exp(rp(1) * tln - rp(2) * t_1);
+            kfac * rp(0) * Math<real_type>::exp(rp(1) * tln - rp(2) * t_1);
           Pr = kfor(ireac) / kinf;
         }
 
@@ -295,25 +316,25 @@ struct CrndDerivative
         else if (kmcd.reacPtype(ipfal) == 2) {
           auto Psri = Kokkos::subview(rp, range_type(3, rp.extent(0)));
           const real_type logPr =
-            ats<real_type>::log(Pr) / ats<real_type>::log(10);
+            Math<real_type>::log(Pr) / Math<real_type>::log(10);
           const real_type Xp = one / (one + logPr * logPr);
           const real_type dXp =
-            -Xp * Xp * two * logPr / (Pr * ats<real_type>::log(10));
-          const real_type abc = Psri(0) * ats<real_type>::exp(-Psri(1) * t_1) +
-                                ats<real_type>::exp(-t / Psri(2));
-          const real_type Ffac = (ats<real_type>::pow(abc, Xp) * Psri(3) *
-                                  ats<real_type>::pow(t, Psri(4))) /
+            -Xp * Xp * two * logPr / (Pr * Math<real_type>::log(10));
+          const real_type abc = Psri(0) * Math<real_type>::exp(-Psri(1) * t_1) +
+                                Math<real_type>::exp(-t / Psri(2));
+          const real_type Ffac = (Math<real_type>::pow(abc, Xp) * Psri(3) *
+                                  Math<real_type>::pow(t, Psri(4))) /
                                  ((one + Pr) * (one + Pr));
           const real_type Prfac = Pr / (one + Pr);
-          const real_type abcS = ats<real_type>::log(abc) * dXp;
+          const real_type abcS = Math<real_type>::log(abc) * dXp;
 
           {
             const real_type FfacDt =
-              Ffac * (Psri(4) * t_1 + dXp * PrDt * ats<real_type>::log(abcS) +
+              Ffac * (Psri(4) * t_1 + dXp * PrDt * Math<real_type>::log(abcS) +
                       Xp *
                         (Psri(0) * Psri(1) * t_1 * t_1 *
-                           ats<real_type>::exp(-Psri(1) * t_1) -
-                         ats<real_type>::exp(-t / Psri(2)) / Psri(2)) /
+                           Math<real_type>::exp(-Psri(1) * t_1) -
+                         Math<real_type>::exp(-t / Psri(2)) / Psri(2)) /
                         abcS);
             CrndDt = Ffac * PrDt + Prfac * FfacDt;
             Kokkos::parallel_for(Kokkos::TeamVectorRange(member, kmcd.nSpec),
@@ -334,10 +355,10 @@ struct CrndDerivative
           const bool one_minus_ptroe_gt_zero = one_minus_ptroe_at_zero > zero;
           const real_type Fc1 =
             one_minus_ptroe_gt_zero
-              ? one_minus_ptroe_at_zero * ats<real_type>::exp(-t / Ptroe(1))
+              ? one_minus_ptroe_at_zero * Math<real_type>::exp(-t / Ptroe(1))
               : zero;
           const real_type Fc2 =
-            ptroe_gt_zero ? ptroe_at_zero * ats<real_type>::exp(-t / Ptroe(2))
+            ptroe_gt_zero ? ptroe_at_zero * Math<real_type>::exp(-t / Ptroe(2))
                           : zero;
 
           real_type Fc(Fc1 + Fc2), FcDer(0);
@@ -345,15 +366,15 @@ struct CrndDerivative
           FcDer -= (ptroe_gt_zero ? Fc2 / Ptroe(2) : zero);
 
           if (kmcd.reacPtype(ipfal) == 4) {
-            const real_type Fc3 = ats<real_type>::exp(-Ptroe(3) * t_1);
+            const real_type Fc3 = Math<real_type>::exp(-Ptroe(3) * t_1);
             Fc += Fc3;
             FcDer += Fc3 * Ptroe(3) * t_1 * t_1;
           }
 
           const real_type logFc =
-            ats<real_type>::log(Fc) / ats<real_type>::log(real_type(10));
+            Math<real_type>::log(Fc) / Math<real_type>::log(real_type(10));
           const real_type logPr =
-            ats<real_type>::log(Pr) / ats<real_type>::log(real_type(10));
+            Math<real_type>::log(Pr) / Math<real_type>::log(real_type(10));
 
           const bool Pr_gt_zero = Pr > zero;
           real_type Atroe(0), Btroe(0), Atroe_Btroe(0);
@@ -367,12 +388,12 @@ struct CrndDerivative
 
           const real_type oABtroe = one / (one + Atroe_Btroe * Atroe_Btroe);
           const real_type logFfac = logFc * oABtroe;
-          real_type Ffac = ats<real_type>::pow(10, logFfac);
+          real_type Ffac = Math<real_type>::pow(10, logFfac);
 
           real_type FfacDer0(0), FfacDer1(0);
           if (Pr_gt_zero) {
-            const real_type oPr = one / (Pr * ats<real_type>::log(10));
-            const real_type oFc = one / (Fc * ats<real_type>::log(10));
+            const real_type oPr = one / (Pr * Math<real_type>::log(10));
+            const real_type oFc = one / (Fc * Math<real_type>::log(10));
             const real_type Afc = -0.67 * oFc;
             const real_type Bfc = -1.1762 * oFc;
             const real_type Apr = 1.0 * oPr;
@@ -0,0 +1,136 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_IMPL_DENSE_EIGENDECOMPOSITION_HPP__
+#define __TCHEM_IMPL_DENSE_EIGENDECOMPOSITION_HPP__
+
+#include "TChem_Util.hpp"
+
+#include "KokkosBatched_Eigendecomposition_Decl.hpp"
+
+namespace TChem {
+namespace Impl {
+
+///
+/// Eigendecomposition of a real nonsymmetric matrix
+///
+/// Input:
+///  A[m,m]: input matrix; overwritten
+/// Output:
+///  er[m], ei[m]: real and imaginary parts of eigenvalues
+///  UL[m,m]: left eigenvectors
+///  UR[m,m]: right eigenvectors; as in LAPACK, a complex conjugate pair
+///           with ei(j) > 0 stores its real and imaginary parts in columns
+///           j and j+1
+/// Workspace
+///  W[2m^2+5m]
+///
+struct DenseEigendecomposition
+{
+  KOKKOS_INLINE_FUNCTION static ordinal_type getWorkSpaceSize(
+    const ordinal_type m)
+  {
+    return (2 * m * m + 5 * m);
+  }
+
+  template<typename RealType1DViewType, typename RealType2DViewType>
+  inline static void host_invoke(const RealType2DViewType& A,
+                                 const RealType1DViewType& er,
+                                 const RealType1DViewType& ei,
+                                 const RealType2DViewType& UL,
+                                 const RealType2DViewType& UR)
+  {
+#if defined(TCHEM_ENABLE_TPL_OPENBLAS) || defined(TCHEM_ENABLE_TPL_MKL)
+    assert(er.stride(0) == 1 && "er must be contiguous");
+    assert(ei.stride(0) == 1 && "ei must be contiguous");
+    if (A.stride(0) == 1) {
+      assert(UL.stride(0) == 1 && "A and UL are not consistent");
+      assert(UR.stride(0) == 1 && "A and UR are not consistent");
+    } else if (A.stride(1) == 1) {
+      assert(UL.stride(1) == 1 && "A and UL are not consistent");
+      assert(UR.stride(1) == 1 && "A and UR are not consistent");
+    } else {
+      assert(false && "A is not colum major nor row major");
+    }
+
+    const int lapack_layouts[2] = { LAPACK_ROW_MAJOR, LAPACK_COL_MAJOR };
+    const auto layout = lapack_layouts[A.stride(0) == 1];
+
+    const ordinal_type m = A.extent(0);
+    const ordinal_type lda = A.stride(A.stride(0) == 1),
+                       ldl = UL.stride(UL.stride(0) == 1),
+                       ldr = UR.stride(UR.stride(0) == 1);
+
+    if (std::is_same<real_type, float>::value) {
+    } else if (std::is_same<real_type, double>::value) {
+      LAPACKE_dgeev(layout,
+                    'V',
+                    'V',
+                    m,
+                    (double*)A.data(),
+                    lda,
+                    (double*)er.data(),
+                    (double*)ei.data(),
+                    (double*)UL.data(),
+                    ldl,
+                    (double*)UR.data(),
+                    ldr);
+    } else {
+      // error
+      printf("Error: DenseEigendecomposition only support real_type i.e., "
+             "float and double\n");
+    }
+#else
+    printf("Error: LAPACKE is not enabled; use MKL or OpenBLAS\n");
+#endif
+  }
+
+  template<typename MemberType,
+           typename RealType1DViewType,
+           typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke(const MemberType& member,
+                                                 const RealType2DViewType& A,
+                                                 const RealType1DViewType& er,
+                                                 const RealType1DViewType& ei,
+                                                 const RealType2DViewType& UL,
+                                                 const RealType2DViewType& UR,
+                                                 const RealType1DViewType& W)
+  {
+    if (std::is_same<Kokkos::Impl::ActiveExecutionMemorySpace,
+                     Kokkos::HostSpace>::value) {
+#if defined(TCHEM_ENABLE_TPL_OPENBLAS) || defined(TCHEM_ENABLE_TPL_MKL)
+      Kokkos::single(Kokkos::PerTeam(member),
+                     [&]() { host_invoke(A, er, ei, UL, UR); });
+#else
+      KokkosBatched::TeamVectorEigendecomposition<MemberType>::invoke(
+        member, A, er, ei, UL, UR, W);
+#endif
+    } else {
+      KokkosBatched::TeamVectorEigendecomposition<MemberType>::invoke(
+        member, A, er, ei, UL, UR, W);
+    }
+    member.team_barrier();
+  }
+};
+
+} // namespace Impl
+} // namespace TChem
+
+#endif
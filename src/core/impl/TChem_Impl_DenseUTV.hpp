@@ -49,6 +49,14 @@ namespace Impl {
 
 struct DenseUTV
 {
+  /// U, V, jpiv, tau and the solve workspace for a single right hand side
+  KOKKOS_INLINE_FUNCTION static ordinal_type getWorkSpaceSize(
+    const ordinal_type m,
+    const ordinal_type n)
+  {
+    return (m * m + n * n + n + (m < n ? m : n) + n + n);
+  }
+
   template<typename OrdinalType1DViewType,
            typename RealType1DViewType,
            typename RealType2DViewType>
@@ -491,6 +499,243 @@ struct DenseUTV
       member.team_barrier();
     }
   }
+
+  /// solves A x = b with the factors left in A and w by the last call of
+  /// team_factorize_and_solve; A and the factor part of w must not be
+  /// modified in between e.g., a corrector reusing the newton iteration
+  /// matrix. only a single right hand side is supported
+  template<typename MemberType,
+           typename RealType1DViewType,
+           typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_solve(
+    const MemberType& member,
+    const RealType2DViewType& A,
+    const RealType1DViewType& x,
+    const RealType1DViewType& b,
+    const RealType1DViewType& w,
+    const ordinal_type& matrix_rank)
+  {
+    const int m = A.extent(0), n = A.extent(1), min_mn = m > n ? n : m;
+    real_type* wptr = w.data();
+    RealType2DViewType U(wptr, m, n);
+    wptr += U.span();
+    RealType2DViewType V(wptr, n, n);
+    wptr += V.span();
+
+    using pivot_view_type =
+      Kokkos::View<ordinal_type*, Kokkos::Impl::ActiveExecutionMemorySpace>;
+    pivot_view_type jpiv((ordinal_type*)wptr, min_mn);
+    wptr += jpiv.span();
+
+    if (std::is_same<Kokkos::Impl::ActiveExecutionMemorySpace,
+                     Kokkos::HostSpace>::value) {
+#if defined(TCHEM_ENABLE_TPL_OPENBLAS) || defined(TCHEM_ENABLE_TPL_MKL)
+      RealType1DViewType tau(wptr, min_mn);
+      wptr += tau.span();
+
+      Kokkos::single(Kokkos::PerTeam(member), [&]() {
+        RealType1DViewType tt(wptr, n);
+        assert(int(wptr - w.data()) + n <= int(w.extent(0)) &&
+               "workspace is used more than allocated");
+        host_1d_solve(matrix_rank, U, A, V, jpiv, tau, x, b, tt);
+      });
+#else
+      RealType1DViewType work(wptr, 3 * m + n);
+      assert(int(wptr - w.data()) <= int(w.extent(0)) &&
+             "workspace is used more than allocated");
+      KokkosBatched::TeamVectorSolveUTV<MemberType,
+                                        KokkosBatched::Algo::UTV::Unblocked>::
+        invoke(member, matrix_rank, U, A, V, jpiv, x, b, work);
+#endif
+    } else {
+      RealType1DViewType work(wptr, 3 * m + n);
+      assert(int(wptr - w.data()) <= int(w.extent(0)) &&
+             "workspace is used more than allocated");
+      KokkosBatched::TeamVectorSolveUTV<MemberType,
+                                        KokkosBatched::Algo::UTV::Unblocked>::
+        invoke(member, matrix_rank, U, A, V, jpiv, x, b, work);
+    }
+    member.team_barrier();
+  }
+};
+
+///
+/// Mixed precision UTV factorization and solve for a single right hand side
+///
+/// A is converted to float and factorized; the right hand side and the
+/// solution stay in real_type. The float factors U and V are stored in the
+/// memory of A (overwritten) and T is stored in the workspace, which halves
+/// the m*m scratch of DenseUTV. The factors are only as accurate as float;
+/// this is intended for iteration matrices of Newton solvers that compute
+/// their residuals in real_type.
+///
+/// Input:
+///  A[m,n]: input matrix (m == n); overwritten by U and V in float
+/// Output:
+///  matrix_rank: numeric rank of matrix A in float
+/// Workspace
+///  w[getWorkSpaceSize(m,n)]: jpiv, T and the solve workspace in float
+///
+struct DenseUTVMixedPrecision
+{
+  using value_type = float;
+  static_assert(sizeof(real_type) >= 2 * sizeof(value_type),
+                "U and V in value_type must fit in the memory of A");
+
+  KOKKOS_INLINE_FUNCTION static ordinal_type getWorkSpaceSize(
+    const ordinal_type m,
+    const ordinal_type n)
+  {
+    const ordinal_type min_mn = m < n ? m : n;
+    /// jpiv, T[m,n], UTV work[3m+n], x[n] and b[n]
+    const ordinal_type nbytes = min_mn * sizeof(ordinal_type) +
+                                (m * n + 3 * m + 3 * n) * sizeof(value_type);
+    return (nbytes + sizeof(real_type) - 1) / sizeof(real_type);
+  }
+
+  template<typename MemberType,
+           typename RealType1DViewType,
+           typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_factorize_and_solve(
+    const MemberType& member,
+    const RealType2DViewType& A,
+    const RealType1DViewType& x,
+    const RealType1DViewType& b,
+    const RealType1DViewType& w,
+    ordinal_type& matrix_rank)
+  {
+    using value_type_1d_view_type =
+      Kokkos::View<value_type*,
+                   typename RealType2DViewType::array_layout,
+                   Kokkos::Impl::ActiveExecutionMemorySpace>;
+    using value_type_2d_view_type =
+      Kokkos::View<value_type**,
+                   typename RealType2DViewType::array_layout,
+                   Kokkos::Impl::ActiveExecutionMemorySpace>;
+    using pivot_view_type =
+      Kokkos::View<ordinal_type*, Kokkos::Impl::ActiveExecutionMemorySpace>;
+
+    const int m = A.extent(0), n = A.extent(1), min_mn = m > n ? n : m;
+    assert(m == n && "DenseUTVMixedPrecision only supports square matrices");
+    assert(ordinal_type(A.span()) == m * n && "A must be contiguous");
+
+    pivot_view_type jpiv((ordinal_type*)w.data(), min_mn);
+    value_type* wptr = (value_type*)(jpiv.data() + jpiv.span());
+    value_type_2d_view_type T(wptr, m, n);
+    wptr += T.span();
+    value_type_1d_view_type work(wptr, 3 * m + n);
+    wptr += work.span();
+    value_type_1d_view_type xx(wptr, n);
+    wptr += xx.span();
+    value_type_1d_view_type bb(wptr, n);
+    wptr += bb.span();
+    assert(int(wptr - (value_type*)w.data()) * sizeof(value_type) <=
+             w.span() * sizeof(real_type) &&
+           "workspace is used more than allocated");
+
+    /// round A to float
+    Kokkos::parallel_for(
+      Kokkos::TeamThreadRange(member, m), [&](const ordinal_type& i) {
+        Kokkos::parallel_for(
+          Kokkos::ThreadVectorRange(member, n),
+          [&](const ordinal_type& j) { T(i, j) = value_type(A(i, j)); });
+      });
+    member.team_barrier();
+
+    /// U and V reuse the memory of A
+    value_type* aptr = (value_type*)A.data();
+    value_type_2d_view_type U(aptr, m, n);
+    aptr += U.span();
+    value_type_2d_view_type V(aptr, n, n);
+
+    KokkosBatched::
+      TeamVectorUTV<MemberType, KokkosBatched::Algo::UTV::Unblocked>::invoke(
+        member, T, jpiv, U, V, work, matrix_rank);
+    member.team_barrier();
+
+    team_solve_detail(member, matrix_rank, U, T, V, jpiv, xx, bb, work, x, b);
+  }
+
+  /// solves A x = b with the factors left in A and w by the last call of
+  /// team_factorize_and_solve
+  template<typename MemberType,
+           typename RealType1DViewType,
+           typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_solve(
+    const MemberType& member,
+    const RealType2DViewType& A,
+    const RealType1DViewType& x,
+    const RealType1DViewType& b,
+    const RealType1DViewType& w,
+    const ordinal_type& matrix_rank)
+  {
+    using value_type_1d_view_type =
+      Kokkos::View<value_type*,
+                   typename RealType2DViewType::array_layout,
+                   Kokkos::Impl::ActiveExecutionMemorySpace>;
+    using value_type_2d_view_type =
+      Kokkos::View<value_type**,
+                   typename RealType2DViewType::array_layout,
+                   Kokkos::Impl::ActiveExecutionMemorySpace>;
+    using pivot_view_type =
+      Kokkos::View<ordinal_type*, Kokkos::Impl::ActiveExecutionMemorySpace>;
+
+    const int m = A.extent(0), n = A.extent(1), min_mn = m > n ? n : m;
+
+    pivot_view_type jpiv((ordinal_type*)w.data(), min_mn);
+    value_type* wptr = (value_type*)(jpiv.data() + jpiv.span());
+    value_type_2d_view_type T(wptr, m, n);
+    wptr += T.span();
+    value_type_1d_view_type work(wptr, 3 * m + n);
+    wptr += work.span();
+    value_type_1d_view_type xx(wptr, n);
+    wptr += xx.span();
+    value_type_1d_view_type bb(wptr, n);
+    wptr += bb.span();
+
+    value_type* aptr = (value_type*)A.data();
+    value_type_2d_view_type U(aptr, m, n);
+    aptr += U.span();
+    value_type_2d_view_type V(aptr, n, n);
+
+    team_solve_detail(member, matrix_rank, U, T, V, jpiv, xx, bb, work, x, b);
+  }
+
+private:
+  template<typename MemberType,
+           typename PivotViewType,
+           typename ValueType1DViewType,
+           typename ValueType2DViewType,
+           typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_solve_detail(
+    const MemberType& member,
+    const ordinal_type& matrix_rank,
+    const ValueType2DViewType& U,
+    const ValueType2DViewType& T,
+    const ValueType2DViewType& V,
+    const PivotViewType& jpiv,
+    const ValueType1DViewType& xx,
+    const ValueType1DViewType& bb,
+    const ValueType1DViewType& work,
+    const RealType1DViewType& x,
+    const RealType1DViewType& b)
+  {
+    const ordinal_type n = xx.extent(0);
+    Kokkos::parallel_for(
+      Kokkos::TeamVectorRange(member, n),
+      [&](const ordinal_type& i) { bb(i) = value_type(b(i)); });
+    member.team_barrier();
+
+    KokkosBatched::TeamVectorSolveUTV<MemberType,
+                                      KokkosBatched::Algo::UTV::Unblocked>::
+      invoke(member, matrix_rank, U, T, V, jpiv, xx, bb, work);
+    member.team_barrier();
+
+    Kokkos::parallel_for(
+      Kokkos::TeamVectorRange(member, n),
+      [&](const ordinal_type& i) { x(i) = real_type(xx(i)); });
+    member.team_barrier();
+  }
 };
 
 } // namespace Impl
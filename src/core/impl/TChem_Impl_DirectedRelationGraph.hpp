@@ -0,0 +1,309 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_IMPL_DIRECTED_RELATION_GRAPH_HPP__
+#define __TCHEM_IMPL_DIRECTED_RELATION_GRAPH_HPP__
+
+#include "TChem_Impl_ReactionRates.hpp"
+#include "TChem_Util.hpp"
+
+namespace TChem {
+namespace Impl {
+
+/// Directed relation graph (DRG) reduction for a single state
+/// - Lu and Law, Proc. Combust. Inst. 30 (2005)
+/// - interaction coefficient of species A to B,
+///     r_AB = sum_j |nu_Aj w_j delta_Bj| / sum_j |nu_Aj w_j|
+///   where w_j is the net rate of progress of reaction j
+/// - target species are those with mass fraction larger than
+///   kmcd.drgTargetMassFraction; species reachable from the targets through
+///   edges with r_AB >= kmcd.drgThreshold are kept
+/// - a reaction is active when all its reactants and products are kept
+struct DirectedRelationGraph
+{
+  template<typename KineticModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static ordinal_type getWorkSpaceSize(
+    const KineticModelConstDataType& kmcd)
+  {
+    /// reaction rates (4 nSpec + 8 nReac), omega, denominator, numerator,
+    /// queue, status and the queue tail
+    const ordinal_type workspace_size =
+      (4 * kmcd.nSpec + 8 * kmcd.nReac) + 5 * kmcd.nSpec + 1;
+    return workspace_size;
+  }
+
+  /// species of the j-th entry of reaction i; reactants come first and
+  /// products follow
+  template<typename KineticModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static ordinal_type getSpeciesIndex(
+    const KineticModelConstDataType& kmcd,
+    const ordinal_type& i,
+    const ordinal_type& j)
+  {
+    const ordinal_type nreac = kmcd.reacNreac(i),
+                       joff = kmcd.reacSidx.extent(1) / 2;
+    return (j < nreac ? kmcd.reacSidx(i, j)
+                      : kmcd.reacSidx(i, j - nreac + joff));
+  }
+
+  /// true when the j-th entry of reaction i is the first appearance of its
+  /// species; a species on both sides is visited once
+  template<typename KineticModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static bool isFirstAppearance(
+    const KineticModelConstDataType& kmcd,
+    const ordinal_type& i,
+    const ordinal_type& j)
+  {
+    const ordinal_type kspec = getSpeciesIndex(kmcd, i, j);
+    for (ordinal_type l = 0; l < j; ++l)
+      if (getSpeciesIndex(kmcd, i, l) == kspec)
+        return false;
+    return true;
+  }
+
+  /// denominator of r_AB, sum_j |nu_Aj w_j|
+  template<typename MemberType,
+           typename RealType1DViewType,
+           typename KineticModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke_denominator(
+    const MemberType& member,
+    const RealType1DViewType& rop,
+    const RealType1DViewType& denom,
+    const KineticModelConstDataType& kmcd)
+  {
+    const real_type zero(0);
+    const ordinal_type joff = kmcd.reacSidx.extent(1) / 2;
+
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, kmcd.nSpec),
+                         [&](const ordinal_type& k) { denom(k) = zero; });
+    member.team_barrier();
+    Kokkos::parallel_for(
+      Kokkos::TeamVectorRange(member, kmcd.nReac), [&](const ordinal_type& i) {
+        const real_type rop_at_i = ats<real_type>::abs(rop(i));
+        for (ordinal_type j = 0; j < kmcd.reacNreac(i); ++j) {
+          const ordinal_type kspec = kmcd.reacSidx(i, j);
+          const real_type val =
+            ats<real_type>::abs(real_type(kmcd.reacNuki(i, j))) * rop_at_i;
+          Kokkos::atomic_fetch_add(&denom(kspec), val);
+        }
+        for (ordinal_type j = 0; j < kmcd.reacNprod(i); ++j) {
+          const ordinal_type kspec = kmcd.reacSidx(i, j + joff);
+          const real_type val =
+            ats<real_type>::abs(real_type(kmcd.reacNuki(i, j + joff))) *
+            rop_at_i;
+          Kokkos::atomic_fetch_add(&denom(kspec), val);
+        }
+      });
+    member.team_barrier();
+  }
+
+  /// interaction coefficients r_aB of species a to all species B
+  /// - a reaction contributes to B at most once even when B appears on both
+  ///   sides, so r_aB <= 1 and r_aa = 1 when a takes part in any reaction
+  template<typename MemberType,
+           typename RealType1DViewType,
+           typename KineticModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke_interaction_coefficients(
+    const MemberType& member,
+    const ordinal_type& a,
+    const RealType1DViewType& rop,
+    const RealType1DViewType& denom,
+    /// output
+    const RealType1DViewType& numer,
+    const KineticModelConstDataType& kmcd)
+  {
+    const real_type zero(0);
+    const ordinal_type joff = kmcd.reacSidx.extent(1) / 2;
+    const real_type denom_at_a = denom(a);
+
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, kmcd.nSpec),
+                         [&](const ordinal_type& k) { numer(k) = zero; });
+    member.team_barrier();
+    if (denom_at_a > zero) {
+      Kokkos::parallel_for(
+        Kokkos::TeamVectorRange(member, kmcd.nReac),
+        [&](const ordinal_type& i) {
+          /// stoichiometric coefficient of a in reaction i
+          real_type nu_a(0);
+          for (ordinal_type j = 0; j < kmcd.reacNreac(i); ++j)
+            if (kmcd.reacSidx(i, j) == a)
+              nu_a += ats<real_type>::abs(real_type(kmcd.reacNuki(i, j)));
+          for (ordinal_type j = 0; j < kmcd.reacNprod(i); ++j)
+            if (kmcd.reacSidx(i, j + joff) == a)
+              nu_a +=
+                ats<real_type>::abs(real_type(kmcd.reacNuki(i, j + joff)));
+
+          if (nu_a > zero) {
+            const real_type val =
+              nu_a * ats<real_type>::abs(rop(i)) / denom_at_a;
+            const ordinal_type n = kmcd.reacNreac(i) + kmcd.reacNprod(i);
+            for (ordinal_type j = 0; j < n; ++j)
+              if (isFirstAppearance(kmcd, i, j))
+                Kokkos::atomic_fetch_add(&numer(getSpeciesIndex(kmcd, i, j)),
+                                         val);
+          }
+        });
+    }
+    member.team_barrier();
+  }
+
+  template<typename MemberType,
+           typename WorkViewType,
+           typename RealType1DViewType,
+           typename OrdinalType1DViewType,
+           typename KineticModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke(
+    const MemberType& member,
+    /// input
+    const real_type& t,
+    const real_type& p,
+    const RealType1DViewType& Ys, /// (kmcd.nSpec)
+    /// output
+    const OrdinalType1DViewType& reacActive, /// (kmcd.nReac)
+    /// workspace
+    const WorkViewType& work,
+    /// const input from kinetic model
+    const KineticModelConstDataType& kmcd)
+  {
+    using ordinal_type_1d_view_type =
+      Kokkos::View<ordinal_type*,
+                   Kokkos::LayoutRight,
+                   typename WorkViewType::memory_space>;
+
+    const real_type zero(0);
+
+    auto w = (real_type*)work.data();
+
+    auto gk = RealType1DViewType(w, kmcd.nSpec);
+    w += kmcd.nSpec;
+    auto hks = RealType1DViewType(w, kmcd.nSpec);
+    w += kmcd.nSpec;
+    auto cpks = RealType1DViewType(w, kmcd.nSpec);
+    w += kmcd.nSpec;
+    auto concX = RealType1DViewType(w, kmcd.nSpec);
+    w += kmcd.nSpec;
+
+    auto concM = RealType1DViewType(w, kmcd.nReac);
+    w += kmcd.nReac;
+    auto kfor = RealType1DViewType(w, kmcd.nReac);
+    w += kmcd.nReac;
+    auto krev = RealType1DViewType(w, kmcd.nReac);
+    w += kmcd.nReac;
+    auto ropFor = RealType1DViewType(w, kmcd.nReac);
+    w += kmcd.nReac;
+    auto ropRev = RealType1DViewType(w, kmcd.nReac);
+    w += kmcd.nReac;
+    auto Crnd = RealType1DViewType(w, kmcd.nReac);
+    w += kmcd.nReac;
+
+    auto iter = ordinal_type_1d_view_type((ordinal_type*)w, kmcd.nReac * 2);
+    w += kmcd.nReac * 2;
+
+    auto omega = RealType1DViewType(w, kmcd.nSpec);
+    w += kmcd.nSpec;
+    auto denom = RealType1DViewType(w, kmcd.nSpec);
+    w += kmcd.nSpec;
+    auto numer = RealType1DViewType(w, kmcd.nSpec);
+    w += kmcd.nSpec;
+    auto queue = ordinal_type_1d_view_type((ordinal_type*)w, kmcd.nSpec);
+    w += kmcd.nSpec;
+    auto status = ordinal_type_1d_view_type((ordinal_type*)w, kmcd.nSpec);
+    w += kmcd.nSpec;
+    auto tail = ordinal_type_1d_view_type((ordinal_type*)w, 1);
+    w += 1;
+
+    /// 1. net rates of progress of the full mechanism; rop = ropFor
+    ReactionRates::team_invoke_detail(member,
+                                      t,
+                                      p,
+                                      Ys,
+                                      omega,
+                                      gk,
+                                      hks,
+                                      cpks,
+                                      concX,
+                                      concM,
+                                      kfor,
+                                      krev,
+                                      ropFor,
+                                      ropRev,
+                                      Crnd,
+                                      iter,
+                                      RealType1DViewType(),
+                                      kmcd);
+    member.team_barrier();
+    const auto rop = ropFor;
+    const ordinal_type joff = kmcd.reacSidx.extent(1) / 2;
+
+    /// 2. denominator, sum_j |nu_Aj w_j|
+    team_invoke_denominator(member, rop, denom, kmcd);
+
+    /// 3. seed the graph search with target species
+    Kokkos::single(Kokkos::PerTeam(member), [&]() {
+      ordinal_type cnt(0);
+      for (ordinal_type k = 0; k < kmcd.nSpec; ++k) {
+        const bool is_target = Ys(k) >= kmcd.drgTargetMassFraction;
+        status(k) = is_target;
+        if (is_target)
+          queue(cnt++) = k;
+      }
+      tail(0) = cnt;
+    });
+    member.team_barrier();
+
+    /// 4. breadth first search
+    for (ordinal_type head = 0; head < tail(0); ++head) {
+      const ordinal_type a = queue(head);
+      if (denom(a) > zero) {
+        team_invoke_interaction_coefficients(
+          member, a, rop, denom, numer, kmcd);
+
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          ordinal_type cnt = tail(0);
+          for (ordinal_type k = 0; k < kmcd.nSpec; ++k) {
+            if (!status(k) && numer(k) >= kmcd.drgThreshold) {
+              status(k) = 1;
+              queue(cnt++) = k;
+            }
+          }
+          tail(0) = cnt;
+        });
+      }
+      member.team_barrier();
+    }
+
+    /// 5. reactions involving only kept species are active
+    Kokkos::parallel_for(
+      Kokkos::TeamVectorRange(member, kmcd.nReac), [&](const ordinal_type& i) {
+        ordinal_type active(1);
+        for (ordinal_type j = 0; j < kmcd.reacNreac(i); ++j)
+          active &= status(kmcd.reacSidx(i, j));
+        for (ordinal_type j = 0; j < kmcd.reacNprod(i); ++j)
+          active &= status(kmcd.reacSidx(i, j + joff));
+        reacActive(i) = active;
+      });
+    member.team_barrier();
+  }
+};
+
+} // namespace Impl
+} // namespace TChem
+
+#endif
@@ -24,6 +24,8 @@ Sandia National Laboratories, Livermore, CA, USA
 #include "TChem_Impl_CpSpecMl.hpp"
 #include "TChem_Impl_EnthalpySpecMl.hpp"
 #include "TChem_Impl_Entropy0SpecMl.hpp"
+#include "TChem_Math.hpp"
+#include "TChem_Profiler.hpp"
 #include "TChem_Util.hpp"
 
 namespace TChem {
@@ -46,8 +48,10 @@ struct GkFcn
     /// const input from kinetic model
     const KineticModelConstDataType& kmcd)
   {
+    TCHEM_PROFILE_TEAM_SCOPE(member, Thermo);
+
     const real_type t_1 = real_type(1) / t;
-    const real_type tln = ats<real_type>::log(t);
+    const real_type tln = Math<real_type>::log(t);
 
     /// no need for barrier as all parallelized for kmcd.nSpec
     Entropy0SpecMl::team_invoke(member, t, gk, cpks, kmcd);
@@ -93,8 +97,10 @@ struct GkFcnSurfGas
     /// const input from kinetic model
     const KineticModelConstDataType& kmcd)
   {
+    TCHEM_PROFILE_TEAM_SCOPE(member, Thermo);
+
     const real_type t_1 = real_type(1) / t;
-    const real_type tln = ats<real_type>::log(t);
+    const real_type tln = Math<real_type>::log(t);
 
     /// no need for barrier as all parallelized for kmcd.nSpec
     Entropy0SpecMl::team_invoke(member, t, gk, cpks, kmcd);
@@ -142,6 +148,8 @@ struct GkFcnDerivative
   {
 
     /* done computing gkp=d(gk)/dT */
+    TCHEM_PROFILE_TEAM_SCOPE(member, Thermo);
+
     const real_type t_1 = real_type(1) / t;
 
     /// no need for barrier as all parallelized for kmcd.nSpec
@@ -49,10 +49,13 @@ struct InitialCondSurface
     // / problem workspace
     const ordinal_type problem_workspace_size =
       problem_type::getWorkSpaceSize(kmcd, kmcdSurf);
+    const ordinal_type memo_workspace_size =
+      problem_type::getMemoWorkSpaceSize(kmcd, kmcdSurf);
     const ordinal_type newton_workspace_size =
       NewtonSolver::getWorkSpaceSize(problem);
 
-    return (problem_workspace_size + newton_workspace_size +
+    return (problem_workspace_size + memo_workspace_size +
+            newton_workspace_size +
             2 * kmcdSurf.nSpec + kmcdSurf.nSpec * kmcdSurf.nSpec);
   }
 
@@ -98,6 +101,12 @@ struct InitialCondSurface
     auto pw = real_type_1d_view_type(wptr, problem_workspace_size);
     wptr += problem_workspace_size;
 
+    /// rate constants memo
+    const ordinal_type memo_workspace_size =
+      problem_type::getMemoWorkSpaceSize(kmcd, kmcdSurf);
+    auto pm = wptr;
+    wptr += memo_workspace_size;
+
     /// constant values of the problem
     problem._p = pressure;        // pressure
     problem._kmcd = kmcd;         // kinetic model
@@ -107,6 +116,7 @@ struct InitialCondSurface
     problem._work = pw;           // problem workspace array
     problem._x = Zs;              // initial conditions
     problem._fac = fac;    // fac for numerical jacobian
+    problem.setMemo(member, pm);
 
     const ordinal_type m = kmcdSurf.nSpec;
     /// newton workspace
@@ -30,6 +30,7 @@ Sandia National Laboratories, Livermore, CA, USA
 #include "TChem_Impl_RateOfProgress.hpp"
 #include "TChem_Impl_RhoMixMs.hpp"
 #include "TChem_Impl_ThirdBodyConcentrations.hpp"
+#include "TChem_Profiler.hpp"
 #include "TChem_Util.hpp"
 
 #include "TChem_Impl_ReactionRates.hpp"
@@ -92,6 +93,8 @@ struct Jacobian
     /// const input from kinetic model
     const KineticModelConstDataType& kmcd)
   {
+    TCHEM_PROFILE_TEAM_SCOPE(member, Jacobian);
+
     const real_type zero(0); //, one(1);
     // const real_type t_1 = one/t;
     const real_type tln = ats<real_type>::log(t);
@@ -226,6 +229,10 @@ struct Jacobian
                                     kmcd);
 
         arbord = ((iord < kmcd.nOrdReac) && (kmcd.reacAOrd(iord) == j));
+        /// inactive reaction in the reduced mechanism does not contribute
+        if (kmcd.reacActive.extent(0) > 0 && !kmcd.reacActive(j))
+          continue;
+
         /// const j variables
         const real_type crnd_at_j = crnd(j), ropFor_at_j = ropFor(j),
                         ropRev_at_j = ropRev(j),
@@ -0,0 +1,286 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_IMPL_JACOBIAN_DIAGONAL_HPP__
+#define __TCHEM_IMPL_JACOBIAN_DIAGONAL_HPP__
+
+#include "TChem_Impl_SourceTerm.hpp"
+#include "TChem_Util.hpp"
+
+namespace TChem {
+namespace Impl {
+
+/// Approximate diagonal of the homogeneous gas-phase Jacobian d(dY_k/dt)/dY_k
+/// - only the explicit dependence of the rate of progress on the species
+///   concentration is taken into account; derivatives of the density, third
+///   body concentrations and falloff factors are ignored
+/// - integer and real stoichiometric coefficients and arbitrary order
+///   reactions follow the same cases as RateOfProgress
+/// - the temperature entry is set to zero
+/// - cheap, O(nReac) preconditioner for Jacobian-free Newton-Krylov solvers
+struct JacobianDiagonal
+{
+  template<typename KineticModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static ordinal_type getWorkSpaceSize(
+    const KineticModelConstDataType& kmcd)
+  {
+    const ordinal_type workspace_size =
+      SourceTerm::getWorkSpaceSize(kmcd) + kmcd.nSpec + 1;
+    return workspace_size;
+  }
+
+  /// add k_at_i * nu(s_j) * d(prod_l c_l^a_l)/dc_{s_j} to diag(s_j + 1)
+  /// - s_j = sidx(j) and a_j = order(j); a negative s_j is skipped
+  /// - when tiny is positive, non-positive concentrations are replaced
+  ///   by tiny so that fractional orders stay finite
+  template<typename SpeciesIndexType,
+           typename OrderType,
+           typename NuType,
+           typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static void serial_add_rop_derivative(
+    const real_type& k_at_i,
+    const ordinal_type& n,
+    const SpeciesIndexType& sidx,
+    const OrderType& order,
+    const NuType& nu,
+    const real_type& tiny,
+    const RealType1DViewType& concX,
+    const RealType1DViewType& diag)
+  {
+    const real_type zero(0), one(1);
+    const auto conc = [&](const ordinal_type& k) {
+      return (tiny > zero && concX(k) <= zero) ? tiny : concX(k);
+    };
+    for (ordinal_type j = 0; j < n; ++j) {
+      const ordinal_type kspec = sidx(j);
+      if (kspec < 0)
+        continue;
+      const real_type nu_at_k = nu(kspec);
+      if (nu_at_k == zero)
+        continue;
+      const real_type a_j = order(j);
+      real_type drop =
+        k_at_i * a_j * ats<real_type>::pow(conc(kspec), a_j - one);
+      for (ordinal_type l = 0; l < n; ++l) {
+        const ordinal_type lspec = sidx(l);
+        if (l != j && lspec >= 0)
+          drop *= ats<real_type>::pow(conc(lspec), order(l));
+      }
+      Kokkos::atomic_fetch_add(&diag(kspec + 1), nu_at_k * drop);
+    }
+  }
+
+  template<typename MemberType,
+           typename WorkViewType,
+           typename RealType1DViewType,
+           typename KineticModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke(
+    const MemberType& member,
+    /// input
+    const real_type& t,
+    const real_type& p,
+    const RealType1DViewType& Ys, /// (kmcd.nSpec)
+    /// output
+    const RealType1DViewType& diag, /// (kmcd.nSpec + 1)
+    /// workspace
+    const WorkViewType& work,
+    /// const input from kinetic model
+    const KineticModelConstDataType& kmcd)
+  {
+    const real_type zero(0);
+
+    auto w = (real_type*)work.data();
+
+    auto Xc = RealType1DViewType(w, kmcd.nSpec);
+    w += kmcd.nSpec;
+    auto gk = RealType1DViewType(w, kmcd.nSpec);
+    w += kmcd.nSpec;
+    auto hks = RealType1DViewType(w, kmcd.nSpec);
+    w += kmcd.nSpec;
+    auto cpks = RealType1DViewType(w, kmcd.nSpec);
+    w += kmcd.nSpec;
+    auto concX = RealType1DViewType(w, kmcd.nSpec);
+    w += kmcd.nSpec;
+
+    auto concM = RealType1DViewType(w, kmcd.nReac);
+    w += kmcd.nReac;
+    auto kfor = RealType1DViewType(w, kmcd.nReac);
+    w += kmcd.nReac;
+    auto krev = RealType1DViewType(w, kmcd.nReac);
+    w += kmcd.nReac;
+    auto ropFor = RealType1DViewType(w, kmcd.nReac);
+    w += kmcd.nReac;
+    auto ropRev = RealType1DViewType(w, kmcd.nReac);
+    w += kmcd.nReac;
+    auto Crnd = RealType1DViewType(w, kmcd.nReac);
+    w += kmcd.nReac;
+
+    auto iter = Kokkos::View<ordinal_type*,
+                             Kokkos::LayoutRight,
+                             typename WorkViewType::memory_space>(
+      (ordinal_type*)w, kmcd.nReac * 2);
+    w += kmcd.nReac * 2;
+
+    auto omega = RealType1DViewType(w, kmcd.nSpec + 1);
+    w += (kmcd.nSpec + 1);
+
+    auto omega_t = RealType1DViewType(omega.data(), 1);
+    auto omega_s = RealType1DViewType(omega.data() + 1, kmcd.nSpec);
+
+    /// 1. rate constants, concentrations and falloff factors
+    SourceTerm::team_invoke_detail(member,
+                                   t,
+                                   p,
+                                   Ys,
+                                   omega_t,
+                                   omega_s,
+                                   Xc,
+                                   gk,
+                                   hks,
+                                   cpks,
+                                   concX,
+                                   concM,
+                                   kfor,
+                                   krev,
+                                   ropFor,
+                                   ropRev,
+                                   Crnd,
+                                   iter,
+                                   RealType1DViewType(),
+                                   kmcd);
+    member.team_barrier();
+
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, kmcd.nSpec + 1),
+                         [&](const ordinal_type& k) { diag(k) = zero; });
+    member.team_barrier();
+
+    /// 2. d(rop)/d(concX_k) scaled with the net stoichiometric coefficient
+    ///    of k; in mass fraction, d(dY_k/dt)/dY_k = d(omega_k)/d(concX_k)
+    const real_type tiny(1e-20);
+    const ordinal_type joff = kmcd.reacSidx.extent(1) / 2;
+    Kokkos::parallel_for(
+      Kokkos::TeamVectorRange(member, kmcd.nReac), [&](const ordinal_type& i) {
+        /// inactive reaction in the reduced mechanism
+        if (kmcd.reacActive.extent(0) > 0 && !kmcd.reacActive(i))
+          return;
+
+        const real_type crnd_at_i = Crnd(i);
+        const ordinal_type irnu = kmcd.reacScoef(i);
+        ordinal_type iord(-1);
+        for (ordinal_type l = 0; l < kmcd.nOrdReac && iord < 0; ++l)
+          if (kmcd.reacAOrd(l) == i)
+            iord = l;
+
+        const auto nu = [&](const ordinal_type& k) {
+          return irnu < 0 ? real_type(kmcd.NuIJ(i, k))
+                          : kmcd.RealNuIJ(irnu, k);
+        };
+
+        if (iord >= 0) {
+          /// arbitrary order; negative indices are forward, positive reverse
+          const ordinal_type n = kmcd.maxOrdPar;
+          const auto order = [&](const ordinal_type& j) {
+            return kmcd.specAOval(iord, j);
+          };
+          serial_add_rop_derivative(
+            kfor(i) * crnd_at_i,
+            n,
+            [&](const ordinal_type& j) {
+              const ordinal_type idx = kmcd.specAOidx(iord, j);
+              return idx < 0 ? -idx - 1 : ordinal_type(-1);
+            },
+            order,
+            nu,
+            tiny,
+            concX,
+            diag);
+          serial_add_rop_derivative(
+            -krev(i) * crnd_at_i,
+            n,
+            [&](const ordinal_type& j) {
+              const ordinal_type idx = kmcd.specAOidx(iord, j);
+              return idx > 0 ? idx - 1 : ordinal_type(-1);
+            },
+            order,
+            nu,
+            tiny,
+            concX,
+            diag);
+        } else if (irnu >= 0) {
+          /// real stoichiometric coefficients
+          serial_add_rop_derivative(
+            kfor(i) * crnd_at_i,
+            kmcd.reacNreac(i),
+            [&](const ordinal_type& j) { return kmcd.reacSidx(i, j); },
+            [&](const ordinal_type& j) {
+              return ats<real_type>::abs(kmcd.reacRealNuki(irnu, j));
+            },
+            nu,
+            tiny,
+            concX,
+            diag);
+          if (kmcd.isRev(i))
+            serial_add_rop_derivative(
+              -krev(i) * crnd_at_i,
+              kmcd.reacNprod(i),
+              [&](const ordinal_type& j) { return kmcd.reacSidx(i, j + joff); },
+              [&](const ordinal_type& j) {
+                return kmcd.reacRealNuki(irnu, j + joff);
+              },
+              nu,
+              tiny,
+              concX,
+              diag);
+        } else {
+          /// integer stoichiometric coefficients; concentrations are used
+          /// as they are, consistent with RateOfProgress
+          serial_add_rop_derivative(
+            kfor(i) * crnd_at_i,
+            kmcd.reacNreac(i),
+            [&](const ordinal_type& j) { return kmcd.reacSidx(i, j); },
+            [&](const ordinal_type& j) {
+              return real_type(ats<ordinal_type>::abs(kmcd.reacNuki(i, j)));
+            },
+            nu,
+            zero,
+            concX,
+            diag);
+          if (kmcd.isRev(i))
+            serial_add_rop_derivative(
+              -krev(i) * crnd_at_i,
+              kmcd.reacNprod(i),
+              [&](const ordinal_type& j) { return kmcd.reacSidx(i, j + joff); },
+              [&](const ordinal_type& j) {
+                return real_type(kmcd.reacNuki(i, j + joff));
+              },
+              nu,
+              zero,
+              concX,
+              diag);
+        }
+      });
+    member.team_barrier();
+  }
+};
+
+} // namespace Impl
+} // namespace TChem
+
+#endif
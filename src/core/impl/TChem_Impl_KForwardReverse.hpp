@@ -21,8 +21,11 @@ Sandia National Laboratories, Livermore, CA, USA
 #ifndef __TCHEM_IMPL_KFORWARDREVERSE_HPP__
 #define __TCHEM_IMPL_KFORWARDREVERSE_HPP__
 
+#include "TChem_Impl_KForwardReverseTable.hpp"
 #include "TChem_Impl_SumNuGk.hpp"
 #include "TChem_Impl_SumRealNuGk.hpp"
+#include "TChem_Math.hpp"
+#include "TChem_Profiler.hpp"
 #include "TChem_Util.hpp"
 // #define TCHEM_ENABLE_SERIAL_TEST_OUTPUT
 namespace TChem {
@@ -49,6 +52,8 @@ struct KForwardReverse
     /// const input from kinetic model
     const KineticModelConstDataType& kmcd)
   {
+    TCHEM_PROFILE_TEAM_SCOPE(member, RateConstants);
+
     Kokkos::single(Kokkos::PerTeam(member), [&]() {
       /// compute iterators
       ordinal_type iplog(0), irev(0);
@@ -65,9 +70,16 @@ struct KForwardReverse
 
     const real_type zero(0);
     const real_type t_1 = real_type(1) / t;
-    const real_type tln = ats<real_type>::log(t);
+    const real_type tln = Math<real_type>::log(t);
     const real_type logP =
-      kmcd.nPlogReac > 0 ? ats<real_type>::log(p / ATMPA) : real_type(0);
+      kmcd.nPlogReac > 0 ? Math<real_type>::log(p / ATMPA) : real_type(0);
+
+    /// interpolation weights of the tabulated rate constants
+    const bool use_table = KForwardReverseTable::isValid(t, kmcd);
+    ordinal_type jtab(0);
+    real_type wtab[4] = {};
+    if (use_table)
+      KForwardReverseTable::getWeights(t, kmcd, jtab, wtab);
 
     ///
     /// this loop has an sparse access structure with an incremental indices
@@ -75,6 +87,23 @@ struct KForwardReverse
     ///
     Kokkos::parallel_for(
       Kokkos::TeamVectorRange(member, kmcd.nReac), [&](const ordinal_type& i) {
+        /// inactive reaction in the reduced mechanism
+        if (kmcd.reacActive.extent(0) > 0 && !kmcd.reacActive(i)) {
+          kfor(i) = zero;
+          krev(i) = zero;
+          return;
+        }
+
+        /// tabulated reaction; gk is not used
+        if (use_table && kmcd.lnKTableMask(i) > 0) {
+          real_type kf, kr;
+          KForwardReverseTable::serial_invoke(i, jtab, wtab, kmcd, kf, kr);
+          const real_type kfac = getArrheniusPerturbation(kmcd, i, t_1);
+          kfor(i) = kfac * kf;
+          krev(i) = kfac * kr;
+          return;
+        }
+
         const ordinal_type iplog = iplogs(i);
         const ordinal_type irev = irevs(i);
         const bool plogtest =
@@ -90,7 +119,7 @@ struct KForwardReverse
           // printf("reacPlogPars %e log %e\n",kmcd.reacPlogPars(idx,0), logP );
           if (logP <= kmcd.reacPlogPars(idx, 0)) {
             rpp.assign_data(&kmcd.reacPlogPars(idx, 0));
-            kfor(i) = ats<real_type>::exp(rpp(1) + rpp(2) * tln - rpp(3) * t_1);
+            kfor(i) = Math<real_type>::exp(rpp(1) + rpp(2) * tln - rpp(3) * t_1);
             // printf("ki i %d,  ki1 %e, logPi %e, log(A) %e, b %e, Ea %e \n",i,
             // kfor(i), rpp(0),rpp(1),rpp(2),rpp(3) );
 
@@ -101,7 +130,7 @@ struct KForwardReverse
             rpp.assign_data(&kmcd.reacPlogPars(idx, 0));
             if (logP >= kmcd.reacPlogPars(idx, 0)) {
               kfor(i) =
-                ats<real_type>::exp(rpp(1) + rpp(2) * tln - rpp(3) * t_1);
+                Math<real_type>::exp(rpp(1) + rpp(2) * tln - rpp(3) * t_1);
               // printf("ki i %d,  ki1 %e, logPi %e, log(A) %e, b %e, Ea %e
               // \n",i, kfor(i), rpp(0),rpp(1),rpp(2),rpp(3) );
             } else {
@@ -126,7 +155,7 @@ struct KForwardReverse
                   // printf("ki i %d,  ki1 %e, logPi %e, log(A) %e, b %e, Ea %e
                   // \n",i, ki, rpp(0),rpp(1),rpp(2),rpp(3) );
 
-                  kfor(i) = ats<real_type>::exp(
+                  kfor(i) = Math<real_type>::exp(
                     ki + (logP - rpp(0)) * (ki1 - ki) / (rpp1 - rpp(0)));
                   // printf("Reacton No %d  kfor PLOG %e\n",i, kfor(i) );
                   break;
@@ -137,10 +166,14 @@ struct KForwardReverse
         }       /* Done if reaction has a PLOG form */
         else {
           kfor(i) = (kmcd.reacArhenFor(i, 0) *
-                     ats<real_type>::exp(kmcd.reacArhenFor(i, 1) * tln -
+                     Math<real_type>::exp(kmcd.reacArhenFor(i, 1) * tln -
                                          kmcd.reacArhenFor(i, 2) * t_1));
         }
 
+        /// per-sample perturbation of the Arrhenius parameters
+        const real_type kfac = getArrheniusPerturbation(kmcd, i, t_1);
+        kfor(i) *= kfac;
+
         ///
         /// check reverse reaction
         ///
@@ -157,8 +190,8 @@ struct KForwardReverse
             krev(i) =
               (kmcd.reacArhenRev(irev, 0) < ats<real_type>::epsilon()
                  ? zero
-                 : kmcd.reacArhenRev(irev, 0) *
-                     ats<real_type>::exp(kmcd.reacArhenRev(irev, 1) * tln -
+                 : kfac * kmcd.reacArhenRev(irev, 0) *
+                     Math<real_type>::exp(kmcd.reacArhenRev(irev, 1) * tln -
                                          kmcd.reacArhenRev(irev, 2) * t_1));
           } /* done if section for reverse Arhenius parameters */
           else {
@@ -168,7 +201,7 @@ struct KForwardReverse
               ir == -1 ? SumNuGk::serial_invoke(i, gk, kmcd)
                        : SumRealNuGk::serial_invoke(i, ir, gk, kmcd);
             const real_type kc =
-              kmcd.kc_coeff(i) * ats<real_type>::exp(sumNuGk);
+              kmcd.kc_coeff(i) * Math<real_type>::exp(sumNuGk);
             krev(i) = kfor(i) / kc;
           } /* done if section for equilibrium constant */
         }   /* done if reaction is reversible */
@@ -272,7 +305,7 @@ struct KForwardReverseDerivative
     const real_type zero(0);
     const real_type t_1 = real_type(1) / t;
     const real_type logP =
-      kmcd.nPlogReac > 0 ? ats<real_type>::log(p / ATMPA) : real_type(0);
+      kmcd.nPlogReac > 0 ? Math<real_type>::log(p / ATMPA) : real_type(0);
 
     ///
     /// this loop has an sparse access structure with an incremental indices
@@ -324,6 +357,12 @@ struct KForwardReverseDerivative
             (t_1 * (kmcd.reacArhenFor(i, 1) + kmcd.reacArhenFor(i, 2) * t_1));
         }
 
+        /// d/dT of the per sample perturbation exp(dlnA - dEa/(R T))
+        const real_type kfacp =
+          kmcd.reacEaShift.extent(0) > 0 ? kmcd.reacEaShift(i) * t_1 * t_1
+                                         : zero;
+        kforp(i) += kfacp;
+
         ///
         /// check reverse reaction
         ///
@@ -337,7 +376,8 @@ struct KForwardReverseDerivative
           if (is_arhenius_parameters_given) {
             /* yes, reverse Arhenius parameters are given */
             krevp(i) = t_1 * (kmcd.reacArhenRev(irev, 1) +
-                              kmcd.reacArhenRev(irev, 2) * t_1);
+                              kmcd.reacArhenRev(irev, 2) * t_1) +
+                       kfacp;
           } /* done if section for reverse Arhenius parameters */
           else {
             /* no, need to compute equilibrium constant */
@@ -0,0 +1,129 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_IMPL_KFORWARD_REVERSE_MEMO_HPP__
+#define __TCHEM_IMPL_KFORWARD_REVERSE_MEMO_HPP__
+
+#include "TChem_Util.hpp"
+
+namespace TChem {
+namespace Impl {
+
+///
+/// Forward and reverse rate constants of the last evaluation keyed by
+/// temperature and pressure. Rate constants do not depend on composition,
+/// so repeated evaluations at the same temperature e.g., columns of a
+/// numerical jacobian perturbing mass fractions or isothermal problems,
+/// reuse them instead of evaluating gibbs energies and Arrhenius rates.
+///
+/// memo (getWorkSpaceSize) : [rtol, t, p, kfor(nReac), krev(nReac)]
+/// - the memo must be a workspace slice that is not shared with others
+/// - an empty memo disables memoization
+/// - team_reset is required before the first use as scratch memory is not
+///   initialized
+///
+struct KForwardReverseMemo
+{
+  template<typename KineticModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static ordinal_type getWorkSpaceSize(
+    const KineticModelConstDataType& kmcd)
+  {
+    return (3 + 2 * kmcd.nReac);
+  }
+
+  /// rtol - relative temperature difference below which the rate constants
+  ///        are reused (kmcd.memoRtol); zero requires a bit-identical
+  ///        temperature
+  template<typename MemberType, typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_reset(
+    const MemberType& member,
+    const RealType1DViewType& memo,
+    const real_type rtol)
+  {
+    if (memo.extent(0) > 0) {
+      Kokkos::single(Kokkos::PerTeam(member), [&]() {
+        memo(0) = rtol;
+        memo(1) = real_type(-1); /// no temperature matches
+        memo(2) = real_type(-1);
+      });
+      member.team_barrier();
+    }
+  }
+
+  template<typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static bool isValid(const RealType1DViewType& memo,
+                                             const real_type& t,
+                                             const real_type& p)
+  {
+    return (memo.extent(0) > 0 &&
+            ats<real_type>::abs(t - memo(1)) <= memo(0) * t && p == memo(2));
+  }
+
+  /// copies the memoized rate constants; returns false when the memo is not
+  /// valid at t and p and the rate constants must be evaluated
+  template<typename MemberType, typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static bool team_load(const MemberType& member,
+                                               const real_type& t,
+                                               const real_type& p,
+                                               const RealType1DViewType& memo,
+                                               const RealType1DViewType& kfor,
+                                               const RealType1DViewType& krev)
+  {
+    if (!isValid(memo, t, p))
+      return false;
+
+    const ordinal_type nReac = kfor.extent(0);
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, nReac),
+                         [&](const ordinal_type& i) {
+                           kfor(i) = memo(3 + i);
+                           krev(i) = memo(3 + nReac + i);
+                         });
+    member.team_barrier();
+    return true;
+  }
+
+  template<typename MemberType, typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_store(const MemberType& member,
+                                                const real_type& t,
+                                                const real_type& p,
+                                                const RealType1DViewType& kfor,
+                                                const RealType1DViewType& krev,
+                                                const RealType1DViewType& memo)
+  {
+    if (memo.extent(0) > 0) {
+      const ordinal_type nReac = kfor.extent(0);
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, nReac),
+                           [&](const ordinal_type& i) {
+                             memo(3 + i) = kfor(i);
+                             memo(3 + nReac + i) = krev(i);
+                           });
+      Kokkos::single(Kokkos::PerTeam(member), [&]() {
+        memo(1) = t;
+        memo(2) = p;
+      });
+      member.team_barrier();
+    }
+  }
+};
+
+} // namespace Impl
+} // namespace TChem
+
+#endif
@@ -51,11 +51,11 @@ struct KForwardReverseSurface
 
     const real_type t_1 = real_type(1) / t;
     const real_type tln = ats<real_type>::log(t);
-    const real_type ten(10);
-    // ordinal_type indx(0);
-
-    real_type Wk(0);
+    const real_type sqrt_t = ats<real_type>::sqrt(t);
 
+    /// the sticking prefactors, the gas nu sums and the unit conversion of
+    /// the equilibrium constant are precomputed in kmcdSurf; see
+    /// KineticModelData::initChemSurf
     Kokkos::parallel_for(
       Kokkos::TeamVectorRange(member, kmcdSurf.nReac),
       [&](const ordinal_type& i) {
@@ -65,52 +65,18 @@ struct KForwardReverseSurface
 
         if (kmcdSurf.isStick(i) == 1) {
           // eq 16.117 chapter 16 Robert J. Kee
-          ordinal_type m(0);
-          for (ordinal_type j = 0; j < kmcdSurf.reacNreac(i); j++) {
-            if (kmcdSurf.reacSsrf(i, j) == 1) { // if species is surface
-              m += ats<real_type>::abs(kmcdSurf.reacNuki(i, j));
-            } else if (kmcdSurf.reacSsrf(i, j) == 0) { // if species is gas
-              // get Wk
-              Wk = kmcd.sMass(kmcdSurf.reacSidx(
-                i, j)); // check this, assume only one species?
-            }
-          }
-          // evaluate
-          kfor(i) *= ats<real_type>::sqrt(kmcd.Rcgs * t / (DPI * Wk)) /
-                     ats<real_type>::pow(kmcdSurf.sitedensity, m);
+          kfor(i) *= kmcdSurf.stickFac(i) * sqrt_t;
         }
 
         /* is reaction reversible ? */
-
-        ordinal_type nusum = 0;
-        ordinal_type nusum2 = 0;
         if (kmcdSurf.isRev(i)) {
           // eq 16.105 chapter 16 Robert J. Kee
-          /* no, need to compute equilibrium constant */
-          for (ordinal_type j = 0; j < kmcdSurf.reacNreac(i); j++) {
-            if (kmcdSurf.reacSsrf(i, j) == 0) { // if species is gas
-              nusum += kmcdSurf.reacNuki(i, j);
-            } else if (kmcdSurf.reacSsrf(i, j) == 1) {
-              nusum2 += kmcdSurf.reacNuki(i, j);
-            }
-          }
-          const ordinal_type joff = kmcdSurf.maxSpecInReac / 2;
-
-          for (ordinal_type j = 0; j < kmcdSurf.reacNprod(i); j++) {
-            if (kmcdSurf.reacSsrf(i, j + joff) == 0) { // gas
-              nusum += kmcdSurf.reacNuki(i, j + joff);
-            } else if (kmcdSurf.reacSsrf(i, j + joff) == 1) {
-              nusum2 += kmcdSurf.reacNuki(i, j + joff);
-            }
-          }
-
           const real_type sumNuGk =
             SumNuGk::serial_invoke(i, gk, gkSurf, kmcdSurf);
 
           const real_type kc =
-            ats<real_type>::pow((ATMPA * ten / kmcd.Rcgs) * t_1, nusum) *
-            ats<real_type>::pow(kmcdSurf.sitedensity, nusum2) *
-            ats<real_type>::exp(sumNuGk);
+            kmcdSurf.kcFac(i) *
+            ats<real_type>::exp(sumNuGk - kmcdSurf.kcNuSum(i) * tln);
 
           krev(i) = kfor(i) / kc;
 
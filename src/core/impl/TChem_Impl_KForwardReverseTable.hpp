@@ -0,0 +1,102 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_IMPL_KFORWARD_REVERSE_TABLE_HPP__
+#define __TCHEM_IMPL_KFORWARD_REVERSE_TABLE_HPP__
+
+#include "TChem_Math.hpp"
+#include "TChem_Util.hpp"
+
+namespace TChem {
+namespace Impl {
+
+///
+/// Rate constants interpolated from tables of ln kfor and ln krev built by
+/// KineticModelData::setRateConstantTable
+///
+/// - the tables are (nGrid, nReac) on a uniform grid of 1/T over
+///   [TthrmMin, TthrmMax]; reactions are contiguous for a grid point so that
+///   the interpolation vectorizes over reactions with the same weights
+/// - four point (cubic) Lagrange interpolation in 1/T
+/// - lnKTableMask(i) is 0 when reaction i is not tabulated (plog reactions,
+///   non-positive rate constants), 1 when krev is zero and 2 otherwise
+///
+struct KForwardReverseTable
+{
+  template<typename KineticModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static bool isValid(
+    const real_type& t,
+    const KineticModelConstDataType& kmcd)
+  {
+    return (kmcd.lnKforTable.extent(0) > 0 && t >= kmcd.TthrmMin &&
+            t <= kmcd.TthrmMax);
+  }
+
+  /// interval j and interpolation weights of nodes j-1, j, j+1, j+2
+  template<typename KineticModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static void getWeights(
+    const real_type& t,
+    const KineticModelConstDataType& kmcd,
+    /* */ ordinal_type& j,
+    /* */ real_type* w)
+  {
+    const real_type one(1), two(2), half(0.5), sixth(1.0 / 6.0);
+    const ordinal_type n = kmcd.lnKforTable.extent(0) - 1;
+    const real_type s =
+      (one / t - kmcd.lnKTableInvTMin) / kmcd.lnKTableDeltaInvT;
+
+    j = ordinal_type(s);
+    j = j < 1 ? 1 : j > n - 2 ? n - 2 : j;
+
+    const real_type u = s - real_type(j);
+    const real_type up1 = u + one, um1 = u - one, um2 = u - two;
+    w[0] = -sixth * u * um1 * um2;
+    w[1] = half * up1 * um1 * um2;
+    w[2] = -half * up1 * u * um2;
+    w[3] = sixth * up1 * u * um1;
+  }
+
+  /// interpolated rate constants of reaction i; lnKTableMask(i) > 0
+  template<typename KineticModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static void serial_invoke(
+    const ordinal_type& i,
+    const ordinal_type& j,
+    const real_type* w,
+    const KineticModelConstDataType& kmcd,
+    /* */ real_type& kfor,
+    /* */ real_type& krev)
+  {
+    const auto& tf = kmcd.lnKforTable;
+    kfor = Math<real_type>::exp(w[0] * tf(j - 1, i) + w[1] * tf(j, i) +
+                               w[2] * tf(j + 1, i) + w[3] * tf(j + 2, i));
+    if (kmcd.lnKTableMask(i) == 2) {
+      const auto& tr = kmcd.lnKrevTable;
+      krev = Math<real_type>::exp(w[0] * tr(j - 1, i) + w[1] * tr(j, i) +
+                                 w[2] * tr(j + 1, i) + w[3] * tr(j + 2, i));
+    } else {
+      krev = real_type(0);
+    }
+  }
+};
+
+} // namespace Impl
+} // namespace TChem
+
+#endif
@@ -0,0 +1,445 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_IMPL_NEWTON_KRYLOV_SOLVER_HPP__
+#define __TCHEM_IMPL_NEWTON_KRYLOV_SOLVER_HPP__
+
+#include "TChem_Impl_DenseNanInf.hpp"
+#include "TChem_Util.hpp"
+
+namespace TChem {
+namespace Impl {
+
+/// problems that provide computeJacobianDiagonal declare
+///   static constexpr bool has_jacobian_diagonal = true;
+template<typename ProblemType, typename Enable = void>
+struct HasJacobianDiagonal
+{
+  static constexpr bool value = false;
+};
+
+template<typename ProblemType>
+struct HasJacobianDiagonal<
+  ProblemType,
+  typename std::enable_if<ProblemType::has_jacobian_diagonal>::type>
+{
+  static constexpr bool value = true;
+};
+
+/// with TCHEM_ENABLE_TIME_INTEGRATOR_USE_NEWTON_KRYLOV, the time integrator
+/// uses the jacobian-free solver only for problems with a jacobian diagonal;
+/// the others keep the dense NewtonSolver
+template<typename ProblemType>
+struct UseNewtonKrylovSolver
+{
+#if defined(TCHEM_ENABLE_TIME_INTEGRATOR_USE_NEWTON_KRYLOV)
+  static constexpr bool value = HasJacobianDiagonal<ProblemType>::value;
+#else
+  static constexpr bool value = false;
+#endif
+};
+
+/// Jacobian-free Newton-Krylov solver
+/// - restarted GMRES(k) solves J dx = f
+/// - J v is approximated by a directional finite difference of computeFunction
+/// - right preconditioning with the Jacobian diagonal given by
+///   problem.computeJacobianDiagonal
+/// - workspace is O(m*k) instead of O(m*m)
+struct NewtonKrylovSolver
+{
+  /// Krylov subspace dimension
+  static constexpr ordinal_type krylov_dimension = 20;
+  /// maximum number of GMRES restarts
+  static constexpr ordinal_type max_num_restarts = 4;
+
+  KOKKOS_INLINE_FUNCTION static ordinal_type getKrylovDimension(
+    const ordinal_type& m)
+  {
+    return (m < krylov_dimension ? m : krylov_dimension);
+  }
+
+  template<typename ProblemType>
+  KOKKOS_INLINE_FUNCTION static ordinal_type getWorkSpaceSize(
+    const ProblemType& problem)
+  {
+    const ordinal_type m = problem.getNumberOfEquations();
+    const ordinal_type k = getKrylovDimension(m);
+    /// V, H, cs, sn, g, diag, z, xs, fs
+    const ordinal_type r_val =
+      m * (k + 1) + (k + 1) * k + k + k + (k + 1) + 4 * m;
+    return r_val;
+  }
+
+  template<typename MemberType, typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static real_type computeDot(
+    const MemberType& member,
+    const ordinal_type& m,
+    const RealType1DViewType& x,
+    const RealType1DViewType& y)
+  {
+    real_type r_val(0);
+    Kokkos::parallel_reduce(
+      Kokkos::TeamVectorRange(member, m),
+      [&](const ordinal_type& i, real_type& update) { update += x(i) * y(i); },
+      r_val);
+    return r_val;
+  }
+
+  /// Jv = (f(x + sigma v) - f(x))/sigma
+  template<typename MemberType,
+           typename ProblemType,
+           typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static void computeJacobianVector(
+    const MemberType& member,
+    const ProblemType& problem,
+    const real_type& norm_x,
+    const RealType1DViewType& x,
+    const RealType1DViewType& f,
+    const RealType1DViewType& v,
+    /// output
+    const RealType1DViewType& Jv,
+    /// workspace
+    const RealType1DViewType& xs,
+    const RealType1DViewType& fs)
+  {
+    const real_type zero(0), one(1);
+    const ordinal_type m = problem.getNumberOfEquations();
+    const real_type norm_v = ats<real_type>::sqrt(computeDot(member, m, v, v));
+    if (norm_v == zero) {
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const ordinal_type& i) { Jv(i) = zero; });
+      member.team_barrier();
+      return;
+    }
+    const real_type sigma =
+      ats<real_type>::sqrt(ats<real_type>::epsilon()) * (one + norm_x) / norm_v;
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                         [&](const ordinal_type& i) {
+                           xs(i) = x(i) + sigma * v(i);
+                         });
+    member.team_barrier();
+    problem.computeFunction(member, xs, fs);
+    member.team_barrier();
+    const real_type osigma = one / sigma;
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                         [&](const ordinal_type& i) {
+                           Jv(i) = (fs(i) - f(i)) * osigma;
+                         });
+    member.team_barrier();
+  }
+
+  /// right preconditioned restarted GMRES for J dx = f
+  /// - diag holds the inverse of the preconditioner
+  template<typename MemberType,
+           typename ProblemType,
+           typename RealType1DViewType,
+           typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke_gmres(
+    const MemberType& member,
+    const ProblemType& problem,
+    const real_type& tol,
+    const RealType1DViewType& x,
+    const RealType1DViewType& f,
+    const RealType1DViewType& diag,
+    /// output
+    const RealType1DViewType& dx,
+    /// workspace
+    const RealType2DViewType& V,
+    const RealType2DViewType& H,
+    const RealType1DViewType& cs,
+    const RealType1DViewType& sn,
+    const RealType1DViewType& g,
+    const RealType1DViewType& z,
+    const RealType1DViewType& xs,
+    const RealType1DViewType& fs)
+  {
+    const real_type zero(0), one(1);
+    const ordinal_type m = problem.getNumberOfEquations();
+    const ordinal_type kdim = V.extent(0) - 1;
+
+    const real_type norm_x = ats<real_type>::sqrt(computeDot(member, m, x, x));
+
+    /// initial guess is zero and the residual is f
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                         [&](const ordinal_type& i) {
+                           dx(i) = zero;
+                           V(0, i) = f(i);
+                         });
+    member.team_barrier();
+
+    real_type beta = ats<real_type>::sqrt(computeDot(member, m, f, f));
+
+    for (ordinal_type restart = 0; restart < max_num_restarts && beta > tol;
+         ++restart) {
+      {
+        const real_type obeta = one / beta;
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const ordinal_type& i) { V(0, i) *= obeta; });
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, kdim + 1),
+                             [&](const ordinal_type& i) {
+                               g(i) = (i == 0 ? beta : zero);
+                             });
+        member.team_barrier();
+      }
+
+      /// arnoldi with modified gram-schmidt
+      ordinal_type j = 0;
+      for (; j < kdim;) {
+        const RealType1DViewType v_j(&V(j, 0), m), v_jp1(&V(j + 1, 0), m);
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const ordinal_type& i) {
+                               z(i) = v_j(i) * diag(i);
+                             });
+        member.team_barrier();
+        computeJacobianVector(member, problem, norm_x, x, f, z, v_jp1, xs, fs);
+
+        for (ordinal_type l = 0; l <= j; ++l) {
+          const RealType1DViewType v_l(&V(l, 0), m);
+          const real_type h = computeDot(member, m, v_l, v_jp1);
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                               [&](const ordinal_type& i) {
+                                 v_jp1(i) -= h * v_l(i);
+                               });
+          Kokkos::single(Kokkos::PerTeam(member), [&]() { H(l, j) = h; });
+          member.team_barrier();
+        }
+        const real_type hn =
+          ats<real_type>::sqrt(computeDot(member, m, v_jp1, v_jp1));
+        if (hn > zero) {
+          const real_type ohn = one / hn;
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                               [&](const ordinal_type& i) { v_jp1(i) *= ohn; });
+        }
+
+        /// givens rotations for the least squares problem
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          H(j + 1, j) = hn;
+          for (ordinal_type l = 0; l < j; ++l) {
+            const real_type tmp = cs(l) * H(l, j) + sn(l) * H(l + 1, j);
+            H(l + 1, j) = -sn(l) * H(l, j) + cs(l) * H(l + 1, j);
+            H(l, j) = tmp;
+          }
+          const real_type a = H(j, j), b = H(j + 1, j);
+          const real_type r = ats<real_type>::sqrt(a * a + b * b);
+          cs(j) = (r == zero ? one : a / r);
+          sn(j) = (r == zero ? zero : b / r);
+          H(j, j) = r;
+          H(j + 1, j) = zero;
+          g(j + 1) = -sn(j) * g(j);
+          g(j) = cs(j) * g(j);
+        });
+        member.team_barrier();
+
+        ++j;
+        const real_type resid = ats<real_type>::abs(g(j));
+        if (resid <= tol || hn == zero)
+          break;
+      }
+
+      /// back substitution; g is overwritten with the solution
+      Kokkos::single(Kokkos::PerTeam(member), [&]() {
+        for (ordinal_type l = j - 1; l >= 0; --l) {
+          real_type val = g(l);
+          for (ordinal_type q = l + 1; q < j; ++q)
+            val -= H(l, q) * g(q);
+          g(l) = (H(l, l) == zero ? zero : val / H(l, l));
+        }
+      });
+      member.team_barrier();
+
+      /// dx += M^{-1} V y
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const ordinal_type& i) {
+                             real_type val(0);
+                             for (ordinal_type l = 0; l < j; ++l)
+                               val += V(l, i) * g(l);
+                             dx(i) += diag(i) * val;
+                           });
+      member.team_barrier();
+
+      /// true residual for the next restart, r = f - J dx
+      {
+        const RealType1DViewType r(&V(0, 0), m);
+        computeJacobianVector(member, problem, norm_x, x, f, dx, r, xs, fs);
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const ordinal_type& i) { r(i) = f(i) - r(i); });
+        member.team_barrier();
+        beta = ats<real_type>::sqrt(computeDot(member, m, r, r));
+      }
+    }
+  }
+
+  template<typename MemberType,
+           typename ProblemType,
+           typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke(
+    const MemberType& member,
+    /// intput
+    const ProblemType& problem,
+    const real_type& atol,
+    const real_type& rtol,
+    const ordinal_type& max_iter,
+    /// input/output
+    const RealType1DViewType& x,
+    /// workspace
+    const RealType1DViewType& dx,
+    const RealType1DViewType& f,
+    const RealType1DViewType& w, // workspace
+                                 /// output
+    /* */ ordinal_type& iter_count,
+    /* */ ordinal_type& converge)
+  {
+    static_assert(HasJacobianDiagonal<ProblemType>::value,
+                  "NewtonKrylovSolver requires problem.computeJacobianDiagonal");
+    using real_type_2d_view_type = typename ProblemType::real_type_2d_view_type;
+
+    const real_type one(1);
+    /// inexact newton forcing term
+    const real_type eta(0.1);
+
+    converge = false;
+
+    /// the problem is square
+    const ordinal_type n = problem.getNumberOfEquations();
+    const ordinal_type k = getKrylovDimension(n);
+
+    real_type* wptr = w.data();
+    auto V = real_type_2d_view_type(wptr, k + 1, n);
+    wptr += V.span();
+    auto H = real_type_2d_view_type(wptr, k + 1, k);
+    wptr += H.span();
+    auto cs = RealType1DViewType(wptr, k);
+    wptr += cs.span();
+    auto sn = RealType1DViewType(wptr, k);
+    wptr += sn.span();
+    auto g = RealType1DViewType(wptr, k + 1);
+    wptr += g.span();
+    auto diag = RealType1DViewType(wptr, n);
+    wptr += diag.span();
+    auto z = RealType1DViewType(wptr, n);
+    wptr += z.span();
+    auto xs = RealType1DViewType(wptr, n);
+    wptr += xs.span();
+    auto fs = RealType1DViewType(wptr, n);
+    wptr += fs.span();
+    assert(ordinal_type(wptr - w.data()) <= ordinal_type(w.extent(0)) &&
+           "Error: given workspace is smaller than required");
+
+    problem.computeInitValues(member, x);
+    bool is_valid(true);
+    ordinal_type iter = 0;
+    real_type norm2_f0(0);
+    for (; iter < max_iter && !converge; ++iter) {
+      problem.computeJacobianDiagonal(member, x, diag);
+      problem.computeFunction(member, x, f);
+      /// sanity check
+      TChem::Impl::DenseNanInf ::team_check_sanity(member, f, is_valid);
+
+      if (is_valid) {
+        /// jacobi preconditioner; fall back to identity for vanishing entries
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, n),
+                             [&](const ordinal_type& i) {
+                               const real_type d = diag(i);
+                               diag(i) = (ats<real_type>::abs(d) >
+                                              ats<real_type>::epsilon()
+                                            ? one / d
+                                            : one);
+                             });
+        member.team_barrier();
+
+        const real_type norm2_f =
+          ats<real_type>::sqrt(computeDot(member, n, f, f));
+
+        /// solve the equation: dx = -J^{-1} f(x);
+        team_invoke_gmres(member,
+                          problem,
+                          eta * norm2_f,
+                          x,
+                          f,
+                          diag,
+                          dx,
+                          V,
+                          H,
+                          cs,
+                          sn,
+                          g,
+                          z,
+                          xs,
+                          fs);
+
+#if defined(TCHEM_ENABLE_NEWTONSOLVER_USE_WRMS_NORMS)
+        /// update the solution x and compute norm
+        real_type sum(0);
+        Kokkos::parallel_reduce(
+          Kokkos::TeamVectorRange(member, n),
+          [&](const ordinal_type& i, real_type& val) {
+            x(i) -= dx(i);
+            const real_type w_at_i =
+              one / (rtol * ats<real_type>::abs(x(i)) + atol);
+            const real_type mult_val = ats<real_type>::abs(f(i)) * w_at_i;
+            val += mult_val * mult_val;
+          },
+          sum);
+
+        /// update norm f
+        const real_type norm2_fn = ats<real_type>::sqrt(sum) / real_type(n);
+
+        /// check convergence
+        converge = norm2_fn < one;
+#else
+        /// update the solution x and compute norm
+        real_type sum(0);
+        Kokkos::parallel_reduce(
+          Kokkos::TeamVectorRange(member, n),
+          [&](const ordinal_type& i, real_type& val) {
+            x(i) -= dx(i);
+            val += ats<real_type>::abs(f(i)) * ats<real_type>::abs(f(i));
+          },
+          sum);
+
+        /// update norm f
+        const real_type norm2_fn = ats<real_type>::sqrt(sum) / real_type(n);
+        if (iter == 0) {
+          norm2_f0 = norm2_fn;
+        }
+
+        /// || f_n || < atol
+        const bool a_conv = norm2_fn < atol;
+
+        /// || f_n || / || f_0 || < rtol
+        const bool r_conv = norm2_fn / norm2_f0 < rtol;
+
+        /// check convergence
+        converge = a_conv || r_conv;
+#endif
+        member.team_barrier();
+      } else {
+        converge = false;
+      }
+    }
+    /// record the final number of iterations
+    iter_count = iter;
+  }
+};
+
+} // namespace Impl
+} // namespace TChem
+
+#endif
@@ -23,6 +23,7 @@ Sandia National Laboratories, Livermore, CA, USA
 
 #include "TChem_Impl_DenseNanInf.hpp"
 #include "TChem_Impl_DenseUTV.hpp"
+#include "TChem_Profiler.hpp"
 #include "TChem_Util.hpp"
 
 namespace TChem {
@@ -30,14 +31,21 @@ namespace Impl {
 
 struct NewtonSolver
 {
+  /// the iteration matrix is factorized in float when mixed precision is
+  /// enabled; residuals, solutions and norms are computed in real_type
+#if defined(TCHEM_ENABLE_NEWTONSOLVER_USE_MIXED_PRECISION)
+  using linear_solver_type = DenseUTVMixedPrecision;
+#else
+  using linear_solver_type = DenseUTV;
+#endif
+
   template<typename ProblemType>
   KOKKOS_INLINE_FUNCTION static ordinal_type getWorkSpaceSize(
     const ProblemType& problem)
   {
-    const ordinal_type m = problem.getNumberOfEquations(), n = m;
-    const ordinal_type r_val = m * m + n * n + n + (m < n ? m : n) + n + n;
+    const ordinal_type m = problem.getNumberOfEquations();
     /// UTV workspace for single right hand side
-    return r_val;
+    return linear_solver_type::getWorkSpaceSize(m, m);
   }
 
   template<typename MemberType,
@@ -60,9 +68,14 @@ struct NewtonSolver
     const RealType1DViewType& w, // workspace
                                  /// output
     /* */ ordinal_type& iter_count,
-    /* */ ordinal_type& converge)
+    /* */ ordinal_type& converge,
+    /// numeric rank of the last factorization left in J and w
+    /* */ ordinal_type& matrix_rank)
   {
+    TCHEM_PROFILE_TEAM_SCOPE(member, NewtonSolver);
+
     converge = false;
+    matrix_rank = 0;
     real_type* wptr = w.data();
     /// the problem is square
     const ordinal_type n = problem.getNumberOfEquations();
@@ -76,16 +89,24 @@ struct NewtonSolver
     ordinal_type iter = 0;
     real_type norm2_f0(0);
     for (; iter < max_iter && !converge; ++iter) {
-      problem.computeJacobian(member, x, J);
-      problem.computeFunction(member, x, f);
+      {
+        TCHEM_PROFILE_TEAM_SCOPE(member, ProblemJacobian);
+        problem.computeJacobian(member, x, J);
+      }
+      {
+        TCHEM_PROFILE_TEAM_SCOPE(member, ProblemFunction);
+        problem.computeFunction(member, x, f);
+      }
       /// sanity check
       TChem::Impl::DenseNanInf ::team_check_sanity(member, J, is_valid);
 
       if (is_valid) {
         /// solve the equation: dx = -J^{-1} f(x);
-        ordinal_type matrix_rank(0);
-        TChem::Impl::DenseUTV ::team_factorize_and_solve(
-          member, J, dx, f, work, matrix_rank);
+        {
+          TCHEM_PROFILE_TEAM_SCOPE(member, Factorization);
+          linear_solver_type::team_factorize_and_solve(
+            member, J, dx, f, work, matrix_rank);
+        }
 
 #if defined(TCHEM_ENABLE_NEWTONSOLVER_USE_WRMS_NORMS)
         const real_type one(1);
@@ -143,6 +164,44 @@ struct NewtonSolver
     /// record the final number of iterations
     iter_count = iter;
   }
+
+  template<typename MemberType,
+           typename ProblemType,
+           typename RealType1DViewType,
+           typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke(
+    const MemberType& member,
+    /// intput
+    const ProblemType& problem,
+    const real_type& atol,
+    const real_type& rtol,
+    const ordinal_type& max_iter,
+    /// input/output
+    const RealType1DViewType& x,
+    /// workspace
+    const RealType1DViewType& dx,
+    const RealType1DViewType& f,
+    const RealType2DViewType& J,
+    const RealType1DViewType& w, // workspace
+                                 /// output
+    /* */ ordinal_type& iter_count,
+    /* */ ordinal_type& converge)
+  {
+    ordinal_type matrix_rank(0);
+    team_invoke(member,
+                problem,
+                atol,
+                rtol,
+                max_iter,
+                x,
+                dx,
+                f,
+                J,
+                w,
+                iter_count,
+                converge,
+                matrix_rank);
+  }
 };
 
 } // namespace Impl
@@ -94,6 +94,9 @@ struct PlugFlowReactorRHS
     const RealType1DViewType& ropForSurf,
     const RealType1DViewType& ropRevSurf,
     const OrdinalType1DViewType& iterSurf,
+    /// rate constants of the last evaluation (can be empty)
+    const RealType1DViewType& memo,
+    const RealType1DViewType& memoSurf,
 
     /// const input from kinetic model
     const KineticModelConstDataType& kmcd,
@@ -132,6 +135,7 @@ struct PlugFlowReactorRHS
                                        ropRev,
                                        Crnd,
                                        iter,
+                                       memo,
                                        kmcd);
 
     member.team_barrier();
@@ -156,6 +160,7 @@ struct PlugFlowReactorRHS
                                               ropForSurf,
                                               ropRevSurf,
                                               iterSurf, //
+                                              memoSurf,
                                               kmcd,
                                               kmcdSurf);
 
@@ -304,6 +309,50 @@ struct PlugFlowReactorRHS
     const KineticModelConstDataType& kmcd,
     const KineticSurfModelConstDataType& kmcdSurf,
     const PlugFlowReactorConstDataType& pfrd)
+  {
+    team_invoke(member,
+                t,
+                Ys,
+                Zs,
+                density,
+                p,
+                u,
+                rhs,
+                work,
+                RealType1DViewType(),
+                RealType1DViewType(),
+                kmcd,
+                kmcdSurf,
+                pfrd);
+  }
+
+  /// memo, memoSurf (KForwardReverseMemo::getWorkSpaceSize) - gas and surface
+  /// rate constants of the last evaluation
+  template<typename MemberType,
+           typename WorkViewType,
+           typename RealType1DViewType,
+           typename KineticModelConstDataType,
+           typename KineticSurfModelConstDataType,
+           typename PlugFlowReactorConstDataType>
+  KOKKOS_FORCEINLINE_FUNCTION static void team_invoke(
+    const MemberType& member,
+    /// input
+    const real_type& t,
+    const RealType1DViewType& Ys, /// (kmcd.nSpec)
+    const RealType1DViewType& Zs, // (kmcdSurf.nSpec) site fraction
+    const real_type& density,
+    const real_type& p, // pressure
+    const real_type& u, // velocity
+    /// output
+    const RealType1DViewType& rhs, /// (kmcd.nSpec + 1)
+    /// workspace
+    const WorkViewType& work,
+    const RealType1DViewType& memo,
+    const RealType1DViewType& memoSurf,
+    /// const input from kinetic model
+    const KineticModelConstDataType& kmcd,
+    const KineticSurfModelConstDataType& kmcdSurf,
+    const PlugFlowReactorConstDataType& pfrd)
   {
     // const real_type zero(0);
 
@@ -424,6 +473,8 @@ struct PlugFlowReactorRHS
                        ropForSurf,
                        ropRevSurf,
                        iterSurf,
+                       memo,
+                       memoSurf,
                        // data from surface and gas phases
                        kmcd,
                        kmcdSurf,
@@ -21,6 +21,7 @@ Sandia National Laboratories, Livermore, CA, USA
 #ifndef __TCHEM_IMPL_RATEOFPROGRESS_HPP__
 #define __TCHEM_IMPL_RATEOFPROGRESS_HPP__
 
+#include "TChem_Profiler.hpp"
 #include "TChem_Util.hpp"
 // #define TCHEM_ENABLE_SERIAL_TEST_OUTPUT
 namespace TChem {
@@ -50,6 +51,8 @@ struct RateOfProgress
     /// const input from kinetic model
     const KineticModelConstDataType& kmcd)
   {
+    TCHEM_PROFILE_TEAM_SCOPE(member, RateOfProgress);
+
     Kokkos::single(Kokkos::PerTeam(member), [&]() {
       /// compute iterators
       ordinal_type irnu(0), iord(0);
@@ -72,6 +75,12 @@ struct RateOfProgress
 
     Kokkos::parallel_for(
       Kokkos::TeamVectorRange(member, kmcd.nReac), [&](const ordinal_type& i) {
+        /// inactive reaction in the reduced mechanism
+        if (kmcd.reacActive.extent(0) > 0 && !kmcd.reacActive(i)) {
+          ropFor(i) = real_type(0);
+          ropRev(i) = real_type(0);
+          return;
+        }
         real_type ropFor_at_i = kfor(i);
         real_type ropRev_at_i = krev(i);
 
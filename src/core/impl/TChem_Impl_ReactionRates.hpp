@@ -24,9 +24,11 @@ Sandia National Laboratories, Livermore, CA, USA
 #include "TChem_Impl_Crnd.hpp"
 #include "TChem_Impl_Gk.hpp"
 #include "TChem_Impl_KForwardReverse.hpp"
+#include "TChem_Impl_KForwardReverseMemo.hpp"
 #include "TChem_Impl_MolarConcentrations.hpp"
 #include "TChem_Impl_RateOfProgress.hpp"
 #include "TChem_Impl_ThirdBodyConcentrations.hpp"
+#include "TChem_Profiler.hpp"
 #include "TChem_Util.hpp"
 // #define TCHEM_ENABLE_SERIAL_TEST_OUTPUT
 namespace TChem {
@@ -65,29 +67,42 @@ struct ReactionRates
     const RealType1DViewType& ropRev,
     const RealType1DViewType& Crnd,
     const OrdinalType1DViewType& iter,
+    /// rate constants of the last evaluation (can be empty)
+    const RealType1DViewType& memo,
     /// const input from kinetic model
     const KineticModelConstDataType& kmcd)
   {
+    TCHEM_PROFILE_TEAM_SCOPE(member, ReactionRates);
+
     const real_type zero(0);
 
-    /// 0. compute (-ln(T)+dS/R-dH/RT) for each species
-    Gk ::team_invoke(member,
-                     t, /// input
-                     gk,
-                     hks,  /// output
-                     cpks, /// workspace
-                     kmcd);
-    member.team_barrier();
+    /// rate constants depend on pressure only through plog reactions
+    const real_type p_memo = kmcd.nPlogReac > 0 ? p : zero;
+    if (!KForwardReverseMemo::team_load(member, t, p_memo, memo, kfor, krev)) {
+      /// 0. compute (-ln(T)+dS/R-dH/RT) for each species; not needed when
+      ///    all rate constants are tabulated
+      if (!(KForwardReverseTable::isValid(t, kmcd) && kmcd.lnKTableComplete)) {
+        Gk ::team_invoke(member,
+                         t, /// input
+                         gk,
+                         hks,  /// output
+                         cpks, /// workspace
+                         kmcd);
+        member.team_barrier();
+      }
 
-    /// 1. compute forward and reverse rate constants
-    KForwardReverse ::team_invoke(member,
-                                  t,
-                                  p,
-                                  gk, /// input
-                                  kfor,
-                                  krev, /// output
-                                  iter,
-                                  kmcd);
+      /// 1. compute forward and reverse rate constants
+      KForwardReverse ::team_invoke(member,
+                                    t,
+                                    p,
+                                    gk, /// input
+                                    kfor,
+                                    krev, /// output
+                                    iter,
+                                    kmcd);
+      member.team_barrier();
+      KForwardReverseMemo::team_store(member, t, p_memo, kfor, krev, memo);
+    }
 
     ///
     /// workspace needed concX = w0, concM = w1, kfor, krev
@@ -147,6 +162,9 @@ struct ReactionRates
         rop(i) -= ropRev(i);
         rop(i) *= Crnd(i);
         const real_type rop_at_i = rop(i);
+        /// inactive reaction in the reduced mechanism has zero rate
+        if (kmcd.reacActive.extent(0) > 0 && !kmcd.reacActive(i))
+          return;
         for (ordinal_type j = 0; j < kmcd.reacNreac(i); ++j) {
           const ordinal_type kspec = kmcd.reacSidx(i, j);
           // omega(kspec) += kmcd.reacNuki(i,j)*rop_at_i;
@@ -253,6 +271,29 @@ struct ReactionRates
     /// kmcd.nReac(5) : concM,kfor,krev,rop,Crnd
     /// const input from kinetic model
     const KineticModelConstDataType& kmcd)
+  {
+    team_invoke(member, t, p, Ys, omega, work, RealType1DViewType(), kmcd);
+  }
+
+  /// memo (KForwardReverseMemo::getWorkSpaceSize) - rate constants of the
+  /// last evaluation; reused when temperature and pressure are unchanged
+  template<typename MemberType,
+           typename WorkViewType,
+           typename RealType1DViewType,
+           typename KineticModelConstDataType>
+  KOKKOS_FORCEINLINE_FUNCTION static void team_invoke(
+    const MemberType& member,
+    /// input
+    const real_type& t,
+    const real_type& p,
+    const RealType1DViewType& Ys, /// (kmcd.nSpec)
+    /// output
+    const RealType1DViewType& omega, /// (kmcd.nSpec)
+    /// workspace
+    const WorkViewType& work,
+    const RealType1DViewType& memo,
+    /// const input from kinetic model
+    const KineticModelConstDataType& kmcd)
   {
     ///const real_type zero(0);  /// not used
 
@@ -305,6 +346,7 @@ struct ReactionRates
                        ropRev,
                        Crnd,
                        iter,
+                       memo,
                        kmcd);
   }
 };
@@ -22,6 +22,7 @@ Sandia National Laboratories, Livermore, CA, USA
 #define __TCHEM_IMPL_ReactionRatesSurface_HPP__
 
 #include "TChem_Impl_Gk.hpp"
+#include "TChem_Impl_KForwardReverseMemo.hpp"
 #include "TChem_Impl_KForwardReverseSurface.hpp"
 #include "TChem_Impl_MolarConcentrations.hpp"
 #include "TChem_Impl_RateOfProgressSurface.hpp"
@@ -85,6 +86,8 @@ struct ReactionRatesSurface
     const RealType1DViewType& ropRev,
     // const RealType1DViewType &Crnd,
     const OrdinalType1DViewType& iter,
+    /// surface rate constants of the last evaluation (can be empty)
+    const RealType1DViewType& memo,
     /// const input from kinetic model
     const KineticModelConstDataType& kmcd,
     /// const input from surface kinetic model
@@ -127,41 +130,48 @@ struct ReactionRatesSurface
                            });
     }
 
-    /*3. compute (-ln(T)+dS/R-dH/RT) for each species */
-    /* We are computing (dS-dH)/R for each species
-    gk is Gibbs free energy */
-
-    GkSurfGas ::team_invoke(member,
-                            t, /// input
-                            gk,
-                            hks,  /// output
-                            cpks, /// workspace
-                            kmcd);
-    // member.team_barrier();
-
-    // surfaces
-    GkSurfGas ::team_invoke(member,
-                            t, /// input
-                            Surf_gk,
-                            Surf_hks,  /// output
-                            Surf_cpks, /// workspace
-                            kmcdSurf);
-
     member.team_barrier();
 
-    /* compute forward and reverse rate constants */
-    KForwardReverseSurface ::team_invoke(member,
-                                         t,
-                                         p,
-                                         gk,
-                                         Surf_gk, /// input
-                                         kfor,
-                                         krev, /// output
-                                         iter,
-                                         kmcd,    // gas info
-                                         kmcdSurf // surface info
-    );
-    member.team_barrier();
+    /// surface rate constants do not depend on pressure
+    const real_type p_memo(0);
+    if (!KForwardReverseMemo::team_load(member, t, p_memo, memo, kfor, krev)) {
+      /*3. compute (-ln(T)+dS/R-dH/RT) for each species */
+      /* We are computing (dS-dH)/R for each species
+      gk is Gibbs free energy */
+
+      GkSurfGas ::team_invoke(member,
+                              t, /// input
+                              gk,
+                              hks,  /// output
+                              cpks, /// workspace
+                              kmcd);
+      // member.team_barrier();
+
+      // surfaces
+      GkSurfGas ::team_invoke(member,
+                              t, /// input
+                              Surf_gk,
+                              Surf_hks,  /// output
+                              Surf_cpks, /// workspace
+                              kmcdSurf);
+
+      member.team_barrier();
+
+      /* compute forward and reverse rate constants */
+      KForwardReverseSurface ::team_invoke(member,
+                                           t,
+                                           p,
+                                           gk,
+                                           Surf_gk, /// input
+                                           kfor,
+                                           krev, /// output
+                                           iter,
+                                           kmcd,    // gas info
+                                           kmcdSurf // surface info
+      );
+      member.team_barrier();
+      KForwardReverseMemo::team_store(member, t, p_memo, kfor, krev, memo);
+    }
 
     // /// compute rate-of-progress
     RateOfProgressSurface::team_invoke(member,
@@ -246,6 +256,43 @@ struct ReactionRatesSurface
     /// const input from kinetic model
     const KineticModelConstDataType& kmcd,
     const KineticSurfModelConstDataType& kmcdSurf)
+  {
+    team_invoke(member,
+                t,
+                p,
+                Yk,
+                zSurf,
+                omega,
+                omegaSurf,
+                work,
+                RealType1DViewType(),
+                kmcd,
+                kmcdSurf);
+  }
+
+  /// memo (KForwardReverseMemo::getWorkSpaceSize(kmcdSurf)) - surface rate
+  /// constants of the last evaluation
+  template<typename MemberType,
+           typename WorkViewType,
+           typename RealType1DViewType,
+           typename KineticModelConstDataType,
+           typename KineticSurfModelConstDataType>
+  KOKKOS_FORCEINLINE_FUNCTION static void team_invoke(
+    const MemberType& member,
+    /// input
+    const real_type& t,
+    const real_type& p,
+    const RealType1DViewType& Yk,    /// (kmcd.nSpec)
+    const RealType1DViewType& zSurf, //(kmcdSurf.nSpec)
+    /// output
+    const RealType1DViewType& omega, /// (kmcd.nSpec)
+    const RealType1DViewType& omegaSurf,
+    /// workspace
+    const WorkViewType& work,
+    const RealType1DViewType& memo,
+    /// const input from kinetic model
+    const KineticModelConstDataType& kmcd,
+    const KineticSurfModelConstDataType& kmcdSurf)
   {
     ///const real_type zero(0); // not used
 
@@ -314,6 +361,7 @@ struct ReactionRatesSurface
                        ropFor,
                        ropRev,
                        iter,
+                       memo,
                        kmcd,
                        kmcdSurf);
   }
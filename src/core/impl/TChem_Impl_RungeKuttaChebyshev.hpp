@@ -0,0 +1,396 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_IMPL_RUNGE_KUTTA_CHEBYSHEV_HPP__
+#define __TCHEM_IMPL_RUNGE_KUTTA_CHEBYSHEV_HPP__
+
+#include "TChem_Util.hpp"
+
+namespace TChem {
+namespace Impl {
+
+/// Second order Runge-Kutta-Chebyshev (RKC) integrator
+/// - Sommeijer, Shampine and Verwer, J. Comput. Appl. Math. 88 (1997)
+/// - stabilized explicit scheme; only computeFunction is required
+/// - the number of stages grows with sqrt(dt*rho) where rho is the spectral
+///   radius of the Jacobian estimated by a nonlinear power iteration
+/// - when the required number of stages exceeds max_num_stages, the problem is
+///   regarded as stiff and the caller is expected to switch to TrBDF2
+struct RungeKuttaChebyshev
+{
+  /// beyond this, implicit integration is cheaper than explicit stages
+  static constexpr ordinal_type max_num_stages = 20;
+
+  /// spectral radius is re-estimated after this number of accepted steps;
+  /// rejected steps reuse the estimate at the same un
+  static constexpr ordinal_type num_steps_per_spectral_radius = 25;
+
+  /// return codes of team_invoke; TrBDF2 continues unless Success
+  enum : ordinal_type
+  {
+    Success = 0,
+    Stiff = 1,
+    SpectralRadiusFailed = 2,
+    TimeStepTooSmall = 3
+  };
+
+  template<typename MemberType, typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static real_type computeNorm2(
+    const MemberType& member,
+    const ordinal_type& m,
+    const RealType1DViewType& x)
+  {
+    real_type norm(0);
+    Kokkos::parallel_reduce(
+      Kokkos::TeamVectorRange(member, m),
+      [&](const ordinal_type& i, real_type& update) {
+        update += x(i) * x(i);
+      },
+      norm);
+    return ats<real_type>::sqrt(norm);
+  }
+
+  template<typename MemberType, typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static real_type computeDiffNorm2(
+    const MemberType& member,
+    const ordinal_type& m,
+    const RealType1DViewType& x,
+    const RealType1DViewType& y)
+  {
+    real_type norm(0);
+    Kokkos::parallel_reduce(
+      Kokkos::TeamVectorRange(member, m),
+      [&](const ordinal_type& i, real_type& update) {
+        const real_type diff = x(i) - y(i);
+        update += diff * diff;
+      },
+      norm);
+    return ats<real_type>::sqrt(norm);
+  }
+
+  /// nonlinear power iteration for the spectral radius of df/du at u
+  /// - fu = f(u) is given
+  /// - v, fv are workspace
+  /// - return 0 with rho on output, or 1 when the iteration does not settle
+  ///   within max_iter or rho is nan/inf; rho is then not usable
+  template<typename MemberType,
+           typename ProblemType,
+           typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static ordinal_type computeSpectralRadius(
+    const MemberType& member,
+    const ProblemType& problem,
+    const RealType1DViewType& u,
+    const RealType1DViewType& fu,
+    const RealType1DViewType& v,
+    const RealType1DViewType& fv,
+    /* */ real_type& rho)
+  {
+    const real_type zero(0), one(1), safety(1.2), rtol(0.01);
+    const real_type uround = ats<real_type>::epsilon();
+    const real_type sqrtu = ats<real_type>::sqrt(uround);
+    const ordinal_type max_iter(50), m = problem.getNumberOfEquations();
+
+    /// initial perturbation along f(u)
+    const real_type unrm = computeNorm2(member, m, u);
+    const real_type fnrm = computeNorm2(member, m, fu);
+
+    real_type dunrm(0);
+    if (unrm != zero && fnrm != zero) {
+      dunrm = unrm * sqrtu;
+      const real_type scal = dunrm / fnrm;
+      Kokkos::parallel_for(
+        Kokkos::TeamVectorRange(member, m),
+        [&](const ordinal_type& i) { v(i) = u(i) + scal * fu(i); });
+    } else if (unrm != zero) {
+      dunrm = unrm * sqrtu;
+      Kokkos::parallel_for(
+        Kokkos::TeamVectorRange(member, m),
+        [&](const ordinal_type& i) { v(i) = u(i) * (one + sqrtu); });
+    } else if (fnrm != zero) {
+      dunrm = uround;
+      const real_type scal = dunrm / fnrm;
+      Kokkos::parallel_for(
+        Kokkos::TeamVectorRange(member, m),
+        [&](const ordinal_type& i) { v(i) = u(i) + scal * fu(i); });
+    } else {
+      dunrm = uround;
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const ordinal_type& i) { v(i) = uround; });
+    }
+    member.team_barrier();
+
+    bool is_converged(false);
+    rho = zero;
+    for (ordinal_type iter = 0; iter < max_iter; ++iter) {
+      problem.computeFunction(member, v, fv);
+      member.team_barrier();
+
+      const real_type dfnrm = computeDiffNorm2(member, m, fv, fu);
+      const real_type rho_prev = rho;
+      rho = dfnrm / dunrm;
+
+      if (ats<real_type>::isNan(rho) || ats<real_type>::isInf(rho))
+        break;
+
+      if (iter > 0 &&
+          ats<real_type>::abs(rho - rho_prev) <=
+            rtol * (rho > one ? rho : one)) {
+        is_converged = true;
+        break;
+      }
+
+      if (dfnrm != zero) {
+        const real_type scal = dunrm / dfnrm;
+        Kokkos::parallel_for(
+          Kokkos::TeamVectorRange(member, m),
+          [&](const ordinal_type& i) { v(i) = u(i) + scal * (fv(i) - fu(i)); });
+      } else {
+        /// f does not change along v; perturb a component and try again
+        const ordinal_type k = iter % m;
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          v(k) = u(k) - (v(k) - u(k));
+        });
+      }
+      member.team_barrier();
+    }
+    rho *= safety;
+    return is_converged ? 0 : 1;
+  }
+
+  /// the number of stages required to be stable with dt
+  KOKKOS_INLINE_FUNCTION static ordinal_type computeNumberOfStages(
+    const real_type& dt,
+    const real_type& rho)
+  {
+    const real_type one(1);
+    const ordinal_type s =
+      1 + ordinal_type(ats<real_type>::sqrt(one + real_type(1.54) * dt * rho));
+    return s < 2 ? 2 : s;
+  }
+
+  /// one RKC step from (un, fn) to u with s stages; f is used as workspace
+  /// for the stage function values and holds f(u) on exit
+  template<typename MemberType,
+           typename ProblemType,
+           typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke_step(
+    const MemberType& member,
+    const ProblemType& problem,
+    const ordinal_type& s,
+    const real_type& dt,
+    const RealType1DViewType& un,
+    const RealType1DViewType& fn,
+    /// workspace
+    const RealType1DViewType& y_a,
+    const RealType1DViewType& y_b,
+    const RealType1DViewType& y_c,
+    const RealType1DViewType& f,
+    /// output
+    /* */ RealType1DViewType& u)
+  {
+    const real_type zero(0), one(1), two(2), four(4);
+    const ordinal_type m = problem.getNumberOfEquations();
+
+    /// damping parameters, eps = 2/13
+    const real_type w0 = one + two / (real_type(13) * real_type(s * s));
+    const real_type tmp1 = w0 * w0 - one, tmp2 = ats<real_type>::sqrt(tmp1);
+    const real_type arg = real_type(s) * ats<real_type>::log(w0 + tmp2);
+    const real_type exp_arg = ats<real_type>::exp(arg);
+    const real_type sinh_arg = (exp_arg - one / exp_arg) / two,
+                    cosh_arg = (exp_arg + one / exp_arg) / two;
+    const real_type w1 =
+      sinh_arg * tmp1 / (cosh_arg * real_type(s) * tmp2 - w0 * sinh_arg);
+
+    real_type b_jm1 = one / (four * w0 * w0), b_jm2 = b_jm1;
+
+    /// first stage
+    RealType1DViewType y_jm2 = y_a, y_jm1 = y_b, y_j = y_c;
+    {
+      const real_type mus = w1 * b_jm1;
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const ordinal_type& i) {
+                             y_jm2(i) = un(i);
+                             y_jm1(i) = un(i) + dt * mus * fn(i);
+                           });
+      member.team_barrier();
+    }
+
+    /// chebyshev recurrences at w0
+    real_type z_jm1 = w0, z_jm2 = one, dz_jm1 = one, dz_jm2 = zero,
+              d2z_jm1 = zero, d2z_jm2 = zero;
+    for (ordinal_type j = 1; j < s; ++j) {
+      const real_type z_j = two * w0 * z_jm1 - z_jm2;
+      const real_type dz_j = two * w0 * dz_jm1 - dz_jm2 + two * z_jm1;
+      const real_type d2z_j = two * w0 * d2z_jm1 - d2z_jm2 + four * dz_jm1;
+      const real_type b_j = d2z_j / (dz_j * dz_j);
+      const real_type a_jm1 = one - z_jm1 * b_jm1;
+      const real_type mu = two * w0 * b_j / b_jm1;
+      const real_type nu = -b_j / b_jm2;
+      const real_type mus = mu * w1 / w0;
+
+      problem.computeFunction(member, y_jm1, f);
+      member.team_barrier();
+
+      Kokkos::parallel_for(
+        Kokkos::TeamVectorRange(member, m), [&](const ordinal_type& i) {
+          y_j(i) = mu * y_jm1(i) + nu * y_jm2(i) + (one - mu - nu) * un(i) +
+                   dt * mus * (f(i) - a_jm1 * fn(i));
+        });
+      member.team_barrier();
+
+      /// shift
+      b_jm2 = b_jm1;
+      b_jm1 = b_j;
+      z_jm2 = z_jm1;
+      z_jm1 = z_j;
+      dz_jm2 = dz_jm1;
+      dz_jm1 = dz_j;
+      d2z_jm2 = d2z_jm1;
+      d2z_jm1 = d2z_j;
+
+      RealType1DViewType tmp = y_jm2;
+      y_jm2 = y_jm1;
+      y_jm1 = y_j;
+      y_j = tmp;
+    }
+    u = y_jm1;
+
+    problem.computeFunction(member, u, f);
+    member.team_barrier();
+  }
+
+  /// integrate un from t up to t_end
+  /// - return Success when the integration reaches t_end or the iteration
+  ///   limit
+  /// - return Stiff, SpectralRadiusFailed or TimeStepTooSmall otherwise;
+  ///   t, dt and un are left at the last accepted step so that an implicit
+  ///   scheme can continue from there
+  template<typename MemberType,
+           typename ProblemType,
+           typename RealType1DViewType,
+           typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION static ordinal_type team_invoke(
+    const MemberType& member,
+    const ProblemType& problem,
+    const ordinal_type& max_num_time_iterations,
+    const RealType2DViewType& tol_time,
+    const real_type& dt_min,
+    const real_type& dt_max,
+    const real_type& t_end,
+    /// input/output
+    /* */ real_type& t,
+    /* */ real_type& dt,
+    /* */ ordinal_type& iter,
+    const RealType1DViewType& un,
+    /// workspace
+    const RealType1DViewType& fn,
+    const RealType1DViewType& y_a,
+    const RealType1DViewType& y_b,
+    const RealType1DViewType& y_c,
+    const RealType1DViewType& f,
+    const RealType1DViewType& v)
+  {
+    const real_type zero(0), one(1), tenth(0.1), ten(10), safety(0.8);
+    const real_type third(real_type(1) / real_type(3));
+    const ordinal_type m = problem.getNumberOfEquations();
+
+    dt = ((t + dt) > t_end) ? t_end - t : dt;
+
+    problem.computeFunction(member, un, fn);
+    member.team_barrier();
+
+    real_type rho(0);
+    ordinal_type num_accepted_steps(0);
+    bool is_rho_outdated(true);
+    for (; iter < max_num_time_iterations && dt != zero; ++iter) {
+      if (is_rho_outdated) {
+        /// v and f are free here
+        if (computeSpectralRadius(member, problem, un, fn, v, f, rho))
+          return SpectralRadiusFailed;
+        is_rho_outdated = false;
+      }
+
+      /// stiffness check; when the stability limit with the maximum number of
+      /// stages is more restrictive than the current time step, TrBDF2 takes
+      /// over
+      const ordinal_type s = computeNumberOfStages(dt, rho);
+      if (s > max_num_stages)
+        return Stiff;
+
+      RealType1DViewType u;
+      team_invoke_step(member, problem, s, dt, un, fn, y_a, y_b, y_c, f, u);
+
+      /// error estimate (weighted rms)
+      real_type norm(0);
+      Kokkos::parallel_reduce(
+        Kokkos::TeamVectorRange(member, m),
+        [&](const ordinal_type& i, real_type& update) {
+          const real_type est = real_type(0.8) * (un(i) - u(i)) +
+                                real_type(0.4) * dt * (fn(i) + f(i));
+          const real_type abs_un = ats<real_type>::abs(un(i)),
+                          abs_u = ats<real_type>::abs(u(i));
+          const real_type w_at_i =
+            one / (tol_time(i, 1) * (abs_un > abs_u ? abs_un : abs_u) +
+                   tol_time(i, 0));
+          const real_type val = est * w_at_i;
+          update += val * val;
+        },
+        norm);
+      const real_type err = ats<real_type>::sqrt(norm / real_type(m));
+
+      /// nan in the stage values rejects the step with the largest reduction
+      const bool is_err_valid = !ats<real_type>::isNan(err);
+      const real_type fac =
+        !is_err_valid ? tenth
+        : err > zero  ? safety * ats<real_type>::pow(one / err, third)
+                      : ten;
+      const real_type alpha = fac < tenth ? tenth : fac > ten ? ten : fac;
+
+      if (!is_err_valid || err > one) {
+        /// reject
+        dt *= alpha;
+        if (dt < dt_min)
+          return TimeStepTooSmall;
+      } else {
+        /// accept
+        t += dt;
+        ++num_accepted_steps;
+        is_rho_outdated =
+          (num_accepted_steps % num_steps_per_spectral_radius) == 0;
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const ordinal_type& i) {
+                               un(i) = u(i);
+                               fn(i) = f(i);
+                             });
+        member.team_barrier();
+
+        dt *= alpha;
+        dt = dt > dt_max ? dt_max : dt < dt_min ? dt_min : dt;
+        dt = ((t + dt) > t_end) ? t_end - t : dt;
+      }
+    }
+    return Success;
+  }
+};
+
+} // namespace Impl
+} // namespace TChem
+
+#endif
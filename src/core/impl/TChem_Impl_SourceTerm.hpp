@@ -74,6 +74,8 @@ struct SourceTerm
     const RealType1DViewType& ropRev,
     const RealType1DViewType& Crnd,
     const OrdinalType1DViewType& iter,
+    /// rate constants of the last evaluation (can be empty)
+    const RealType1DViewType& memo,
     /// const input from kinetic model
     const KineticModelConstDataType& kmcd)
   {
@@ -103,6 +105,7 @@ struct SourceTerm
                                        ropRev,
                                        Crnd,
                                        iter,
+                                       memo,
                                        kmcd);
 
     /// 2. transform molar reaction rates to mass reaction rates
@@ -152,6 +155,29 @@ struct SourceTerm
     /// kmcd.nReac(5) : concM,kfor,krev,rop,Crnd
     /// const input from kinetic model
     const KineticModelConstDataType& kmcd)
+  {
+    team_invoke(member, t, p, Ys, omega, work, RealType1DViewType(), kmcd);
+  }
+
+  /// memo (KForwardReverseMemo::getWorkSpaceSize) - rate constants of the
+  /// last evaluation; reused when temperature and pressure are unchanged
+  template<typename MemberType,
+           typename WorkViewType,
+           typename RealType1DViewType,
+           typename KineticModelConstDataType>
+  KOKKOS_FORCEINLINE_FUNCTION static void team_invoke(
+    const MemberType& member,
+    /// input
+    const real_type& t,
+    const real_type& p,
+    const RealType1DViewType& Ys, /// (kmcd.nSpec)
+    /// output
+    const RealType1DViewType& omega, /// (kmcd.nSpec + 1)
+    /// workspace
+    const WorkViewType& work,
+    const RealType1DViewType& memo,
+    /// const input from kinetic model
+    const KineticModelConstDataType& kmcd)
   {
     // const real_type zero(0);
 
@@ -212,8 +238,109 @@ struct SourceTerm
                        ropRev,
                        Crnd,
                        iter,
+                       memo,
                        kmcd);
   }
+
+  ///
+  ///  \return fp : array of \f$N_{reac}\times(N_{spec}+1)\f$ holding the
+  ///  derivatives of the source term with respect to \f$\ln A\f$ of each
+  ///  reaction; the forward and reverse rate constants scale together, so
+  ///  the derivative of a reaction is its net rate of progress transformed
+  ///  as the source term. omega is the source term computed on the way
+  ///
+  template<typename MemberType,
+           typename WorkViewType,
+           typename RealType1DViewType,
+           typename RealType2DViewType,
+           typename KineticModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke_parameter_jacobian(
+    const MemberType& member,
+    /// input
+    const real_type& t,
+    const real_type& p,
+    const RealType1DViewType& Ys, /// (kmcd.nSpec)
+    /// output
+    const RealType1DViewType& omega, /// (kmcd.nSpec + 1)
+    const RealType2DViewType& fp,    /// (kmcd.nReac, kmcd.nSpec + 1)
+    /// workspace
+    const WorkViewType& work,
+    /// const input from kinetic model
+    const KineticModelConstDataType& kmcd)
+  {
+    const real_type zero(0), one(1), one_e_3(1e3);
+
+    /// intermediates are left in the workspace with the layout of team_invoke
+    team_invoke(member, t, p, Ys, omega, work, kmcd);
+    member.team_barrier();
+
+    auto w = (real_type*)work.data();
+    auto hks = RealType1DViewType(w + 2 * kmcd.nSpec, kmcd.nSpec);
+    auto cpks = RealType1DViewType(w + 3 * kmcd.nSpec, kmcd.nSpec);
+    /// net rate of progress including Crnd [mole/(cm3 s)]
+    auto rop = RealType1DViewType(w + 5 * kmcd.nSpec + 3 * kmcd.nReac,
+                                  kmcd.nReac);
+
+    const real_type rhomix = RhoMixMs::team_invoke(member, t, p, Ys, kmcd);
+    const real_type cpmix = CpMixMs::team_invoke(member, t, Ys, cpks, kmcd);
+    const real_type orho = one / rhomix, ocp = one / cpmix;
+
+    const ordinal_type m = kmcd.nSpec + 1;
+    const ordinal_type joff = kmcd.reacSidx.extent(1) / 2;
+    Kokkos::parallel_for(
+      Kokkos::TeamVectorRange(member, kmcd.nReac), [&](const ordinal_type& i) {
+        for (ordinal_type k = 0; k < m; ++k)
+          fp(i, k) = zero;
+        /// inactive reaction in the reduced mechanism has zero rate
+        if (kmcd.reacActive.extent(0) > 0 && !kmcd.reacActive(i))
+          return;
+        const real_type rop_at_i = one_e_3 * rop(i) * orho;
+        real_type sum(0);
+        for (ordinal_type j = 0; j < kmcd.reacNreac(i); ++j) {
+          const ordinal_type kspec = kmcd.reacSidx(i, j);
+          const real_type val =
+            kmcd.sMass(kspec) * kmcd.reacNuki(i, j) * rop_at_i;
+          fp(i, kspec + 1) += val;
+          sum += val * hks(kspec);
+        }
+        for (ordinal_type j = 0; j < kmcd.reacNprod(i); ++j) {
+          const ordinal_type kspec = kmcd.reacSidx(i, j + joff);
+          const real_type val =
+            kmcd.sMass(kspec) * kmcd.reacNuki(i, j + joff) * rop_at_i;
+          fp(i, kspec + 1) += val;
+          sum += val * hks(kspec);
+        }
+        fp(i, 0) = -sum * ocp;
+      });
+
+    /// reactions with real stoichiometric coefficients
+    if (kmcd.nRealNuReac > 0) {
+      member.team_barrier();
+      Kokkos::parallel_for(
+        Kokkos::TeamVectorRange(member, kmcd.nRealNuReac),
+        [&](const ordinal_type& ir) {
+          const ordinal_type i = kmcd.reacRnu(ir);
+          const real_type rop_at_i = one_e_3 * rop(i) * orho;
+          real_type sum(0);
+          for (ordinal_type j = 0; j < kmcd.reacNreac(i); ++j) {
+            const ordinal_type kspec = kmcd.reacSidx(i, j);
+            const real_type val =
+              kmcd.sMass(kspec) * kmcd.reacRealNuki(ir, j) * rop_at_i;
+            fp(i, kspec + 1) += val;
+            sum += val * hks(kspec);
+          }
+          for (ordinal_type j = 0; j < kmcd.reacNprod(i); ++j) {
+            const ordinal_type kspec = kmcd.reacSidx(i, j + joff);
+            const real_type val =
+              kmcd.sMass(kspec) * kmcd.reacRealNuki(ir, j) * rop_at_i;
+            fp(i, kspec + 1) += val;
+            sum += val * hks(kspec);
+          }
+          fp(i, 0) -= sum * ocp;
+        });
+    }
+    member.team_barrier();
+  }
 };
 
 } // namespace Impl
@@ -0,0 +1,273 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_IMPL_STEADY_STATE_SOLVER_HPP__
+#define __TCHEM_IMPL_STEADY_STATE_SOLVER_HPP__
+
+#include "TChem_Impl_DenseNanInf.hpp"
+#include "TChem_Impl_DenseUTV.hpp"
+#include "TChem_Impl_NewtonSolver.hpp"
+#include "TChem_Util.hpp"
+
+namespace TChem {
+namespace Impl {
+
+/// per sample status of the steady state solvers
+struct SteadyStateSolverStatus
+{
+  enum : ordinal_type
+  {
+    Converged = 0,
+    MaxIterationsReached = 1,
+    LineSearchFailed = 2,
+    InvalidJacobian = 3
+  };
+};
+
+///
+/// Steady state of a problem, f(x) = 0
+///
+/// Newton's method with pseudo-transient continuation. Each iteration solves
+/// (I/dt - J) dx = f where the pseudo time step dt is applied to the first
+/// m_pseudo_time rows only (the time ODE rows of the problem by default);
+/// the remaining rows are algebraic and solved as they are. dt grows
+/// with the ratio of successive residual norms (switched evolution
+/// relaxation) and the iteration becomes a plain damped Newton iteration once
+/// dt reaches dt_max. A backtracking line search on the residual norm keeps
+/// the solution non negative; when it fails, dt is reduced and the step is
+/// retried. The problem provides computeFunction and computeJacobian as for
+/// NewtonSolver.
+///
+struct SteadyStateSolver
+{
+  template<typename ProblemType>
+  KOKKOS_INLINE_FUNCTION static ordinal_type getWorkSpaceSize(
+    const ProblemType& problem)
+  {
+    const ordinal_type m = problem.getNumberOfEquations();
+    /// dx, f, x trial, f trial, J and UTV workspace
+    return (4 * m + m * m + DenseUTV::getWorkSpaceSize(m, m));
+  }
+
+  template<typename MemberType,
+           typename ProblemType,
+           typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke(
+    const MemberType& member,
+    /// input
+    const ProblemType& problem,
+    const real_type& atol,
+    const real_type& rtol,
+    const ordinal_type& max_num_iterations,
+    const real_type& dt_init, /// initial pseudo time step
+    const real_type& dt_max,  /// pseudo time step treated as newton
+    const ordinal_type& m_pseudo_time, /// rows with the pseudo time term
+    /// input/output
+    const RealType1DViewType& x,
+    /// workspace
+    const RealType1DViewType& work,
+    /// output
+    /* */ ordinal_type& iter_count,
+    /* */ ordinal_type& status)
+  {
+    using real_type_2d_view_type = typename ProblemType::real_type_2d_view_type;
+    using status_type = SteadyStateSolverStatus;
+
+    const real_type zero(0), one(1), half(0.5);
+    const real_type dt_min = dt_init * real_type(1e-6);
+    const ordinal_type max_num_line_search_iterations(10);
+    const real_type sufficient_decrease(1e-4);
+
+    const ordinal_type m = problem.getNumberOfEquations();
+
+    auto wptr = work.data();
+    auto dx = RealType1DViewType(wptr, m);
+    wptr += m;
+    auto f = RealType1DViewType(wptr, m);
+    wptr += m;
+    auto xt = RealType1DViewType(wptr, m);
+    wptr += m;
+    auto ft = RealType1DViewType(wptr, m);
+    wptr += m;
+    auto J = real_type_2d_view_type(wptr, m, m);
+    wptr += m * m;
+    const ordinal_type utv_work_size = DenseUTV::getWorkSpaceSize(m, m);
+    auto w = RealType1DViewType(wptr, utv_work_size);
+    wptr += utv_work_size;
+
+    /// error check
+    const ordinal_type workspace_used(wptr - work.data()),
+      workspace_extent(work.extent(0));
+    if (workspace_used > workspace_extent) {
+      Kokkos::abort("Error: workspace used is larger than it is "
+                    "provided::TChem_Impl_SteadyStateSolver\n");
+    }
+
+    auto compute_norm2 = [&](const RealType1DViewType& v) {
+      real_type sum(0);
+      Kokkos::parallel_reduce(
+        Kokkos::TeamVectorRange(member, m),
+        [&](const ordinal_type& i, real_type& update) {
+          update += v(i) * v(i);
+        },
+        sum);
+      return ats<real_type>::sqrt(sum);
+    };
+
+    problem.computeFunction(member, x, f);
+    member.team_barrier();
+    real_type norm_f = compute_norm2(f);
+
+    status = status_type::MaxIterationsReached;
+    real_type dt = dt_init;
+    ordinal_type iter = 0;
+    for (; iter < max_num_iterations; ++iter) {
+      /// A = I/dt - J on the pseudo time rows and -J on the algebraic rows
+      problem.computeJacobian(member, x, J);
+      member.team_barrier();
+      bool is_valid(true);
+      TChem::Impl::DenseNanInf::team_check_sanity(member, J, is_valid);
+      if (!is_valid) {
+        status = status_type::InvalidJacobian;
+        break;
+      }
+      const real_type dt_inv = dt < dt_max ? one / dt : zero;
+      Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(member, m), [&](const ordinal_type& i) {
+          Kokkos::parallel_for(Kokkos::ThreadVectorRange(member, m),
+                               [&](const ordinal_type& j) {
+                                 J(i, j) = -J(i, j);
+                               });
+          if (i < m_pseudo_time)
+            J(i, i) += dt_inv;
+        });
+      member.team_barrier();
+
+      ordinal_type matrix_rank(0);
+      TChem::Impl::DenseUTV::team_factorize_and_solve(
+        member, J, dx, f, w, matrix_rank);
+
+      /// backtracking line search; the solution is clipped at zero
+      real_type lambda(1), norm_ft(0);
+      bool accepted(false);
+      for (ordinal_type ls = 0; ls < max_num_line_search_iterations; ++ls) {
+        Kokkos::parallel_for(
+          Kokkos::TeamVectorRange(member, m), [&](const ordinal_type& i) {
+            const real_type val = x(i) + lambda * dx(i);
+            xt(i) = val > zero ? val : zero;
+          });
+        member.team_barrier();
+        problem.computeFunction(member, xt, ft);
+        member.team_barrier();
+        norm_ft = compute_norm2(ft);
+        if (norm_ft <= (one - sufficient_decrease * lambda) * norm_f) {
+          accepted = true;
+          break;
+        }
+        lambda *= half;
+      }
+
+      if (!accepted) {
+        /// retry with a smaller pseudo time step
+        dt = (dt < dt_max ? dt : dt_max) * real_type(0.1);
+        if (dt < dt_min) {
+          status = status_type::LineSearchFailed;
+          break;
+        }
+        continue;
+      }
+
+      /// weighted norm of the step at the accepted solution
+      real_type sum(0);
+      Kokkos::parallel_reduce(
+        Kokkos::TeamVectorRange(member, m),
+        [&](const ordinal_type& i, real_type& update) {
+          const real_type step =
+            (xt(i) - x(i)) / (atol + rtol * ats<real_type>::abs(xt(i)));
+          update += step * step;
+        },
+        sum);
+      const real_type norm_step = ats<real_type>::sqrt(sum / real_type(m));
+      const bool is_newton_step = dt >= dt_max;
+
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const ordinal_type& i) {
+                             x(i) = xt(i);
+                             f(i) = ft(i);
+                           });
+      member.team_barrier();
+
+      /// switched evolution relaxation; damped steps do not grow dt
+      if (lambda == one && dt < dt_max) {
+        const real_type dt_ser =
+          norm_ft > zero ? dt * norm_f / norm_ft : dt_max;
+        dt = dt_ser < dt_max ? dt_ser : dt_max;
+      }
+      norm_f = norm_ft;
+
+      if (is_newton_step && lambda == one && norm_step < one) {
+        status = status_type::Converged;
+        ++iter;
+        break;
+      }
+    }
+    iter_count = iter;
+  }
+
+  /// the pseudo time term is applied to the time ODE rows of the problem
+  template<typename MemberType,
+           typename ProblemType,
+           typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke(
+    const MemberType& member,
+    /// input
+    const ProblemType& problem,
+    const real_type& atol,
+    const real_type& rtol,
+    const ordinal_type& max_num_iterations,
+    const real_type& dt_init,
+    const real_type& dt_max,
+    /// input/output
+    const RealType1DViewType& x,
+    /// workspace
+    const RealType1DViewType& work,
+    /// output
+    /* */ ordinal_type& iter_count,
+    /* */ ordinal_type& status)
+  {
+    team_invoke(member,
+                problem,
+                atol,
+                rtol,
+                max_num_iterations,
+                dt_init,
+                dt_max,
+                problem.getNumberOfTimeODEs(),
+                x,
+                work,
+                iter_count,
+                status);
+  }
+};
+
+} // namespace Impl
+} // namespace TChem
+
+#endif
@@ -60,6 +60,7 @@ struct SurfaceRHS
     const RealType1DViewType& omegaSurf,
     const WorkViewType& work,
     /// workspace
+    const RealType1DViewType& memoSurf,
 
     /// const input from kinetic model
     const KineticModelConstDataType& kmcd,
@@ -67,8 +68,17 @@ struct SurfaceRHS
   {
     const real_type ten(10.0);
     /// compute catalysis production rates
-    ReactionRatesSurface ::team_invoke(
-      member, t, p, Ys, Zs, omegaSurfGas, omegaSurf, work, kmcd, kmcdSurf);
+    ReactionRatesSurface ::team_invoke(member,
+                                       t,
+                                       p,
+                                       Ys,
+                                       Zs,
+                                       omegaSurfGas,
+                                       omegaSurf,
+                                       work,
+                                       memoSurf,
+                                       kmcd,
+                                       kmcdSurf);
 
     member.team_barrier();
 
@@ -143,6 +153,33 @@ struct SurfaceRHS
     const KineticModelConstDataType& kmcd,
     const KineticSurfModelConstDataType& kmcdSurf)
   {
+    team_invoke(
+      member, t, Ys, Zs, p, rhs, work, RealType1DViewType(), kmcd, kmcdSurf);
+  }
+
+  /// memoSurf (KForwardReverseMemo::getWorkSpaceSize) - surface rate
+  /// constants of the last evaluation
+  template<typename MemberType,
+           typename WorkViewType,
+           typename RealType1DViewType,
+           typename KineticModelConstDataType,
+           typename KineticSurfModelConstDataType>
+  KOKKOS_FORCEINLINE_FUNCTION static void team_invoke(
+    const MemberType& member,
+    /// input
+    const real_type& t,
+    const RealType1DViewType& Ys, /// (kmcd.nSpec)
+    const RealType1DViewType& Zs, // (kmcdSurf.nSpec) site fraction
+    const real_type& p,           // pressure
+    /// output
+    const RealType1DViewType& rhs, /// (kmcdSurf.nSpec )
+    /// workspace
+    const WorkViewType& work,
+    const RealType1DViewType& memoSurf,
+    /// const input from kinetic model
+    const KineticModelConstDataType& kmcd,
+    const KineticSurfModelConstDataType& kmcdSurf)
+  {
 
     auto w = (real_type*)work.data();
 
@@ -162,6 +199,7 @@ struct SurfaceRHS
                        omegaSurf,
                        /// workspace
                        work_surf,
+                       memoSurf,
                        // data from surface and gas phases
                        kmcd,
                        kmcdSurf);
@@ -179,8 +217,10 @@ struct SurfaceNumJacobian
   {
     const ordinal_type per_team_extent =
       SurfaceRHS::getWorkSpaceSize(kmcd, kmcdSurf);
+    const ordinal_type memo_extent =
+      KForwardReverseMemo::getWorkSpaceSize(kmcdSurf);
 
-    return (per_team_extent + 3 * kmcdSurf.nSpec);
+    return (per_team_extent + 3 * kmcdSurf.nSpec + memo_extent);
   }
 
   template<typename MemberType,
@@ -222,6 +262,13 @@ struct SurfaceNumJacobian
     auto Zp = real_type_1d_view_type(wptr, Nspec);
     wptr += Nspec;
 
+    /// temperature is not perturbed; rate constants are evaluated once
+    const ordinal_type memo_extent =
+      KForwardReverseMemo::getWorkSpaceSize(kmcdSurf);
+    auto memo = real_type_1d_view_type(wptr, memo_extent);
+    wptr += memo_extent;
+    KForwardReverseMemo::team_reset(member, memo, kmcdSurf.memoRtol);
+
     const ordinal_type workspace_used(wptr - work.data()),
       workspace_extent(work.extent(0));
     auto work_rhs = WorkViewType(wptr, workspace_extent - workspace_used);
@@ -230,7 +277,7 @@ struct SurfaceNumJacobian
                          [&](const ordinal_type& i) { Zp(i) = Zs(i); });
 
     Impl::SurfaceRHS::team_invoke(
-      member, t, Ys, Zs, p, f, work_rhs, kmcd, kmcdSurf);
+      member, t, Ys, Zs, p, f, work_rhs, memo, kmcd, kmcdSurf);
 
     member.team_barrier();
 
@@ -244,7 +291,7 @@ struct SurfaceNumJacobian
       Zp(j) = Zs(j) + perturb; // add perturb
 
       SurfaceRHS::team_invoke(
-        member, t, Ys, Zp, p, fp, work_rhs, kmcd, kmcdSurf);
+        member, t, Ys, Zp, p, fp, work_rhs, memo, kmcd, kmcdSurf);
 
       member.team_barrier();
 
@@ -0,0 +1,186 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_IMPL_SURFACE_STEADY_STATE_HPP__
+#define __TCHEM_IMPL_SURFACE_STEADY_STATE_HPP__
+
+#include "TChem_Impl_SimpleSurface_Problem.hpp"
+#include "TChem_Impl_SteadyStateSolver.hpp"
+#include "TChem_Util.hpp"
+
+namespace TChem {
+namespace Impl {
+
+/// per sample status of the steady state surface solver
+using SurfaceSteadyStateStatus = SteadyStateSolverStatus;
+
+///
+/// Steady state site fractions for a frozen gas phase
+///
+///   0 = dZ_k/dt (k < m-1),  0 = 1 - sum_k Z_k
+///
+/// is solved with SteadyStateSolver i.e., Newton's method with
+/// pseudo-transient continuation and a line search. SimpleSurface_Problem
+/// reports all rows as time ODEs; the pseudo time term is applied to the
+/// first m-1 species rows only so that the site conservation row of
+/// SurfaceRHS is solved as the algebraic constraint it is.
+///
+struct SurfaceSteadyState
+{
+  template<typename KineticModelConstDataType,
+           typename KineticSurfModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static ordinal_type getWorkSpaceSize(
+    const KineticModelConstDataType& kmcd,
+    const KineticSurfModelConstDataType& kmcdSurf)
+  {
+    using problem_type =
+      TChem::Impl::SimpleSurface_Problem<KineticModelConstDataType,
+                                         KineticSurfModelConstDataType>;
+    problem_type problem;
+    problem._kmcd = kmcd;
+    problem._kmcdSurf = kmcdSurf;
+
+    const ordinal_type problem_workspace_size =
+      problem_type::getWorkSpaceSize(kmcd, kmcdSurf);
+    const ordinal_type memo_workspace_size =
+      problem_type::getMemoWorkSpaceSize(kmcd, kmcdSurf);
+    const ordinal_type solver_workspace_size =
+      SteadyStateSolver::getWorkSpaceSize(problem);
+
+    return (problem_workspace_size + memo_workspace_size +
+            solver_workspace_size);
+  }
+
+  template<typename MemberType,
+           typename WorkViewType,
+           typename RealType1DViewType,
+           typename KineticModelConstDataType,
+           typename KineticSurfModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke(
+    const MemberType& member,
+    /// input
+    const real_type& atol,
+    const real_type& rtol,
+    const ordinal_type& max_num_iterations,
+    const real_type& dt_init, /// initial pseudo time step
+    const real_type& dt_max,  /// pseudo time step treated as newton
+    const real_type& t,
+    const RealType1DViewType& Ys, /// (kmcd.nSpec) mass fraction
+    const real_type& pressure,
+    const RealType1DViewType& Zs,
+    /// output
+    const RealType1DViewType& Zsout,
+    const RealType1DViewType& fac, /// numerical jacobian percentage
+    /* */ ordinal_type& iter_count,
+    /* */ ordinal_type& status,
+    /// workspace
+    const WorkViewType& work,
+    /// const input from kinetic model
+    const KineticModelConstDataType& kmcd,
+    const KineticSurfModelConstDataType& kmcdSurf)
+  {
+    using kmcd_type = KineticModelConstDataType;
+    using real_type_1d_view_type = typename kmcd_type::real_type_1d_view_type;
+    using problem_type =
+      TChem::Impl::SimpleSurface_Problem<KineticModelConstDataType,
+                                         KineticSurfModelConstDataType>;
+
+    const ordinal_type m = kmcdSurf.nSpec;
+    const ordinal_type problem_workspace_size =
+      problem_type::getWorkSpaceSize(kmcd, kmcdSurf);
+
+    auto wptr = work.data();
+    auto pw = real_type_1d_view_type(wptr, problem_workspace_size);
+    wptr += problem_workspace_size;
+
+    /// temperature is fixed; surface rate constants are evaluated once
+    const ordinal_type memo_workspace_size =
+      problem_type::getMemoWorkSpaceSize(kmcd, kmcdSurf);
+    auto pm = wptr;
+    wptr += memo_workspace_size;
+
+    problem_type problem;
+    problem._p = pressure;
+    problem._kmcd = kmcd;
+    problem._kmcdSurf = kmcdSurf;
+    problem._Ys = Ys;
+    problem._t = t;
+    problem._work = pw;
+    problem._x = Zs;
+    problem._fac = fac;
+    problem.setMemo(member, pm);
+
+    const ordinal_type solver_workspace_size =
+      SteadyStateSolver::getWorkSpaceSize(problem);
+    auto sw = RealType1DViewType(wptr, solver_workspace_size);
+    wptr += solver_workspace_size;
+
+    /// error check
+    const ordinal_type workspace_used(wptr - work.data()),
+      workspace_extent(work.extent(0));
+    if (workspace_used > workspace_extent) {
+      Kokkos::abort("Error: workspace used is larger than it is "
+                    "provided::TChem_Impl_SurfaceSteadyState\n");
+    }
+
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                         [&](const ordinal_type& i) { Zsout(i) = Zs(i); });
+    member.team_barrier();
+
+    SteadyStateSolver::team_invoke(member,
+                                   problem,
+                                   atol,
+                                   rtol,
+                                   max_num_iterations,
+                                   dt_init,
+                                   dt_max,
+                                   m - 1,
+                                   Zsout,
+                                   sw,
+                                   iter_count,
+                                   status);
+
+#if defined(TCHEM_ENABLE_SERIAL_TEST_OUTPUT) && !defined(__CUDA_ARCH__)
+    if (member.league_rank() == 0) {
+      FILE* fs = fopen("SurfaceSteadyState.team_invoke.test.out", "a+");
+      fprintf(fs, ":: SurfaceSteadyState::team_invoke\n");
+      fprintf(fs, ":::: input\n");
+      fprintf(fs,
+              "     nSpec %3d, nReac %3d, site density %e\n",
+              kmcdSurf.nSpec,
+              kmcdSurf.nReac,
+              kmcdSurf.sitedensity);
+      fprintf(fs, "  t %e, p %e\n", t, pressure);
+      for (int i = 0; i < kmcdSurf.nSpec; ++i)
+        fprintf(fs, "   i %3d,  Zs %e, \n", i, Zs(i));
+
+      fprintf(fs, ":::: output\n");
+      fprintf(fs, "  iterations %d, status %d\n", iter_count, status);
+      for (int i = 0; i < kmcdSurf.nSpec; ++i)
+        fprintf(fs, "   i %3d,  Zs %e, \n", i, Zsout(i));
+    }
+#endif
+  }
+};
+
+} // namespace Impl
+} // namespace TChem
+
+#endif
@@ -0,0 +1,217 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_IMPL_THERMAL_PROPERTIES_HPP__
+#define __TCHEM_IMPL_THERMAL_PROPERTIES_HPP__
+
+#include "TChem_Util.hpp"
+
+namespace TChem {
+namespace Impl {
+
+/// bit mask of the quantities requested from ThermalProperties
+struct ThermalPropertiesMask
+{
+  enum : ordinal_type
+  {
+    CpSpecies = 1 << 0,
+    CpMixture = 1 << 1,
+    CvSpecies = 1 << 2,
+    CvMixture = 1 << 3,
+    EnthalpySpecies = 1 << 4,
+    EnthalpyMixture = 1 << 5,
+    EntropySpecies = 1 << 6,
+    EntropyMixture = 1 << 7,
+    InternalEnergySpecies = 1 << 8,
+    InternalEnergyMixture = 1 << 9,
+    All = (1 << 10) - 1
+  };
+};
+
+/// Mass based cp, cv, h, s and u of species and mixture in a single pass
+/// - NASA polynomials are evaluated once per species; the values are the same
+///   as CpMixMs, EnthalpySpecMs, Entropy0SpecMl and the internal energy
+///   u = h - R T / W
+/// - outputs not selected by the mask are not touched and can be empty views
+struct ThermalProperties
+{
+  template<typename KineticModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static ordinal_type getWorkSpaceSize(
+    const KineticModelConstDataType& kmcd)
+  {
+    /// cp, h, s of species for mixture averages
+    return 3 * kmcd.nSpec;
+  }
+
+  template<typename MemberType,
+           typename RealType0DViewType,
+           typename RealType1DViewType,
+           typename KineticModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke(
+    const MemberType& member,
+    /// input
+    const ordinal_type& mask,
+    const real_type& t,
+    const RealType1DViewType& Ys, /// (kmcd.nSpec)
+    /// output
+    const RealType1DViewType& CpMass,
+    const RealType0DViewType& CpMixMass,
+    const RealType1DViewType& CvMass,
+    const RealType0DViewType& CvMixMass,
+    const RealType1DViewType& EnthalpyMass,
+    const RealType0DViewType& EnthalpyMixMass,
+    const RealType1DViewType& EntropyMass,
+    const RealType0DViewType& EntropyMixMass,
+    const RealType1DViewType& InternalEnergyMass,
+    const RealType0DViewType& InternalEnergyMixMass,
+    /// workspace
+    const RealType1DViewType& work,
+    /// const input from kinetic model
+    const KineticModelConstDataType& kmcd)
+  {
+    using mask_type = ThermalPropertiesMask;
+
+    const real_type one[4] = { 0.5, (1.0 / 3.0), 0.25, 0.2 };
+    const real_type tLoc = getValueInRange(kmcd.TthrmMin, kmcd.TthrmMax, t);
+    const real_type delT = t - tLoc;
+    const real_type tln = ats<real_type>::log(tLoc);
+    const bool out_of_range = ats<real_type>::abs(delT) > REACBALANCE;
+    const real_type tln_t_tLoc = ats<real_type>::log(t / tLoc);
+
+    auto w = work.data();
+    auto cpks = RealType1DViewType(w, kmcd.nSpec);
+    w += kmcd.nSpec;
+    auto hks = RealType1DViewType(w, kmcd.nSpec);
+    w += kmcd.nSpec;
+    auto sks = RealType1DViewType(w, kmcd.nSpec);
+    w += kmcd.nSpec;
+
+    /// 1. species properties
+    Kokkos::parallel_for(
+      Kokkos::TeamVectorRange(member, kmcd.nSpec), [&](const ordinal_type& i) {
+        const ordinal_type ipol = tLoc > kmcd.Tmi(i);
+        const real_type a0 = kmcd.cppol(i, ipol, 0),
+                        a1 = kmcd.cppol(i, ipol, 1),
+                        a2 = kmcd.cppol(i, ipol, 2),
+                        a3 = kmcd.cppol(i, ipol, 3),
+                        a4 = kmcd.cppol(i, ipol, 4),
+                        a5 = kmcd.cppol(i, ipol, 5),
+                        a6 = kmcd.cppol(i, ipol, 6);
+
+        /// molar based
+        const real_type cp =
+          kmcd.Runiv *
+          (a0 + tLoc * (a1 + tLoc * (a2 + tLoc * (a3 + tLoc * a4))));
+        real_type h =
+          kmcd.Runiv *
+          (tLoc * (a0 + tLoc * (a1 * one[0] +
+                                tLoc * (a2 * one[1] +
+                                        tLoc * (a3 * one[2] +
+                                                tLoc * (a4 * one[3]))))) +
+           a5);
+        real_type s =
+          kmcd.Runiv *
+          (a0 * tln +
+           tLoc * (a1 + tLoc * (a2 * one[0] +
+                                tLoc * (a3 * one[1] + tLoc * a4 * one[2]))) +
+           a6);
+        if (out_of_range) {
+          h += cp * delT;
+          s += cp * tln_t_tLoc;
+        }
+
+        /// mass based
+        const real_type sMass_inv = real_type(1) / kmcd.sMass(i);
+        cpks(i) = cp * sMass_inv;
+        hks(i) = h * sMass_inv;
+        sks(i) = s * sMass_inv;
+
+        if (mask & mask_type::CpSpecies)
+          CpMass(i) = cpks(i);
+        if (mask & mask_type::CvSpecies)
+          CvMass(i) = cpks(i) - kmcd.Runiv * sMass_inv;
+        if (mask & mask_type::EnthalpySpecies)
+          EnthalpyMass(i) = hks(i);
+        if (mask & mask_type::EntropySpecies)
+          EntropyMass(i) = sks(i);
+        if (mask & mask_type::InternalEnergySpecies)
+          InternalEnergyMass(i) = hks(i) - kmcd.Runiv * t * sMass_inv;
+      });
+    member.team_barrier();
+
+    /// 2. mixture averages
+    const bool need_cp =
+      mask & (mask_type::CpMixture | mask_type::CvMixture);
+    const bool need_h =
+      mask & (mask_type::EnthalpyMixture | mask_type::InternalEnergyMixture);
+    const bool need_s = mask & mask_type::EntropyMixture;
+    const bool need_w =
+      mask & (mask_type::CvMixture | mask_type::InternalEnergyMixture);
+
+    real_type cpmix(0), hmix(0), smix(0), wmix_inv(0);
+    if (need_cp)
+      Kokkos::parallel_reduce(
+        Kokkos::TeamVectorRange(member, kmcd.nSpec),
+        [&](const ordinal_type& i, real_type& update) {
+          update += Ys(i) * cpks(i);
+        },
+        cpmix);
+    if (need_h)
+      Kokkos::parallel_reduce(
+        Kokkos::TeamVectorRange(member, kmcd.nSpec),
+        [&](const ordinal_type& i, real_type& update) {
+          update += Ys(i) * hks(i);
+        },
+        hmix);
+    if (need_s)
+      Kokkos::parallel_reduce(
+        Kokkos::TeamVectorRange(member, kmcd.nSpec),
+        [&](const ordinal_type& i, real_type& update) {
+          update += Ys(i) * sks(i);
+        },
+        smix);
+    if (need_w)
+      Kokkos::parallel_reduce(
+        Kokkos::TeamVectorRange(member, kmcd.nSpec),
+        [&](const ordinal_type& i, real_type& update) {
+          update += Ys(i) / kmcd.sMass(i);
+        },
+        wmix_inv);
+
+    Kokkos::single(Kokkos::PerTeam(member), [&]() {
+      if (mask & mask_type::CpMixture)
+        CpMixMass() = cpmix;
+      if (mask & mask_type::CvMixture)
+        CvMixMass() = cpmix - kmcd.Runiv * wmix_inv;
+      if (mask & mask_type::EnthalpyMixture)
+        EnthalpyMixMass() = hmix;
+      if (mask & mask_type::EntropyMixture)
+        EntropyMixMass() = smix;
+      if (mask & mask_type::InternalEnergyMixture)
+        InternalEnergyMixMass() = hmix - kmcd.Runiv * t * wmix_inv;
+    });
+    member.team_barrier();
+  }
+};
+
+} // namespace Impl
+} // namespace TChem
+
+#endif
@@ -21,10 +21,15 @@ Sandia National Laboratories, Livermore, CA, USA
 #ifndef __TCHEM_IMPL_TIME_INTEGRATOR_HPP__
 #define __TCHEM_IMPL_TIME_INTEGRATOR_HPP__
 
+#include "TChem_Profiler.hpp"
 #include "TChem_Util.hpp"
 
+#include "TChem_Impl_NewtonKrylovSolver.hpp"
 #include "TChem_Impl_NewtonSolver.hpp"
 #include "TChem_Impl_TrBDF2.hpp"
+#if defined(TCHEM_ENABLE_TIME_INTEGRATOR_USE_RKC)
+#include "TChem_Impl_RungeKuttaChebyshev.hpp"
+#endif
 
 namespace TChem {
 namespace Impl {
@@ -41,18 +46,192 @@ struct TimeIntegrator
     const ordinal_type trbdf_workspace_size =
       TrBDF2<typename problem_type::exec_space_type>::getWorkSpaceSize(problem);
     const ordinal_type newton_workspace_size =
-      NewtonSolver::getWorkSpaceSize(problem);
+      UseNewtonKrylovSolver<ProblemType>::value
+        ? NewtonKrylovSolver::getWorkSpaceSize(problem)
+        : NewtonSolver::getWorkSpaceSize(problem);
 
     return (problem_workspace_size + trbdf_workspace_size +
             newton_workspace_size);
   }
 
+  /// additional workspace when sensitivities are integrated
+  template<typename ProblemType>
+  KOKKOS_INLINE_FUNCTION static ordinal_type getSensitivityWorkSpaceSize(
+    const ProblemType& problem)
+  {
+    const ordinal_type m = problem.getNumberOfEquations(),
+                       np = problem.getNumberOfParameters();
+    /// pad, iteration matrix, two vectors and five (np x m) arrays
+    return (3 * m + m * m + 5 * np * m);
+  }
+
+  /// T(j,i) = sum_k A(i,k) S(j,k)
+  template<typename MemberType, typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_apply_sensitivity(
+    const MemberType& member,
+    const RealType2DViewType& A,
+    const RealType2DViewType& S,
+    const RealType2DViewType& T)
+  {
+    const ordinal_type np = S.extent(0), m = S.extent(1);
+    Kokkos::parallel_for(
+      Kokkos::TeamThreadRange(member, np), [&](const ordinal_type& j) {
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(member, m),
+                             [&](const ordinal_type& i) {
+                               real_type sum(0);
+                               for (ordinal_type k = 0; k < m; ++k)
+                                 sum += A(i, k) * S(j, k);
+                               T(j, i) = sum;
+                             });
+      });
+    member.team_barrier();
+  }
+
+  /// newton iterations of a TrBDF2 stage; the jacobian-free solver does
+  /// not use J nor the matrix rank
+  template<typename MemberType,
+           typename TrBDF2PartType,
+           typename RealType1DViewType,
+           typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke_newton(
+    std::true_type,
+    const MemberType& member,
+    const TrBDF2PartType& trbdf_part,
+    const real_type& atol,
+    const real_type& rtol,
+    const ordinal_type& max_iter,
+    const RealType1DViewType& x,
+    const RealType1DViewType& dx,
+    const RealType1DViewType& f,
+    const RealType2DViewType& J,
+    const RealType1DViewType& w,
+    /* */ ordinal_type& iter_count,
+    /* */ ordinal_type& converge,
+    /* */ ordinal_type& matrix_rank)
+  {
+    NewtonKrylovSolver::team_invoke(member,
+                                    trbdf_part,
+                                    atol,
+                                    rtol,
+                                    max_iter,
+                                    x,
+                                    dx,
+                                    f,
+                                    w,
+                                    iter_count,
+                                    converge);
+  }
+
+  template<typename MemberType,
+           typename TrBDF2PartType,
+           typename RealType1DViewType,
+           typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke_newton(
+    std::false_type,
+    const MemberType& member,
+    const TrBDF2PartType& trbdf_part,
+    const real_type& atol,
+    const real_type& rtol,
+    const ordinal_type& max_iter,
+    const RealType1DViewType& x,
+    const RealType1DViewType& dx,
+    const RealType1DViewType& f,
+    const RealType2DViewType& J,
+    const RealType1DViewType& w,
+    /* */ ordinal_type& iter_count,
+    /* */ ordinal_type& converge,
+    /* */ ordinal_type& matrix_rank)
+  {
+    NewtonSolver::team_invoke(member,
+                              trbdf_part,
+                              atol,
+                              rtol,
+                              max_iter,
+                              x,
+                              dx,
+                              f,
+                              J,
+                              w,
+                              iter_count,
+                              converge,
+                              matrix_rank);
+  }
+
+  /// staggered corrector for the sensitivities of a converged stage;
+  /// A S = B is solved by S <- S - M^{-1} (A S - B) where A is the stage
+  /// iteration matrix at the converged state and M is the newton iteration
+  /// matrix whose factors are left in J and w, so no factorization is done
+  template<typename MemberType,
+           typename RealType1DViewType,
+           typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke_sensitivity_corrector(
+    const MemberType& member,
+    const ordinal_type& max_iter,
+    const real_type& atol,
+    const real_type& rtol,
+    /// newton iteration matrix factors
+    const RealType2DViewType& J,
+    const RealType1DViewType& w,
+    const ordinal_type& matrix_rank,
+    /// input
+    const RealType2DViewType& A,
+    const RealType2DViewType& B,
+    /// output
+    const RealType2DViewType& S,
+    /// workspace
+    const RealType2DViewType& T,
+    const RealType1DViewType& x,
+    const RealType1DViewType& b)
+  {
+    const ordinal_type np = S.extent(0), m = S.extent(1);
+    const real_type one(1);
+
+    /// predictor S = M^{-1} B
+    for (ordinal_type j = 0; j < np; ++j) {
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const ordinal_type& i) { b(i) = B(j, i); });
+      member.team_barrier();
+      NewtonSolver::linear_solver_type::team_solve(
+        member, J, RealType1DViewType(&S(j, 0), m), b, w, matrix_rank);
+    }
+
+    for (ordinal_type iter = 0; iter < max_iter; ++iter) {
+      team_apply_sensitivity(member, A, S, T);
+
+      real_type err(0);
+      for (ordinal_type j = 0; j < np; ++j) {
+        Kokkos::parallel_for(
+          Kokkos::TeamVectorRange(member, m),
+          [&](const ordinal_type& i) { b(i) = T(j, i) - B(j, i); });
+        member.team_barrier();
+        NewtonSolver::linear_solver_type::team_solve(
+          member, J, x, b, w, matrix_rank);
+
+        real_type err_j(0);
+        Kokkos::parallel_reduce(
+          Kokkos::TeamVectorRange(member, m),
+          [&](const ordinal_type& i, real_type& update) {
+            S(j, i) -= x(i);
+            const real_type val = ats<real_type>::abs(x(i)) /
+                                  (atol + rtol * ats<real_type>::abs(S(j, i)));
+            update = update > val ? update : val;
+          },
+          Kokkos::Max<real_type>(err_j));
+        err = err > err_j ? err : err_j;
+        member.team_barrier();
+      }
+      if (err < one)
+        break;
+    }
+  }
+
   template<typename MemberType,
            typename ProblemType,
            typename WorkViewType,
            typename RealType0DViewType,
            typename RealType1DViewType,
-           typename RealType2DViewType>
+           typename RealType2DViewType,
+           typename RealType2DSensViewType>
   KOKKOS_INLINE_FUNCTION static ordinal_type team_invoke_detail(
     const MemberType& member,
     /// problem
@@ -74,6 +253,9 @@ struct TimeIntegrator
     const RealType0DViewType& t_out,
     const RealType0DViewType& dt_out,
     const RealType1DViewType& vals_out,
+    /// sensitivities (nParameters x m) with respect to the problem
+    /// parameters; input at t_beg and output at t_out. empty to skip
+    const RealType2DSensViewType& sens,
     /// workspace
     const WorkViewType& work)
   {
@@ -129,14 +311,50 @@ struct TimeIntegrator
     wptr += m;
     auto f = real_type_1d_view_type(wptr, m);
     wptr += m;
-    auto J = real_type_2d_view_type(wptr, m, m);
-    wptr += m * m;
-    // auto w   = real_type_1d_view(wptr, 2*m); wptr += (2*m);
+    using use_newton_krylov_type =
+      std::integral_constant<bool, UseNewtonKrylovSolver<ProblemType>::value>;
+    const bool use_newton_krylov = use_newton_krylov_type::value;
+    const ordinal_type mJ = use_newton_krylov ? 0 : m;
+    auto J = real_type_2d_view_type(wptr, mJ, mJ);
+    wptr += J.span();
     const ordinal_type newton_workspace_size =
-      NewtonSolver::getWorkSpaceSize(problem);
+      use_newton_krylov ? NewtonKrylovSolver::getWorkSpaceSize(problem)
+                        : NewtonSolver::getWorkSpaceSize(problem);
     auto w = real_type_1d_view_type(wptr, newton_workspace_size);
     wptr += (newton_workspace_size);
 
+    /// sensitivity workspace
+    /// the jacobian-free solver does not keep an iteration matrix
+    if (use_newton_krylov && sens.extent(0) > 0)
+      Kokkos::single(Kokkos::PerTeam(member), [&]() {
+        printf("Warning: TimeIntegrator, sensitivities are not supported "
+               "with the newton krylov solver\n");
+      });
+    /// problems without parameters ignore the sensitivities
+    const bool use_sens = !use_newton_krylov && sens.extent(0) > 0 &&
+                          problem.getNumberOfParameters() > 0;
+    const ordinal_type np = use_sens ? sens.extent(0) : 0,
+                       msens = use_sens ? m : 0;
+    /// the UTV solve may use workspace beyond the newton workspace
+    wptr += msens;
+    auto A = real_type_2d_view_type(wptr, msens, msens);
+    wptr += A.span();
+    auto xs = real_type_1d_view_type(wptr, msens);
+    wptr += xs.span();
+    auto bs = real_type_1d_view_type(wptr, msens);
+    wptr += bs.span();
+    auto FSn = real_type_2d_view_type(wptr, np, msens);
+    wptr += FSn.span();
+    auto FP = real_type_2d_view_type(wptr, np, msens);
+    wptr += FP.span();
+    auto B = real_type_2d_view_type(wptr, np, msens);
+    wptr += B.span();
+    auto Sr = real_type_2d_view_type(wptr, np, msens);
+    wptr += Sr.span();
+    auto T = real_type_2d_view_type(wptr, np, msens);
+    wptr += T.span();
+    ordinal_type matrix_rank(0);
+
     /// error check
     const ordinal_type workspace_used(wptr - work.data()),
       workspace_extent(work.extent(0));
@@ -153,10 +371,59 @@ struct TimeIntegrator
                          [&](const ordinal_type& k) { un(k) = vals(k); });
     member.team_barrier();
 
+    /// sensitivity rate at the initial condition, J S + df/dp
+    if (use_sens) {
+      problem.computeJacobian(member, un, A);
+      problem.computeParameterJacobian(member, un, xs, FP);
+      team_apply_sensitivity(member, A, sens, FSn);
+      Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(member, np), [&](const ordinal_type& j) {
+          Kokkos::parallel_for(
+            Kokkos::ThreadVectorRange(member, m),
+            [&](const ordinal_type& i) { FSn(j, i) += FP(j, i); });
+        });
+      member.team_barrier();
+    }
+
     /// time integration
     real_type t(t_beg), dt(dt_in);
-    for (ordinal_type iter = 0; iter < max_num_time_iterations && dt != zero;
-         ++iter) {
+    ordinal_type iter(0);
+
+#if defined(TCHEM_ENABLE_TIME_INTEGRATOR_USE_RKC)
+    /// non-stiff samples are integrated by the explicit RKC scheme;
+    /// when a sample turns out to be stiff or its spectral radius cannot
+    /// be estimated, TrBDF2 continues from the last accepted step
+    if (problem.getNumberOfConstraints() == 0 && !use_sens) {
+      const ordinal_type r_rkc =
+        RungeKuttaChebyshev::team_invoke(member,
+                                         problem,
+                                         max_num_time_iterations,
+                                         tol_time,
+                                         dt_min,
+                                         dt_max,
+                                         t_end,
+                                         t,
+                                         dt,
+                                         iter,
+                                         un,
+                                         fn,
+                                         unr,
+                                         fnr,
+                                         u,
+                                         f,
+                                         dx);
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const ordinal_type& k) { u(k) = un(k); });
+      member.team_barrier();
+      if (r_rkc != RungeKuttaChebyshev::Success) {
+        /// a rejected RKC step may have left dt below dt_min
+        dt = (dt > dt_min ? dt : dt_min);
+        dt = ((t + dt) > t_end) ? t_end - t : dt;
+      }
+    }
+#endif
+
+    for (; iter < max_num_time_iterations && dt != zero; ++iter) {
       {
         ordinal_type converge(0);
         for (ordinal_type i = 0; i < 4 && converge == 0; ++i) {
@@ -169,21 +436,55 @@ struct TimeIntegrator
             problem.computeFunction(member, un, fn);
 
             ordinal_type newton_iteration_count(0);
-            TChem::Impl::NewtonSolver ::team_invoke(member,
-                                                    trbdf_part1,
-                                                    tol_newton(0),
-                                                    tol_newton(1),
-                                                    max_num_newton_iterations,
-                                                    unr,
-                                                    dx,
-                                                    f,
-                                                    J,
-                                                    w,
-                                                    newton_iteration_count,
-                                                    converge_part1);
+            team_invoke_newton(use_newton_krylov_type(),
+                               member,
+                               trbdf_part1,
+                               tol_newton(0),
+                               tol_newton(1),
+                               max_num_newton_iterations,
+                               unr,
+                               dx,
+                               f,
+                               J,
+                               w,
+                               newton_iteration_count,
+                               converge_part1,
+                               matrix_rank);
 
             if (converge_part1) {
               problem.computeFunction(member, unr, fnr);
+              /// trapezoidal stage sensitivities
+              /// A1 Sr = Sn + gamma dt/2 (J Sn + fp_n + fp_r)
+              if (use_sens) {
+                trbdf_part1.computeJacobian(member, unr, A);
+                problem.computeParameterJacobian(member, unr, xs, FP);
+                const real_type scal = gamma * dt * real_type(0.5);
+                Kokkos::parallel_for(
+                  Kokkos::TeamThreadRange(member, np),
+                  [&](const ordinal_type& j) {
+                    Kokkos::parallel_for(
+                      Kokkos::ThreadVectorRange(member, m),
+                      [&](const ordinal_type& i) {
+                        B(j, i) = i < m_ode ? sens(j, i) +
+                                                scal * (FSn(j, i) + FP(j, i))
+                                            : -FP(j, i);
+                      });
+                  });
+                member.team_barrier();
+                team_invoke_sensitivity_corrector(member,
+                                                  max_num_newton_iterations,
+                                                  tol_newton(0),
+                                                  tol_newton(1),
+                                                  J,
+                                                  w,
+                                                  matrix_rank,
+                                                  A,
+                                                  B,
+                                                  Sr,
+                                                  T,
+                                                  xs,
+                                                  bs);
+              }
             } else {
               /// try again with half time step
               dt *= half;
@@ -198,20 +499,74 @@ struct TimeIntegrator
             trbdf_part2._unr = unr;
 
             ordinal_type newton_iteration_count(0);
-            TChem::Impl::NewtonSolver ::team_invoke(member,
-                                                    trbdf_part2,
-                                                    tol_newton(0),
-                                                    tol_newton(1),
-                                                    max_num_newton_iterations,
-                                                    u,
-                                                    dx,
-                                                    f,
-                                                    J,
-                                                    w,
-                                                    newton_iteration_count,
-                                                    converge_part2);
+            team_invoke_newton(use_newton_krylov_type(),
+                               member,
+                               trbdf_part2,
+                               tol_newton(0),
+                               tol_newton(1),
+                               max_num_newton_iterations,
+                               u,
+                               dx,
+                               f,
+                               J,
+                               w,
+                               newton_iteration_count,
+                               converge_part2,
+                               matrix_rank);
             if (converge_part2) {
               problem.computeFunction(member, u, f);
+              /// bdf2 stage sensitivities; the step is accepted here
+              /// A2 S = scal1 Sr - scal2 Sn + scal3 fp
+              if (use_sens) {
+                const real_type one(1);
+                const real_type scal1 = one / gamma / (two - gamma);
+                const real_type scal2 = scal1 * (one - gamma) * (one - gamma);
+                const real_type scal3 = (one - gamma) / (two - gamma) * dt;
+                trbdf_part2.computeJacobian(member, u, A);
+                problem.computeParameterJacobian(member, u, xs, FP);
+                Kokkos::parallel_for(
+                  Kokkos::TeamThreadRange(member, np),
+                  [&](const ordinal_type& j) {
+                    Kokkos::parallel_for(
+                      Kokkos::ThreadVectorRange(member, m),
+                      [&](const ordinal_type& i) {
+                        B(j, i) = i < m_ode ? scal1 * Sr(j, i) -
+                                                scal2 * sens(j, i) +
+                                                scal3 * FP(j, i)
+                                            : -FP(j, i);
+                      });
+                  });
+                member.team_barrier();
+                team_invoke_sensitivity_corrector(member,
+                                                  max_num_newton_iterations,
+                                                  tol_newton(0),
+                                                  tol_newton(1),
+                                                  J,
+                                                  w,
+                                                  matrix_rank,
+                                                  A,
+                                                  B,
+                                                  Sr,
+                                                  T,
+                                                  xs,
+                                                  bs);
+
+                /// J S + fp for the next step is recovered from A2 S
+                team_apply_sensitivity(member, A, Sr, T);
+                Kokkos::parallel_for(
+                  Kokkos::TeamThreadRange(member, np),
+                  [&](const ordinal_type& j) {
+                    Kokkos::parallel_for(
+                      Kokkos::ThreadVectorRange(member, m),
+                      [&](const ordinal_type& i) {
+                        FSn(j, i) =
+                          (i < m_ode ? (Sr(j, i) - T(j, i)) / scal3 : T(j, i)) +
+                          FP(j, i);
+                        sens(j, i) = Sr(j, i);
+                      });
+                  });
+                member.team_barrier();
+              }
             } else {
               dt *= half;
               continue;
@@ -222,8 +577,11 @@ struct TimeIntegrator
 
         if (converge) {
           t += dt;
-          trbdf.computeTimeStepSize(
-            member, dt_min, dt_max, tol_time, m_ode, fn, fnr, f, u, dt);
+          {
+            TCHEM_PROFILE_TEAM_SCOPE(member, TimeStepController);
+            trbdf.computeTimeStepSize(
+              member, dt_min, dt_max, tol_time, m_ode, fn, fnr, f, u, dt);
+          }
           dt = ((t + dt) > t_end) ? t_end - t : dt;
           Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
                                [&](const ordinal_type& k) { un(k) = u(k); });
@@ -270,6 +628,55 @@ struct TimeIntegrator
 
     return r_val;
   }
+
+  template<typename MemberType,
+           typename ProblemType,
+           typename WorkViewType,
+           typename RealType0DViewType,
+           typename RealType1DViewType,
+           typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION static ordinal_type team_invoke_detail(
+    const MemberType& member,
+    /// problem
+    const ProblemType& problem,
+    /// input iteration and qoi index to store
+    const ordinal_type& max_num_newton_iterations,
+    const ordinal_type& max_num_time_iterations,
+    const RealType1DViewType& tol_newton,
+    const RealType2DViewType& tol_time,
+    /// input time step and time range
+    const real_type& dt_in,
+    const real_type& dt_min,
+    const real_type& dt_max,
+    const real_type& t_beg,
+    const real_type& t_end,
+    /// input (initial condition)
+    const RealType1DViewType& vals,
+    /// output (final output conditions)
+    const RealType0DViewType& t_out,
+    const RealType0DViewType& dt_out,
+    const RealType1DViewType& vals_out,
+    /// workspace
+    const WorkViewType& work)
+  {
+    return team_invoke_detail(member,
+                              problem,
+                              max_num_newton_iterations,
+                              max_num_time_iterations,
+                              tol_newton,
+                              tol_time,
+                              dt_in,
+                              dt_min,
+                              dt_max,
+                              t_beg,
+                              t_end,
+                              vals,
+                              t_out,
+                              dt_out,
+                              vals_out,
+                              RealType2DViewType(),
+                              work);
+  }
 };
 
 } // namespace Impl
@@ -0,0 +1,440 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_IMPL_TIME_INTEGRATOR_CSP_HPP__
+#define __TCHEM_IMPL_TIME_INTEGRATOR_CSP_HPP__
+
+#include "TChem_Util.hpp"
+
+#include "TChem_Impl_DenseEigendecomposition.hpp"
+#include "TChem_Impl_DenseNanInf.hpp"
+#include "TChem_Impl_DenseUTV.hpp"
+
+namespace TChem {
+namespace Impl {
+
+/// Computational singular perturbation (CSP) explicit integrator
+/// - Valorani and Goussis, J. Comput. Phys. 169 (2001)
+/// - the CSP basis is the real eigenbasis of the Jacobian sorted by
+///   decreasing magnitude of eigenvalues; complex conjugate pairs are
+///   represented by their real and imaginary parts
+/// - the first M decaying modes are exhausted when their contribution over
+///   the time scale of the fastest slow mode is below the tolerence,
+///     1/|lambda_M+1| |sum_{r<M} a_r h^r| < rtol |y| + atol
+/// - the slow vector field f - sum_{r<M} a_r h^r is advanced by the explicit
+///   Heun scheme with dt <= stability_factor/|lambda_M+1| and the state is
+///   brought back to the slow manifold by the radical correction
+///     y = y - sum_{r<M} a_r (Lambda^-1 h)^r
+/// - the time step is also controlled by the difference of the Heun and
+///   Euler steps in the weighted rms norm; dt_in is the first trial step
+/// - the basis is frozen during a time step
+/// - returns 0 on success and 1 when the vector field or the Jacobian has
+///   nan/inf or the step size falls below dt_min; as TimeIntegrator does,
+///   failed samples have zero values, t_out = t_end and dt_out = -1
+struct TimeIntegratorCSP
+{
+  /// dt |lambda_M+1| for the slow explicit step
+  static constexpr real_type stability_factor = 0.5;
+
+  /// eigensolver and the factorization of the basis share the workspace
+  KOKKOS_INLINE_FUNCTION static ordinal_type getSolverWorkSpaceSize(
+    const ordinal_type m)
+  {
+    const ordinal_type eig_workspace_size =
+      DenseEigendecomposition::getWorkSpaceSize(m);
+    const ordinal_type utv_workspace_size = 3 * m * m + 4 * m;
+    return (eig_workspace_size > utv_workspace_size ? eig_workspace_size
+                                                    : utv_workspace_size);
+  }
+
+  template<typename ProblemType>
+  KOKKOS_INLINE_FUNCTION static ordinal_type getWorkSpaceSize(
+    const ProblemType& problem)
+  {
+    const ordinal_type m = problem.getNumberOfEquations();
+    const ordinal_type problem_workspace_size = problem.getWorkSpaceSize();
+
+    /// un, u, us, f, fs, g, h, er, ei, perm, J, UL, UR, Ar, B
+    return (problem_workspace_size + 10 * m + 5 * m * m +
+            getSolverWorkSpaceSize(m));
+  }
+
+  template<typename MemberType,
+           typename ProblemType,
+           typename WorkViewType,
+           typename RealType0DViewType,
+           typename RealType1DViewType,
+           typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION static ordinal_type team_invoke_detail(
+    const MemberType& member,
+    /// problem
+    const ProblemType& problem,
+    /// input iteration and tolerence
+    const ordinal_type& max_num_time_iterations,
+    const RealType2DViewType& tol_time,
+    /// input time step and time range
+    const real_type& dt_in,
+    const real_type& dt_min,
+    const real_type& dt_max,
+    const real_type& t_beg,
+    const real_type& t_end,
+    /// input (initial condition)
+    const RealType1DViewType& vals,
+    /// output (final output conditions)
+    const RealType0DViewType& t_out,
+    const RealType0DViewType& dt_out,
+    const RealType1DViewType& vals_out,
+    /// workspace
+    const WorkViewType& work)
+  {
+    using problem_type = ProblemType;
+    using real_type_1d_view_type =
+      typename problem_type::real_type_1d_view_type;
+    using real_type_2d_view_type =
+      typename problem_type::real_type_2d_view_type;
+    using ordinal_type_1d_view_type =
+      Kokkos::View<ordinal_type*,
+                   Kokkos::LayoutRight,
+                   typename WorkViewType::memory_space>;
+
+    const real_type zero(0), one(1), half(0.5), minus_one(-1);
+    const real_type tenth(0.1), two(2), safety(0.8);
+
+    /// early return
+    if (dt_in < zero)
+      return 3;
+
+    const ordinal_type m = problem.getNumberOfEquations();
+
+    /// workspace
+    auto wptr = work.data();
+
+    auto un = real_type_1d_view_type(wptr, m);
+    wptr += m;
+    auto u = real_type_1d_view_type(wptr, m);
+    wptr += m;
+    auto us = real_type_1d_view_type(wptr, m);
+    wptr += m;
+    auto f = real_type_1d_view_type(wptr, m);
+    wptr += m;
+    auto fs = real_type_1d_view_type(wptr, m);
+    wptr += m;
+    auto g = real_type_1d_view_type(wptr, m);
+    wptr += m;
+    auto h = real_type_1d_view_type(wptr, m);
+    wptr += m;
+    auto er = real_type_1d_view_type(wptr, m);
+    wptr += m;
+    auto ei = real_type_1d_view_type(wptr, m);
+    wptr += m;
+    auto perm = ordinal_type_1d_view_type((ordinal_type*)wptr, m);
+    wptr += m;
+
+    auto J = real_type_2d_view_type(wptr, m, m);
+    wptr += m * m;
+    auto UL = real_type_2d_view_type(wptr, m, m);
+    wptr += m * m;
+    auto UR = real_type_2d_view_type(wptr, m, m);
+    wptr += m * m;
+    auto Ar = real_type_2d_view_type(wptr, m, m);
+    wptr += m * m;
+    auto B = real_type_2d_view_type(wptr, m, m);
+    wptr += m * m;
+
+    const ordinal_type w_size = getSolverWorkSpaceSize(m);
+    auto w = real_type_1d_view_type(wptr, w_size);
+    wptr += w_size;
+
+    /// error check
+    const ordinal_type workspace_used(wptr - work.data()),
+      workspace_extent(work.extent(0));
+    if (workspace_used > workspace_extent) {
+      Kokkos::abort("Error: workspace used is larger than it is provided\n");
+    }
+
+    auto modulus = [&](const ordinal_type& j) {
+      return ats<real_type>::sqrt(er(j) * er(j) + ei(j) * ei(j));
+    };
+
+    /// initial conditions
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                         [&](const ordinal_type& k) { un(k) = vals(k); });
+    member.team_barrier();
+
+    ordinal_type r_val(0);
+    real_type t(t_beg), dt(dt_in);
+    /// step size proposed by the error control
+    real_type dt_err(dt_in > zero ? dt_in : dt_max);
+    for (ordinal_type iter = 0; iter < max_num_time_iterations && t < t_end;
+         ++iter) {
+      /// 1. vector field and Jacobian
+      problem.computeFunction(member, un, f);
+      problem.computeJacobian(member, un, J);
+      member.team_barrier();
+
+      {
+        bool is_valid_f(true), is_valid_J(true);
+        DenseNanInf::team_check_sanity(member, f, is_valid_f);
+        DenseNanInf::team_check_sanity(member, J, is_valid_J);
+        if (!is_valid_f || !is_valid_J) {
+          r_val = 1;
+          break;
+        }
+      }
+
+      /// 2. eigenvalues and right eigenvectors
+      DenseEigendecomposition::team_invoke(member, J, er, ei, UL, UR, w);
+
+      /// 3. sort modes by decreasing magnitude; conjugate pairs have the same
+      ///    magnitude and the stable sort keeps them adjacent
+      Kokkos::single(Kokkos::PerTeam(member), [&]() {
+        for (ordinal_type k = 0; k < m; ++k)
+          perm(k) = k;
+        for (ordinal_type k = 1; k < m; ++k) {
+          const ordinal_type pk = perm(k);
+          const real_type mk = modulus(pk);
+          ordinal_type l = k;
+          for (; l > 0 && modulus(perm(l - 1)) < mk; --l)
+            perm(l) = perm(l - 1);
+          perm(l) = pk;
+        }
+      });
+      member.team_barrier();
+
+      /// 4. real CSP basis and its dual, B = Ar^{-1}
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m * m),
+                           [&](const ordinal_type& ij) {
+                             const ordinal_type i = ij / m, j = ij % m;
+                             Ar(i, j) = UR(i, perm(j));
+                             J(i, j) = Ar(i, j);
+                             UL(i, j) = i == j ? one : zero;
+                           });
+      member.team_barrier();
+
+      ordinal_type matrix_rank(0);
+      DenseUTV::team_factorize_and_solve(member, J, B, UL, w, matrix_rank);
+      member.team_barrier();
+
+      /// 5. mode amplitudes h = B f
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const ordinal_type& r) {
+                             real_type hr(0);
+                             for (ordinal_type i = 0; i < m; ++i)
+                               hr += B(r, i) * f(i);
+                             h(r) = hr;
+                           });
+      member.team_barrier();
+
+      /// 6. number of exhausted modes; a defective basis disables the
+      ///    projection
+      ordinal_type num_exhausted(0);
+      if (matrix_rank == m) {
+        for (ordinal_type M = 0; M < m;) {
+          const ordinal_type jM = perm(M);
+          const ordinal_type nM = ei(jM) == zero ? 1 : 2;
+          const ordinal_type Mn = M + nM;
+
+          /// fast modes must be decaying and at least one slow mode remains
+          if (Mn >= m || er(jM) >= zero)
+            break;
+
+          const real_type tau = one / modulus(perm(Mn));
+          ordinal_type is_exhausted(0);
+          Kokkos::parallel_reduce(
+            Kokkos::TeamVectorRange(member, m),
+            [&](const ordinal_type& i, ordinal_type& update) {
+              real_type fast(0);
+              for (ordinal_type r = 0; r < Mn; ++r)
+                fast += Ar(i, r) * h(r);
+              const real_type tol =
+                tol_time(i, 1) * ats<real_type>::abs(un(i)) + tol_time(i, 0);
+              update += (tau * ats<real_type>::abs(fast) < tol);
+            },
+            is_exhausted);
+          if (is_exhausted < m)
+            break;
+          M = Mn;
+          num_exhausted = M;
+        }
+      }
+      const ordinal_type M = num_exhausted;
+
+      /// 7. slow vector field, g = f - sum_{r<M} a_r h^r
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const ordinal_type& i) {
+                             real_type fast(0);
+                             for (ordinal_type r = 0; r < M; ++r)
+                               fast += Ar(i, r) * h(r);
+                             g(i) = f(i) - fast;
+                           });
+      member.team_barrier();
+
+      /// 8. explicit Heun step on the slow vector field; the time step is
+      ///    limited by the fastest slow mode and the local error
+      const real_type lambda_slow = modulus(perm(M));
+      const real_type dt_stable =
+        lambda_slow > zero ? stability_factor / lambda_slow : dt_max;
+      for (bool is_accepted = false; !is_accepted;) {
+        dt = dt_stable < dt_err ? dt_stable : dt_err;
+        dt = dt > dt_max ? dt_max : dt;
+        dt = dt < dt_min ? dt_min : dt;
+        dt = (t + dt) > t_end ? t_end - t : dt;
+
+        Kokkos::parallel_for(
+          Kokkos::TeamVectorRange(member, m),
+          [&](const ordinal_type& i) { us(i) = un(i) + dt * g(i); });
+        member.team_barrier();
+
+        problem.computeFunction(member, us, fs);
+        member.team_barrier();
+
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, M),
+                             [&](const ordinal_type& r) {
+                               real_type hr(0);
+                               for (ordinal_type i = 0; i < m; ++i)
+                                 hr += B(r, i) * fs(i);
+                               h(r) = hr;
+                             });
+        member.team_barrier();
+
+        /// Heun minus Euler, u - us = dt/2 (gs - g), in the weighted rms norm
+        real_type norm(0);
+        Kokkos::parallel_reduce(
+          Kokkos::TeamVectorRange(member, m),
+          [&](const ordinal_type& i, real_type& update) {
+            real_type fast(0);
+            for (ordinal_type r = 0; r < M; ++r)
+              fast += Ar(i, r) * h(r);
+            const real_type gs = fs(i) - fast;
+            u(i) = un(i) + half * dt * (g(i) + gs);
+
+            const real_type abs_un = ats<real_type>::abs(un(i)),
+                            abs_u = ats<real_type>::abs(u(i));
+            const real_type w_at_i =
+              one / (tol_time(i, 1) * (abs_un > abs_u ? abs_un : abs_u) +
+                     tol_time(i, 0));
+            const real_type val = half * dt * (gs - g(i)) * w_at_i;
+            update += val * val;
+          },
+          norm);
+        member.team_barrier();
+        const real_type err = ats<real_type>::sqrt(norm / real_type(m));
+
+        /// nan rejects the step with the largest reduction
+        const bool is_err_valid = !ats<real_type>::isNan(err);
+        const real_type fac =
+          !is_err_valid ? tenth
+          : err > zero  ? safety * ats<real_type>::sqrt(one / err)
+                        : two;
+        const real_type alpha = fac < tenth ? tenth : fac > two ? two : fac;
+
+        is_accepted = is_err_valid && err <= one;
+        if (!is_accepted && dt <= dt_min) {
+          r_val = 1;
+          break;
+        }
+        dt_err = dt * alpha;
+      }
+      if (r_val)
+        break;
+
+      /// 9. radical correction
+      if (M > 0) {
+        problem.computeFunction(member, u, fs);
+        member.team_barrier();
+
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, M),
+                             [&](const ordinal_type& r) {
+                               real_type hr(0);
+                               for (ordinal_type i = 0; i < m; ++i)
+                                 hr += B(r, i) * fs(i);
+                               h(r) = hr;
+                             });
+        member.team_barrier();
+
+        /// h = Lambda^{-1} h; a conjugate pair a + ib with the basis
+        /// (Re v, Im v) has the block [a b; -b a]
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          for (ordinal_type r = 0; r < M;) {
+            const ordinal_type jr = perm(r);
+            if (ei(jr) == zero) {
+              h(r) /= er(jr);
+              ++r;
+            } else {
+              const real_type a = er(jr), b = ei(jr), d = a * a + b * b;
+              const real_type h0 = h(r), h1 = h(r + 1);
+              h(r) = (a * h0 - b * h1) / d;
+              h(r + 1) = (b * h0 + a * h1) / d;
+              r += 2;
+            }
+          }
+        });
+        member.team_barrier();
+
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const ordinal_type& i) {
+                               real_type fast(0);
+                               for (ordinal_type r = 0; r < M; ++r)
+                                 fast += Ar(i, r) * h(r);
+                               u(i) -= fast;
+                             });
+        member.team_barrier();
+      }
+
+      t += dt;
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const ordinal_type& k) { un(k) = u(k); });
+      member.team_barrier();
+    }
+
+    /// finalize with output for next iterations of time solutions
+    if (r_val == 0) {
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const ordinal_type& k) {
+                             vals_out(k) = un(k);
+                             if (k == 0) {
+                               t_out() = t;
+                               dt_out() = dt_err;
+                             }
+                           });
+    } else {
+      /// if the step fails,
+      /// - set values with zero
+      /// - t_out becomes t_end
+      /// - dt_out is minus one
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const ordinal_type& k) {
+                             vals_out(k) = zero;
+                             if (k == 0) {
+                               t_out() = t_end;
+                               dt_out() = minus_one;
+                             }
+                           });
+    }
+    member.team_barrier();
+
+    return r_val;
+  }
+};
+
+} // namespace Impl
+} // namespace TChem
+
+#endif
@@ -21,6 +21,7 @@ Sandia National Laboratories, Livermore, CA, USA
 #ifndef __TCHEM_IMPL_TR_BDF2_HPP__
 #define __TCHEM_IMPL_TR_BDF2_HPP__
 
+#include "TChem_Impl_NewtonKrylovSolver.hpp"
 #include "TChem_Util.hpp"
 
 namespace TChem {
@@ -150,7 +151,10 @@ struct TrBDF2
   getWorkSpaceSize(const ProblemType& problem)
   {
     const ordinal_type m = problem.getNumberOfEquations();
-    const ordinal_type r_val = 1 + m * 8 + m * m;
+    /// jacobian is not stored with the jacobian-free solver
+    const ordinal_type r_val = UseNewtonKrylovSolver<ProblemType>::value
+                                 ? 1 + m * 8
+                                 : 1 + m * 8 + m * m;
     return r_val;
   }
 };
@@ -159,6 +163,8 @@ template<typename ProblemType>
 struct TrBDF2_Part1
 {
   using problem_type = ProblemType;
+  static constexpr bool has_jacobian_diagonal =
+    HasJacobianDiagonal<ProblemType>::value;
   using real_type_1d_view_type = typename problem_type::real_type_1d_view_type;
   using real_type_2d_view_type = typename problem_type::real_type_2d_view_type;
 
@@ -222,6 +228,24 @@ struct TrBDF2_Part1
     member.team_barrier();
   }
 
+  template<typename MemberType>
+  KOKKOS_INLINE_FUNCTION void computeJacobianDiagonal(
+    const MemberType& member,
+    const real_type_1d_view_type& u,
+    const real_type_1d_view_type& d) const
+  {
+    const real_type one(1), half(0.5);
+    const ordinal_type m = _problem.getNumberOfTimeODEs();
+
+    _problem.computeJacobianDiagonal(member, u, d);
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                         [&](const ordinal_type& i) {
+                           const auto scal = _gamma * _dt * half;
+                           d(i) = one - scal * d(i);
+                         });
+    member.team_barrier();
+  }
+
   template<typename MemberType>
   KOKKOS_INLINE_FUNCTION void computeFunction(
     const MemberType& member,
@@ -247,6 +271,8 @@ template<typename ProblemType>
 struct TrBDF2_Part2
 {
   using problem_type = ProblemType;
+  static constexpr bool has_jacobian_diagonal =
+    HasJacobianDiagonal<ProblemType>::value;
   using real_type_1d_view_type = typename problem_type::real_type_1d_view_type;
   using real_type_2d_view_type = typename problem_type::real_type_2d_view_type;
 
@@ -309,6 +335,24 @@ struct TrBDF2_Part2
     member.team_barrier();
   }
 
+  template<typename MemberType>
+  KOKKOS_INLINE_FUNCTION void computeJacobianDiagonal(
+    const MemberType& member,
+    const real_type_1d_view_type& u,
+    const real_type_1d_view_type& d) const
+  {
+    const real_type one(1), two(2);
+    const ordinal_type m = _problem.getNumberOfTimeODEs();
+
+    _problem.computeJacobianDiagonal(member, u, d);
+    Kokkos::parallel_for(
+      Kokkos::TeamVectorRange(member, m), [&](const ordinal_type& i) {
+        const auto scal = (one - _gamma) / (two - _gamma) * _dt;
+        d(i) = one - scal * d(i);
+      });
+    member.team_barrier();
+  }
+
   template<typename MemberType>
   KOKKOS_INLINE_FUNCTION void computeFunction(
     const MemberType& member,
@@ -80,6 +80,9 @@ struct TransientContStirredTankReactorRHS
     const RealType1DViewType& cpks,
     // gas species
     const RealType1DViewType& work,
+    /// rate constants of the last evaluation (can be empty)
+    const RealType1DViewType& memo,
+    const RealType1DViewType& memoSurf,
 
     /// const input from kinetic model
     const KineticModelConstDataType& kmcd,
@@ -103,6 +106,7 @@ struct TransientContStirredTankReactorRHS
                                        Ys,
                                        omega,
                                        work,
+                                       memo,
                                        kmcd);
 
     // compute mix enthalpy
@@ -126,6 +130,7 @@ struct TransientContStirredTankReactorRHS
                                             omegaSurfGas,
                                             omegaSurf,
                                             work,
+                                            memoSurf,
                                             kmcd,
                                             kmcdSurf);
 
@@ -256,6 +261,48 @@ struct TransientContStirredTankReactorRHS
     const KineticModelConstDataType& kmcd,
     const KineticSurfModelConstDataType& kmcdSurf,
     const ContStirredTankReactorConstDataType& cstr)
+  {
+    team_invoke(member,
+                t,
+                Ys,
+                Zs,
+                density,
+                p,
+                rhs,
+                work,
+                RealType1DViewType(),
+                RealType1DViewType(),
+                kmcd,
+                kmcdSurf,
+                cstr);
+  }
+
+  /// memo, memoSurf (KForwardReverseMemo::getWorkSpaceSize) - gas and surface
+  /// rate constants of the last evaluation
+  template<typename MemberType,
+           typename WorkViewType,
+           typename RealType1DViewType,
+           typename KineticModelConstDataType,
+           typename KineticSurfModelConstDataType,
+           typename ContStirredTankReactorConstDataType>
+  KOKKOS_FORCEINLINE_FUNCTION static void team_invoke(
+    const MemberType& member,
+    /// input
+    const real_type& t,
+    const RealType1DViewType& Ys, /// (kmcd.nSpec)
+    const RealType1DViewType& Zs, // (kmcdSurf.nSpec) site fraction
+    const real_type& density,
+    const real_type& p, // pressure
+    /// output
+    const RealType1DViewType& rhs, /// (kmcd.nSpec + 1)
+    /// workspace
+    const WorkViewType& work,
+    const RealType1DViewType& memo,
+    const RealType1DViewType& memoSurf,
+    /// const input from kinetic model
+    const KineticModelConstDataType& kmcd,
+    const KineticSurfModelConstDataType& kmcdSurf,
+    const ContStirredTankReactorConstDataType& cstr)
   {
     // const real_type zero(0);
 
@@ -305,6 +352,8 @@ struct TransientContStirredTankReactorRHS
                        hks,
                        cpks,
                        workRHS,
+                       memo,
+                       memoSurf,
                  // data from surface and gas phases
                        kmcd,
                        kmcdSurf,
@@ -23,6 +23,7 @@ Sandia National Laboratories, Livermore, CA, USA
 
 #include "TChem_Util.hpp"
 
+#include "TChem_Impl_DirectedRelationGraph.hpp"
 #include "TChem_Impl_IgnitionZeroD_Problem.hpp"
 #include "TChem_Impl_TimeIntegrator.hpp"
 
@@ -40,7 +41,37 @@ struct IgnitionZeroD
     problem_type problem;
     problem._kmcd = kmcd;
 
-    return TimeIntegrator::getWorkSpaceSize(problem);
+    const ordinal_type time_integrator_workspace_size =
+      TimeIntegrator::getWorkSpaceSize(problem);
+    const ordinal_type memo_workspace_size =
+      problem_type::getMemoWorkSpaceSize(kmcd);
+    if (kmcd.drgThreshold >= real_type(0)) {
+      /// the problem workspace is carved out first; the drg workspace after
+      /// the reaction mask is reused by the time integrator
+      const ordinal_type problem_workspace_size =
+        problem_type::getWorkSpaceSize(kmcd);
+      const ordinal_type drg_workspace_size =
+        DirectedRelationGraph::getWorkSpaceSize(kmcd);
+      const ordinal_type remaining_workspace_size =
+        time_integrator_workspace_size - problem_workspace_size;
+      return (problem_workspace_size + memo_workspace_size + kmcd.nReac +
+              (drg_workspace_size > remaining_workspace_size
+                 ? drg_workspace_size
+                 : remaining_workspace_size));
+    }
+    return (memo_workspace_size + time_integrator_workspace_size);
+  }
+
+  /// additional workspace for the sensitivities with respect to ln A
+  template<typename KineticModelConstDataType>
+  static inline ordinal_type getSensitivityWorkSpaceSize(
+    const KineticModelConstDataType& kmcd)
+  {
+    using problem_type =
+      TChem::Impl::IgnitionZeroD_Problem<KineticModelConstDataType>;
+    problem_type problem;
+    problem._kmcd = kmcd;
+    return TimeIntegrator::getSensitivityWorkSpaceSize(problem);
   }
 
   template<typename MemberType,
@@ -48,6 +79,7 @@ struct IgnitionZeroD
            typename RealType0DViewType,
            typename RealType1DViewType,
            typename RealType2DViewType,
+           typename RealType2DSensViewType,
            typename KineticModelConstDataType>
   KOKKOS_INLINE_FUNCTION static void team_invoke_detail(
     const MemberType& member,
@@ -71,6 +103,8 @@ struct IgnitionZeroD
     const RealType0DViewType& dt_out,
     const RealType0DViewType& pressure_out,
     const RealType1DViewType& vals_out,
+    /// sensitivities with respect to ln A (kmcd.nReac, kmcd.nSpec + 1)
+    const RealType2DSensViewType& sens,
     /// workspace
     const WorkViewType& work,
     /// const input from kinetic model
@@ -88,6 +122,21 @@ struct IgnitionZeroD
       wptr, problem_workspace_size);
     wptr += problem_workspace_size;
 
+    /// rate constants memo
+    const ordinal_type memo_workspace_size =
+      problem_type::getMemoWorkSpaceSize(kmcd);
+    auto pm = wptr;
+    wptr += memo_workspace_size;
+
+    /// reduced mechanism for this sample
+    KineticModelConstDataType kmcd_reduced = kmcd;
+    const bool use_drg = kmcd.drgThreshold >= real_type(0);
+    auto reacActive = Kokkos::View<ordinal_type*,
+                                   Kokkos::LayoutRight,
+                                   typename WorkViewType::memory_space>(
+      (ordinal_type*)wptr, use_drg ? kmcd.nReac : 0);
+    wptr += reacActive.span();
+
     /// error check
     const ordinal_type workspace_used(wptr - work.data()),
       workspace_extent(work.extent(0));
@@ -98,11 +147,21 @@ struct IgnitionZeroD
     /// time integrator workspace
     auto tw = WorkViewType(wptr, workspace_extent - workspace_used);
 
+    /// active reactions are determined at the beginning of each interval
+    if (use_drg) {
+      const real_type temperature = vals(0);
+      const RealType1DViewType Ys(&vals(1), kmcd.nSpec);
+      DirectedRelationGraph::team_invoke(
+        member, temperature, pressure, Ys, reacActive, tw, kmcd);
+      kmcd_reduced.reacActive = reacActive;
+    }
+
     /// initialize problem
-    problem._p = pressure; // pressure
-    problem._work = pw;    // problem workspace array
-    problem._kmcd = kmcd;  // kinetic model
+    problem._p = pressure;        // pressure
+    problem._work = pw;           // problem workspace array
+    problem._kmcd = kmcd_reduced; // kinetic model
     problem._fac = fac;    // fac for numerical jacobian
+    problem.setMemo(member, pm);
 
     const ordinal_type r_val =
       TimeIntegrator::team_invoke_detail(member,
@@ -120,6 +179,7 @@ struct IgnitionZeroD
                                          t_out,
                                          dt_out,
                                          vals_out,
+                                         sens,
                                          tw);
 
     /// pressure is constant, make sure it in the next restarting iteration
@@ -138,6 +198,7 @@ struct IgnitionZeroD
            typename RealType0DViewType,
            typename RealType1DViewType,
            typename RealType2DViewType,
+           typename RealType2DSensViewType,
            typename KineticModelConstDataType>
   KOKKOS_INLINE_FUNCTION static void team_invoke(
     const MemberType& member,
@@ -161,6 +222,8 @@ struct IgnitionZeroD
     const RealType0DViewType& dt_out,
     const RealType0DViewType& pressure_out,
     const RealType1DViewType& vals_out,
+    /// sensitivities with respect to ln A (kmcd.nReac, kmcd.nSpec + 1)
+    const RealType2DSensViewType& sens,
     /// workspace
     const WorkViewType& work,
     /// const input from kinetic model
@@ -184,6 +247,7 @@ struct IgnitionZeroD
                        dt_out,
                        pressure_out,
                        vals_out,
+                       sens,
                        work,
                        kmcd);
     member.team_barrier();
@@ -196,6 +260,61 @@ struct IgnitionZeroD
       });
     }
   }
+
+  template<typename MemberType,
+           typename WorkViewType,
+           typename RealType0DViewType,
+           typename RealType1DViewType,
+           typename RealType2DViewType,
+           typename KineticModelConstDataType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke(
+    const MemberType& member,
+    /// input iteration and qoi index to store
+    const ordinal_type& max_num_newton_iterations,
+    const ordinal_type& max_num_time_iterations,
+    const RealType1DViewType& tol_newton,
+    const RealType2DViewType& tol_time,
+    const RealType1DViewType& fac,
+    /// input time step and time range
+    const real_type& dt_in,
+    const real_type& dt_min,
+    const real_type& dt_max,
+    const real_type& t_beg,
+    const real_type& t_end,
+    /// input (initial condition)
+    const real_type& pressure,      /// pressure
+    const RealType1DViewType& vals, /// temperature, mass fractions
+    /// output (final output conditions)
+    const RealType0DViewType& t_out,
+    const RealType0DViewType& dt_out,
+    const RealType0DViewType& pressure_out,
+    const RealType1DViewType& vals_out,
+    /// workspace
+    const WorkViewType& work,
+    /// const input from kinetic model
+    const KineticModelConstDataType& kmcd)
+  {
+    team_invoke(member,
+                max_num_newton_iterations,
+                max_num_time_iterations,
+                tol_newton,
+                tol_time,
+                fac,
+                dt_in,
+                dt_min,
+                dt_max,
+                t_beg,
+                t_end,
+                pressure,
+                vals,
+                t_out,
+                dt_out,
+                pressure_out,
+                vals_out,
+                RealType2DViewType(),
+                work,
+                kmcd);
+  }
 };
 
 } // namespace Impl
@@ -23,6 +23,7 @@ Sandia National Laboratories, Livermore, CA, USA
 
 #include "TChem_Util.hpp"
 
+#include "TChem_Impl_JacobianDiagonal.hpp"
 #include "TChem_Impl_JacobianReduced.hpp"
 #include "TChem_Impl_SourceTerm.hpp"
 
@@ -41,6 +42,9 @@ struct IgnitionZeroD_Problem
   using real_type_1d_view_type = typename kmcd_type::real_type_1d_view_type;
   using real_type_2d_view_type = typename kmcd_type::real_type_2d_view_type;
 
+  /// computeJacobianDiagonal preconditions the newton krylov solver
+  static constexpr bool has_jacobian_diagonal = true;
+
   KOKKOS_DEFAULTED_FUNCTION
   IgnitionZeroD_Problem() = default;
 
@@ -49,6 +53,8 @@ struct IgnitionZeroD_Problem
   real_type_1d_view_type _x;
   real_type_1d_view_type _fac; /// numerical jacobian
   real_type_1d_view_type _work;
+  /// rate constants of the last evaluation; empty view disables the memo
+  real_type_1d_view_type _memo;
   kmcd_type _kmcd;
 
   KOKKOS_INLINE_FUNCTION
@@ -71,11 +77,21 @@ struct IgnitionZeroD_Problem
     return getNumberOfTimeODEs(kmcd) + getNumberOfConstraints(kmcd);
   }
 
+  /// sensitivity parameters are ln A of reactions
+  KOKKOS_INLINE_FUNCTION
+  static ordinal_type getNumberOfParameters(
+    const KineticModelConstDataType& kmcd)
+  {
+    return kmcd.nReac;
+  }
+
   KOKKOS_INLINE_FUNCTION
   static ordinal_type getWorkSpaceSize(const KineticModelConstDataType& kmcd)
   {
     const ordinal_type src_workspace_size = SourceTerm::getWorkSpaceSize(kmcd);
-#if defined(TCHEM_ENABLE_PROBLEMS_NUMERICAL_JACOBIAN)
+#if defined(TCHEM_ENABLE_PROBLEMS_NUMERICAL_JACOBIAN) ||                        \
+  defined(TCHEM_ENABLE_TIME_INTEGRATOR_USE_NEWTON_KRYLOV)
+    /// the jacobian diagonal uses the tail as the numerical jacobian does
     const ordinal_type jac_workspace_size = 2 * getNumberOfEquations(kmcd);
     const ordinal_type workspace_size = src_workspace_size + jac_workspace_size;
 #else
@@ -88,6 +104,22 @@ struct IgnitionZeroD_Problem
     return workspace_size;
   }
 
+  /// the memo is a separate slice as _work is overwritten by the jacobian
+  KOKKOS_INLINE_FUNCTION
+  static ordinal_type getMemoWorkSpaceSize(
+    const KineticModelConstDataType& kmcd)
+  {
+    return KForwardReverseMemo::getWorkSpaceSize(kmcd);
+  }
+
+  template<typename MemberType>
+  KOKKOS_INLINE_FUNCTION void setMemo(const MemberType& member,
+                                      real_type* wptr)
+  {
+    _memo = real_type_1d_view_type(wptr, getMemoWorkSpaceSize(_kmcd));
+    KForwardReverseMemo::team_reset(member, _memo, _kmcd.memoRtol);
+  }
+
   ///
   /// non static functions that require the object
   /// workspace size is required without kmcd
@@ -110,6 +142,12 @@ struct IgnitionZeroD_Problem
     return getNumberOfTimeODEs() + getNumberOfConstraints();
   }
 
+  KOKKOS_INLINE_FUNCTION
+  ordinal_type getNumberOfParameters() const
+  {
+    return getNumberOfParameters(_kmcd);
+  }
+
   KOKKOS_INLINE_FUNCTION
   ordinal_type getWorkSpaceSize() const { return getWorkSpaceSize(_kmcd); }
 
@@ -131,7 +169,24 @@ struct IgnitionZeroD_Problem
   {
     const real_type t = x(0);
     const real_type_1d_view_type Ys(&x(1), _kmcd.nSpec);
-    Impl::SourceTerm::team_invoke(member, t, _p, Ys, f, _work, _kmcd);
+    Impl::SourceTerm::team_invoke(member, t, _p, Ys, f, _work, _memo, _kmcd);
+    member.team_barrier();
+  }
+
+  /// fp(j,i) is the derivative of f(i) with respect to the parameter j
+  template<typename MemberType,
+           typename RealType1DViewType,
+           typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION void computeParameterJacobian(
+    const MemberType& member,
+    const RealType1DViewType& x,
+    const RealType1DViewType& f,
+    const RealType2DViewType& fp) const
+  {
+    const real_type t = x(0);
+    const real_type_1d_view_type Ys(&x(1), _kmcd.nSpec);
+    Impl::SourceTerm::team_invoke_parameter_jacobian(
+      member, t, _p, Ys, f, fp, _work, _kmcd);
     member.team_barrier();
   }
 
@@ -142,7 +197,9 @@ struct IgnitionZeroD_Problem
                                               const RealType1DViewType& x,
                                               const RealType2DViewType& J) const
   {
-#if defined(TCHEM_ENABLE_PROBLEMS_NUMERICAL_JACOBIAN)
+#if defined(TCHEM_ENABLE_PROBLEMS_NUMERICAL_JACOBIAN) ||                        \
+  defined(TCHEM_ENABLE_TIME_INTEGRATOR_USE_NEWTON_KRYLOV)
+    /// the analytic jacobian is not affordable with the jacobian-free solver
     const ordinal_type m = getNumberOfEquations();
     /// _work is used for evaluating a function
     /// f_0 and f_h should be gained from the tail
@@ -167,6 +224,18 @@ struct IgnitionZeroD_Problem
     member.team_barrier();
 #endif
   }
+
+  template<typename MemberType, typename RealType1DViewType>
+  KOKKOS_INLINE_FUNCTION void computeJacobianDiagonal(
+    const MemberType& member,
+    const RealType1DViewType& x,
+    const RealType1DViewType& d) const
+  {
+    const real_type t = x(0);
+    const real_type_1d_view_type Ys(&x(1), _kmcd.nSpec);
+    Impl::JacobianDiagonal::team_invoke(member, t, _p, Ys, d, _work, _kmcd);
+    member.team_barrier();
+  }
 };
 
 } // namespace Impl
@@ -49,7 +49,8 @@ struct PlugFlowReactor
     problem_type problem;
     problem._kmcd = kmcd;
     problem._kmcdSurf = kmcdSurf;
-    return TimeIntegrator::getWorkSpaceSize(problem);
+    return (TimeIntegrator::getWorkSpaceSize(problem) +
+            problem_type::getMemoWorkSpaceSize(kmcd, kmcdSurf));
   }
 
   template<typename MemberType,
@@ -108,6 +109,12 @@ struct PlugFlowReactor
     auto pw = real_type_1d_view(wptr, problem_workspace_size);
     wptr += problem_workspace_size;
 
+    /// rate constants memo
+    const ordinal_type memo_workspace_size =
+      problem_type::getMemoWorkSpaceSize(kmcd, kmcdSurf);
+    auto pm = wptr;
+    wptr += memo_workspace_size;
+
     /// error check
     const ordinal_type workspace_used(wptr - work.data()),
       workspace_extent(work.extent(0));
@@ -123,6 +130,7 @@ struct PlugFlowReactor
     problem._pfrd = pfrd;
     problem._work = pw; // problem workspace array
     problem._fac = fac;    // fac for numerical jacobian
+    problem.setMemo(member, pm);
 
     TimeIntegrator::team_invoke_detail(member,
                                        problem,
@@ -49,6 +49,9 @@ struct PlugFlowReactor_Problem
   real_type_1d_view _x;
   real_type_1d_view _work;
   real_type_1d_view _fac; /// numerical jacobian
+  /// rate constants of the last evaluation; empty views disable the memo
+  real_type_1d_view_type _memo;
+  real_type_1d_view_type _memoSurf;
   KineticModelConstDataType _kmcd;
   KineticSurfModelConstDataType _kmcdSurf;
   PlugFlowReactorConstDataType _pfrd;
@@ -69,6 +72,29 @@ struct PlugFlowReactor_Problem
     return workspace_size;
   }
 
+  /// gas and surface memos are carved as one slice; see setMemo
+  KOKKOS_INLINE_FUNCTION
+  static ordinal_type getMemoWorkSpaceSize(
+    const KineticModelConstDataType& kmcd,
+    const KineticSurfModelConstDataType& kmcdSurf)
+  {
+    return (KForwardReverseMemo::getWorkSpaceSize(kmcd) +
+            KForwardReverseMemo::getWorkSpaceSize(kmcdSurf));
+  }
+
+  template<typename MemberType>
+  KOKKOS_INLINE_FUNCTION void setMemo(const MemberType& member,
+                                      real_type* wptr)
+  {
+    const ordinal_type memo_size = KForwardReverseMemo::getWorkSpaceSize(_kmcd),
+                       memo_surf_size =
+                         KForwardReverseMemo::getWorkSpaceSize(_kmcdSurf);
+    _memo = real_type_1d_view_type(wptr, memo_size);
+    _memoSurf = real_type_1d_view_type(wptr + memo_size, memo_surf_size);
+    KForwardReverseMemo::team_reset(member, _memo, _kmcd.memoRtol);
+    KForwardReverseMemo::team_reset(member, _memoSurf, _kmcdSurf.memoRtol);
+  }
+
   KOKKOS_INLINE_FUNCTION
   static ordinal_type getNumberOfTimeODEs(const KineticModelConstDataType& kmcd)
   {
@@ -100,6 +126,10 @@ struct PlugFlowReactor_Problem
     return getWorkSpaceSize(_kmcd, _kmcdSurf);
   }
 
+  /// sensitivity parameters are not defined for this problem
+  KOKKOS_INLINE_FUNCTION
+  ordinal_type getNumberOfParameters() const { return 0; }
+
   KOKKOS_INLINE_FUNCTION
   ordinal_type getNumberOfTimeODEs() const
   {
@@ -159,6 +189,18 @@ struct PlugFlowReactor_Problem
   //  (member, *this, fac_min, fac_max, _fac, x, f_0, f_h, J);
 
 }
+  template<typename MemberType,
+           typename RealType1DViewType,
+           typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION void computeParameterJacobian(
+    const MemberType& member,
+    const RealType1DViewType& x,
+    const RealType1DViewType& f,
+    const RealType2DViewType& fp) const
+  {
+    /// no parameters
+  }
+
   template<typename MemberType, typename RealType1DViewType>
   KOKKOS_INLINE_FUNCTION void computeFunction(const MemberType& member,
                                               const RealType1DViewType& x,
@@ -182,6 +224,8 @@ struct PlugFlowReactor_Problem
                                            vel,
                                            f,
                                            _work,
+                                           _memo,
+                                           _memoSurf,
                                            _kmcd,
                                            _kmcdSurf,
                                            _pfrd);
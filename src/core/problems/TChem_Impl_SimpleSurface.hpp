@@ -47,7 +47,8 @@ struct SimpleSurface
     problem._kmcd = kmcd;
     problem._kmcdSurf = kmcdSurf;
     return TimeIntegrator::getWorkSpaceSize(problem) +
-           problem.getNumberOfEquations(kmcdSurf); /// temporal vector tolerence
+           problem.getNumberOfEquations(kmcdSurf) + /// temporal vector tolerence
+           problem_type::getMemoWorkSpaceSize(kmcd, kmcdSurf);
   }
 
   template<typename MemberType,
@@ -107,6 +108,12 @@ struct SimpleSurface
     auto pw = real_type_1d_view_type(wptr, problem_workspace_size);
     wptr += pw.span();
 
+    /// rate constants memo
+    const ordinal_type memo_workspace_size =
+      problem_type::getMemoWorkSpaceSize(kmcd, kmcdSurf);
+    auto pm = wptr;
+    wptr += memo_workspace_size;
+
     /// error check
     const ordinal_type workspace_used(wptr - work.data()),
       workspace_extent(work.extent(0));
@@ -124,6 +131,7 @@ struct SimpleSurface
     problem._t = temperature;     // temperature
     problem._work = pw;           // problem workspace array
     problem._fac = fac;    // fac for numerical jacobian
+    problem.setMemo(member, pm);
 
     TimeIntegrator::team_invoke_detail(member,
                                        problem,
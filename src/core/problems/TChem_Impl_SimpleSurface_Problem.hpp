@@ -53,6 +53,9 @@ struct SimpleSurface_Problem
   real_type_1d_view_type _x;
   real_type_1d_view_type _work;
   real_type_1d_view_type _fac; /// numerical jacobian
+  /// surface rate constants of the last evaluation; empty view disables the
+  /// memo. temperature is fixed so rate constants are evaluated once
+  real_type_1d_view_type _memoSurf;
   KineticModelConstDataType _kmcd;
   KineticSurfModelConstDataType _kmcdSurf;
   // ordinal_type _jac_dim;
@@ -78,6 +81,23 @@ struct SimpleSurface_Problem
     return workspace_size;
   }
 
+  KOKKOS_INLINE_FUNCTION
+  static ordinal_type getMemoWorkSpaceSize(
+    const KineticModelConstDataType& kmcd,
+    const KineticSurfModelConstDataType& kmcdSurf)
+  {
+    return KForwardReverseMemo::getWorkSpaceSize(kmcdSurf);
+  }
+
+  template<typename MemberType>
+  KOKKOS_INLINE_FUNCTION void setMemo(const MemberType& member,
+                                      real_type* wptr)
+  {
+    _memoSurf =
+      real_type_1d_view_type(wptr, getMemoWorkSpaceSize(_kmcd, _kmcdSurf));
+    KForwardReverseMemo::team_reset(member, _memoSurf, _kmcdSurf.memoRtol);
+  }
+
   KOKKOS_INLINE_FUNCTION
   static ordinal_type getNumberOfTimeODEs(
     const KineticSurfModelConstDataType& kmcdSurf)
@@ -109,6 +129,10 @@ struct SimpleSurface_Problem
     return getWorkSpaceSize(_kmcd, _kmcdSurf);
   }
 
+  /// sensitivity parameters are not defined for this problem
+  KOKKOS_INLINE_FUNCTION
+  ordinal_type getNumberOfParameters() const { return 0; }
+
   KOKKOS_INLINE_FUNCTION
   ordinal_type getNumberOfTimeODEs() const
   {
@@ -170,6 +194,18 @@ struct SimpleSurface_Problem
 
   }
 
+  template<typename MemberType,
+           typename RealType1DViewType,
+           typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION void computeParameterJacobian(
+    const MemberType& member,
+    const RealType1DViewType& x,
+    const RealType1DViewType& f,
+    const RealType2DViewType& fp) const
+  {
+    /// no parameters
+  }
+
   template<typename MemberType, typename RealType1DViewType>
   KOKKOS_INLINE_FUNCTION void computeFunction(const MemberType& member,
                                               const RealType1DViewType& x,
@@ -177,7 +213,7 @@ struct SimpleSurface_Problem
   {
 
     Impl::SurfaceRHS::team_invoke(
-      member, _t, _Ys, x, _p, f, _work, _kmcd, _kmcdSurf);
+      member, _t, _Ys, x, _p, f, _work, _memoSurf, _kmcd, _kmcdSurf);
     member.team_barrier();
   }
 };
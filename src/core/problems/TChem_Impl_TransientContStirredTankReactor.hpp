@@ -50,7 +50,8 @@ struct TransientContStirredTankReactor
     problem_type problem;
     problem._kmcd = kmcd;
     problem._kmcdSurf = kmcdSurf;
-    return TimeIntegrator::getWorkSpaceSize(problem);
+    return (TimeIntegrator::getWorkSpaceSize(problem) +
+            problem_type::getMemoWorkSpaceSize(kmcd, kmcdSurf));
   }
 
   template<typename MemberType,
@@ -105,6 +106,12 @@ struct TransientContStirredTankReactor
     auto pw = real_type_1d_view(wptr, problem_workspace_size);
     wptr += problem_workspace_size;
 
+    /// rate constants memo
+    const ordinal_type memo_workspace_size =
+      problem_type::getMemoWorkSpaceSize(kmcd, kmcdSurf);
+    auto pm = wptr;
+    wptr += memo_workspace_size;
+
     /// error check
     const ordinal_type workspace_used(wptr - work.data()),
       workspace_extent(work.extent(0));
@@ -120,6 +127,7 @@ struct TransientContStirredTankReactor
     problem._cstr = cstr;
     problem._work = pw; // problem workspace array
     problem._fac = fac; // fac for numerical jacobian
+    problem.setMemo(member, pm);
 
     TimeIntegrator::team_invoke_detail(member,
                                        problem,
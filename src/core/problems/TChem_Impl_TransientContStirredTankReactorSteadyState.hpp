@@ -0,0 +1,446 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_IMPL_TRANSIENT_CONT_STIRRED_TANK_REACTOR_STEADY_STATE_HPP__
+#define __TCHEM_IMPL_TRANSIENT_CONT_STIRRED_TANK_REACTOR_STEADY_STATE_HPP__
+
+#include "TChem_Util.hpp"
+
+#include "TChem_Impl_DenseNanInf.hpp"
+#include "TChem_Impl_DenseUTV.hpp"
+#include "TChem_Impl_SteadyStateSolver.hpp"
+#include "TChem_Impl_TransientContStirredTankReactor_Problem.hpp"
+
+namespace TChem {
+namespace Impl {
+
+///
+/// Steady state of the stirred tank reactor (PSR) on the same problem as
+/// TransientContStirredTankReactor i.e., gas and surface species with or
+/// without the DAE constraint of the site fractions.
+///
+/// - team_invoke solves f(x) = 0 with SteadyStateSolver (damped Newton with
+///   pseudo-transient fallback).
+/// - team_invoke_continuation traces the steady solution branch in residence
+///   time with pseudo arc-length continuation. The continuation parameter is
+///   lambda = -ln(mdotIn/mdotIn_0) so that lambda increases with residence
+///   time, and the augmented system
+///
+///     f(x, lambda) = 0
+///     <t, (x, lambda) - (x_0, lambda_0)>_w = ds
+///
+///   is solved with Newton's method from the predictor (x_0, lambda_0) +
+///   ds t. The tangent t is the secant of the last two points (the first one
+///   solves J t_x = -df/dlambda). Turning points (ignition and extinction)
+///   are passed as the augmented system is regular there. The step size is
+///   halved when the corrector fails and grows when it converges quickly.
+///   Temperature is scaled with its initial value in the weighted norm.
+///
+struct TransientContStirredTankReactorSteadyState
+{
+  template<typename KineticModelConstDataType,
+           typename KineticSurfModelConstDataType,
+           typename TransientContStirredTankReactorConstDataType>
+  static inline ordinal_type getWorkSpaceSize(
+    const KineticModelConstDataType& kmcd,
+    const KineticSurfModelConstDataType& kmcdSurf,
+    const TransientContStirredTankReactorConstDataType& cstr)
+  {
+    using problem_type = TransientContStirredTankReactor_Problem<
+      KineticModelConstDataType,
+      KineticSurfModelConstDataType,
+      TransientContStirredTankReactorConstDataType>;
+    problem_type problem;
+    problem._kmcd = kmcd;
+    problem._kmcdSurf = kmcdSurf;
+
+    const ordinal_type m = problem.getNumberOfEquations(), n = m + 1;
+    const ordinal_type problem_workspace_size =
+      problem_type::getWorkSpaceSize(kmcd, kmcdSurf);
+    const ordinal_type solver_workspace_size =
+      SteadyStateSolver::getWorkSpaceSize(problem);
+    /// y0, y, t, dy, g, f_h, J, A and UTV workspace of A
+    const ordinal_type continuation_workspace_size =
+      5 * n + m + m * m + n * n + DenseUTV::getWorkSpaceSize(n, n);
+
+    return (problem_workspace_size +
+            (solver_workspace_size > continuation_workspace_size
+               ? solver_workspace_size
+               : continuation_workspace_size));
+  }
+
+  template<typename MemberType,
+           typename WorkViewType,
+           typename RealType1DViewType,
+           typename KineticModelConstDataType,
+           typename KineticSurfModelConstDataType,
+           typename TransientContStirredTankReactorConstDataType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke(
+    const MemberType& member,
+    /// input
+    const real_type& atol,
+    const real_type& rtol,
+    const ordinal_type& max_num_iterations,
+    const real_type& dt_init,
+    const real_type& dt_max,
+    const RealType1DViewType& fac, /// numerical jacobian percentage
+    /// input/output (initial guess and steady state)
+    const RealType1DViewType& vals,
+    /// output
+    /* */ ordinal_type& iter_count,
+    /* */ ordinal_type& status,
+    /// workspace
+    const WorkViewType& work,
+    /// const input from kinetic model
+    const KineticModelConstDataType& kmcd,
+    const KineticSurfModelConstDataType& kmcdSurf,
+    const TransientContStirredTankReactorConstDataType& cstr)
+  {
+    using problem_type = TransientContStirredTankReactor_Problem<
+      KineticModelConstDataType,
+      KineticSurfModelConstDataType,
+      TransientContStirredTankReactorConstDataType>;
+
+    const ordinal_type problem_workspace_size =
+      problem_type::getWorkSpaceSize(kmcd, kmcdSurf);
+
+    auto wptr = work.data();
+    auto pw = real_type_1d_view(wptr, problem_workspace_size);
+    wptr += problem_workspace_size;
+
+    problem_type problem;
+    problem._kmcd = kmcd;
+    problem._kmcdSurf = kmcdSurf;
+    problem._cstr = cstr;
+    problem._work = pw;
+    problem._fac = fac;
+
+    const ordinal_type workspace_used(wptr - work.data()),
+      workspace_extent(work.extent(0));
+    auto sw = RealType1DViewType(wptr, workspace_extent - workspace_used);
+
+    SteadyStateSolver::team_invoke(member,
+                                   problem,
+                                   atol,
+                                   rtol,
+                                   max_num_iterations,
+                                   dt_init,
+                                   dt_max,
+                                   vals,
+                                   sw,
+                                   iter_count,
+                                   status);
+  }
+
+  template<typename MemberType,
+           typename WorkViewType,
+           typename RealType1DViewType,
+           typename RealType2DViewType,
+           typename KineticModelConstDataType,
+           typename KineticSurfModelConstDataType,
+           typename TransientContStirredTankReactorConstDataType>
+  KOKKOS_INLINE_FUNCTION static void team_invoke_continuation(
+    const MemberType& member,
+    /// input
+    const real_type& atol,
+    const real_type& rtol,
+    const ordinal_type& max_num_iterations,
+    const real_type& dt_init,
+    const real_type& dt_max,
+    const real_type& ds_init, /// arc-length step; negative goes backward
+    const real_type& ds_max,
+    const RealType1DViewType& fac, /// numerical jacobian percentage
+    /// input/output (initial guess at cstr.mdotIn and the last point)
+    const RealType1DViewType& vals,
+    /// output
+    const RealType2DViewType& vals_path, /// (num_steps, m)
+    const RealType1DViewType& mdot_path, /// (num_steps)
+    /* */ ordinal_type& num_steps_out,
+    /* */ ordinal_type& status,
+    /// workspace
+    const WorkViewType& work,
+    /// const input from kinetic model
+    const KineticModelConstDataType& kmcd,
+    const KineticSurfModelConstDataType& kmcdSurf,
+    const TransientContStirredTankReactorConstDataType& cstr)
+  {
+    using problem_type = TransientContStirredTankReactor_Problem<
+      KineticModelConstDataType,
+      KineticSurfModelConstDataType,
+      TransientContStirredTankReactorConstDataType>;
+    using status_type = SteadyStateSolverStatus;
+
+    const real_type zero(0), one(1), half(0.5);
+    const ordinal_type max_num_corrector_iterations(10);
+    const ordinal_type max_num_step_reductions(10);
+    const real_type h(1e-6); /// finite difference step of lambda
+
+    const ordinal_type num_steps = vals_path.extent(0);
+    const ordinal_type problem_workspace_size =
+      problem_type::getWorkSpaceSize(kmcd, kmcdSurf);
+
+    auto wptr = work.data();
+    auto pw = real_type_1d_view(wptr, problem_workspace_size);
+    wptr += problem_workspace_size;
+
+    problem_type problem;
+    problem._kmcd = kmcd;
+    problem._kmcdSurf = kmcdSurf;
+    problem._cstr = cstr;
+    problem._work = pw;
+    problem._fac = fac;
+
+    const ordinal_type m = problem.getNumberOfEquations(), n = m + 1;
+    const real_type mdot0 = cstr.mdotIn;
+
+    /// 1. steady state at the initial residence time
+    {
+      const ordinal_type workspace_used(wptr - work.data()),
+        workspace_extent(work.extent(0));
+      auto sw = RealType1DViewType(wptr, workspace_extent - workspace_used);
+      ordinal_type iter_count(0);
+      SteadyStateSolver::team_invoke(member,
+                                     problem,
+                                     atol,
+                                     rtol,
+                                     max_num_iterations,
+                                     dt_init,
+                                     dt_max,
+                                     vals,
+                                     sw,
+                                     iter_count,
+                                     status);
+    }
+    num_steps_out = 0;
+    if (status != status_type::Converged || num_steps == 0)
+      return;
+
+    /// 2. continuation; the solver workspace is reused
+    auto y0 = RealType1DViewType(wptr, n);
+    wptr += n;
+    auto y = RealType1DViewType(wptr, n);
+    wptr += n;
+    auto tng = RealType1DViewType(wptr, n);
+    wptr += n;
+    auto dy = RealType1DViewType(wptr, n);
+    wptr += n;
+    auto g = RealType1DViewType(wptr, n);
+    wptr += n;
+    auto f_h = RealType1DViewType(wptr, m);
+    wptr += m;
+    auto J = RealType2DViewType(wptr, m, m);
+    wptr += m * m;
+    auto A = RealType2DViewType(wptr, n, n);
+    wptr += n * n;
+    const ordinal_type utv_work_size = DenseUTV::getWorkSpaceSize(n, n);
+    auto w = RealType1DViewType(wptr, utv_work_size);
+    wptr += utv_work_size;
+
+    const ordinal_type workspace_used(wptr - work.data()),
+      workspace_extent(work.extent(0));
+    if (workspace_used > workspace_extent) {
+      Kokkos::abort("Error: workspace used is larger than it is provided::"
+                    "TChem_Impl_TransientContStirredTankReactorSteadyState\n");
+    }
+
+    /// weights of the arc-length norm; temperature is scaled
+    const real_type w_temperature = one / vals(0);
+    auto weight = [&](const ordinal_type& i) {
+      return i == 0 ? w_temperature : one;
+    };
+    auto set_parameter = [&](const real_type& lambda) {
+      problem._cstr.mdotIn = mdot0 * ats<real_type>::exp(-lambda);
+    };
+    auto weighted_dot = [&](const RealType1DViewType& a,
+                            const RealType1DViewType& b) {
+      real_type sum(0);
+      Kokkos::parallel_reduce(
+        Kokkos::TeamVectorRange(member, n),
+        [&](const ordinal_type& i, real_type& update) {
+          const real_type wi = weight(i);
+          update += wi * wi * a(i) * b(i);
+        },
+        sum);
+      return sum;
+    };
+
+    /// jacobian of the augmented system at y; the last row is given later
+    auto assemble = [&](bool& is_valid) {
+      const RealType1DViewType x(y.data(), m);
+      const RealType1DViewType f(g.data(), m);
+      set_parameter(y(m) + h);
+      problem.computeFunction(member, x, f_h);
+      member.team_barrier();
+      set_parameter(y(m));
+      problem.computeJacobian(member, x, J);
+      member.team_barrier();
+      problem.computeFunction(member, x, f);
+      member.team_barrier();
+      TChem::Impl::DenseNanInf::team_check_sanity(member, J, is_valid);
+      Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(member, m), [&](const ordinal_type& i) {
+          Kokkos::parallel_for(Kokkos::ThreadVectorRange(member, m),
+                               [&](const ordinal_type& j) {
+                                 A(i, j) = J(i, j);
+                               });
+          A(i, m) = (f_h(i) - f(i)) / h;
+        });
+      member.team_barrier();
+    };
+
+    /// record the converged initial point
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, n),
+                         [&](const ordinal_type& i) {
+                           y0(i) = i < m ? vals(i) : zero;
+                           y(i) = y0(i);
+                         });
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                         [&](const ordinal_type& i) {
+                           vals_path(0, i) = vals(i);
+                         });
+    Kokkos::single(Kokkos::PerTeam(member), [&]() { mdot_path(0) = mdot0; });
+    member.team_barrier();
+
+    /// initial tangent; J t_x + df/dlambda t_lambda = 0 with t_lambda = 1
+    {
+      bool is_valid(true);
+      assemble(is_valid);
+      if (!is_valid) {
+        status = status_type::InvalidJacobian;
+        num_steps_out = 1;
+        return;
+      }
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, n),
+                           [&](const ordinal_type& j) {
+                             A(m, j) = j == m ? one : zero;
+                             g(j) = j == m ? one : zero;
+                           });
+      member.team_barrier();
+      ordinal_type matrix_rank(0);
+      TChem::Impl::DenseUTV::team_factorize_and_solve(
+        member, A, tng, g, w, matrix_rank);
+      const real_type norm = ats<real_type>::sqrt(weighted_dot(tng, tng));
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, n),
+                           [&](const ordinal_type& i) { tng(i) /= norm; });
+      member.team_barrier();
+    }
+
+    real_type ds = ds_init;
+    const real_type ds_abs_max = ats<real_type>::abs(ds_max);
+    ordinal_type step = 1;
+    for (; step < num_steps; ++step) {
+      bool converged(false);
+      ordinal_type corrector_iter(0);
+      for (ordinal_type reduction = 0;
+           reduction < max_num_step_reductions && !converged;
+           ++reduction) {
+        /// predictor
+        Kokkos::parallel_for(
+          Kokkos::TeamVectorRange(member, n), [&](const ordinal_type& i) {
+            const real_type val = y0(i) + ds * tng(i);
+            y(i) = (i < m && val < zero) ? zero : val;
+          });
+        member.team_barrier();
+
+        /// corrector
+        for (corrector_iter = 0;
+             corrector_iter < max_num_corrector_iterations && !converged;
+             ++corrector_iter) {
+          bool is_valid(true);
+          assemble(is_valid);
+          if (!is_valid)
+            break;
+          Kokkos::parallel_for(
+            Kokkos::TeamVectorRange(member, n), [&](const ordinal_type& j) {
+              const real_type wj = weight(j);
+              A(m, j) = wj * wj * tng(j);
+              dy(j) = y(j) - y0(j);
+            });
+          member.team_barrier();
+          const real_type g_m = weighted_dot(tng, dy) - ds;
+          Kokkos::single(Kokkos::PerTeam(member), [&]() { g(m) = g_m; });
+          member.team_barrier();
+
+          ordinal_type matrix_rank(0);
+          TChem::Impl::DenseUTV::team_factorize_and_solve(
+            member, A, dy, g, w, matrix_rank);
+
+          real_type sum(0);
+          Kokkos::parallel_reduce(
+            Kokkos::TeamVectorRange(member, n),
+            [&](const ordinal_type& i, real_type& update) {
+              const real_type val = y(i) - dy(i);
+              const real_type step_at_i =
+                dy(i) / (atol + rtol * ats<real_type>::abs(val));
+              y(i) = (i < m && val < zero) ? zero : val;
+              update += step_at_i * step_at_i;
+            },
+            sum);
+          member.team_barrier();
+          converged = ats<real_type>::sqrt(sum / real_type(n)) < one;
+        }
+        if (!converged)
+          ds *= half;
+      }
+      if (!converged) {
+        status = status_type::MaxIterationsReached;
+        break;
+      }
+
+      /// record the point, update the secant tangent and the anchor
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const ordinal_type& i) {
+                             vals_path(step, i) = y(i);
+                           });
+      Kokkos::single(Kokkos::PerTeam(member), [&]() {
+        mdot_path(step) = mdot0 * ats<real_type>::exp(-y(m));
+      });
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, n),
+                           [&](const ordinal_type& i) {
+                             tng(i) = (y(i) - y0(i)) / ds;
+                           });
+      member.team_barrier();
+      const real_type norm = ats<real_type>::sqrt(weighted_dot(tng, tng));
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, n),
+                           [&](const ordinal_type& i) {
+                             tng(i) /= norm;
+                             y0(i) = y(i);
+                           });
+      member.team_barrier();
+
+      if (corrector_iter <= 3) {
+        const real_type ds_abs = ats<real_type>::abs(ds) * real_type(1.5);
+        const real_type ds_new = ds_abs < ds_abs_max ? ds_abs : ds_abs_max;
+        ds = ds < zero ? -ds_new : ds_new;
+      }
+    }
+    num_steps_out = step;
+
+    /// last converged point
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                         [&](const ordinal_type& i) { vals(i) = y0(i); });
+    member.team_barrier();
+  }
+};
+
+} // namespace Impl
+} // namespace TChem
+
+#endif
@@ -49,6 +49,9 @@ struct TransientContStirredTankReactor_Problem
   real_type_1d_view _x;
   real_type_1d_view _work;
   real_type_1d_view_type _fac; /// numerical jacobian
+  /// rate constants of the last evaluation; empty views disable the memo
+  real_type_1d_view_type _memo;
+  real_type_1d_view_type _memoSurf;
   KineticModelConstDataType _kmcd;
   KineticSurfModelConstDataType _kmcdSurf;
   ContStirredTankReactorConstDataType _cstr;
@@ -66,6 +69,29 @@ struct TransientContStirredTankReactor_Problem
     return workspace_size;
   }
 
+  /// gas and surface memos are carved as one slice; see setMemo
+  KOKKOS_INLINE_FUNCTION
+  static ordinal_type getMemoWorkSpaceSize(
+    const KineticModelConstDataType& kmcd,
+    const KineticSurfModelConstDataType& kmcdSurf)
+  {
+    return (KForwardReverseMemo::getWorkSpaceSize(kmcd) +
+            KForwardReverseMemo::getWorkSpaceSize(kmcdSurf));
+  }
+
+  template<typename MemberType>
+  KOKKOS_INLINE_FUNCTION void setMemo(const MemberType& member,
+                                      real_type* wptr)
+  {
+    const ordinal_type memo_size = KForwardReverseMemo::getWorkSpaceSize(_kmcd),
+                       memo_surf_size =
+                         KForwardReverseMemo::getWorkSpaceSize(_kmcdSurf);
+    _memo = real_type_1d_view_type(wptr, memo_size);
+    _memoSurf = real_type_1d_view_type(wptr + memo_size, memo_surf_size);
+    KForwardReverseMemo::team_reset(member, _memo, _kmcd.memoRtol);
+    KForwardReverseMemo::team_reset(member, _memoSurf, _kmcdSurf.memoRtol);
+  }
+
   KOKKOS_INLINE_FUNCTION
   static ordinal_type getNumberOfTimeODEs(const KineticModelConstDataType& kmcd,
     const KineticSurfModelConstDataType& kmcdSurf)
@@ -106,6 +132,10 @@ struct TransientContStirredTankReactor_Problem
     return getWorkSpaceSize(_kmcd, _kmcdSurf);
   }
 
+  /// sensitivity parameters are not defined for this problem
+  KOKKOS_INLINE_FUNCTION
+  ordinal_type getNumberOfParameters() const { return 0; }
+
   KOKKOS_INLINE_FUNCTION
   ordinal_type getNumberOfTimeODEs() const
   {
@@ -171,6 +201,18 @@ struct TransientContStirredTankReactor_Problem
 #endif
   }
 
+  template<typename MemberType,
+           typename RealType1DViewType,
+           typename RealType2DViewType>
+  KOKKOS_INLINE_FUNCTION void computeParameterJacobian(
+    const MemberType& member,
+    const RealType1DViewType& x,
+    const RealType1DViewType& f,
+    const RealType2DViewType& fp) const
+  {
+    /// no parameters
+  }
+
   template<typename MemberType, typename RealType1DViewType>
   KOKKOS_INLINE_FUNCTION void computeFunction(const MemberType& member,
                                               const RealType1DViewType& x,
@@ -192,6 +234,8 @@ struct TransientContStirredTankReactor_Problem
                                            _cstr.pressure, // constant pressure
                                            f,
                                            _work,
+                                           _memo,
+                                           _memoSurf,
                                            _kmcd,
                                            _kmcdSurf,
                                            _cstr);
@@ -23,6 +23,7 @@ Sandia National Laboratories, Livermore, CA, USA
 #include "TChem_Util.hpp"
 
 #include "TChem_IgnitionZeroD.hpp"
+#include "TChem_IgnitionZeroDCSP.hpp"
 
 using ordinal_type = TChem::ordinal_type;
 using real_type = TChem::real_type;
@@ -63,7 +64,10 @@ main(int argc, char* argv[])
 
   int nBatch(1), team_size(-1), vector_size(-1);
   ;
-  bool verbose(true);
+  bool verbose(true), use_csp(false);
+  real_type drg_threshold(-1), drg_target_mass_fraction(1e-3);
+  int rate_table_intervals(0);
+  real_type rate_table_error(1e-6);
 
   /// parse command line arguments
   TChem::CommandLineParser opts(
@@ -101,6 +105,24 @@ main(int argc, char* argv[])
   opts.set_option<int>("vector-size", "User defined vector size", &vector_size);
   opts.set_option<bool>(
     "verbose", "If true, printout the first Jacobian values", &verbose);
+  opts.set_option<bool>(
+    "use-csp",
+    "If true, use the CSP slow manifold integrator instead of TrBDF2",
+    &use_csp);
+  opts.set_option<real_type>(
+    "drg-threshold",
+    "DRG threshold for adaptive chemistry; negative value disables it",
+    &drg_threshold);
+  opts.set_option<real_type>("drg-target-mass-fraction",
+                             "Mass fraction above which species are DRG targets",
+                             &drg_target_mass_fraction);
+  opts.set_option<int>(
+    "rate-table-intervals",
+    "Number of 1/T intervals of the rate constant table; zero disables it",
+    &rate_table_intervals);
+  opts.set_option<real_type>("rate-table-error",
+                             "Max interpolation error of ln k in the table",
+                             &rate_table_error);
 
   const bool r_parse = opts.parse(argc, argv);
   if (r_parse)
@@ -115,8 +137,14 @@ main(int argc, char* argv[])
 
     /// construct kmd and use the view for testing
     TChem::KineticModelData kmd(chemFile, thermFile);
+    kmd.setDirectedRelationGraph(drg_threshold, drg_target_mass_fraction);
+    kmd.setRateConstantTable(rate_table_intervals, rate_table_error);
     const TChem::KineticModelConstData<TChem::exec_space> kmcd =
       kmd.createConstData<TChem::exec_space>();
+    if (rate_table_intervals > 0)
+      printf("Rate constant table with %d intervals, error %e\n",
+             kmd.getRateConstantTableNumIntervals(),
+             kmd.getRateConstantTableError());
 
     const ordinal_type stateVecDim =
       TChem::Impl::getStateVectorSize(kmcd.nSpec);
@@ -172,7 +200,8 @@ main(int argc, char* argv[])
 
       const ordinal_type level = 1;
       const ordinal_type per_team_extent =
-        TChem::IgnitionZeroD::getWorkSpaceSize(kmcd);
+        use_csp ? TChem::IgnitionZeroDCSP::getWorkSpaceSize(kmcd)
+                : TChem::IgnitionZeroD::getWorkSpaceSize(kmcd);
       const ordinal_type per_team_scratch =
         TChem::Scratch<real_type_1d_view>::shmem_size(per_team_extent);
       policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
@@ -242,8 +271,20 @@ main(int argc, char* argv[])
 #endif
         real_type tsum(0);
         for (; iter < max_num_time_iterations && tsum <= tend; ++iter) {
-          TChem::IgnitionZeroD::runDeviceBatch(
-            policy, tol_newton, tol_time, fac, tadv, state, t, dt, state, kmcd);
+          if (use_csp)
+            TChem::IgnitionZeroDCSP::runDeviceBatch(
+              policy, tol_time, fac, tadv, state, t, dt, state, kmcd);
+          else
+            TChem::IgnitionZeroD::runDeviceBatch(policy,
+                                                 tol_newton,
+                                                 tol_time,
+                                                 fac,
+                                                 tadv,
+                                                 state,
+                                                 t,
+                                                 dt,
+                                                 state,
+                                                 kmcd);
           Kokkos::fence();
           /// print of store QOI for the first sample
 #if defined(TCHEM_EXAMPLE_IGNITIONZEROD_QOI_PRINT)
@@ -20,6 +20,8 @@ Sandia National Laboratories, Livermore, CA, USA
 ===================================================================================== */
 #include "TChem_CommandLineParser.hpp"
 #include "TChem_KineticModelData.hpp"
+#include "TChem_SampleFileReader.hpp"
+#include "TChem_TrajectoryWriter.hpp"
 #include "TChem_Util.hpp"
 
 #include "TChem_IgnitionZeroD.hpp"
@@ -65,6 +67,7 @@ main(int argc, char* argv[])
   ;
   bool verbose(true);
   bool OnlyComputeIgnDelayTime(false);
+  bool binary_output(false);
 
   std::string chemFile("chem.inp");
   std::string thermFile("therm.dat");
@@ -107,6 +110,10 @@ main(int argc, char* argv[])
                        &max_num_newton_iterations);
   opts.set_option<int>(
     "output_frequency", "save data at this iterations", &output_frequency);
+  opts.set_option<bool>(
+    "binary_output",
+    "If true, save data in IgnSolution.bin with a background writer thread",
+    &binary_output);
   // opts.set_option<int>("batchsize", "Batchsize the same state vector
   // described in statefile is cloned", &nBatch);
   opts.set_option<bool>(
@@ -160,7 +167,11 @@ main(int argc, char* argv[])
              T_threshold);
     }
 
-    FILE* fout = fopen("IgnSolution.dat", "w");
+    /// text output is written only without binary_output
+    FILE* fout = binary_output ? nullptr : fopen("IgnSolution.dat", "w");
+
+    /// binary trajectory; see scripts/tchem_trajectory.py
+    std::unique_ptr<TChem::TrajectoryWriter> writer;
 
     /// input from a file; this is not necessary as the input is created
     /// by other applications.
@@ -383,18 +394,34 @@ main(int argc, char* argv[])
           Kokkos::deep_copy(dt_host, dt);
           Kokkos::deep_copy(t_host, t);
 
-          fprintf(fout, "%s \t %s \t %s \t ", "iter", "t", "dt");
-          fprintf(fout,
-                  "%s \t %s \t %s \t",
-                  "Density[kg/m3]",
-                  "Pressure[Pascal]",
-                  "Temperature[K]");
-
-          for (ordinal_type k = 0; k < kmcd.nSpec; k++)
-            fprintf(fout, "%s \t", &speciesNamesHost(k, 0));
-          fprintf(fout, "\n");
-          // save initial condition
-          writeState(-1, t_host, dt_host, state_host, fout);
+          if (binary_output) {
+            std::vector<std::string> names = { "iter", "t", "dt" };
+            TChem::TrajectoryWriter::addStateVectorNames(
+              names, speciesNamesHost, kmcd.nSpec);
+            writer = std::unique_ptr<TChem::TrajectoryWriter>(
+              new TChem::TrajectoryWriter("IgnSolution.bin", names, true));
+
+            // save initial condition
+            writer->append(-1,
+                           t_host,
+                           dt_host,
+                           state_host,
+                           real_type_2d_view_host(),
+                           real_type_1d_view_host());
+          } else {
+            fprintf(fout, "%s \t %s \t %s \t ", "iter", "t", "dt");
+            fprintf(fout,
+                    "%s \t %s \t %s \t",
+                    "Density[kg/m3]",
+                    "Pressure[Pascal]",
+                    "Temperature[K]");
+
+            for (ordinal_type k = 0; k < kmcd.nSpec; k++)
+              fprintf(fout, "%s \t", &speciesNamesHost(k, 0));
+            fprintf(fout, "\n");
+            // save initial condition
+            writeState(-1, t_host, dt_host, state_host, fout);
+          }
         }
 
         real_type tsum(0);
@@ -473,7 +500,15 @@ main(int argc, char* argv[])
             Kokkos::deep_copy(t_host, t);
             Kokkos::deep_copy(state_host, state);
 
-            writeState(iter, t_host, dt_host, state_host, fout);
+            if (writer)
+              writer->append(iter,
+                             t_host,
+                             dt_host,
+                             state_host,
+                             real_type_2d_view_host(),
+                             real_type_1d_view_host());
+            else
+              writeState(iter, t_host, dt_host, state_host, fout);
 
             // Kokkos::parallel_for(
             //   Kokkos::RangePolicy<TChem::exec_space>(0, nBatch),
@@ -538,7 +573,8 @@ main(int argc, char* argv[])
     TChem::Test::write1DVector("IgnitionDelayTimeTthreshold.dat",
                                IgnDelayTimesT_host);
 
-    fclose(fout);
+    if (fout)
+      fclose(fout);
   }
   Kokkos::finalize();
 
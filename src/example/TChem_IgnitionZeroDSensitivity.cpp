@@ -0,0 +1,224 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#include "TChem_CommandLineParser.hpp"
+#include "TChem_KineticModelData.hpp"
+#include "TChem_Util.hpp"
+
+#include "TChem_IgnitionZeroDSensitivity.hpp"
+
+using ordinal_type = TChem::ordinal_type;
+using real_type = TChem::real_type;
+using time_advance_type = TChem::time_advance_type;
+
+using real_type_1d_view_host = TChem::real_type_1d_view_host;
+using real_type_2d_view_host = TChem::real_type_2d_view_host;
+using real_type_3d_view_host = TChem::real_type_3d_view_host;
+
+using time_advance_type_1d_view_host = TChem::time_advance_type_1d_view_host;
+
+int
+main(int argc, char* argv[])
+{
+  /// default inputs
+  std::string prefixPath("data/ignition-zero-d/");
+  std::string chemFile(prefixPath + "chem.inp");
+  std::string thermFile(prefixPath + "therm.dat");
+  std::string inputFile(prefixPath + "input.dat");
+
+  real_type tbeg(0), tend(1e-3);
+  real_type dtmin(1e-11), dtmax(1e-6);
+  real_type rtol_time(1e-8), atol_newton(1e-8), rtol_newton(1e-5);
+  real_type temperature_threshold(400);
+  int num_time_iterations_per_interval(1e1), max_num_time_iterations(1e5),
+    max_num_newton_iterations(100), num_reactions_to_print(10);
+
+  /// parse command line arguments
+  TChem::CommandLineParser opts(
+    "This example computes ignition delay sensitivities with respect to the "
+    "pre-exponential factor of each reaction");
+  opts.set_option<std::string>(
+    "chemfile", "Chem file name e.g., chem.inp", &chemFile);
+  opts.set_option<std::string>(
+    "thermfile", "Therm file name e.g., therm.dat", &thermFile);
+  opts.set_option<std::string>(
+    "inputfile", "Input state file name e.g., input.dat", &inputFile);
+  opts.set_option<real_type>("tbeg", "Time begin", &tbeg);
+  opts.set_option<real_type>("tend", "Time end", &tend);
+  opts.set_option<real_type>("dtmin", "Minimum time step size", &dtmin);
+  opts.set_option<real_type>("dtmax", "Maximum time step size", &dtmax);
+  opts.set_option<real_type>(
+    "atol-newton", "Absolute tolerence used in newton solver", &atol_newton);
+  opts.set_option<real_type>(
+    "rtol-newton", "Relative tolerence used in newton solver", &rtol_newton);
+  opts.set_option<real_type>(
+    "tol-time", "Tolerence used for adaptive time stepping", &rtol_time);
+  opts.set_option<real_type>(
+    "temperature-threshold",
+    "Ignition is detected when temperature rises by this amount",
+    &temperature_threshold);
+  opts.set_option<int>("time-iterations-per-interval",
+                       "Number of time iterations per interval",
+                       &num_time_iterations_per_interval);
+  opts.set_option<int>("max-time-iterations",
+                       "Maximum number of time iterations",
+                       &max_num_time_iterations);
+  opts.set_option<int>("max-newton-iterations",
+                       "Maximum number of newton iterations",
+                       &max_num_newton_iterations);
+  opts.set_option<int>("print-reactions",
+                       "Number of the most sensitive reactions to print",
+                       &num_reactions_to_print);
+
+  const bool r_parse = opts.parse(argc, argv);
+  if (r_parse)
+    return 0; // print help return
+
+  Kokkos::initialize(argc, argv);
+  {
+    const bool detail = false;
+
+    TChem::host_exec_space::print_configuration(std::cout, detail);
+
+    TChem::KineticModelData kmd(chemFile, thermFile);
+    const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+
+    const ordinal_type nBatch = 1;
+    const ordinal_type stateVecDim =
+      TChem::Impl::getStateVectorSize(kmcd.nSpec);
+
+    real_type_2d_view_host state("StateVector", nBatch, stateVecDim);
+    {
+      auto state_at_0 = Kokkos::subview(state, 0, Kokkos::ALL());
+      TChem::Test::readStateVector(inputFile, kmcd.nSpec, state_at_0);
+    }
+
+    using problem_type = TChem::Impl::IgnitionZeroD_Problem<decltype(kmcd)>;
+    const ordinal_type m = problem_type::getNumberOfEquations(kmcd);
+
+    real_type_2d_view_host tol_time(
+      "tol time", problem_type::getNumberOfTimeODEs(kmcd), 2);
+    real_type_1d_view_host tol_newton("tol newton", 2);
+    {
+      const real_type atol_time = 1e-12;
+      for (ordinal_type i = 0, iend = tol_time.extent(0); i < iend; ++i) {
+        tol_time(i, 0) = atol_time;
+        tol_time(i, 1) = rtol_time;
+      }
+      tol_newton(0) = atol_newton;
+      tol_newton(1) = rtol_newton;
+    }
+
+    real_type_2d_view_host fac("fac", nBatch, m);
+    real_type_1d_view_host t("time", nBatch);
+    real_type_1d_view_host dt("delta time", nBatch);
+    real_type_3d_view_host sens("sensitivity", nBatch, kmcd.nReac, m);
+
+    time_advance_type tadv_default;
+    tadv_default._tbeg = tbeg;
+    tadv_default._tend = tend;
+    tadv_default._dt = dtmin;
+    tadv_default._dtmin = dtmin;
+    tadv_default._dtmax = dtmax;
+    tadv_default._max_num_newton_iterations = max_num_newton_iterations;
+    tadv_default._num_time_iterations_per_interval =
+      num_time_iterations_per_interval;
+
+    time_advance_type_1d_view_host tadv("tadv", nBatch);
+    Kokkos::deep_copy(tadv, tadv_default);
+    Kokkos::deep_copy(t, tbeg);
+    Kokkos::deep_copy(dt, dtmin);
+
+    using policy_type =
+      typename TChem::UseThisTeamPolicy<TChem::host_exec_space>::type;
+    policy_type policy(nBatch, Kokkos::AUTO());
+    {
+      const ordinal_type level = 1;
+      const ordinal_type per_team_extent =
+        TChem::IgnitionZeroDSensitivity::getWorkSpaceSize(kmcd);
+      const ordinal_type per_team_scratch =
+        TChem::Scratch<real_type_1d_view_host>::shmem_size(per_team_extent);
+      policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+    }
+
+    /// the ignition delay tau is where T(tau) = T0 + threshold; differentiating
+    /// T(tau(p), p) = const gives dtau/dlnA = - S_T(tau) / (dT/dt)(tau)
+    const real_type temperature_ignition = state(0, 2) + temperature_threshold;
+    real_type t_prev(tbeg), temperature_prev(state(0, 2)), tau(-1);
+    std::vector<real_type> sens_T_prev(kmcd.nReac, 0), dtau(kmcd.nReac, 0);
+
+    Kokkos::Impl::Timer timer;
+    timer.reset();
+    for (ordinal_type iter = 0; iter < max_num_time_iterations && t(0) < tend;
+         ++iter) {
+      TChem::IgnitionZeroDSensitivity::runHostBatch(
+        policy, tol_newton, tol_time, fac, tadv, state, t, dt, state, sens,
+        kmcd);
+      tadv(0)._tbeg = t(0);
+      tadv(0)._dt = dt(0);
+
+      const real_type temperature = state(0, 2);
+      if (temperature >= temperature_ignition) {
+        /// linear interpolation within the last interval
+        const real_type dTdt =
+          (temperature - temperature_prev) / (t(0) - t_prev);
+        const real_type alpha =
+          (temperature_ignition - temperature_prev) /
+          (temperature - temperature_prev);
+        tau = t_prev + alpha * (t(0) - t_prev);
+        for (ordinal_type j = 0; j < kmcd.nReac; ++j) {
+          const real_type sens_T =
+            sens_T_prev[j] + alpha * (sens(0, j, 0) - sens_T_prev[j]);
+          dtau[j] = -sens_T / dTdt;
+        }
+        break;
+      }
+      t_prev = t(0);
+      temperature_prev = temperature;
+      for (ordinal_type j = 0; j < kmcd.nReac; ++j)
+        sens_T_prev[j] = sens(0, j, 0);
+    }
+    const real_type t_sens = timer.seconds();
+
+    if (tau < 0) {
+      printf("Ignition is not detected before tend %e\n", tend);
+    } else {
+      std::vector<ordinal_type> order(kmcd.nReac);
+      for (ordinal_type j = 0; j < kmcd.nReac; ++j)
+        order[j] = j;
+      std::sort(order.begin(), order.end(), [&](ordinal_type a, ordinal_type b) {
+        return std::abs(dtau[a]) > std::abs(dtau[b]);
+      });
+
+      printf("Ignition delay time %e [sec]\n", tau);
+      printf("Normalized sensitivity dlntau/dlnA of the %d most sensitive "
+             "reactions\n",
+             std::min(num_reactions_to_print, ordinal_type(kmcd.nReac)));
+      for (ordinal_type j = 0;
+           j < std::min(num_reactions_to_print, ordinal_type(kmcd.nReac));
+           ++j)
+        printf("  reaction %5d  %e\n", order[j], dtau[order[j]] / tau);
+    }
+    printf("Time ignition sensitivity %e [sec]\n", t_sens);
+  }
+  Kokkos::finalize();
+
+  return 0;
+}
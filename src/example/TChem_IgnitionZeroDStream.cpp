@@ -0,0 +1,136 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#include "TChem_CommandLineParser.hpp"
+#include "TChem_KineticModelData.hpp"
+#include "TChem_Util.hpp"
+
+#include "TChem_IgnitionZeroDStream.hpp"
+
+using ordinal_type = TChem::ordinal_type;
+using real_type = TChem::real_type;
+using time_advance_type = TChem::time_advance_type;
+
+int
+main(int argc, char* argv[])
+{
+  /// default inputs
+  std::string prefixPath("data/ignition-zero-d/gri3.0/");
+  std::string chemFile(prefixPath + "chem.inp");
+  std::string thermFile(prefixPath + "therm.dat");
+  std::string inputFile(prefixPath + "sample.dat");
+  std::string outputFile("IgnSolution.bin");
+
+  real_type tend(1e-3);
+  real_type dtmin(1e-10), dtmax(1e-4);
+  real_type rtol_time(1e-4), atol_newton(1e-10), rtol_newton(1e-6);
+  int num_time_iterations_per_interval(1e1), max_num_newton_iterations(100),
+    max_num_outer_iterations(1e3);
+  int chunk_size(1024);
+
+  /// parse command line arguments
+  TChem::CommandLineParser opts(
+    "This example advances ignition samples from a file in chunks");
+  opts.set_option<std::string>(
+    "chemfile", "Chem file name e.g., chem.inp", &chemFile);
+  opts.set_option<std::string>(
+    "thermfile", "Therm file name e.g., therm.dat", &thermFile);
+  opts.set_option<std::string>(
+    "samplefile", "Input sample file name e.g., sample.dat", &inputFile);
+  opts.set_option<std::string>("outputfile",
+                               "Output trajectory file name e.g., IgnSolution.bin",
+                               &outputFile);
+  opts.set_option<real_type>("tend", "Time end", &tend);
+  opts.set_option<real_type>("dtmin", "Minimum time step size", &dtmin);
+  opts.set_option<real_type>("dtmax", "Maximum time step size", &dtmax);
+  opts.set_option<real_type>(
+    "atol-newton", "Absolute tolerence used in newton solver", &atol_newton);
+  opts.set_option<real_type>(
+    "rtol-newton", "Relative tolerence used in newton solver", &rtol_newton);
+  opts.set_option<real_type>(
+    "tol-time", "Tolerence used for adaptive time stepping", &rtol_time);
+  opts.set_option<int>("time-iterations-per-interval",
+                       "Number of time iterations per launch",
+                       &num_time_iterations_per_interval);
+  opts.set_option<int>("max-newton-iterations",
+                       "Maximum number of newton iterations",
+                       &max_num_newton_iterations);
+  opts.set_option<int>("max-outer-iterations",
+                       "Maximum number of launches per chunk",
+                       &max_num_outer_iterations);
+  opts.set_option<int>(
+    "chunksize", "Number of samples integrated at a time", &chunk_size);
+
+  const bool r_parse = opts.parse(argc, argv);
+  if (r_parse)
+    return 0; // print help return
+
+  Kokkos::initialize(argc, argv);
+  {
+    const bool detail = false;
+
+    TChem::exec_space::print_configuration(std::cout, detail);
+    TChem::host_exec_space::print_configuration(std::cout, detail);
+
+    TChem::KineticModelData kmd(chemFile, thermFile);
+    const auto kmcd = kmd.createConstData<TChem::exec_space>();
+    const auto kmcd_host = kmd.createConstData<TChem::host_exec_space>();
+
+    time_advance_type tadv_default;
+    tadv_default._tbeg = 0;
+    tadv_default._tend = tend;
+    tadv_default._dt = dtmin;
+    tadv_default._dtmin = dtmin;
+    tadv_default._dtmax = dtmax;
+    tadv_default._max_num_newton_iterations = max_num_newton_iterations;
+    tadv_default._num_time_iterations_per_interval =
+      num_time_iterations_per_interval;
+
+    const real_type atol_time = 1e-12;
+    TChem::IgnitionZeroDStream stream(kmcd,
+                                      kmcd_host,
+                                      chunk_size,
+                                      atol_newton,
+                                      rtol_newton,
+                                      atol_time,
+                                      rtol_time,
+                                      tadv_default,
+                                      max_num_outer_iterations);
+
+    Kokkos::Impl::Timer timer;
+    timer.reset();
+    const auto stats = stream.run(inputFile, outputFile, tend);
+    const real_type t_total = timer.seconds();
+
+    printf("Number of samples %d, chunks %d, failures %d\n",
+           stats._num_samples,
+           stats._num_chunks,
+           stats._num_failures);
+    printf("Time compute   %e [sec]\n", stats._t_compute);
+    printf("Time load wait %e [sec]\n", stats._t_load_wait);
+    printf("Time write     %e [sec]\n", stats._t_write);
+    printf("Time total     %e [sec] %e [sec/sample]\n",
+           t_total,
+           t_total / real_type(std::max(stats._num_samples, 1)));
+  }
+  Kokkos::finalize();
+
+  return 0;
+}
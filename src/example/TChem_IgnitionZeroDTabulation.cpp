@@ -0,0 +1,160 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#include "TChem_CommandLineParser.hpp"
+#include "TChem_KineticModelData.hpp"
+#include "TChem_Util.hpp"
+
+#include "TChem_IgnitionZeroDTabulation.hpp"
+
+using ordinal_type = TChem::ordinal_type;
+using real_type = TChem::real_type;
+using time_advance_type = TChem::time_advance_type;
+
+using real_type_1d_view_host = TChem::real_type_1d_view_host;
+using real_type_2d_view_host = TChem::real_type_2d_view_host;
+
+int
+main(int argc, char* argv[])
+{
+  /// default inputs
+  std::string prefixPath("data/ignition-zero-d/");
+  std::string chemFile(prefixPath + "chem.inp");
+  std::string thermFile(prefixPath + "therm.dat");
+  std::string inputFile(prefixPath + "input.dat");
+
+  real_type dt(1e-6), tend(1e-3);
+  real_type dtmin(1e-11), dtmax(1e-6);
+  real_type rtol_time(1e-8), atol_newton(1e-8), rtol_newton(1e-5);
+  real_type tol_isat(1e-4), temperature_perturbation(10);
+  int num_time_iterations_per_interval(1e2), max_num_newton_iterations(100),
+    max_num_records(1e4);
+  int nBatch(1);
+
+  /// parse command line arguments
+  TChem::CommandLineParser opts(
+    "This example advances ignition samples with in situ adaptive tabulation");
+  opts.set_option<std::string>(
+    "chemfile", "Chem file name e.g., chem.inp", &chemFile);
+  opts.set_option<std::string>(
+    "thermfile", "Therm file name e.g., therm.dat", &thermFile);
+  opts.set_option<std::string>(
+    "inputfile", "Input state file name e.g., input.dat", &inputFile);
+  opts.set_option<real_type>("dt", "Tabulated time step size", &dt);
+  opts.set_option<real_type>("tend", "Time end", &tend);
+  opts.set_option<real_type>("dtmin", "Minimum time step size", &dtmin);
+  opts.set_option<real_type>("dtmax", "Maximum time step size", &dtmax);
+  opts.set_option<real_type>(
+    "atol-newton", "Absolute tolerence used in newton solver", &atol_newton);
+  opts.set_option<real_type>(
+    "rtol-newton", "Relative tolerence used in newton solver", &rtol_newton);
+  opts.set_option<real_type>(
+    "tol-time", "Tolerence used for adaptive time stepping", &rtol_time);
+  opts.set_option<real_type>(
+    "tol-isat", "Error tolerence of the tabulation", &tol_isat);
+  opts.set_option<real_type>(
+    "temperature-perturbation",
+    "Samples are perturbed with uniform random temperature in [-val, val]",
+    &temperature_perturbation);
+  opts.set_option<int>("time-iterations-per-interval",
+                       "Number of time iterations per interval",
+                       &num_time_iterations_per_interval);
+  opts.set_option<int>("max-newton-iterations",
+                       "Maximum number of newton iterations",
+                       &max_num_newton_iterations);
+  opts.set_option<int>(
+    "max-records", "Maximum number of tabulated records", &max_num_records);
+  opts.set_option<int>(
+    "batchsize",
+    "Batchsize the same state vector described in statefile is cloned",
+    &nBatch);
+
+  const bool r_parse = opts.parse(argc, argv);
+  if (r_parse)
+    return 0; // print help return
+
+  Kokkos::initialize(argc, argv);
+  {
+    const bool detail = false;
+
+    TChem::host_exec_space::print_configuration(std::cout, detail);
+
+    TChem::KineticModelData kmd(chemFile, thermFile);
+    const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+
+    const ordinal_type stateVecDim =
+      TChem::Impl::getStateVectorSize(kmcd.nSpec);
+
+    real_type_2d_view_host state("StateVector", nBatch, stateVecDim);
+    {
+      auto state_at_0 = Kokkos::subview(state, 0, Kokkos::ALL());
+      TChem::Test::readStateVector(inputFile, kmcd.nSpec, state_at_0);
+      TChem::Test::cloneView(state);
+
+      std::mt19937 gen(0);
+      std::uniform_real_distribution<real_type> dist(-1, 1);
+      for (ordinal_type i = 0; i < nBatch; ++i)
+        state(i, 2) += temperature_perturbation * dist(gen);
+    }
+
+    using problem_type =
+      TChem::Impl::IgnitionZeroD_Problem<decltype(kmcd)>;
+    real_type_2d_view_host tol_time(
+      "tol time", problem_type::getNumberOfTimeODEs(kmcd), 2);
+    real_type_1d_view_host tol_newton("tol newton", 2);
+    {
+      const real_type atol_time = 1e-12;
+      for (ordinal_type i = 0, iend = tol_time.extent(0); i < iend; ++i) {
+        tol_time(i, 0) = atol_time;
+        tol_time(i, 1) = rtol_time;
+      }
+      tol_newton(0) = atol_newton;
+      tol_newton(1) = rtol_newton;
+    }
+
+    time_advance_type tadv;
+    tadv._dt = dtmin;
+    tadv._dtmin = dtmin;
+    tadv._dtmax = dtmax;
+    tadv._max_num_newton_iterations = max_num_newton_iterations;
+    tadv._num_time_iterations_per_interval = num_time_iterations_per_interval;
+
+    TChem::IgnitionZeroDTabulation isat(
+      kmcd, tol_newton, tol_time, tadv, tol_isat, max_num_records);
+
+    Kokkos::Impl::Timer timer;
+    timer.reset();
+    for (real_type t = 0; t < tend; t += dt) {
+      const ordinal_type nFail = isat.runHostBatch(dt, state, state);
+      if (nFail > 0)
+        printf("Warning: %d samples fail to advance from t %e\n", nFail, t);
+      printf("%e %e\n", t + dt, state(0, 2));
+    }
+    const real_type t_isat = timer.seconds();
+
+    isat.showStatistics(std::cout);
+    printf("Time ignition with tabulation %e [sec] %e [sec/sample]\n",
+           t_isat,
+           t_isat / real_type(nBatch));
+  }
+  Kokkos::finalize();
+
+  return 0;
+}
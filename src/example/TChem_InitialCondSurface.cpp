@@ -20,6 +20,7 @@ Sandia National Laboratories, Livermore, CA, USA
 ===================================================================================== */
 #include "TChem_CommandLineParser.hpp"
 #include "TChem_KineticModelData.hpp"
+#include "TChem_SampleFileReader.hpp"
 #include "TChem_Util.hpp"
 
 #include "TChem_InitialCondSurface.hpp"
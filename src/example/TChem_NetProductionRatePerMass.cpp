@@ -21,6 +21,7 @@ Sandia National Laboratories, Livermore, CA, USA
 #include "TChem_NetProductionRatePerMass.hpp"
 #include "TChem_CommandLineParser.hpp"
 #include "TChem_KineticModelData.hpp"
+#include "TChem_TeamPolicyTuner.hpp"
 #include "TChem_Util.hpp"
 
 using ordinal_type = TChem::ordinal_type;
@@ -38,8 +39,10 @@ main(int argc, char* argv[])
   std::string thermFile(prefixPath + "therm.dat");
   std::string inputFile(prefixPath + "input.dat");
   std::string outputFile(prefixPath + "omega.dat");
+  std::string tuningFile("tchem-tuning.dat");
   int nBatch(1);
   bool verbose(true);
+  bool autotune(false);
 
   /// parse command line arguments
   TChem::CommandLineParser opts(
@@ -58,6 +61,12 @@ main(int argc, char* argv[])
     &nBatch);
   opts.set_option<bool>(
     "verbose", "If true, printout the first omega values", &verbose);
+  opts.set_option<bool>(
+    "autotune",
+    "If true, team and vector sizes are tuned and cached in tuningfile",
+    &autotune);
+  opts.set_option<std::string>(
+    "tuningfile", "Tuning cache file name e.g., tchem-tuning.dat", &tuningFile);
 
   const bool r_parse = opts.parse(argc, argv);
   if (r_parse)
@@ -98,10 +107,36 @@ main(int argc, char* argv[])
     Kokkos::deep_copy(state, state_host);
     const real_type t_deepcopy = timer.seconds();
 
-    timer.reset();
-    TChem::NetProductionRatePerMass::runDeviceBatch(nBatch, state, omega, kmcd);
-    Kokkos::fence(); /// timing purpose
-    const real_type t_device_batch = timer.seconds();
+    real_type t_device_batch(0);
+    if (autotune) {
+      using policy_type =
+        typename TChem::UseThisTeamPolicy<TChem::exec_space>::type;
+      TChem::TeamPolicyTuner tuner(tuningFile);
+      const ordinal_type per_team_scratch =
+        TChem::Scratch<real_type_1d_view>::shmem_size(
+          TChem::NetProductionRatePerMass::getWorkSpaceSize(kmcd));
+      policy_type policy = tuner.getPolicy(
+        "NetProductionRatePerMass",
+        kmcd,
+        nBatch,
+        per_team_scratch,
+        [&](policy_type& p) {
+          TChem::NetProductionRatePerMass::runDeviceBatch(
+            p, state, omega, kmcd);
+        });
+
+      timer.reset();
+      TChem::NetProductionRatePerMass::runDeviceBatch(
+        policy, state, omega, kmcd);
+      Kokkos::fence(); /// timing purpose
+      t_device_batch = timer.seconds();
+    } else {
+      timer.reset();
+      TChem::NetProductionRatePerMass::runDeviceBatch(
+        nBatch, state, omega, kmcd);
+      Kokkos::fence(); /// timing purpose
+      t_device_batch = timer.seconds();
+    }
 
     /// show time
     printf("---------------------------------------------------\n");    
@@ -20,9 +20,12 @@ Sandia National Laboratories, Livermore, CA, USA
 ===================================================================================== */
 #include "TChem_CommandLineParser.hpp"
 #include "TChem_KineticModelData.hpp"
+#include "TChem_TrajectoryWriter.hpp"
+#include "TChem_SampleFileReader.hpp"
 #include "TChem_Util.hpp"
 #include "TChem_SimpleSurface.hpp"
 #include "TChem_InitialCondSurface.hpp"
+#include "TChem_SurfaceSteadyState.hpp"
 #include "TChem_PlugFlowReactor.hpp"
 
 using ordinal_type = TChem::ordinal_type;
@@ -71,9 +74,11 @@ main(int argc, char* argv[])
   int nBatch(1), team_size(-1), vector_size(-1);
   bool verbose(true);
   int output_frequency(-1);
+  bool binary_output(false);
 
   bool transient_initial_condition(false);
   bool initial_condition(true);
+  bool steady_state_initial_condition(false);
 
   std::string chemFile("chem.inp");
   std::string thermFile("therm.dat");
@@ -152,12 +157,18 @@ main(int argc, char* argv[])
 
   opts.set_option<int>(
     "output_frequency", "save data at this iterations", &output_frequency);
+  opts.set_option<bool>(
+    "binary_output",
+    "If true, save data in PFRSolution.bin with a background writer thread",
+    &binary_output);
   opts.set_option<int>("team-size", "User defined team size", &team_size);
   opts.set_option<int>("vector-size", "User defined vector size", &vector_size);
   opts.set_option<bool>(
     "transient_initial_condition", "If true, use a transient solver to obtain initial condition of the constraint", &transient_initial_condition);
     opts.set_option<bool>(
       "initial_condition", "If true, use a newton solver to obtain initial condition of the constraint", &initial_condition);
+    opts.set_option<bool>(
+      "steady_state_initial_condition", "If true, use a pseudo transient newton solver to obtain steady state site fractions instead of the transient and newton solvers above", &steady_state_initial_condition);
 
 
   const bool r_parse = opts.parse(argc, argv);
@@ -248,7 +259,8 @@ main(int argc, char* argv[])
 
     Kokkos::Impl::Timer timer;
 
-    FILE* fout = fopen("PFRSolution.dat", "w");
+    /// text output is written only without binary_output
+    FILE* fout = binary_output ? nullptr : fopen("PFRSolution.dat", "w");
 
     auto writeState =
       [](const ordinal_type iter,
@@ -276,6 +288,9 @@ main(int argc, char* argv[])
       };
 
 
+    /// binary trajectory; see scripts/tchem_trajectory.py
+    std::unique_ptr<TChem::TrajectoryWriter> writer;
+
     auto printState = [](const time_advance_type _tadv,
                          const real_type _t,
                          const real_type_1d_view_host _state_at_i,
@@ -314,7 +329,60 @@ main(int argc, char* argv[])
     using policy_type =
       typename TChem::UseThisTeamPolicy<TChem::exec_space>::type;
 
-    if (transient_initial_condition) {
+    if (steady_state_initial_condition) {
+      real_type_2d_view facSurf("facSurf", nBatch, kmcdSurf.nSpec);
+      real_type_1d_view tol_newton_surf("tol newton surface", 2);
+      {
+        auto tol_newton_host_surf = Kokkos::create_mirror_view(tol_newton_surf);
+        tol_newton_host_surf(0) = 1e-12;
+        tol_newton_host_surf(1) = 1e-8;
+        Kokkos::deep_copy(tol_newton_surf, tol_newton_host_surf);
+      }
+      TChem::ordinal_type_1d_view iter_count_surf("iter count surface", nBatch);
+      TChem::ordinal_type_1d_view status_surf("status surface", nBatch);
+
+      /// team policy
+      policy_type policy(exec_space_instance, nBatch, Kokkos::AUTO());
+
+      const ordinal_type level = 1;
+      const ordinal_type per_team_extent =
+        TChem::SurfaceSteadyState::getWorkSpaceSize(kmcd, kmcdSurf);
+      const ordinal_type per_team_scratch =
+        TChem::Scratch<real_type_1d_view>::shmem_size(per_team_extent);
+      policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+      /// steady state site fractions for the inlet gas in a single launch
+      const ordinal_type max_num_iterations_surf(1000);
+      const real_type dt_init_surf(1e-10), dt_max_surf(1e3);
+      TChem::SurfaceSteadyState::runDeviceBatch(policy,
+                                                tol_newton_surf,
+                                                max_num_iterations_surf,
+                                                dt_init_surf,
+                                                dt_max_surf,
+                                                state,
+                                                siteFraction, // input
+                                                siteFraction, // output
+                                                facSurf,
+                                                iter_count_surf,
+                                                status_surf,
+                                                kmcd,
+                                                kmcdSurf);
+
+      ordinal_type num_failed(0);
+      Kokkos::parallel_reduce(
+        Kokkos::RangePolicy<TChem::exec_space>(0, nBatch),
+        KOKKOS_LAMBDA(const ordinal_type& i, ordinal_type& update) {
+          using status_type = TChem::SurfaceSteadyState::status_type;
+          update += status_surf(i) != status_type::Converged;
+        },
+        num_failed);
+      printf("Done with steady state surface for DAE system, %d of %d samples "
+             "did not converge\n",
+             num_failed,
+             nBatch);
+    }
+
+    if (transient_initial_condition && !steady_state_initial_condition) {
 
       policy_type policy_surf(exec_space_instance, nBatch, Kokkos::AUTO());
 
@@ -415,7 +483,7 @@ main(int argc, char* argv[])
     }
     //Run a newton solver to check that constraint is satified.
 
-    if (initial_condition){
+    if (initial_condition && !steady_state_initial_condition) {
       real_type_2d_view facSurf("facSurf", nBatch, kmcdSurf.nSpec);
 
       /// team policy
@@ -543,32 +611,52 @@ main(int argc, char* argv[])
           Kokkos::deep_copy(dt_host, dt);
           Kokkos::deep_copy(t_host, t);
 
-          fprintf(fout, "%s \t %s \t %s \t ", "iter", "t", "dt");
-          fprintf(fout,
-                  "%s \t %s \t %s \t",
-                  "Density[kg/m3]",
-                  "Pressure[Pascal]",
-                  "Temperature[K]");
-
-          for (ordinal_type k = 0; k < kmcd.nSpec; k++)
-            fprintf(fout, "%s \t", &speciesNamesHost(k, 0));
-          //
-          for (ordinal_type k = 0; k < kmcdSurf.nSpec; k++)
-            fprintf(fout, "%s \t", &SurfSpeciesNamesHost(k, 0));
-
-          fprintf(fout, "%s \t", "velocity[m/s]");
+          if (binary_output) {
+            std::vector<std::string> names = { "iter", "t", "dt" };
+            TChem::TrajectoryWriter::addStateVectorNames(
+              names, speciesNamesHost, kmcd.nSpec);
+            TChem::TrajectoryWriter::addSpeciesNames(
+              names, SurfSpeciesNamesHost, kmcdSurf.nSpec);
+            names.push_back("velocity[m/s]");
+            writer = std::unique_ptr<TChem::TrajectoryWriter>(
+              new TChem::TrajectoryWriter("PFRSolution.bin", names, true));
+
+            // save initial condition
+            Kokkos::deep_copy(siteFraction_host, siteFraction);
+            writer->append(-1,
+                           t_host,
+                           dt_host,
+                           state_host,
+                           siteFraction_host,
+                           velocity_host);
+          } else {
+            fprintf(fout, "%s \t %s \t %s \t ", "iter", "t", "dt");
+            fprintf(fout,
+                    "%s \t %s \t %s \t",
+                    "Density[kg/m3]",
+                    "Pressure[Pascal]",
+                    "Temperature[K]");
+
+            for (ordinal_type k = 0; k < kmcd.nSpec; k++)
+              fprintf(fout, "%s \t", &speciesNamesHost(k, 0));
+            //
+            for (ordinal_type k = 0; k < kmcdSurf.nSpec; k++)
+              fprintf(fout, "%s \t", &SurfSpeciesNamesHost(k, 0));
+
+            fprintf(fout, "%s \t", "velocity[m/s]");
+
+            fprintf(fout, "\n");
+            // save initial condition
+            Kokkos::deep_copy(siteFraction_host, siteFraction);
 
-          fprintf(fout, "\n");
-          // save initial condition
-          Kokkos::deep_copy(siteFraction_host, siteFraction);
-
-          writeState(-1,
-                     t_host,
-                     dt_host,
-                     state_host,
-                     siteFraction_host,
-                     velocity_host,
-                     fout);
+            writeState(-1,
+                       t_host,
+                       dt_host,
+                       state_host,
+                       siteFraction_host,
+                       velocity_host,
+                       fout);
+          }
         }
 
         /// team policy
@@ -639,13 +727,21 @@ main(int argc, char* argv[])
             Kokkos::deep_copy(siteFraction_host, siteFraction);
             Kokkos::deep_copy(velocity_host, velocity);
 
-            writeState(iter,
-                       t_host,
-                       dt_host,
-                       state_host,
-                       siteFraction_host,
-                       velocity_host,
-                       fout);
+            if (writer)
+              writer->append(iter,
+                             t_host,
+                             dt_host,
+                             state_host,
+                             siteFraction_host,
+                             velocity_host);
+            else
+              writeState(iter,
+                         t_host,
+                         dt_host,
+                         state_host,
+                         siteFraction_host,
+                         velocity_host,
+                         fout);
           }
 
           /// carry over time and dt computed in this step
@@ -669,7 +765,8 @@ main(int argc, char* argv[])
            t_device_batch,
            t_device_batch / real_type(nBatch));
 
-    fclose(fout);
+    if (fout)
+      fclose(fout);
   }
   Kokkos::finalize();
 
@@ -0,0 +1,258 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#include "TChem_CommandLineParser.hpp"
+#include "TChem_KineticModelData.hpp"
+#include "TChem_SampleFileReader.hpp"
+#include "TChem_Util.hpp"
+
+#include "TChem_ReactorNetwork.hpp"
+
+using ordinal_type = TChem::ordinal_type;
+using real_type = TChem::real_type;
+using time_advance_type = TChem::time_advance_type;
+
+using real_type_1d_view = TChem::real_type_1d_view;
+using real_type_2d_view = TChem::real_type_2d_view;
+
+using real_type_1d_view_host = TChem::real_type_1d_view_host;
+using real_type_2d_view_host = TChem::real_type_2d_view_host;
+
+int
+main(int argc, char* argv[])
+{
+  /// default inputs
+  std::string prefixPath("data/");
+
+  /// stirred tanks
+  int num_cstr(2);
+  real_type mdotIn(3.596978981250784e-06);
+  real_type Vol(0.00013470), Acat(0.0013074), tend_cstr(0.025);
+  /// plug flow reactor
+  real_type Area(0.00053), Pcat(0.025977239243415308), zend(0.025);
+
+  real_type dtmin(1e-10), dtmax(1e-6);
+  real_type rtol_time(1e-4), atol_newton(1e-12), rtol_newton(1e-6);
+  int num_time_iterations_per_interval(1e1), max_num_newton_iterations(100),
+    max_num_outer_iterations(4e3);
+  int nBatch(1);
+
+  /// parse command line arguments
+  TChem::CommandLineParser opts(
+    "This example advances a series of stirred tanks followed by a plug flow "
+    "reactor; the outlet of a reactor is the inlet of the next");
+  opts.set_option<std::string>(
+    "prefixPath", "prefixPath e.g.,inputs/", &prefixPath);
+  opts.set_option<int>("num-cstr", "Number of stirred tanks", &num_cstr);
+  opts.set_option<real_type>(
+    "mdotIn", "Inlet mass flow rate [kg/s]", &mdotIn);
+  opts.set_option<real_type>("Vol", "Stirred tank volumen [m3]", &Vol);
+  opts.set_option<real_type>(
+    "Acat", "Stirred tank catalytic area [m2]", &Acat);
+  opts.set_option<real_type>(
+    "tend-cstr", "Time the stirred tanks are advanced to", &tend_cstr);
+  opts.set_option<real_type>(
+    "Area", "Plug flow reactor cross-sectional area [m2]", &Area);
+  opts.set_option<real_type>(
+    "Pcat", "Plug flow reactor chemically active perimeter [m]", &Pcat);
+  opts.set_option<real_type>(
+    "zend", "Plug flow reactor length [m]; 0 drops the reactor", &zend);
+  opts.set_option<real_type>("dtmin", "Minimum time step size", &dtmin);
+  opts.set_option<real_type>("dtmax", "Maximum time step size", &dtmax);
+  opts.set_option<real_type>(
+    "atol-newton", "Absolute tolerence used in newton solver", &atol_newton);
+  opts.set_option<real_type>(
+    "rtol-newton", "Relative tolerence used in newton solver", &rtol_newton);
+  opts.set_option<real_type>(
+    "tol-time", "Tolerence used for adaptive time stepping", &rtol_time);
+  opts.set_option<int>("time-iterations-per-interval",
+                       "Number of time iterations per launch",
+                       &num_time_iterations_per_interval);
+  opts.set_option<int>("max-newton-iterations",
+                       "Maximum number of newton iterations",
+                       &max_num_newton_iterations);
+  opts.set_option<int>("max-outer-iterations",
+                       "Maximum number of launches per stage",
+                       &max_num_outer_iterations);
+  opts.set_option<int>(
+    "batchsize",
+    "Batchsize the same state vector described in statefile is cloned",
+    &nBatch);
+
+  const bool r_parse = opts.parse(argc, argv);
+  if (r_parse)
+    return 0; // print help return
+
+  std::string chemFile(prefixPath + "chem.inp");
+  std::string thermFile(prefixPath + "therm.dat");
+  std::string chemSurfFile(prefixPath + "chemSurf.inp");
+  std::string thermSurfFile(prefixPath + "thermSurf.dat");
+  std::string inputFile(prefixPath + "sample.dat");
+  std::string inputFileSurf(prefixPath + "inputSurf.dat");
+
+  Kokkos::initialize(argc, argv);
+  {
+    const bool detail = false;
+
+    TChem::exec_space::print_configuration(std::cout, detail);
+    TChem::host_exec_space::print_configuration(std::cout, detail);
+
+    TChem::KineticModelData kmdSurf(
+      chemFile, thermFile, chemSurfFile, thermSurfFile);
+    const auto kmcd = kmdSurf.createConstData<TChem::exec_space>();
+    const auto kmcdSurf = kmdSurf.createConstSurfData<TChem::exec_space>();
+
+    const ordinal_type stateVecDim =
+      TChem::Impl::getStateVectorSize(kmcd.nSpec);
+
+    const auto speciesNamesHost = Kokkos::create_mirror_view(kmcd.speciesNames);
+    Kokkos::deep_copy(speciesNamesHost, kmcd.speciesNames);
+    const auto SurfSpeciesNamesHost =
+      Kokkos::create_mirror_view(kmcdSurf.speciesNames);
+    Kokkos::deep_copy(SurfSpeciesNamesHost, kmcdSurf.speciesNames);
+
+    real_type_2d_view_host state_host;
+    real_type_2d_view_host siteFraction_host;
+    {
+      const auto SpeciesMolecularWeights =
+        Kokkos::create_mirror_view(kmcd.sMass);
+      Kokkos::deep_copy(SpeciesMolecularWeights, kmcd.sMass);
+
+      TChem::Test::readSample(inputFile,
+                              speciesNamesHost,
+                              SpeciesMolecularWeights,
+                              kmcd.nSpec,
+                              stateVecDim,
+                              state_host,
+                              nBatch);
+      TChem::Test::readSurfaceSample(inputFileSurf,
+                                     SurfSpeciesNamesHost,
+                                     kmcdSurf.nSpec,
+                                     siteFraction_host,
+                                     nBatch);
+    }
+
+    real_type_2d_view state("StateVector", nBatch, stateVecDim);
+    real_type_1d_view mdot("mass flow rate", nBatch);
+    Kokkos::deep_copy(state, state_host);
+    Kokkos::deep_copy(mdot, mdotIn);
+
+    time_advance_type tadv_default;
+    tadv_default._dt = dtmin;
+    tadv_default._dtmin = dtmin;
+    tadv_default._dtmax = dtmax;
+    tadv_default._max_num_newton_iterations = max_num_newton_iterations;
+    tadv_default._num_time_iterations_per_interval =
+      num_time_iterations_per_interval;
+
+    const real_type atol_time = 1e-12;
+    TChem::ReactorNetwork network(kmcd,
+                                  kmcdSurf,
+                                  nBatch,
+                                  atol_newton,
+                                  rtol_newton,
+                                  atol_time,
+                                  rtol_time,
+                                  tadv_default,
+                                  max_num_outer_iterations);
+
+    /// each reactor has its own catalyst surface
+    auto create_site_fractions = [&]() {
+      real_type_2d_view zSurf("SiteFraction", nBatch, kmcdSurf.nSpec);
+      Kokkos::deep_copy(zSurf, siteFraction_host);
+      return zSurf;
+    };
+
+    for (ordinal_type s = 0; s < num_cstr; ++s) {
+      TChem::ReactorNetworkStage cstr;
+      cstr.type = TChem::ReactorNetworkStage::TransientContStirredTankReactor;
+      cstr.tend = tend_cstr;
+      cstr.Vol = Vol;
+      cstr.Acat = Acat;
+      cstr.zSurf = create_site_fractions();
+      network.addStage(cstr);
+    }
+    if (zend > 0) {
+      TChem::ReactorNetworkStage pfr;
+      pfr.type = TChem::ReactorNetworkStage::PlugFlowReactor;
+      pfr.tend = zend;
+      pfr.Area = Area;
+      pfr.Pcat = Pcat;
+      pfr.zSurf = create_site_fractions();
+      network.addStage(pfr);
+    }
+
+    TChem::ordinal_type_1d_view status("status", nBatch);
+
+    Kokkos::Impl::Timer timer;
+    timer.reset();
+    network.execute(state, mdot, status);
+    Kokkos::fence(); /// timing purpose
+    const real_type t_device_batch = timer.seconds();
+
+    /// outlet of every stage
+    FILE* fout = fopen("ReactorNetwork.dat", "w");
+    fprintf(fout, "%s \t %s \t ", "stage", "sample");
+    fprintf(fout,
+            "%s \t %s \t %s \t",
+            "Density[kg/m3]",
+            "Pressure[Pascal]",
+            "Temperature[K]");
+    for (ordinal_type k = 0; k < kmcd.nSpec; k++)
+      fprintf(fout, "%s \t", &speciesNamesHost(k, 0));
+    fprintf(fout, "\n");
+
+    for (ordinal_type s = 0; s < network.getNumberOfStages(); ++s) {
+      auto outlet_host =
+        Kokkos::create_mirror_view(network.getOutletState(s));
+      Kokkos::deep_copy(outlet_host, network.getOutletState(s));
+      for (ordinal_type i = 0; i < nBatch; ++i) {
+        fprintf(fout, "%d \t %d \t ", s, i);
+        for (ordinal_type k = 0; k < stateVecDim; ++k)
+          fprintf(fout, "%15.10e \t", outlet_host(i, k));
+        fprintf(fout, "\n");
+      }
+      printf("Stage %d outlet temperature of the first sample %e [K]\n",
+             s,
+             outlet_host(0, 2));
+    }
+    fclose(fout);
+
+    {
+      auto status_host = Kokkos::create_mirror_view(status);
+      Kokkos::deep_copy(status_host, status);
+      ordinal_type num_failures(0);
+      for (ordinal_type i = 0; i < nBatch; ++i) {
+        if (status_host(i) >= 0) {
+          printf("Sample %d failed at stage %d\n", i, status_host(i));
+          ++num_failures;
+        }
+      }
+      printf("Number of failed samples %d\n", num_failures);
+    }
+
+    printf("Time reactor network %e [sec] %e [sec/sample]\n",
+           t_device_batch,
+           t_device_batch / real_type(nBatch));
+  }
+  Kokkos::finalize();
+
+  return 0;
+}
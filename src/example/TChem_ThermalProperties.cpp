@@ -19,12 +19,9 @@ Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
 Sandia National Laboratories, Livermore, CA, USA
 ===================================================================================== */
 #include "TChem_CommandLineParser.hpp"
-#include "TChem_EnthalpyMass.hpp"
-#include "TChem_InternalEnergyMass.hpp"
-#include "TChem_EntropyMass.hpp"
 #include "TChem_KineticModelData.hpp"
-#include "TChem_SpecificHeatCapacityPerMass.hpp"
-#include "TChem_SpecificHeatCapacityConsVolumePerMass.hpp"
+#include "TChem_ThermalProperties.hpp"
+#include "TChem_SampleFileReader.hpp"
 #include "TChem_Util.hpp"
 
 using ordinal_type = TChem::ordinal_type;
@@ -111,6 +108,7 @@ main(int argc, char* argv[])
     real_type_2d_view CpMass("CpMass", nBatch, kmcd.nSpec);
     real_type_1d_view CpMixMass("CpMass Mixture", nBatch);
 
+    real_type_2d_view CvMass("CvMass", nBatch, kmcd.nSpec);
     real_type_1d_view CvMixMass("CvMass Mixture", nBatch);
 
     real_type_2d_view EnthalpyMass("EnthalpyMass", nBatch, kmcd.nSpec);
@@ -135,111 +133,35 @@ main(int argc, char* argv[])
     const ordinal_type level = 1;
 
     timer.reset();
-
     {
+      const ordinal_type per_team_extent =
+        TChem::ThermalProperties::getWorkSpaceSize(kmcd);
+      const ordinal_type per_team_scratch =
+        TChem::Scratch<real_type_1d_view>::shmem_size(per_team_extent);
 
-      policy_type policy_cp(exec_space_instance, nBatch, Kokkos::AUTO());
-
-      const ordinal_type per_team_extent_cp =
-        TChem::SpecificHeatCapacityPerMass::getWorkSpaceSize();
-      ordinal_type per_team_scratch_cp =
-        TChem::Scratch<real_type_1d_view>::shmem_size(per_team_extent_cp);
-      policy_cp.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch_cp));
-
-      TChem::SpecificHeatCapacityPerMass::runDeviceBatch(policy_cp,
-                                                         state,
-                                                         CpMass,
-                                                         CpMixMass,
-                                                         kmcd);
-    }
-
-
-    {
-
-      const ordinal_type per_team_extent_h = EnthalpyMass::getWorkSpaceSize(kmcd);
-      const ordinal_type per_team_scratch_h =
-        Scratch<real_type_1d_view>::shmem_size(per_team_extent_h);
-
-      policy_type policy_enthalpy(exec_space_instance, nBatch, Kokkos::AUTO());
+      policy_type policy(exec_space_instance, nBatch, Kokkos::AUTO());
       if (team_size > 0 && vector_size > 0) {
-        policy_enthalpy = policy_type(exec_space_instance, nBatch, team_size, vector_size);
+        policy = policy_type(exec_space_instance, nBatch, team_size, vector_size);
       }
-      policy_enthalpy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch_h));
-
-      TChem::EnthalpyMass::runDeviceBatch(policy_enthalpy,
-                                          state,
-                                          EnthalpyMass,
-                                          EnthalpyMixMass,
-                                          kmcd);
+      policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+      /// all quantities are computed in a single pass over the state
+      TChem::ThermalProperties::runDeviceBatch(policy,
+                                               TChem::ThermalProperties::All,
+                                               state,
+                                               CpMass,
+                                               CpMixMass,
+                                               CvMass,
+                                               CvMixMass,
+                                               EnthalpyMass,
+                                               EnthalpyMixMass,
+                                               EntropyMass,
+                                               EntropyMixMass,
+                                               InternalEnergyMass,
+                                               InternalEnergyMixMass,
+                                               kmcd);
     }
 
-    //
-
-    {
-      const ordinal_type per_team_extent_entropy = EntropyMass::getWorkSpaceSize(kmcd);
-      const ordinal_type per_team_scratch_entropy =
-        Scratch<real_type_1d_view>::shmem_size(per_team_extent_entropy);
-
-      policy_type policy_entropy(exec_space_instance, nBatch, Kokkos::AUTO());
-      if (team_size > 0 && vector_size > 0) {
-        policy_entropy = policy_type(exec_space_instance, nBatch, team_size, vector_size);
-      }
-
-      policy_entropy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch_entropy));
-
-      TChem::EntropyMass::runDeviceBatch(policy_entropy,
-                                          state,
-                                          EntropyMass,
-                                          EntropyMixMass,
-                                          kmcd);
-    }
-
-    //
-
-    {
-
-      const ordinal_type per_team_extent_int_energy = InternalEnergyMass::getWorkSpaceSize(kmcd);
-      const ordinal_type per_team_scratch_int_energy =
-        Scratch<real_type_1d_view>::shmem_size(per_team_extent_int_energy);
-
-      policy_type policy_int_energy(exec_space_instance, nBatch, Kokkos::AUTO());
-      if (team_size > 0 && vector_size > 0) {
-        policy_int_energy = policy_type(exec_space_instance, nBatch, team_size, vector_size);
-      }
-      policy_int_energy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch_int_energy));
-
-      TChem::InternalEnergyMass::runDeviceBatch(policy_int_energy,
-                                          state,
-                                          InternalEnergyMass,
-                                          InternalEnergyMixMass,
-                                          kmcd);
-
-    }
-
-    {
-
-      const ordinal_type per_team_extent_cv =
-        TChem::SpecificHeatCapacityConsVolumePerMass::getWorkSpaceSize(kmcd);
-      const ordinal_type per_team_scratch_cv =
-        Scratch<real_type_1d_view>::shmem_size(per_team_extent_cv);
-
-      policy_type policy_cv(exec_space_instance, nBatch, Kokkos::AUTO());
-      if (team_size > 0 && vector_size > 0) {
-        policy_cv = policy_type(exec_space_instance, nBatch, team_size, vector_size);
-      }
-      policy_cv.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch_cv));
-
-
-      TChem::SpecificHeatCapacityConsVolumePerMass::
-      runDeviceBatch(policy_cv,
-                     state,
-                     CvMixMass,
-                     kmcd);
-    }
-
-
-
-
     Kokkos::fence(); /// timing purpose
     const real_type t_device_batch = timer.seconds();
 
@@ -253,7 +175,7 @@ main(int argc, char* argv[])
     printf("Time deep copy      %e [sec] %e [sec/sample]\n",
            t_deepcopy,
            t_deepcopy / real_type(nBatch));
-    printf("Time reaction rates %e [sec] %e [sec/sample]\n",
+    printf("Time thermal properties %e [sec] %e [sec/sample]\n",
            t_device_batch,
            t_device_batch / real_type(nBatch));
 
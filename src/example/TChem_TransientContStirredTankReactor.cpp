@@ -20,9 +20,12 @@ Sandia National Laboratories, Livermore, CA, USA
 ===================================================================================== */
 #include "TChem_CommandLineParser.hpp"
 #include "TChem_KineticModelData.hpp"
+#include "TChem_TrajectoryWriter.hpp"
+#include "TChem_SampleFileReader.hpp"
 #include "TChem_Util.hpp"
 #include "TChem_EnthalpyMass.hpp"
 #include "TChem_TransientContStirredTankReactor.hpp"
+#include "TChem_TransientContStirredTankReactorSteadyState.hpp"
 
 using ordinal_type = TChem::ordinal_type;
 using real_type = TChem::real_type;
@@ -49,6 +52,7 @@ using time_advance_type_1d_view_host = TChem::time_advance_type_1d_view_host;
 #if defined(TCHEM_ENABLE_PROBLEM_DAE_CSTR)
 #include "TChem_SimpleSurface.hpp"
 #include "TChem_InitialCondSurface.hpp"
+#include "TChem_SurfaceSteadyState.hpp"
 #endif
 
 int
@@ -73,10 +77,15 @@ main(int argc, char* argv[])
   int nBatch(1), team_size(-1), vector_size(-1);
   bool verbose(true);
   int output_frequency(-1);
+  bool binary_output(false);
+  bool steady_state(false);
+  int num_continuation_steps(0);
+  real_type ds(1e-1), ds_max(1);
 
 #if defined(TCHEM_ENABLE_PROBLEM_DAE_CSTR)
   bool transient_initial_condition(false);
   bool initial_condition(true);
+  bool steady_state_initial_condition(false);
 #endif
   /// parse command line arguments
   TChem::CommandLineParser opts(
@@ -94,6 +103,8 @@ main(int argc, char* argv[])
     "transient_initial_condition", "If true, use a transient solver to obtain initial condition of the constraint", &transient_initial_condition);
     opts.set_option<bool>(
       "initial_condition", "If true, use a newton solver to obtain initial condition of the constraint", &initial_condition);
+    opts.set_option<bool>(
+      "steady_state_initial_condition", "If true, use a pseudo transient newton solver to obtain steady state site fractions instead of the transient and newton solvers above", &steady_state_initial_condition);
 
 #endif
 
@@ -139,6 +150,24 @@ main(int argc, char* argv[])
 
   opts.set_option<int>(
     "output_frequency", "save data at this iterations", &output_frequency);
+  opts.set_option<bool>(
+    "binary_output",
+    "If true, save data in CSTRSolution.bin with a background writer thread",
+    &binary_output);
+  opts.set_option<bool>(
+    "steady_state",
+    "If true, solve the steady state of the reactor instead of time marching",
+    &steady_state);
+  opts.set_option<int>(
+    "continuation_steps",
+    "Number of arc-length continuation steps in residence time taken from the "
+    "steady state; 0 computes the steady state only",
+    &num_continuation_steps);
+  opts.set_option<real_type>(
+    "ds",
+    "Initial arc-length step; positive increases residence time",
+    &ds);
+  opts.set_option<real_type>("ds_max", "Maximum arc-length step", &ds_max);
   opts.set_option<int>("team-size", "User defined team size", &team_size);
   opts.set_option<int>("vector-size", "User defined vector size", &vector_size);
 
@@ -226,10 +255,11 @@ main(int argc, char* argv[])
 
     Kokkos::Impl::Timer timer;
 
+    /// text output is written only without binary_output
 #if defined(TCHEM_ENABLE_PROBLEM_DAE_CSTR)
-    FILE* fout = fopen("CSTRSolutionDAE.dat", "w");
+    FILE* fout = binary_output ? nullptr : fopen("CSTRSolutionDAE.dat", "w");
 #else
-  FILE* fout = fopen("CSTRSolution.dat", "w");
+    FILE* fout = binary_output ? nullptr : fopen("CSTRSolution.dat", "w");
 #endif
     auto writeState =
       [](const ordinal_type iter,
@@ -255,6 +285,9 @@ main(int argc, char* argv[])
       };
 
 
+    /// binary trajectory; see scripts/tchem_trajectory.py
+    std::unique_ptr<TChem::TrajectoryWriter> writer;
+
     auto printState = [](const time_advance_type _tadv,
                          const real_type _t,
                          const real_type_1d_view_host _state_at_i,
@@ -287,7 +320,60 @@ main(int argc, char* argv[])
 
 #if defined(TCHEM_ENABLE_PROBLEM_DAE_CSTR)
 
-    if (transient_initial_condition) {
+    if (steady_state_initial_condition) {
+      real_type_2d_view facSurf("facSurf", nBatch, kmcdSurf.nSpec);
+      real_type_1d_view tol_newton_surf("tol newton surface", 2);
+      {
+        auto tol_newton_host_surf = Kokkos::create_mirror_view(tol_newton_surf);
+        tol_newton_host_surf(0) = 1e-12;
+        tol_newton_host_surf(1) = 1e-8;
+        Kokkos::deep_copy(tol_newton_surf, tol_newton_host_surf);
+      }
+      TChem::ordinal_type_1d_view iter_count_surf("iter count surface", nBatch);
+      TChem::ordinal_type_1d_view status_surf("status surface", nBatch);
+
+      /// team policy
+      policy_type policy(exec_space_instance, nBatch, Kokkos::AUTO());
+
+      const ordinal_type level = 1;
+      const ordinal_type per_team_extent =
+        TChem::SurfaceSteadyState::getWorkSpaceSize(kmcd, kmcdSurf);
+      const ordinal_type per_team_scratch =
+        TChem::Scratch<real_type_1d_view>::shmem_size(per_team_extent);
+      policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+      /// steady state site fractions for the inlet gas in a single launch
+      const ordinal_type max_num_iterations_surf(1000);
+      const real_type dt_init_surf(1e-10), dt_max_surf(1e3);
+      TChem::SurfaceSteadyState::runDeviceBatch(policy,
+                                                tol_newton_surf,
+                                                max_num_iterations_surf,
+                                                dt_init_surf,
+                                                dt_max_surf,
+                                                state,
+                                                siteFraction, // input
+                                                siteFraction, // output
+                                                facSurf,
+                                                iter_count_surf,
+                                                status_surf,
+                                                kmcd,
+                                                kmcdSurf);
+
+      ordinal_type num_failed(0);
+      Kokkos::parallel_reduce(
+        Kokkos::RangePolicy<TChem::exec_space>(0, nBatch),
+        KOKKOS_LAMBDA(const ordinal_type& i, ordinal_type& update) {
+          using status_type = TChem::SurfaceSteadyState::status_type;
+          update += status_surf(i) != status_type::Converged;
+        },
+        num_failed);
+      printf("Done with steady state surface for DAE system, %d of %d samples "
+             "did not converge\n",
+             num_failed,
+             nBatch);
+    }
+
+    if (transient_initial_condition && !steady_state_initial_condition) {
 
       printf("Running transient initial condition \n" );
 
@@ -389,7 +475,7 @@ main(int argc, char* argv[])
     }
     //Run a newton solver to check that constraint is satified.
 
-    if (initial_condition){
+    if (initial_condition && !steady_state_initial_condition) {
       real_type_2d_view facSurf("facSurf", nBatch, kmcdSurf.nSpec);
 
       /// team policy
@@ -530,6 +616,132 @@ main(int argc, char* argv[])
 
         printf("Done Setting up CSTR reactor\n" );
 
+        if (steady_state) {
+          using steady_state_type =
+            TChem::TransientContStirredTankReactorSteadyState;
+
+          /// team policy
+          policy_type policy(exec_space_instance, nBatch, Kokkos::AUTO());
+
+          const ordinal_type level = 1;
+          const ordinal_type per_team_extent =
+            steady_state_type::getWorkSpaceSize(kmcd, kmcdSurf, cstr);
+          const ordinal_type per_team_scratch =
+            TChem::Scratch<real_type_1d_view>::shmem_size(per_team_extent);
+          policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+          const ordinal_type num_steps = num_continuation_steps + 1;
+          TChem::real_type_3d_view state_path(
+            "state path", nBatch, num_steps, stateVecDim);
+          TChem::real_type_3d_view Z_path(
+            "site fraction path", nBatch, num_steps, kmcdSurf.nSpec);
+          real_type_2d_view mdot_path("mdot path", nBatch, num_steps);
+          TChem::ordinal_type_1d_view num_steps_out("num steps", nBatch);
+          TChem::ordinal_type_1d_view status("status", nBatch);
+
+          const real_type dt_init(1e-10), dt_max(1e3);
+          if (num_continuation_steps > 0) {
+            steady_state_type::runDeviceBatchContinuation(
+              policy,
+              tol_newton,
+              max_num_newton_iterations,
+              dt_init,
+              dt_max,
+              ds,
+              ds_max,
+              fac,
+              state,
+              siteFraction,
+              state_path,
+              Z_path,
+              mdot_path,
+              num_steps_out,
+              status,
+              kmcd,
+              kmcdSurf,
+              cstr);
+          } else {
+            TChem::ordinal_type_1d_view iter_count("iter count", nBatch);
+            steady_state_type::runDeviceBatch(
+              policy,
+              tol_newton,
+              max_num_newton_iterations,
+              dt_init,
+              dt_max,
+              fac,
+              state,
+              siteFraction,
+              state,
+              siteFraction,
+              iter_count,
+              status,
+              kmcd,
+              kmcdSurf,
+              cstr);
+            Kokkos::deep_copy(
+              Kokkos::subview(state_path, Kokkos::ALL(), 0, Kokkos::ALL()),
+              state);
+            Kokkos::deep_copy(
+              Kokkos::subview(Z_path, Kokkos::ALL(), 0, Kokkos::ALL()),
+              siteFraction);
+            Kokkos::deep_copy(mdot_path, cstr.mdotIn);
+            Kokkos::parallel_for(
+              Kokkos::RangePolicy<TChem::exec_space>(0, nBatch),
+              KOKKOS_LAMBDA(const ordinal_type& i) {
+                num_steps_out(i) =
+                  status(i) == steady_state_type::status_type::Converged;
+              });
+          }
+
+          auto state_path_host = Kokkos::create_mirror_view(state_path);
+          auto Z_path_host = Kokkos::create_mirror_view(Z_path);
+          auto mdot_path_host = Kokkos::create_mirror_view(mdot_path);
+          auto num_steps_out_host = Kokkos::create_mirror_view(num_steps_out);
+          auto status_host = Kokkos::create_mirror_view(status);
+          Kokkos::deep_copy(state_path_host, state_path);
+          Kokkos::deep_copy(Z_path_host, Z_path);
+          Kokkos::deep_copy(mdot_path_host, mdot_path);
+          Kokkos::deep_copy(num_steps_out_host, num_steps_out);
+          Kokkos::deep_copy(status_host, status);
+
+          FILE* fss = fopen("CSTRSteadyState.dat", "w");
+          fprintf(fss, "%s \t %s \t %s \t ", "sample", "mdotIn[kg/s]", "tau[s]");
+          fprintf(fss,
+                  "%s \t %s \t %s \t",
+                  "Density[kg/m3]",
+                  "Pressure[Pascal]",
+                  "Temperature[K]");
+          for (ordinal_type k = 0; k < kmcd.nSpec; k++)
+            fprintf(fss, "%s \t", &speciesNamesHost(k, 0));
+          for (ordinal_type k = 0; k < kmcdSurf.nSpec; k++)
+            fprintf(fss, "%s \t", &SurfSpeciesNamesHost(k, 0));
+          fprintf(fss, "\n");
+
+          for (ordinal_type i = 0; i < nBatch; ++i) {
+            printf("Steady state sample %d: status %d, %d points\n",
+                   i,
+                   status_host(i),
+                   num_steps_out_host(i));
+            for (ordinal_type j = 0; j < num_steps_out_host(i); ++j) {
+              const real_type mdot = mdot_path_host(i, j);
+              fprintf(fss,
+                      "%d \t %15.10e \t %15.10e \t ",
+                      i,
+                      mdot,
+                      state_path_host(i, j, 0) * cstr.Vol / mdot);
+              for (ordinal_type k = 0; k < stateVecDim; ++k)
+                fprintf(fss, "%15.10e \t", state_path_host(i, j, k));
+              for (ordinal_type k = 0; k < kmcdSurf.nSpec; ++k)
+                fprintf(fss, "%15.10e \t", Z_path_host(i, j, k));
+              fprintf(fss, "\n");
+            }
+          }
+          fclose(fss);
+
+          /// the steady state replaces time marching
+          max_num_time_iterations = 0;
+        }
+
         ordinal_type iter = 0;
         /// print of store QOI for the first sample
 #if defined(TCHEM_EXAMPLE_SimpleSurface_QOI_PRINT)
@@ -556,30 +768,49 @@ main(int argc, char* argv[])
           Kokkos::deep_copy(dt_host, dt);
           Kokkos::deep_copy(t_host, t);
 
-          fprintf(fout, "%s \t %s \t %s \t ", "iter", "t", "dt");
-          fprintf(fout,
-                  "%s \t %s \t %s \t",
-                  "Density[kg/m3]",
-                  "Pressure[Pascal]",
-                  "Temperature[K]");
-
-          for (ordinal_type k = 0; k < kmcd.nSpec; k++)
-            fprintf(fout, "%s \t", &speciesNamesHost(k, 0));
-          //
-          for (ordinal_type k = 0; k < kmcdSurf.nSpec; k++)
-            fprintf(fout, "%s \t", &SurfSpeciesNamesHost(k, 0));
+          if (binary_output) {
+            std::vector<std::string> names = { "iter", "t", "dt" };
+            TChem::TrajectoryWriter::addStateVectorNames(
+              names, speciesNamesHost, kmcd.nSpec);
+            TChem::TrajectoryWriter::addSpeciesNames(
+              names, SurfSpeciesNamesHost, kmcdSurf.nSpec);
+            writer = std::unique_ptr<TChem::TrajectoryWriter>(
+              new TChem::TrajectoryWriter("CSTRSolution.bin", names, true));
 
+            // save initial condition
+            Kokkos::deep_copy(siteFraction_host, siteFraction);
+            writer->append(-1,
+                           t_host,
+                           dt_host,
+                           state_host,
+                           siteFraction_host,
+                           real_type_1d_view_host());
+          } else {
+            fprintf(fout, "%s \t %s \t %s \t ", "iter", "t", "dt");
+            fprintf(fout,
+                    "%s \t %s \t %s \t",
+                    "Density[kg/m3]",
+                    "Pressure[Pascal]",
+                    "Temperature[K]");
+
+            for (ordinal_type k = 0; k < kmcd.nSpec; k++)
+              fprintf(fout, "%s \t", &speciesNamesHost(k, 0));
+            //
+            for (ordinal_type k = 0; k < kmcdSurf.nSpec; k++)
+              fprintf(fout, "%s \t", &SurfSpeciesNamesHost(k, 0));
+
+
+            fprintf(fout, "\n");
+            // save initial condition
+            Kokkos::deep_copy(siteFraction_host, siteFraction);
 
-          fprintf(fout, "\n");
-          // save initial condition
-          Kokkos::deep_copy(siteFraction_host, siteFraction);
-
-          writeState(-1,
-                     t_host,
-                     dt_host,
-                     state_host,
-                     siteFraction_host,
-                     fout);
+            writeState(-1,
+                       t_host,
+                       dt_host,
+                       state_host,
+                       siteFraction_host,
+                       fout);
+          }
         }
 
 
@@ -644,12 +875,20 @@ main(int argc, char* argv[])
             Kokkos::deep_copy(state_host, state);
             Kokkos::deep_copy(siteFraction_host, siteFraction);
 
-            writeState(iter,
-                       t_host,
-                       dt_host,
-                       state_host,
-                       siteFraction_host,
-                       fout);
+            if (writer)
+              writer->append(iter,
+                             t_host,
+                             dt_host,
+                             state_host,
+                             siteFraction_host,
+                             real_type_1d_view_host());
+            else
+              writeState(iter,
+                         t_host,
+                         dt_host,
+                         state_host,
+                         siteFraction_host,
+                         fout);
           }
 
           /// carry over time and dt computed in this step
@@ -673,7 +912,8 @@ main(int argc, char* argv[])
            t_device_batch,
            t_device_batch / real_type(nBatch));
 
-    fclose(fout);
+    if (fout)
+      fclose(fout);
   }
   Kokkos::finalize();
 
@@ -29,6 +29,10 @@ using real_type = TChem::real_type;
 
 #include "TChem_Test_Util.hpp"
 #include "TChem_Test_ReactionRates.hpp"
+#include "TChem_Test_Thermo.hpp"
+#include "TChem_Test_IgnitionZeroD.hpp"
+#include "TChem_Test_TransientContStirredTankReactor.hpp"
+#include "TChem_Test_ReactorNetwork.hpp"
 
 int
 main(int argc, char* argv[])
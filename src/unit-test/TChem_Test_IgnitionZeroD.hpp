@@ -0,0 +1,801 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_TEST_IGNITIONZEROD_HPP__
+#define __TCHEM_TEST_IGNITIONZEROD_HPP__
+
+#include "TChem_IgnitionZeroD.hpp"
+#include "TChem_IgnitionZeroDCSP.hpp"
+#include "TChem_IgnitionZeroDSensitivity.hpp"
+#include "TChem_IgnitionZeroDStream.hpp"
+#include "TChem_IgnitionZeroDTabulation.hpp"
+#include "TChem_KineticModelData.hpp"
+#if defined(TCHEM_ENABLE_TIME_INTEGRATOR_USE_RKC)
+#include "TChem_Impl_RungeKuttaChebyshev.hpp"
+#endif
+#if defined(TCHEM_ENABLE_TIME_INTEGRATOR_USE_NEWTON_KRYLOV)
+#include "TChem_Impl_IgnitionZeroD_Problem.hpp"
+#include "TChem_Impl_TimeIntegrator.hpp"
+#endif
+
+/// gri3.0 sample at 1200K and 10 atm ignites within a few milli seconds
+static inline void
+readIgnitionZeroDSample(const TChem::KineticModelConstDataHost& kmcd,
+                        const ordinal_type nBatch,
+                        TChem::real_type_2d_view_host& state)
+{
+  const std::string inputFile("../example/data/reaction-rates/input.dat");
+  state = TChem::real_type_2d_view_host(
+    "state", nBatch, TChem::Impl::getStateVectorSize(kmcd.nSpec));
+  auto state_at_0 = Kokkos::subview(state, 0, Kokkos::ALL());
+  TChem::Test::readStateVector(inputFile, kmcd.nSpec, state_at_0);
+  TChem::Test::cloneView(state);
+}
+
+static inline TChem::time_advance_type
+getIgnitionZeroDTimeAdvance(const real_type tend)
+{
+  TChem::time_advance_type tadv;
+  tadv._tbeg = 0;
+  tadv._tend = tend;
+  tadv._dt = 1e-8;
+  tadv._dtmin = 1e-8;
+  tadv._dtmax = 1e-3;
+  tadv._max_num_newton_iterations = 100;
+  tadv._num_time_iterations_per_interval = 100;
+  return tadv;
+}
+
+/// the state is overwritten with the state at tend
+static inline void
+advanceIgnitionZeroD(const TChem::KineticModelConstDataHost& kmcd,
+                     const real_type tend,
+                     const TChem::real_type_2d_view_host& state)
+{
+  TChem::IgnitionZeroD::Plan<TChem::host_exec_space> plan(
+    kmcd,
+    state.extent(0),
+    1e-12,
+    1e-6,
+    1e-12,
+    1e-6,
+    getIgnitionZeroDTimeAdvance(tend));
+  plan.execute(state, tend);
+}
+
+/// TrBDF2 reference; the sensitivity driver never takes the explicit RKC path
+static inline void
+advanceIgnitionZeroDTrBDF2(const TChem::KineticModelConstDataHost& kmcd,
+                           const real_type tend,
+                           const TChem::real_type_2d_view_host& state)
+{
+  using policy_type =
+    typename TChem::UseThisTeamPolicy<TChem::host_exec_space>::type;
+  using problem_type =
+    TChem::Impl::IgnitionZeroD_Problem<TChem::KineticModelConstDataHost>;
+  const ordinal_type nBatch = state.extent(0);
+  policy_type policy(TChem::host_exec_space(), nBatch, Kokkos::AUTO());
+  const ordinal_type level = 1;
+  const ordinal_type per_team_scratch =
+    TChem::Scratch<TChem::real_type_1d_view_host>::shmem_size(
+      TChem::IgnitionZeroDSensitivity::getWorkSpaceSize(kmcd));
+  policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+  TChem::real_type_1d_view_host tol_newton("tol newton", 2);
+  tol_newton(0) = 1e-12;
+  tol_newton(1) = 1e-6;
+  TChem::real_type_2d_view_host tol_time(
+    "tol time", problem_type::getNumberOfTimeODEs(kmcd), 2);
+  for (ordinal_type i = 0, iend = tol_time.extent(0); i < iend; ++i) {
+    tol_time(i, 0) = 1e-12;
+    tol_time(i, 1) = 1e-6;
+  }
+  TChem::real_type_2d_view_host fac(
+    "fac", nBatch, problem_type::getNumberOfEquations(kmcd));
+  TChem::time_advance_type_1d_view_host tadv("tadv", nBatch);
+  Kokkos::deep_copy(tadv, getIgnitionZeroDTimeAdvance(tend));
+  TChem::real_type_1d_view_host t("time", nBatch), dt("delta time", nBatch);
+  TChem::real_type_3d_view_host sens(
+    "sens", nBatch, kmcd.nReac, kmcd.nSpec + 1);
+
+  for (ordinal_type iter = 0; iter < 1000 && t(0) < tend; ++iter) {
+    TChem::IgnitionZeroDSensitivity::runHostBatch(policy,
+                                                  tol_newton,
+                                                  tol_time,
+                                                  fac,
+                                                  tadv,
+                                                  state,
+                                                  t,
+                                                  dt,
+                                                  state,
+                                                  sens,
+                                                  kmcd);
+    for (ordinal_type i = 0; i < nBatch; ++i) {
+      tadv(i)._tbeg = t(i);
+      tadv(i)._dt = dt(i);
+    }
+  }
+}
+
+TEST(IgnitionZeroD, directed_relation_graph)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat");
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+  kmd.setDirectedRelationGraph(1e-2, 1e-3);
+  const auto kmcd_drg = kmd.createConstData<TChem::host_exec_space>();
+
+  /// the reduced mechanism keeps fall-off reactions inactive in some
+  /// intervals; the analytic jacobian must stay finite through ignition
+  const real_type tend(0.05);
+  TChem::real_type_2d_view_host state, state_drg;
+  readIgnitionZeroDSample(kmcd, 1, state);
+  readIgnitionZeroDSample(kmcd, 1, state_drg);
+  const real_type temperature_init = state(0, 2);
+
+  advanceIgnitionZeroD(kmcd, tend, state);
+  advanceIgnitionZeroD(kmcd_drg, tend, state_drg);
+
+  const real_type temperature = state(0, 2),
+                  temperature_drg = state_drg(0, 2);
+  EXPECT_TRUE(std::isfinite(temperature_drg));
+  EXPECT_GT(temperature, temperature_init + 500);
+  EXPECT_GT(temperature_drg, temperature_init + 500);
+  EXPECT_NEAR(temperature_drg, temperature, 0.02 * temperature);
+}
+
+TEST(IgnitionZeroD, plan_reuse)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat");
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+
+  /// one interval with a fresh plan
+  const real_type tend(5e-4);
+  const ordinal_type nBatch(2);
+  TChem::real_type_2d_view_host state, state_ref;
+  readIgnitionZeroDSample(kmcd, nBatch, state);
+  readIgnitionZeroDSample(kmcd, nBatch, state_ref);
+  advanceIgnitionZeroD(kmcd, tend, state_ref);
+
+  /// two half intervals with the same plan; the time step size of the
+  /// first execution is carried over to the second
+  const auto tadv = getIgnitionZeroDTimeAdvance(tend);
+  TChem::IgnitionZeroD::Plan<TChem::host_exec_space> plan(
+    kmcd, nBatch, 1e-12, 1e-6, 1e-12, 1e-6, tadv);
+  plan.execute(state, tend / 2);
+  const auto dt = plan.getTimeStepSize();
+  for (ordinal_type i = 0; i < nBatch; ++i)
+    EXPECT_GT(dt(i), tadv._dt);
+  plan.execute(state, tend / 2);
+
+  for (ordinal_type i = 0; i < nBatch; ++i) {
+    EXPECT_NEAR(state(i, 2), state_ref(i, 2), 1e-4 * state_ref(i, 2));
+    for (ordinal_type k = 3, kend = state.extent(1); k < kend; ++k)
+      EXPECT_NEAR(state(i, k), state_ref(i, k), 1e-5);
+  }
+
+  /// a refilled batch starts again from the initial time step size
+  plan.resetTimeStepSize();
+  Kokkos::fence();
+  for (ordinal_type i = 0; i < nBatch; ++i)
+    EXPECT_EQ(dt(i), tadv._dt);
+}
+
+TEST(IgnitionZeroD, stream_vs_plan)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat");
+  const auto kmcd = kmd.createConstData<TChem::exec_space>();
+  const auto kmcd_host = kmd.createConstData<TChem::host_exec_space>();
+  const ordinal_type nSpec = kmcd_host.nSpec;
+
+  /// samples at different temperatures; the sample of nan temperature fails.
+  /// with two samples in a chunk the last chunk is partially filled
+  const ordinal_type nSamples(5), chunk_size(2), failed(3);
+  const real_type tend(1e-3);
+  TChem::real_type_2d_view_host state_ref;
+  readIgnitionZeroDSample(kmcd_host, nSamples, state_ref);
+  for (ordinal_type i = 0; i < nSamples; ++i)
+    state_ref(i, 2) += 50 * i;
+
+  const std::string sampleFile("stream_sample.dat"),
+    outputFile("stream_solution.bin");
+  {
+    std::ofstream file(sampleFile);
+    file << std::setprecision(17) << "T P";
+    for (ordinal_type k = 0; k < nSpec; ++k)
+      if (state_ref(0, k + 3) > 0)
+        file << " " << &kmcd_host.speciesNames(k, 0);
+    file << "\n";
+    for (ordinal_type i = 0; i < nSamples; ++i) {
+      if (i == failed)
+        file << "nan";
+      else
+        file << state_ref(i, 2);
+      file << " " << state_ref(i, 1);
+      for (ordinal_type k = 0; k < nSpec; ++k)
+        if (state_ref(0, k + 3) > 0)
+          file << " " << state_ref(i, k + 3);
+      file << "\n";
+    }
+  }
+
+  const auto tadv = getIgnitionZeroDTimeAdvance(tend);
+  TChem::IgnitionZeroDStream stream(
+    kmcd, kmcd_host, chunk_size, 1e-12, 1e-6, 1e-12, 1e-6, tadv);
+  const auto stats = stream.run(sampleFile, outputFile, tend);
+  EXPECT_EQ(stats._num_samples, nSamples);
+  EXPECT_EQ(stats._num_chunks, (nSamples + chunk_size - 1) / chunk_size);
+  EXPECT_EQ(stats._num_failures, 1);
+
+  /// in-core reference of the samples that do not fail
+  advanceIgnitionZeroD(kmcd_host, tend, state_ref);
+
+  /// rows of the output in sample order; columns are iter, t, dt and the
+  /// state vector
+  const ordinal_type ncolumns = 3 + TChem::Impl::getStateVectorSize(nSpec);
+  std::vector<std::vector<double>> rows;
+  {
+    FILE* fin = fopen(outputFile.c_str(), "rb");
+    ASSERT_TRUE(fin != nullptr);
+    char magic[8];
+    uint32_t version(0), ncolumns_in_file(0);
+    ASSERT_EQ(fread(magic, 1, 8, fin), size_t(8));
+    ASSERT_EQ(fread(&version, sizeof(uint32_t), 1, fin), size_t(1));
+    ASSERT_EQ(fread(&ncolumns_in_file, sizeof(uint32_t), 1, fin), size_t(1));
+    ASSERT_EQ(ordinal_type(ncolumns_in_file), ncolumns);
+    for (ordinal_type k = 0; k < ncolumns; ++k) {
+      uint32_t len(0);
+      ASSERT_EQ(fread(&len, sizeof(uint32_t), 1, fin), size_t(1));
+      fseek(fin, len, SEEK_CUR);
+    }
+    uint64_t n(0);
+    while (fread(&n, sizeof(uint64_t), 1, fin) == 1) {
+      std::vector<double> values(size_t(ncolumns) * n);
+      ASSERT_EQ(fread(values.data(), sizeof(double), values.size(), fin),
+                values.size());
+      for (uint64_t i = 0; i < n; ++i) {
+        std::vector<double> row(ncolumns);
+        for (ordinal_type k = 0; k < ncolumns; ++k)
+          row[k] = values[k * n + i];
+        rows.push_back(row);
+      }
+    }
+    fclose(fin);
+  }
+  ASSERT_EQ(ordinal_type(rows.size()), nSamples);
+
+  for (ordinal_type i = 0; i < nSamples; ++i) {
+    const auto& row = rows[i];
+    EXPECT_EQ(row[0], real_type(i / chunk_size)) << "sample " << i;
+    if (i == failed) {
+      EXPECT_EQ(row[1], real_type(0));
+      EXPECT_LT(row[2], real_type(0));
+      continue;
+    }
+    EXPECT_EQ(row[1], tend) << "sample " << i;
+    EXPECT_GT(row[2], real_type(0)) << "sample " << i;
+    EXPECT_NEAR(row[3 + 2], state_ref(i, 2), 1e-4 * state_ref(i, 2))
+      << "sample " << i;
+    for (ordinal_type k = 3; k < ncolumns - 3; ++k)
+      EXPECT_NEAR(row[3 + k], state_ref(i, k), 1e-5)
+        << "sample " << i << " species " << k - 3;
+  }
+  std::remove(sampleFile.c_str());
+  std::remove(outputFile.c_str());
+}
+
+TEST(IgnitionZeroD, tabulation)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat");
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+
+  using problem_type =
+    TChem::Impl::IgnitionZeroD_Problem<TChem::KineticModelConstDataHost>;
+  TChem::real_type_1d_view_host tol_newton("tol newton", 2);
+  TChem::real_type_2d_view_host tol_time(
+    "tol time", problem_type::getNumberOfTimeODEs(kmcd), 2);
+  tol_newton(0) = 1e-12;
+  tol_newton(1) = 1e-6;
+  for (ordinal_type i = 0, iend = tol_time.extent(0); i < iend; ++i) {
+    tol_time(i, 0) = 1e-12;
+    tol_time(i, 1) = 1e-6;
+  }
+
+  /// a short step in the induction period
+  const real_type dt(1e-4), tol_isat(1e-3);
+  TChem::IgnitionZeroDTabulation isat(kmcd,
+                                      tol_newton,
+                                      tol_time,
+                                      getIgnitionZeroDTimeAdvance(dt),
+                                      tol_isat,
+                                      10);
+
+  /// the first query adds a record; the second is a perturbation inside
+  /// its EOA and is retrieved
+  TChem::real_type_2d_view_host state[2], state_out[2], state_direct[2];
+  for (ordinal_type i = 0; i < 2; ++i) {
+    readIgnitionZeroDSample(kmcd, 1, state[i]);
+    state[i](0, 2) *= (1 + 1e-6 * i);
+    state_out[i] = TChem::real_type_2d_view_host(
+      "state out", state[i].extent(0), state[i].extent(1));
+    state_direct[i] = TChem::real_type_2d_view_host(
+      "state direct", state[i].extent(0), state[i].extent(1));
+    Kokkos::deep_copy(state_direct[i], state[i]);
+    advanceIgnitionZeroD(kmcd, dt, state_direct[i]);
+  }
+
+  TChem::ordinal_type_1d_view_host status("status", 1);
+  EXPECT_EQ(isat.runHostBatch(dt, state[0], state_out[0], status), 0);
+  EXPECT_EQ(status(0), 0);
+  EXPECT_EQ(isat.getNumberOfRecords(), 1);
+  EXPECT_EQ(isat.runHostBatch(dt, state[1], state_out[1]), 0);
+
+  const auto stat = isat.getStatistics();
+  EXPECT_EQ(stat._num_queries, 2);
+  EXPECT_EQ(stat._num_retrieves, 1);
+  EXPECT_EQ(stat._num_failures, 0);
+
+  /// retrieved and added states agree with the direct integration
+  for (ordinal_type i = 0; i < 2; ++i) {
+    EXPECT_NEAR(state_out[i](0, 2),
+                state_direct[i](0, 2),
+                tol_isat * state_direct[i](0, 2));
+    for (ordinal_type k = 3, kend = state[i].extent(1); k < kend; ++k)
+      EXPECT_NEAR(state_out[i](0, k), state_direct[i](0, k), tol_isat);
+  }
+}
+
+TEST(IgnitionZeroD, csp_vs_trbdf2)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat");
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+
+  const real_type tend(0.05);
+  TChem::real_type_2d_view_host state, state_ref;
+  readIgnitionZeroDSample(kmcd, 1, state);
+  readIgnitionZeroDSample(kmcd, 1, state_ref);
+  advanceIgnitionZeroD(kmcd, tend, state_ref);
+
+  using policy_type =
+    typename TChem::UseThisTeamPolicy<TChem::host_exec_space>::type;
+  using problem_type =
+    TChem::Impl::IgnitionZeroD_Problem<TChem::KineticModelConstDataHost>;
+  policy_type policy(TChem::host_exec_space(), 1, Kokkos::AUTO());
+  const ordinal_type level = 1;
+  const ordinal_type per_team_scratch =
+    TChem::Scratch<TChem::real_type_1d_view_host>::shmem_size(
+      TChem::IgnitionZeroDCSP::getWorkSpaceSize(kmcd));
+  policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+  TChem::real_type_2d_view_host tol_time(
+    "tol time", problem_type::getNumberOfTimeODEs(kmcd), 2);
+  for (ordinal_type i = 0, iend = tol_time.extent(0); i < iend; ++i) {
+    tol_time(i, 0) = 1e-12;
+    tol_time(i, 1) = 1e-5;
+  }
+  TChem::real_type_2d_view_host fac(
+    "fac", 1, problem_type::getNumberOfEquations(kmcd));
+  TChem::time_advance_type_1d_view_host tadv("tadv", 1);
+  Kokkos::deep_copy(tadv, getIgnitionZeroDTimeAdvance(tend));
+  TChem::real_type_1d_view_host t("time", 1), dt("delta time", 1);
+
+  for (ordinal_type iter = 0; iter < 1000 && t(0) < tend; ++iter) {
+    TChem::IgnitionZeroDCSP::runHostBatch(
+      policy, tol_time, fac, tadv, state, t, dt, state, kmcd);
+    ASSERT_GT(dt(0), 0);
+    tadv(0)._tbeg = t(0);
+    tadv(0)._dt = dt(0);
+  }
+  EXPECT_EQ(t(0), tend);
+
+  /// both integrators pass the ignition and reach the same equilibrium
+  EXPECT_NEAR(state(0, 2), state_ref(0, 2), 0.01 * state_ref(0, 2));
+  for (ordinal_type k = 3, kend = state.extent(1); k < kend; ++k)
+    EXPECT_NEAR(state(0, k), state_ref(0, k), 1e-3);
+}
+
+TEST(IgnitionZeroD, sensitivity_vs_finite_difference)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat");
+  auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+  const ordinal_type nSpec = kmcd.nSpec, nReac = kmcd.nReac;
+
+  /// before ignition, where the sensitivities are smooth in ln A
+  const real_type tend(5e-4);
+  const real_type atol_newton(1e-12), rtol_newton(1e-8), atol_time(1e-14),
+    rtol_time(1e-8);
+
+  using policy_type =
+    typename TChem::UseThisTeamPolicy<TChem::host_exec_space>::type;
+  using problem_type =
+    TChem::Impl::IgnitionZeroD_Problem<TChem::KineticModelConstDataHost>;
+  policy_type policy(TChem::host_exec_space(), 1, Kokkos::AUTO());
+  const ordinal_type level = 1;
+  const ordinal_type per_team_scratch =
+    TChem::Scratch<TChem::real_type_1d_view_host>::shmem_size(
+      TChem::IgnitionZeroDSensitivity::getWorkSpaceSize(kmcd));
+  policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+  TChem::real_type_1d_view_host tol_newton("tol newton", 2);
+  tol_newton(0) = atol_newton;
+  tol_newton(1) = rtol_newton;
+  TChem::real_type_2d_view_host tol_time(
+    "tol time", problem_type::getNumberOfTimeODEs(kmcd), 2);
+  for (ordinal_type i = 0, iend = tol_time.extent(0); i < iend; ++i) {
+    tol_time(i, 0) = atol_time;
+    tol_time(i, 1) = rtol_time;
+  }
+  TChem::real_type_2d_view_host fac(
+    "fac", 1, problem_type::getNumberOfEquations(kmcd));
+  TChem::time_advance_type_1d_view_host tadv("tadv", 1);
+  Kokkos::deep_copy(tadv, getIgnitionZeroDTimeAdvance(tend));
+  TChem::real_type_1d_view_host t("time", 1), dt("delta time", 1);
+
+  /// dy/dlnA along the trajectory
+  TChem::real_type_2d_view_host state;
+  readIgnitionZeroDSample(kmcd, 1, state);
+  TChem::real_type_3d_view_host sens("sens", 1, nReac, nSpec + 1);
+  for (ordinal_type iter = 0; iter < 1000 && t(0) < tend; ++iter) {
+    TChem::IgnitionZeroDSensitivity::runHostBatch(policy,
+                                                  tol_newton,
+                                                  tol_time,
+                                                  fac,
+                                                  tadv,
+                                                  state,
+                                                  t,
+                                                  dt,
+                                                  state,
+                                                  sens,
+                                                  kmcd);
+    ASSERT_GT(dt(0), 0);
+    tadv(0)._tbeg = t(0);
+    tadv(0)._dt = dt(0);
+  }
+  EXPECT_EQ(t(0), tend);
+
+  /// the two reactions the temperature is most sensitive to
+  ordinal_type jmax[2] = { 0, 0 };
+  for (ordinal_type j = 0; j < nReac; ++j) {
+    const real_type s = std::abs(sens(0, j, 0));
+    if (s > std::abs(sens(0, jmax[0], 0))) {
+      jmax[1] = jmax[0];
+      jmax[0] = j;
+    } else if (j != jmax[0] && s > std::abs(sens(0, jmax[1], 0))) {
+      jmax[1] = j;
+    }
+  }
+  ASSERT_GT(std::abs(sens(0, jmax[0], 0)), 0);
+
+  /// central differences of two runs with ln A perturbed by +/- delta
+  const real_type delta(1e-2);
+  for (ordinal_type r = 0; r < 2; ++r) {
+    const ordinal_type j = jmax[r];
+    TChem::real_type_2d_view_host logA("logA", 2, nReac);
+    logA(0, j) = delta;
+    logA(1, j) = -delta;
+    kmcd.sampleLogAFactor = logA;
+
+    TChem::real_type_2d_view_host state_fd;
+    readIgnitionZeroDSample(kmcd, 2, state_fd);
+    TChem::IgnitionZeroD::Plan<TChem::host_exec_space> plan(
+      kmcd,
+      2,
+      atol_newton,
+      rtol_newton,
+      atol_time,
+      rtol_time,
+      getIgnitionZeroDTimeAdvance(tend));
+    plan.execute(state_fd, tend);
+
+    /// temperature and mass fractions
+    real_type norm(0), diff(0);
+    for (ordinal_type k = 0; k <= nSpec; ++k) {
+      const real_type s_fd =
+        (state_fd(0, k + 2) - state_fd(1, k + 2)) / (2 * delta);
+      if (k == 0)
+        EXPECT_NEAR(sens(0, j, 0), s_fd, 0.05 * std::abs(s_fd));
+      else {
+        norm += s_fd * s_fd;
+        diff += (sens(0, j, k) - s_fd) * (sens(0, j, k) - s_fd);
+      }
+    }
+    EXPECT_LE(std::sqrt(diff), 0.05 * std::sqrt(norm)) << "reaction " << j;
+  }
+}
+
+#if defined(TCHEM_ENABLE_TIME_INTEGRATOR_USE_RKC)
+TEST(IgnitionZeroD, rkc_vs_trbdf2)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat");
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+  const ordinal_type nSpec = kmcd.nSpec;
+
+  /// a short interval at the start of the induction period is non-stiff
+  /// with time steps bounded by dt_max; RKC must integrate it on its own
+  {
+    const real_type tend(1e-6), dt_max(1e-9);
+    TChem::real_type_2d_view_host state, state_ref;
+    readIgnitionZeroDSample(kmcd, 1, state);
+    readIgnitionZeroDSample(kmcd, 1, state_ref);
+    advanceIgnitionZeroDTrBDF2(kmcd, tend, state_ref);
+
+    using problem_type =
+      TChem::Impl::IgnitionZeroD_Problem<TChem::KineticModelConstDataHost>;
+    const ordinal_type m = problem_type::getNumberOfEquations(kmcd);
+    problem_type problem;
+    problem._p = state(0, 1);
+    problem._kmcd = kmcd;
+    problem._work = TChem::real_type_1d_view_host(
+      "work", problem_type::getWorkSpaceSize(kmcd));
+
+    TChem::real_type_2d_view_host tol_time("tol time", m, 2);
+    for (ordinal_type i = 0; i < m; ++i) {
+      tol_time(i, 0) = 1e-12;
+      tol_time(i, 1) = 1e-6;
+    }
+    TChem::real_type_1d_view_host un("un", m), fn("fn", m), y_a("y a", m),
+      y_b("y b", m), y_c("y c", m), f("f", m), v("v", m);
+    for (ordinal_type k = 0; k < m; ++k)
+      un(k) = state(0, k + 2);
+
+    real_type t(0), dt(1e-10);
+    ordinal_type iter(0), r_val(-1);
+    using policy_type = Kokkos::TeamPolicy<TChem::host_exec_space>;
+    Kokkos::parallel_for(
+      policy_type(1, 1), [&](const typename policy_type::member_type& member) {
+        r_val = TChem::Impl::RungeKuttaChebyshev::team_invoke(member,
+                                                             problem,
+                                                             100000,
+                                                             tol_time,
+                                                             1e-14,
+                                                             dt_max,
+                                                             tend,
+                                                             t,
+                                                             dt,
+                                                             iter,
+                                                             un,
+                                                             fn,
+                                                             y_a,
+                                                             y_b,
+                                                             y_c,
+                                                             f,
+                                                             v);
+      });
+    ASSERT_EQ(r_val, ordinal_type(TChem::Impl::RungeKuttaChebyshev::Success));
+    EXPECT_NEAR(t, tend, 1e-12 * tend);
+
+    EXPECT_NEAR(un(0), state_ref(0, 2), 1e-5 * state_ref(0, 2));
+    for (ordinal_type k = 1; k <= nSpec; ++k)
+      EXPECT_NEAR(un(k), state_ref(0, k + 2), 1e-7) << "species " << k - 1;
+  }
+
+  /// through the induction period RKC hands the stiff part over to TrBDF2;
+  /// the result agrees with TrBDF2 alone
+  {
+    const real_type tend(5e-4);
+    TChem::real_type_2d_view_host state, state_ref;
+    readIgnitionZeroDSample(kmcd, 1, state);
+    readIgnitionZeroDSample(kmcd, 1, state_ref);
+    advanceIgnitionZeroD(kmcd, tend, state);
+    advanceIgnitionZeroDTrBDF2(kmcd, tend, state_ref);
+
+    EXPECT_NEAR(state(0, 2), state_ref(0, 2), 1e-4 * state_ref(0, 2));
+    for (ordinal_type k = 3, kend = state.extent(1); k < kend; ++k)
+      EXPECT_NEAR(state(0, k), state_ref(0, k), 1e-5);
+  }
+}
+#endif
+
+#if defined(TCHEM_ENABLE_TIME_INTEGRATOR_USE_NEWTON_KRYLOV)
+/// the same problem without a jacobian diagonal is integrated with the dense
+/// newton solver
+template<typename KineticModelConstDataType>
+struct IgnitionZeroDDenseNewton_Problem
+  : TChem::Impl::IgnitionZeroD_Problem<KineticModelConstDataType>
+{
+  static constexpr bool has_jacobian_diagonal = false;
+};
+
+/// x = (T, Ys) is overwritten with the state at tend; returns false when
+/// the time integrator fails
+template<typename ProblemType>
+static inline bool
+advanceIgnitionZeroDTimeIntegrator(
+  const TChem::KineticModelConstDataHost& kmcd,
+  const real_type pressure,
+  const real_type tend,
+  const TChem::real_type_1d_view_host& x)
+{
+  ProblemType problem;
+  problem._p = pressure;
+  problem._kmcd = kmcd;
+  const ordinal_type m = problem.getNumberOfEquations();
+  problem._work =
+    TChem::real_type_1d_view_host("problem work", problem.getWorkSpaceSize());
+  problem._fac = TChem::real_type_1d_view_host("fac", m);
+
+  TChem::real_type_1d_view_host tol_newton("tol newton", 2);
+  tol_newton(0) = 1e-12;
+  tol_newton(1) = 1e-8;
+  TChem::real_type_2d_view_host tol_time("tol time", m, 2);
+  for (ordinal_type i = 0; i < m; ++i) {
+    tol_time(i, 0) = 1e-12;
+    tol_time(i, 1) = 1e-6;
+  }
+  TChem::real_type_1d_view_host work(
+    "work", TChem::Impl::TimeIntegrator::getWorkSpaceSize(problem));
+  TChem::real_type_0d_view_host t_out("t out"), dt_out("dt out");
+
+  const auto tadv = getIgnitionZeroDTimeAdvance(tend);
+  real_type t(tadv._tbeg), dt(tadv._dt);
+  ordinal_type r_val(0);
+  using policy_type = Kokkos::TeamPolicy<TChem::host_exec_space>;
+  Kokkos::parallel_for(
+    policy_type(1, 1), [&](const typename policy_type::member_type& member) {
+      for (ordinal_type iter = 0; iter < 1000 && t < tend && r_val == 0;
+           ++iter) {
+        r_val = TChem::Impl::TimeIntegrator::team_invoke(
+          member,
+          problem,
+          tadv._max_num_newton_iterations,
+          tadv._num_time_iterations_per_interval,
+          tol_newton,
+          tol_time,
+          dt,
+          tadv._dtmin,
+          tadv._dtmax,
+          t,
+          tend,
+          x,
+          t_out,
+          dt_out,
+          x,
+          work);
+        t = t_out();
+        dt = dt_out();
+      }
+    });
+  return r_val == 0 && t == tend;
+}
+
+TEST(IgnitionZeroD, newton_krylov_vs_dense_newton)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat");
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+
+  using krylov_problem_type =
+    TChem::Impl::IgnitionZeroD_Problem<TChem::KineticModelConstDataHost>;
+  using dense_problem_type =
+    IgnitionZeroDDenseNewton_Problem<TChem::KineticModelConstDataHost>;
+  const bool use_krylov =
+               TChem::Impl::UseNewtonKrylovSolver<krylov_problem_type>::value,
+             use_krylov_dense =
+               TChem::Impl::UseNewtonKrylovSolver<dense_problem_type>::value;
+  EXPECT_TRUE(use_krylov);
+  EXPECT_FALSE(use_krylov_dense);
+
+  /// through the ignition to the equilibrium
+  const real_type tend(0.05);
+  TChem::real_type_2d_view_host state;
+  readIgnitionZeroDSample(kmcd, 1, state);
+  const real_type pressure = state(0, 1), temperature_init = state(0, 2);
+
+  const ordinal_type m = krylov_problem_type::getNumberOfEquations(kmcd);
+  TChem::real_type_1d_view_host x("x", m), x_ref("x ref", m);
+  for (ordinal_type k = 0; k < m; ++k)
+    x(k) = x_ref(k) = state(0, k + 2);
+
+  ASSERT_TRUE(advanceIgnitionZeroDTimeIntegrator<krylov_problem_type>(
+    kmcd, pressure, tend, x));
+  ASSERT_TRUE(advanceIgnitionZeroDTimeIntegrator<dense_problem_type>(
+    kmcd, pressure, tend, x_ref));
+
+  EXPECT_GT(x_ref(0), temperature_init + 500);
+  EXPECT_NEAR(x(0), x_ref(0), 1e-3 * x_ref(0));
+  for (ordinal_type k = 1; k < m; ++k)
+    EXPECT_NEAR(x(k), x_ref(k), 1e-4) << "species " << k - 1;
+}
+#endif
+
+#if defined(TCHEM_ENABLE_NEWTONSOLVER_USE_MIXED_PRECISION)
+/// the newton iteration matrices of TrBDF2 are factorized in float; CSP
+/// factorizes its jacobians in real_type and serves as the reference
+TEST(IgnitionZeroD, mixed_precision_vs_csp)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat");
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+
+  const real_type tend(0.05);
+  const ordinal_type nBatch(2);
+  TChem::real_type_2d_view_host state, state_ref;
+  readIgnitionZeroDSample(kmcd, nBatch, state);
+  readIgnitionZeroDSample(kmcd, 1, state_ref);
+  const real_type temperature_init = state(0, 2);
+
+  TChem::IgnitionZeroD::Plan<TChem::host_exec_space> plan(
+    kmcd, nBatch, 1e-12, 1e-6, 1e-12, 1e-6, getIgnitionZeroDTimeAdvance(tend));
+  plan.execute(state, tend);
+  const auto dt = plan.getTimeStepSize();
+
+  using policy_type =
+    typename TChem::UseThisTeamPolicy<TChem::host_exec_space>::type;
+  using problem_type =
+    TChem::Impl::IgnitionZeroD_Problem<TChem::KineticModelConstDataHost>;
+  policy_type policy(TChem::host_exec_space(), 1, Kokkos::AUTO());
+  const ordinal_type level = 1;
+  const ordinal_type per_team_scratch =
+    TChem::Scratch<TChem::real_type_1d_view_host>::shmem_size(
+      TChem::IgnitionZeroDCSP::getWorkSpaceSize(kmcd));
+  policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+
+  TChem::real_type_2d_view_host tol_time(
+    "tol time", problem_type::getNumberOfTimeODEs(kmcd), 2);
+  for (ordinal_type i = 0, iend = tol_time.extent(0); i < iend; ++i) {
+    tol_time(i, 0) = 1e-12;
+    tol_time(i, 1) = 1e-5;
+  }
+  TChem::real_type_2d_view_host fac(
+    "fac", 1, problem_type::getNumberOfEquations(kmcd));
+  TChem::time_advance_type_1d_view_host tadv("tadv", 1);
+  Kokkos::deep_copy(tadv, getIgnitionZeroDTimeAdvance(tend));
+  TChem::real_type_1d_view_host t("time", 1), dt_ref("delta time", 1);
+  for (ordinal_type iter = 0; iter < 1000 && t(0) < tend; ++iter) {
+    TChem::IgnitionZeroDCSP::runHostBatch(
+      policy, tol_time, fac, tadv, state_ref, t, dt_ref, state_ref, kmcd);
+    ASSERT_GT(dt_ref(0), 0);
+    tadv(0)._tbeg = t(0);
+    tadv(0)._dt = dt_ref(0);
+  }
+
+  for (ordinal_type i = 0; i < nBatch; ++i) {
+    /// no time integration failed and the sample ignited
+    EXPECT_GT(dt(i), 0);
+    EXPECT_GT(state(i, 2), temperature_init + 500);
+
+    real_type Ysum(0);
+    for (ordinal_type k = 3, kend = state.extent(1); k < kend; ++k)
+      Ysum += state(i, k);
+    EXPECT_NEAR(Ysum, real_type(1), 1e-6);
+
+    EXPECT_NEAR(state(i, 2), state_ref(0, 2), 0.01 * state_ref(0, 2));
+    for (ordinal_type k = 3, kend = state.extent(1); k < kend; ++k)
+      EXPECT_NEAR(state(i, k), state_ref(0, k), 1e-3);
+  }
+}
+#endif
+
+#endif
@@ -23,6 +23,13 @@ Sandia National Laboratories, Livermore, CA, USA
 
 #include "TChem_KineticModelData.hpp"
 #include "TChem_NetProductionRatePerMass.hpp"
+#include "TChem_Profiler.hpp"
+#include "TChem_TeamPolicyTuner.hpp"
+#include "TChem_Impl_DirectedRelationGraph.hpp"
+#include "TChem_Impl_Gk.hpp"
+#include "TChem_Impl_IgnitionZeroD_Problem.hpp"
+#include "TChem_Impl_KForwardReverse.hpp"
+#include "TChem_Impl_KForwardReverseSurface.hpp"
 
 TEST(NetProductionRatePerMass, single)
 {
@@ -49,4 +56,699 @@ TEST(NetProductionRatePerMass, single)
 	      );
 }
 
+TEST(NetProductionRatePerMass, layout_left)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  std::string chemFile(prefixPath + "chem.inp");
+  std::string thermFile(prefixPath + "therm.dat");
+  std::string inputFile(prefixPath + "input.dat");
+
+  TChem::KineticModelData kmd(chemFile, thermFile);
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+
+  const ordinal_type nBatch(10);
+  const ordinal_type stateVecDim =
+    TChem::Impl::getStateVectorSize(kmcd.nSpec);
+
+  /// sample major (default) and species major batches of the same states
+  TChem::real_type_2d_view_host state("state", nBatch, stateVecDim);
+  {
+    auto state_at_0 = Kokkos::subview(state, 0, Kokkos::ALL());
+    TChem::Test::readStateVector(inputFile, kmcd.nSpec, state_at_0);
+    TChem::Test::cloneView(state);
+    for (ordinal_type i = 0; i < nBatch; ++i)
+      state(i, 2) += 10 * i;
+  }
+  Kokkos::View<real_type**, Kokkos::LayoutLeft, TChem::host_exec_space>
+    state_left("state left", nBatch, stateVecDim),
+    omega_left("omega left", nBatch, kmcd.nSpec);
+  Kokkos::deep_copy(state_left, state);
+
+  TChem::real_type_2d_view_host omega("omega", nBatch, kmcd.nSpec);
+
+  TChem::NetProductionRatePerMass::runHostBatch(nBatch, state, omega, kmcd);
+  TChem::NetProductionRatePerMass::runHostBatch(
+    nBatch, state_left, omega_left, kmcd);
+
+  for (ordinal_type i = 0; i < nBatch; ++i)
+    for (ordinal_type k = 0; k < kmcd.nSpec; ++k)
+      EXPECT_DOUBLE_EQ(omega(i, k), omega_left(i, k));
+}
+
+TEST(NetProductionRatePerMass, arrhenius_perturbation)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  std::string chemFile(prefixPath + "chem.inp");
+  std::string thermFile(prefixPath + "therm.dat");
+  std::string inputFile(prefixPath + "input.dat");
+
+  TChem::KineticModelData kmd(chemFile, thermFile);
+  auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+
+  const ordinal_type nBatch(2);
+  const ordinal_type stateVecDim =
+    TChem::Impl::getStateVectorSize(kmcd.nSpec);
+
+  TChem::real_type_2d_view_host state("state", nBatch, stateVecDim);
+  {
+    auto state_at_0 = Kokkos::subview(state, 0, Kokkos::ALL());
+    TChem::Test::readStateVector(inputFile, kmcd.nSpec, state_at_0);
+    TChem::Test::cloneView(state);
+  }
+
+  /// sample 1 doubles all pre-exponential factors; forward and reverse
+  /// rate constants and falloff limits are scaled together, so the net
+  /// production rates are doubled
+  TChem::real_type_2d_view_host logA("logA", nBatch, kmcd.nReac);
+  for (ordinal_type j = 0; j < kmcd.nReac; ++j)
+    logA(1, j) = std::log(2.0);
+  kmcd.sampleLogAFactor = logA;
+
+  TChem::real_type_2d_view_host omega("omega", nBatch, kmcd.nSpec);
+  TChem::NetProductionRatePerMass::runHostBatch(nBatch, state, omega, kmcd);
+
+  for (ordinal_type k = 0; k < kmcd.nSpec; ++k)
+    EXPECT_NEAR(omega(1, k),
+                2 * omega(0, k),
+                1e-10 * std::abs(omega(0, k)) + 1e-15);
+}
+
+
+TEST(JacobianReduced, arrhenius_perturbation)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  std::string chemFile(prefixPath + "chem.inp");
+  std::string thermFile(prefixPath + "therm.dat");
+  std::string inputFile(prefixPath + "input.dat");
+
+  TChem::KineticModelData kmd(chemFile, thermFile);
+  auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+  const ordinal_type nSpec = kmcd.nSpec;
+
+  TChem::real_type_1d_view_host state(
+    "state", TChem::Impl::getStateVectorSize(nSpec));
+  TChem::Test::readStateVector(inputFile, nSpec, state);
+
+  /// sample 1 perturbs ln A and Ea/R of all reactions including falloff
+  /// and given reverse parameters
+  const ordinal_type nBatch(2);
+  TChem::real_type_2d_view_host logA("logA", nBatch, kmcd.nReac);
+  TChem::real_type_2d_view_host EaShift("EaShift", nBatch, kmcd.nReac);
+  for (ordinal_type j = 0; j < kmcd.nReac; ++j) {
+    logA(1, j) = j % 2 ? std::log(2.0) : -0.5;
+    EaShift(1, j) = j % 3 ? 1000 : -500;
+  }
+  kmcd.sampleLogAFactor = logA;
+  kmcd.sampleEaShift = EaShift;
+  const auto kmcd_at_1 = TChem::Impl::getKineticModelAtSample(kmcd, 1);
+
+  using problem_type = TChem::Impl::IgnitionZeroD_Problem<decltype(kmcd)>;
+  const ordinal_type m = problem_type::getNumberOfEquations(kmcd);
+  problem_type problem;
+  problem._p = state(1);
+  problem._kmcd = kmcd_at_1;
+  problem._work = TChem::real_type_1d_view_host(
+    "work", problem_type::getWorkSpaceSize(kmcd));
+
+  /// x = (T, Ys)
+  TChem::real_type_1d_view_host x("x", m);
+  for (ordinal_type k = 0; k < m; ++k)
+    x(k) = state(k + 2);
+
+  TChem::real_type_2d_view_host J("J", m, m), J_fd("J fd", m, m);
+  TChem::real_type_1d_view_host f_p("f p", m), f_m("f m", m);
+  using policy_type = Kokkos::TeamPolicy<TChem::host_exec_space>;
+  Kokkos::parallel_for(
+    policy_type(1, 1), [&](const typename policy_type::member_type& member) {
+      problem.computeJacobian(member, x, J);
+
+      /// central differences
+      for (ordinal_type j = 0; j < m; ++j) {
+        const real_type xj = x(j);
+        const real_type h = j == 0 ? 1e-6 * xj : 1e-7;
+        x(j) = xj + h;
+        problem.computeFunction(member, x, f_p);
+        x(j) = xj - h;
+        problem.computeFunction(member, x, f_m);
+        x(j) = xj;
+        for (ordinal_type i = 0; i < m; ++i)
+          J_fd(i, j) = (f_p(i) - f_m(i)) / (2 * h);
+      }
+    });
+
+  /// columns are compared in norm as the entries span many orders
+  for (ordinal_type j = 0; j < m; ++j) {
+    real_type norm(0), diff(0);
+    for (ordinal_type i = 0; i < m; ++i) {
+      norm += J_fd(i, j) * J_fd(i, j);
+      diff += (J(i, j) - J_fd(i, j)) * (J(i, j) - J_fd(i, j));
+    }
+    EXPECT_LE(std::sqrt(diff), 1e-4 * std::sqrt(norm) + 1e-10)
+      << "column " << j;
+  }
+}
+
+TEST(KForwardReverseMemo, memo_vs_direct)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  std::string chemFile(prefixPath + "chem.inp");
+  std::string thermFile(prefixPath + "therm.dat");
+  std::string inputFile(prefixPath + "input.dat");
+
+  TChem::KineticModelData kmd(chemFile, thermFile);
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+  const ordinal_type nSpec = kmcd.nSpec;
+  EXPECT_EQ(kmcd.memoRtol, real_type(0));
+
+  TChem::real_type_1d_view_host state(
+    "state", TChem::Impl::getStateVectorSize(nSpec));
+  TChem::Test::readStateVector(inputFile, nSpec, state);
+
+  using problem_type = TChem::Impl::IgnitionZeroD_Problem<decltype(kmcd)>;
+  const ordinal_type m = problem_type::getNumberOfEquations(kmcd);
+  problem_type problem[2];
+  for (ordinal_type r = 0; r < 2; ++r) {
+    problem[r]._p = state(1);
+    problem[r]._kmcd = kmcd;
+    problem[r]._work = TChem::real_type_1d_view_host(
+      "work", problem_type::getWorkSpaceSize(kmcd));
+  }
+  TChem::real_type_1d_view_host memo(
+    "memo", problem_type::getMemoWorkSpaceSize(kmcd));
+
+  /// x = (T, Ys); the sequence revisits temperatures so that problem 1
+  /// reuses memoized rate constants while problem 0 evaluates them
+  TChem::real_type_1d_view_host x("x", m);
+  for (ordinal_type k = 0; k < m; ++k)
+    x(k) = state(k + 2);
+
+  const ordinal_type num_evals(4);
+  TChem::real_type_1d_view_host f[2][num_evals];
+  TChem::real_type_2d_view_host J[2];
+  for (ordinal_type r = 0; r < 2; ++r) {
+    for (ordinal_type l = 0; l < num_evals; ++l)
+      f[r][l] = TChem::real_type_1d_view_host("f", m);
+    J[r] = TChem::real_type_2d_view_host("J", m, m);
+  }
+  using policy_type = Kokkos::TeamPolicy<TChem::host_exec_space>;
+  Kokkos::parallel_for(
+    policy_type(1, 1), [&](const typename policy_type::member_type& member) {
+      problem[1].setMemo(member, memo.data());
+      for (ordinal_type r = 0; r < 2; ++r) {
+        const real_type temperature = x(0), Y = x(1);
+        problem[r].computeFunction(member, x, f[r][0]);
+        x(1) = Y * (1 + 1e-6);
+        problem[r].computeFunction(member, x, f[r][1]);
+        x(1) = Y;
+        x(0) = temperature * (1 + 1e-12);
+        problem[r].computeFunction(member, x, f[r][2]);
+        x(0) = temperature;
+        problem[r].computeJacobian(member, x, J[r]);
+        problem[r].computeFunction(member, x, f[r][3]);
+      }
+    });
+
+  /// the default tolerance reuses rate constants only at the same
+  /// temperature; results are bit-identical
+  for (ordinal_type l = 0; l < num_evals; ++l)
+    for (ordinal_type i = 0; i < m; ++i)
+      EXPECT_EQ(f[1][l](i), f[0][l](i)) << "evaluation " << l << " row " << i;
+  for (ordinal_type i = 0; i < m; ++i)
+    for (ordinal_type j = 0; j < m; ++j)
+      EXPECT_EQ(J[1](i, j), J[0](i, j)) << "row " << i << " column " << j;
+
+  /// the tolerance set on the kinetic model reaches the memo
+  kmd.setKForwardReverseMemoTolerance(1e-8);
+  const auto kmcd_rtol = kmd.createConstData<TChem::host_exec_space>();
+  EXPECT_EQ(kmcd_rtol.memoRtol, real_type(1e-8));
+  problem[1]._kmcd = kmcd_rtol;
+  Kokkos::parallel_for(
+    policy_type(1, 1), [&](const typename policy_type::member_type& member) {
+      problem[1].setMemo(member, memo.data());
+    });
+  EXPECT_EQ(memo(0), real_type(1e-8));
+}
+
+TEST(KForwardReverse, rate_constant_table)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat");
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+  kmd.setRateConstantTable(64);
+  const auto kmcd_table = kmd.createConstData<TChem::host_exec_space>();
+  const ordinal_type nSpec = kmcd.nSpec, nReac = kmcd.nReac;
+
+  const real_type error = kmd.getRateConstantTableError();
+  EXPECT_GT(kmd.getRateConstantTableNumIntervals(), 0);
+  EXPECT_LE(error, 1e-6);
+
+  /// points off the grid and off the interval midpoints where the error is
+  /// measured, and points outside of the table range
+  const ordinal_type num_points(1000);
+  const real_type xmin = 1 / kmcd.TthrmMax, xmax = 1 / kmcd.TthrmMin;
+  std::vector<real_type> temperature;
+  for (ordinal_type k = 0; k <= num_points; ++k)
+    temperature.push_back(1 / (xmin + (xmax - xmin) * k / num_points));
+  temperature.push_back(kmcd.TthrmMin * 0.9);
+  temperature.push_back(kmcd.TthrmMax * 1.1);
+
+  TChem::real_type_1d_view_host gk("gk", nSpec), hks("hks", nSpec),
+    cpks("cpks", nSpec), iter("iter", 2 * nReac);
+  TChem::real_type_1d_view_host kfor("kfor", nReac), krev("krev", nReac);
+  TChem::real_type_1d_view_host kfor_table("kfor table", nReac),
+    krev_table("krev table", nReac);
+
+  /// the table bounds the error at the midpoints; the four point
+  /// interpolation error elsewhere is within a small factor of it
+  real_type max_error(0);
+  ordinal_type num_mismatch(0);
+  using policy_type = Kokkos::TeamPolicy<TChem::host_exec_space>;
+  for (const real_type t : temperature) {
+    Kokkos::parallel_for(
+      policy_type(1, 1), [&](const typename policy_type::member_type& member) {
+        TChem::Impl::Gk::team_invoke(member, t, gk, hks, cpks, kmcd);
+        TChem::Impl::KForwardReverse::team_invoke(
+          member, t, TChem::ATMPA, gk, kfor, krev, iter, kmcd);
+        TChem::Impl::Gk::team_invoke(member, t, gk, hks, cpks, kmcd_table);
+        TChem::Impl::KForwardReverse::team_invoke(member,
+                                                  t,
+                                                  TChem::ATMPA,
+                                                  gk,
+                                                  kfor_table,
+                                                  krev_table,
+                                                  iter,
+                                                  kmcd_table);
+      });
+    const bool in_range = t >= kmcd.TthrmMin && t <= kmcd.TthrmMax;
+    for (ordinal_type i = 0; i < nReac; ++i) {
+      if (in_range) {
+        if (kfor(i) > 0)
+          max_error = std::max(max_error,
+                               std::abs(std::log(kfor_table(i) / kfor(i))));
+        if (krev(i) > 0)
+          max_error = std::max(max_error,
+                               std::abs(std::log(krev_table(i) / krev(i))));
+        num_mismatch += (kfor(i) > 0) != (kfor_table(i) > 0);
+        num_mismatch += (krev(i) > 0) != (krev_table(i) > 0);
+      } else {
+        num_mismatch += kfor_table(i) != kfor(i) || krev_table(i) != krev(i);
+      }
+    }
+  }
+  EXPECT_EQ(num_mismatch, 0);
+  EXPECT_LE(max_error, 2 * error + 1e-12);
+}
+
+TEST(KForwardReverseSurface, precomputed_factors)
+{
+  const std::string prefixPath("../example/data/plug-flow-reactor/X/");
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat",
+                              prefixPath + "chemSurf.inp",
+                              prefixPath + "thermSurf.dat");
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+  const auto kmcdSurf = kmd.createConstSurfData<TChem::host_exec_space>();
+  const ordinal_type nReac = kmcdSurf.nReac;
+
+  /// the mechanism has sticking and reversible reactions
+  ordinal_type num_stick(0), num_rev(0);
+  for (ordinal_type i = 0; i < nReac; ++i) {
+    num_stick += kmcdSurf.isStick(i) == 1;
+    num_rev += kmcdSurf.isRev(i) != 0;
+  }
+  EXPECT_GT(num_stick, 0);
+  EXPECT_GT(num_rev, 0);
+
+  /// gibbs energies are inputs of the kernel; any values do
+  TChem::real_type_1d_view_host gk("gk", kmcd.nSpec);
+  TChem::real_type_1d_view_host gkSurf("gkSurf", kmcdSurf.nSpec);
+  for (ordinal_type k = 0; k < kmcd.nSpec; ++k)
+    gk(k) = real_type(0.3) * k - real_type(2);
+  for (ordinal_type k = 0; k < kmcdSurf.nSpec; ++k)
+    gkSurf(k) = real_type(1) - real_type(0.2) * k;
+
+  TChem::real_type_1d_view_host kfor("kfor", nReac), krev("krev", nReac);
+  using policy_type = Kokkos::TeamPolicy<TChem::host_exec_space>;
+  for (const real_type t : { 500.0, 900.0, 1400.0 }) {
+    const real_type p(TChem::ATMPA);
+    Kokkos::parallel_for(
+      policy_type(1, 1), [&](const typename policy_type::member_type& member) {
+        TChem::Impl::KForwardReverseSurface::team_invoke_detail(
+          member, t, p, gk, gkSurf, kfor, krev, kmcd, kmcdSurf);
+      });
+
+    /// direct evaluation scanning the species of each reaction
+    /// (eq 16.117 and 16.105 chapter 16 Robert J. Kee)
+    const ordinal_type joff = kmcdSurf.maxSpecInReac / 2;
+    for (ordinal_type i = 0; i < nReac; ++i) {
+      real_type kfor_ref =
+        kmcdSurf.reacArhenFor(i, 0) * std::pow(t, kmcdSurf.reacArhenFor(i, 1)) *
+        std::exp(-kmcdSurf.reacArhenFor(i, 2) / t);
+      if (kmcdSurf.isStick(i) == 1) {
+        real_type Wk(0);
+        ordinal_type m(0);
+        for (ordinal_type j = 0; j < kmcdSurf.reacNreac(i); ++j) {
+          if (kmcdSurf.reacSsrf(i, j) == 1)
+            m += std::abs(kmcdSurf.reacNuki(i, j));
+          else if (kmcdSurf.reacSsrf(i, j) == 0)
+            Wk = kmcd.sMass(kmcdSurf.reacSidx(i, j));
+        }
+        kfor_ref *= std::sqrt(kmcd.Rcgs * t / (TChem::DPI * Wk)) /
+                    std::pow(kmcdSurf.sitedensity, m);
+      }
+      EXPECT_NEAR(kfor(i), kfor_ref, 1e-12 * std::abs(kfor_ref))
+        << "reaction " << i << " at " << t;
+
+      real_type krev_ref(0);
+      if (kmcdSurf.isRev(i)) {
+        ordinal_type nusum(0), nusum2(0);
+        for (ordinal_type j = 0; j < kmcdSurf.reacNreac(i); ++j) {
+          if (kmcdSurf.reacSsrf(i, j) == 0)
+            nusum += kmcdSurf.reacNuki(i, j);
+          else if (kmcdSurf.reacSsrf(i, j) == 1)
+            nusum2 += kmcdSurf.reacNuki(i, j);
+        }
+        for (ordinal_type j = 0; j < kmcdSurf.reacNprod(i); ++j) {
+          if (kmcdSurf.reacSsrf(i, j + joff) == 0)
+            nusum += kmcdSurf.reacNuki(i, j + joff);
+          else if (kmcdSurf.reacSsrf(i, j + joff) == 1)
+            nusum2 += kmcdSurf.reacNuki(i, j + joff);
+        }
+        EXPECT_EQ(kmcdSurf.kcNuSum(i), nusum) << "reaction " << i;
+        const real_type sumNuGk =
+          TChem::Impl::SumNuGk::serial_invoke(i, gk, gkSurf, kmcdSurf);
+        const real_type kc =
+          std::pow(TChem::ATMPA * 10 / (kmcd.Rcgs * t), nusum) *
+          std::pow(kmcdSurf.sitedensity, nusum2) * std::exp(sumNuGk);
+        krev_ref = kfor_ref / kc;
+      }
+      EXPECT_NEAR(krev(i), krev_ref, 1e-12 * std::abs(krev_ref))
+        << "reaction " << i << " at " << t;
+    }
+  }
+}
+
+TEST(NetProductionRatePerMass, mixed_mechanisms)
+{
+  const std::string prefixPath[2] = { "../example/data/reaction-rates/",
+                                      "../example/data/ignition-zero-d/" };
+
+  TChem::KineticModelData kmd0(prefixPath[0] + "chem.inp",
+                               prefixPath[0] + "therm.dat");
+  TChem::KineticModelData kmd1(prefixPath[1] + "chem.inp",
+                               prefixPath[1] + "therm.dat");
+  const TChem::KineticModelConstDataHost kmcd[2] = {
+    kmd0.createConstData<TChem::host_exec_space>(),
+    kmd1.createConstData<TChem::host_exec_space>()
+  };
+  const auto kmcds = TChem::createConstDataArray<TChem::host_exec_space>(
+    { kmcd[0], kmcd[1] });
+
+  /// reference rates of each mechanism run separately
+  TChem::real_type_2d_view_host state_ref[2], omega_ref[2];
+  for (ordinal_type m = 0; m < 2; ++m) {
+    state_ref[m] = TChem::real_type_2d_view_host(
+      "state ref", 1, TChem::Impl::getStateVectorSize(kmcd[m].nSpec));
+    omega_ref[m] =
+      TChem::real_type_2d_view_host("omega ref", 1, kmcd[m].nSpec);
+    auto state_at_0 = Kokkos::subview(state_ref[m], 0, Kokkos::ALL());
+    TChem::Test::readStateVector(
+      prefixPath[m] + "input.dat", kmcd[m].nSpec, state_at_0);
+    TChem::NetProductionRatePerMass::runHostBatch(
+      1, state_ref[m], omega_ref[m], kmcd[m]);
+  }
+
+  /// samples alternate the mechanisms in one launch
+  const ordinal_type nBatch(4);
+  const ordinal_type nSpecMax = std::max(kmcd[0].nSpec, kmcd[1].nSpec);
+  TChem::ordinal_type_1d_view_host mechanism("mechanism", nBatch);
+  TChem::real_type_2d_view_host state(
+    "state", nBatch, TChem::Impl::getStateVectorSize(nSpecMax));
+  TChem::real_type_2d_view_host omega("omega", nBatch, nSpecMax);
+  for (ordinal_type i = 0; i < nBatch; ++i) {
+    const ordinal_type m = i % 2;
+    mechanism(i) = m;
+    for (ordinal_type k = 0, kend = state_ref[m].extent(1); k < kend; ++k)
+      state(i, k) = state_ref[m](0, k);
+  }
+  TChem::NetProductionRatePerMass::runHostBatch(
+    mechanism, state, omega, kmcds);
+
+  for (ordinal_type i = 0; i < nBatch; ++i) {
+    const ordinal_type m = mechanism(i);
+    for (ordinal_type k = 0; k < kmcd[m].nSpec; ++k)
+      EXPECT_DOUBLE_EQ(omega(i, k), omega_ref[m](0, k));
+    for (ordinal_type k = kmcd[m].nSpec; k < nSpecMax; ++k)
+      EXPECT_EQ(omega(i, k), 0);
+  }
+}
+
+TEST(DirectedRelationGraph, species_on_both_sides)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat");
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+  const ordinal_type nSpec = kmcd.nSpec, nReac = kmcd.nReac;
+  using drg_type = TChem::Impl::DirectedRelationGraph;
+
+  /// gri3.0 has H+O2+H2O<=>HO2+H2O with H2O on both sides
+  ordinal_type iH2O(-1);
+  for (ordinal_type k = 0; k < nSpec; ++k)
+    if (std::string(&kmcd.speciesNames(k, 0)) == "H2O")
+      iH2O = k;
+  ASSERT_GE(iH2O, 0);
+  ordinal_type num_both_sides(0);
+  for (ordinal_type i = 0; i < nReac; ++i) {
+    const ordinal_type n = kmcd.reacNreac(i) + kmcd.reacNprod(i);
+    ordinal_type cnt(0);
+    for (ordinal_type j = 0; j < n; ++j)
+      cnt += drg_type::getSpeciesIndex(kmcd, i, j) == iH2O;
+    num_both_sides += cnt > 1;
+  }
+  ASSERT_GT(num_both_sides, 0);
+
+  /// with unit rates of progress, every reaction of a contributes
+  /// |nu_a| / denom(a) to each of its species once; so r_aa = 1 and
+  /// r_aB <= 1 for all species a
+  TChem::real_type_1d_view_host rop("rop", nReac), denom("denom", nSpec),
+    numer("numer", nSpec);
+  Kokkos::deep_copy(rop, real_type(1));
+  using policy_type = Kokkos::TeamPolicy<TChem::host_exec_space>;
+  for (ordinal_type a = 0; a < nSpec; ++a) {
+    Kokkos::parallel_for(
+      policy_type(1, 1), [&](const typename policy_type::member_type& member) {
+        drg_type::team_invoke_denominator(member, rop, denom, kmcd);
+        drg_type::team_invoke_interaction_coefficients(
+          member, a, rop, denom, numer, kmcd);
+      });
+    if (denom(a) > 0)
+      EXPECT_NEAR(numer(a), 1, 1e-12) << "species " << a;
+    for (ordinal_type k = 0; k < nSpec; ++k)
+      EXPECT_LE(numer(k), 1 + 1e-12) << "species " << a << " to " << k;
+  }
+}
+
+TEST(NetProductionRatePerMass, plan)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat");
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+
+  const ordinal_type nBatch(3);
+  TChem::real_type_2d_view_host state(
+    "state", nBatch, TChem::Impl::getStateVectorSize(kmcd.nSpec));
+  auto state_at_0 = Kokkos::subview(state, 0, Kokkos::ALL());
+  TChem::Test::readStateVector(
+    prefixPath + "input.dat", kmcd.nSpec, state_at_0);
+  TChem::Test::cloneView(state);
+  for (ordinal_type i = 1; i < nBatch; ++i)
+    state(i, 2) += 100 * i;
+
+  TChem::real_type_2d_view_host omega_ref("omega ref", nBatch, kmcd.nSpec),
+    omega("omega", nBatch, kmcd.nSpec);
+  TChem::NetProductionRatePerMass::runHostBatch(
+    nBatch, state, omega_ref, kmcd);
+
+  /// the plan is built once and executed repeatedly with the same result
+  TChem::NetProductionRatePerMass::Plan<TChem::host_exec_space> plan(kmcd,
+                                                                     nBatch);
+  for (ordinal_type r = 0; r < 2; ++r) {
+    Kokkos::deep_copy(omega, real_type(0));
+    plan.execute(state, omega);
+    for (ordinal_type i = 0; i < nBatch; ++i)
+      for (ordinal_type k = 0; k < kmcd.nSpec; ++k)
+        EXPECT_DOUBLE_EQ(omega(i, k), omega_ref(i, k));
+  }
+}
+
+TEST(TeamPolicyTuner, cache)
+{
+  const std::string prefixPath[2] = { "../example/data/reaction-rates/",
+                                      "../example/data/ignition-zero-d/" };
+  TChem::KineticModelData kmd(prefixPath[0] + "chem.inp",
+                              prefixPath[0] + "therm.dat");
+  TChem::KineticModelData kmd_other(prefixPath[1] + "chem.inp",
+                                    prefixPath[1] + "therm.dat");
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+  const auto kmcd_other = kmd_other.createConstData<TChem::host_exec_space>();
+
+  const ordinal_type nBatch(8);
+  TChem::real_type_2d_view_host state(
+    "state", nBatch, TChem::Impl::getStateVectorSize(kmcd.nSpec));
+  auto state_at_0 = Kokkos::subview(state, 0, Kokkos::ALL());
+  TChem::Test::readStateVector(
+    prefixPath[0] + "input.dat", kmcd.nSpec, state_at_0);
+  TChem::Test::cloneView(state);
+  TChem::real_type_2d_view_host omega_ref("omega ref", nBatch, kmcd.nSpec),
+    omega("omega", nBatch, kmcd.nSpec);
+  TChem::NetProductionRatePerMass::runHostBatch(
+    nBatch, state, omega_ref, kmcd);
+
+  using policy_type =
+    typename TChem::UseThisTeamPolicy<TChem::host_exec_space>::type;
+  const ordinal_type per_team_scratch =
+    TChem::Scratch<TChem::real_type_1d_view_host>::shmem_size(
+      TChem::NetProductionRatePerMass::getWorkSpaceSize(kmcd));
+  ordinal_type num_runs(0);
+  const auto run = [&](policy_type& p) {
+    ++num_runs;
+    TChem::NetProductionRatePerMass::runHostBatch(p, state, omega, kmcd);
+  };
+
+  /// the key depends on the mechanism
+  const std::string name("NetProductionRatePerMass");
+  const std::string key = TChem::TeamPolicyTuner::getKey(name, kmcd);
+  EXPECT_EQ(key, TChem::TeamPolicyTuner::getKey(name, kmcd));
+  EXPECT_NE(key, TChem::TeamPolicyTuner::getKey(name, kmcd_other));
+
+  /// the first tuner calibrates and appends the winner to the cache file
+  const std::string filename("tchem-tuning-test.dat");
+  std::remove(filename.c_str());
+  {
+    TChem::TeamPolicyTuner tuner(filename, 4, 1);
+    policy_type policy =
+      tuner.getPolicy(name, kmcd, nBatch, per_team_scratch, run);
+    EXPECT_GT(num_runs, 0);
+    EXPECT_EQ(ordinal_type(policy.league_size()), nBatch);
+
+    Kokkos::deep_copy(omega, real_type(0));
+    TChem::NetProductionRatePerMass::runHostBatch(policy, state, omega, kmcd);
+    for (ordinal_type i = 0; i < nBatch; ++i)
+      for (ordinal_type k = 0; k < kmcd.nSpec; ++k)
+        EXPECT_DOUBLE_EQ(omega(i, k), omega_ref(i, k));
+  }
+
+  /// a second tuner reads the file and does not calibrate again
+  {
+    std::ifstream file(filename);
+    std::string line;
+    ordinal_type num_entries(0);
+    while (std::getline(file, line))
+      num_entries += line.compare(0, key.size(), key) == 0;
+    EXPECT_EQ(num_entries, 1);
+  }
+  num_runs = 0;
+  {
+    TChem::TeamPolicyTuner tuner(filename, 4, 1);
+    policy_type policy =
+      tuner.getPolicy(name, kmcd, nBatch, per_team_scratch, run);
+    EXPECT_EQ(num_runs, 0);
+    EXPECT_EQ(ordinal_type(policy.league_size()), nBatch);
+  }
+  std::remove(filename.c_str());
+}
+
+#if defined(TCHEM_ENABLE_PROFILING)
+TEST(Profiler, team_scope_and_collector)
+{
+  using region_type = TChem::ProfilerRegion;
+  auto& profiler = TChem::Profiler::getInstance();
+  profiler.reset();
+
+  /// the team leader records one call per scope
+  const ordinal_type nTeam(3);
+  using policy_type = Kokkos::TeamPolicy<TChem::host_exec_space>;
+  Kokkos::parallel_for(
+    policy_type(nTeam, 1),
+    [&](const typename policy_type::member_type& member) {
+      TCHEM_PROFILE_TEAM_SCOPE(member, Factorization);
+    });
+  Kokkos::fence();
+  {
+    const auto summary = profiler.getSummary();
+    ASSERT_EQ(summary.size(), size_t(region_type::NumRegions));
+    for (ordinal_type i = 0; i < region_type::NumRegions; ++i) {
+      EXPECT_EQ(summary[i].count,
+                i == ordinal_type(region_type::Factorization)
+                  ? (unsigned long long)(nTeam)
+                  : 0ull);
+      EXPECT_GE(summary[i].seconds, 0.0);
+    }
+  }
+
+  /// kernel scopes are inclusive; reaction rates contain rate of progress
+  std::string prefixPath="../example/data/reaction-rates/";
+  std::string chemFile(prefixPath + "chem.inp");
+  std::string thermFile(prefixPath + "therm.dat");
+  std::string inputFile(prefixPath + "input.dat");
+
+  TChem::KineticModelData kmd(chemFile, thermFile);
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+
+  const ordinal_type nBatch(4);
+  const ordinal_type stateVecDim =
+    TChem::Impl::getStateVectorSize(kmcd.nSpec);
+  TChem::real_type_2d_view_host state("state", nBatch, stateVecDim);
+  {
+    auto state_at_0 = Kokkos::subview(state, 0, Kokkos::ALL());
+    TChem::Test::readStateVector(inputFile, kmcd.nSpec, state_at_0);
+    TChem::Test::cloneView(state);
+  }
+  TChem::real_type_2d_view_host omega("omega", nBatch, kmcd.nSpec);
+
+  profiler.reset();
+  TChem::NetProductionRatePerMass::runHostBatch(nBatch, state, omega, kmcd);
+  Kokkos::fence();
+  {
+    const auto summary = profiler.getSummary();
+    const auto& rates = summary[region_type::ReactionRates];
+    const auto& rop = summary[region_type::RateOfProgress];
+    EXPECT_EQ(rates.count, (unsigned long long)(nBatch));
+    EXPECT_EQ(rop.count, (unsigned long long)(nBatch));
+    EXPECT_GE(rates.seconds, rop.seconds);
+    EXPECT_EQ(summary[region_type::NewtonSolver].count, 0ull);
+    EXPECT_EQ(summary[region_type::Factorization].count, 0ull);
+  }
+
+  /// json lists every region with its name and call count
+  const std::string filename("profiler-test.json");
+  profiler.writeJSON(filename);
+  {
+    std::ifstream file(filename);
+    ASSERT_TRUE(file.is_open());
+    std::stringstream ss;
+    ss << file.rdbuf();
+    const std::string json = ss.str();
+    for (ordinal_type i = 0; i < region_type::NumRegions; ++i)
+      EXPECT_NE(json.find(std::string("\"name\": \"") +
+                          region_type::getName(i) + "\""),
+                std::string::npos);
+    EXPECT_NE(json.find("\"name\": \"ReactionRates\", \"calls\": " +
+                        std::to_string(nBatch) + ","),
+              std::string::npos);
+  }
+  std::remove(filename.c_str());
+
+  /// reset clears the slots of all threads
+  profiler.reset();
+  for (const auto& s : profiler.getSummary()) {
+    EXPECT_EQ(s.count, 0ull);
+    EXPECT_EQ(s.seconds, 0.0);
+  }
+}
+#endif
+
 #endif
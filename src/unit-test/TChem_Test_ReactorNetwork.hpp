@@ -0,0 +1,174 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_TEST_REACTORNETWORK_HPP__
+#define __TCHEM_TEST_REACTORNETWORK_HPP__
+
+#include "TChem_KineticModelData.hpp"
+#include "TChem_ReactorNetwork.hpp"
+#include "TChem_SampleFileReader.hpp"
+
+/// a stirred tank followed by a plug flow reactor on the methane/argon case;
+/// the site fractions of the stirred tank are given per sample
+static inline void
+executeReactorNetwork(const TChem::KineticModelConstDataDevice& kmcd,
+                      const TChem::KineticSurfModelConstDataDevice& kmcdSurf,
+                      const TChem::real_type_2d_view_host& zSurf_cstr,
+                      const TChem::real_type_2d_view_host& zSurf_pfr,
+                      const TChem::real_type_2d_view& state,
+                      const TChem::real_type_1d_view& mdot,
+                      const TChem::ordinal_type_1d_view& status,
+                      std::vector<TChem::real_type_2d_view>& outlets)
+{
+  const ordinal_type nBatch = state.extent(0);
+
+  TChem::time_advance_type tadv_default;
+  tadv_default._dt = 1e-10;
+  tadv_default._dtmin = 1e-10;
+  tadv_default._dtmax = 1e-4;
+  tadv_default._max_num_newton_iterations = 100;
+  tadv_default._num_time_iterations_per_interval = 100;
+
+  TChem::ReactorNetwork network(
+    kmcd, kmcdSurf, nBatch, 1e-12, 1e-6, 1e-12, 1e-6, tadv_default, 1000);
+
+  TChem::ReactorNetworkStage cstr;
+  cstr.type = TChem::ReactorNetworkStage::TransientContStirredTankReactor;
+  cstr.tend = 1e-3;
+  cstr.Vol = 1.347e-4;
+  cstr.Acat = 1.3074e-3;
+  cstr.zSurf =
+    TChem::real_type_2d_view("SiteFraction", nBatch, kmcdSurf.nSpec);
+  Kokkos::deep_copy(cstr.zSurf, zSurf_cstr);
+  network.addStage(cstr);
+
+  TChem::ReactorNetworkStage pfr;
+  pfr.type = TChem::ReactorNetworkStage::PlugFlowReactor;
+  pfr.tend = 1e-3;
+  pfr.Area = 5.3e-4;
+  pfr.Pcat = 2.5977e-2;
+  pfr.zSurf =
+    TChem::real_type_2d_view("SiteFraction", nBatch, kmcdSurf.nSpec);
+  Kokkos::deep_copy(pfr.zSurf, zSurf_pfr);
+  network.addStage(pfr);
+
+  network.execute(state, mdot, status);
+
+  outlets.clear();
+  for (ordinal_type s = 0; s < network.getNumberOfStages(); ++s)
+    outlets.push_back(network.getOutletState(s));
+}
+
+TEST(ReactorNetwork, failed_sample)
+{
+  const std::string prefixPath("../example/data/plug-flow-reactor/X/");
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat",
+                              prefixPath + "chemSurf.inp",
+                              prefixPath + "thermSurf.dat");
+  const auto kmcd = kmd.createConstData<TChem::exec_space>();
+  const auto kmcdSurf = kmd.createConstSurfData<TChem::exec_space>();
+
+  TChem::real_type_2d_view inlet, state_sample, siteFraction;
+  readTransientContStirredTankReactorSample(prefixPath,
+                                            kmcd,
+                                            kmcdSurf,
+                                            850,
+                                            inlet,
+                                            state_sample,
+                                            siteFraction);
+
+  /// two copies of the sample
+  const ordinal_type nBatch(2), stateVecDim = inlet.extent(1),
+                     nSpecSurf = kmcdSurf.nSpec;
+  TChem::real_type_2d_view_host state_host("state", nBatch, stateVecDim);
+  TChem::real_type_2d_view_host zSurf_host("SiteFraction", nBatch, nSpecSurf);
+  {
+    const auto inlet_host = Kokkos::create_mirror_view(inlet);
+    const auto siteFraction_host = Kokkos::create_mirror_view(siteFraction);
+    Kokkos::deep_copy(inlet_host, inlet);
+    Kokkos::deep_copy(siteFraction_host, siteFraction);
+    for (ordinal_type i = 0; i < nBatch; ++i) {
+      for (ordinal_type k = 0; k < stateVecDim; ++k)
+        state_host(i, k) = inlet_host(0, k);
+      for (ordinal_type k = 0; k < nSpecSurf; ++k)
+        zSurf_host(i, k) = siteFraction_host(0, k);
+    }
+  }
+  const real_type mdotIn(3.597e-6);
+
+  /// the second sample starts the surface steady state of the stirred tank
+  /// from invalid site fractions and fails at the first stage
+  TChem::real_type_2d_view_host zSurf_failed("SiteFraction", nBatch, nSpecSurf);
+  Kokkos::deep_copy(zSurf_failed, zSurf_host);
+  for (ordinal_type k = 0; k < nSpecSurf; ++k)
+    zSurf_failed(1, k) = std::numeric_limits<real_type>::quiet_NaN();
+
+  TChem::real_type_2d_view state[2];
+  TChem::real_type_1d_view mdot[2];
+  TChem::ordinal_type_1d_view status[2];
+  std::vector<TChem::real_type_2d_view> outlets[2];
+  for (ordinal_type r = 0; r < 2; ++r) {
+    state[r] = TChem::real_type_2d_view("state", nBatch, stateVecDim);
+    mdot[r] = TChem::real_type_1d_view("mass flow rate", nBatch);
+    status[r] = TChem::ordinal_type_1d_view("status", nBatch);
+    Kokkos::deep_copy(state[r], state_host);
+    Kokkos::deep_copy(mdot[r], mdotIn);
+    executeReactorNetwork(kmcd,
+                          kmcdSurf,
+                          r == 0 ? zSurf_host : zSurf_failed,
+                          zSurf_host,
+                          state[r],
+                          mdot[r],
+                          status[r],
+                          outlets[r]);
+  }
+
+  TChem::ordinal_type_1d_view_host status_host[2];
+  TChem::real_type_1d_view_host mdot_host[2];
+  for (ordinal_type r = 0; r < 2; ++r) {
+    status_host[r] = Kokkos::create_mirror_view(status[r]);
+    mdot_host[r] = Kokkos::create_mirror_view(mdot[r]);
+    Kokkos::deep_copy(status_host[r], status[r]);
+    Kokkos::deep_copy(mdot_host[r], mdot[r]);
+  }
+  EXPECT_EQ(status_host[0](0), -1);
+  EXPECT_EQ(status_host[0](1), -1);
+  EXPECT_EQ(status_host[1](0), -1);
+  EXPECT_EQ(status_host[1](1), 0);
+  EXPECT_EQ(mdot_host[1](1), real_type(0));
+  EXPECT_EQ(mdot_host[1](0), mdot_host[0](0));
+
+  /// the failed sample carries a zero state through the network and does
+  /// not change the other sample
+  for (ordinal_type s = 0, send = outlets[0].size(); s < send; ++s) {
+    const auto outlet_host = Kokkos::create_mirror_view(outlets[0][s]);
+    const auto outlet_failed_host = Kokkos::create_mirror_view(outlets[1][s]);
+    Kokkos::deep_copy(outlet_host, outlets[0][s]);
+    Kokkos::deep_copy(outlet_failed_host, outlets[1][s]);
+    EXPECT_GT(outlet_host(0, 2), real_type(0));
+    for (ordinal_type k = 0; k < stateVecDim; ++k) {
+      EXPECT_EQ(outlet_failed_host(0, k), outlet_host(0, k));
+      EXPECT_EQ(outlet_failed_host(1, k), real_type(0));
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,122 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_TEST_THERMO_HPP__
+#define __TCHEM_TEST_THERMO_HPP__
+
+#include "TChem_EnthalpyMass.hpp"
+#include "TChem_EntropyMass.hpp"
+#include "TChem_InternalEnergyMass.hpp"
+#include "TChem_KineticModelData.hpp"
+#include "TChem_SpecificHeatCapacityConsVolumePerMass.hpp"
+#include "TChem_SpecificHeatCapacityPerMass.hpp"
+#include "TChem_ThermalProperties.hpp"
+
+TEST(ThermalProperties, fused_vs_separate)
+{
+  std::string prefixPath="../example/data/reaction-rates/";
+  std::string chemFile(prefixPath + "chem.inp");
+  std::string thermFile(prefixPath + "therm.dat");
+  std::string inputFile(prefixPath + "input.dat");
+
+  TChem::KineticModelData kmd(chemFile, thermFile);
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+
+  /// temperatures cross the midpoint of the nasa polynomials
+  const ordinal_type nBatch(10), nSpec(kmcd.nSpec);
+  TChem::real_type_2d_view_host state(
+    "state", nBatch, TChem::Impl::getStateVectorSize(nSpec));
+  {
+    auto state_at_0 = Kokkos::subview(state, 0, Kokkos::ALL());
+    TChem::Test::readStateVector(inputFile, nSpec, state_at_0);
+    TChem::Test::cloneView(state);
+    for (ordinal_type i = 0; i < nBatch; ++i)
+      state(i, 2) = 300 + 250 * i;
+  }
+
+  using policy_type =
+    typename TChem::UseThisTeamPolicy<TChem::host_exec_space>::type;
+  policy_type policy(TChem::host_exec_space(), nBatch, Kokkos::AUTO());
+  {
+    const ordinal_type level = 1;
+    const ordinal_type per_team_extent =
+      std::max(TChem::ThermalProperties::getWorkSpaceSize(kmcd), nSpec);
+    policy.set_scratch_size(
+      level,
+      Kokkos::PerTeam(
+        TChem::Scratch<TChem::real_type_1d_view_host>::shmem_size(
+          per_team_extent)));
+  }
+
+  /// separate kernels
+  TChem::real_type_2d_view_host cp("cp", nBatch, nSpec),
+    h("h", nBatch, nSpec), s("s", nBatch, nSpec), u("u", nBatch, nSpec);
+  TChem::real_type_1d_view_host cpmix("cpmix", nBatch),
+    cvmix("cvmix", nBatch), hmix("hmix", nBatch), smix("smix", nBatch),
+    umix("umix", nBatch);
+  TChem::SpecificHeatCapacityPerMass::runHostBatch(
+    policy, state, cp, cpmix, kmcd);
+  TChem::SpecificHeatCapacityConsVolumePerMass::runHostBatch(
+    policy, state, cvmix, kmcd);
+  TChem::EnthalpyMass::runHostBatch(policy, state, h, hmix, kmcd);
+  TChem::EntropyMass::runHostBatch(policy, state, s, smix, kmcd);
+  TChem::InternalEnergyMass::runHostBatch(policy, state, u, umix, kmcd);
+
+  /// fused kernel
+  TChem::real_type_2d_view_host cp_f("cp fused", nBatch, nSpec),
+    cv_f("cv fused", nBatch, nSpec), h_f("h fused", nBatch, nSpec),
+    s_f("s fused", nBatch, nSpec), u_f("u fused", nBatch, nSpec);
+  TChem::real_type_1d_view_host cpmix_f("cpmix fused", nBatch),
+    cvmix_f("cvmix fused", nBatch), hmix_f("hmix fused", nBatch),
+    smix_f("smix fused", nBatch), umix_f("umix fused", nBatch);
+  TChem::ThermalProperties::runHostBatch(policy,
+                                         TChem::ThermalProperties::All,
+                                         state,
+                                         cp_f,
+                                         cpmix_f,
+                                         cv_f,
+                                         cvmix_f,
+                                         h_f,
+                                         hmix_f,
+                                         s_f,
+                                         smix_f,
+                                         u_f,
+                                         umix_f,
+                                         kmcd);
+
+  auto expect_near = [](const real_type a, const real_type b) {
+    EXPECT_NEAR(a, b, 1e-12 * std::abs(b) + 1e-12);
+  };
+  for (ordinal_type i = 0; i < nBatch; ++i) {
+    expect_near(cpmix_f(i), cpmix(i));
+    expect_near(cvmix_f(i), cvmix(i));
+    expect_near(hmix_f(i), hmix(i));
+    expect_near(smix_f(i), smix(i));
+    expect_near(umix_f(i), umix(i));
+    for (ordinal_type k = 0; k < nSpec; ++k) {
+      expect_near(cp_f(i, k), cp(i, k));
+      expect_near(h_f(i, k), h(i, k));
+      expect_near(s_f(i, k), s(i, k));
+      expect_near(u_f(i, k), u(i, k));
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,539 @@
+/* =====================================================================================
+TChem version 2.0
+Copyright (2020) NTESS
+https://github.com/sandialabs/TChem
+
+Copyright 2020 National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains
+certain rights in this software.
+
+This file is part of TChem. TChem is open source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the licese is also
+provided under the main directory
+
+Questions? Contact Cosmin Safta at <csafta@sandia.gov>, or
+           Kyungjoo Kim at <kyukim@sandia.gov>, or
+           Oscar Diaz-Ibarra at <odiazib@sandia.gov>
+
+Sandia National Laboratories, Livermore, CA, USA
+===================================================================================== */
+#ifndef __TCHEM_TEST_TRANSIENTCONTSTIRREDTANKREACTOR_HPP__
+#define __TCHEM_TEST_TRANSIENTCONTSTIRREDTANKREACTOR_HPP__
+
+#include "TChem_EnthalpyMass.hpp"
+#include "TChem_KineticModelData.hpp"
+#include "TChem_SampleFileReader.hpp"
+#include "TChem_SimpleSurface.hpp"
+#include "TChem_SurfaceSteadyState.hpp"
+#include "TChem_TransientContStirredTankReactor.hpp"
+#include "TChem_TransientContStirredTankReactorSteadyState.hpp"
+
+using cstr_problem_type = TChem::Impl::TransientContStirredTankReactor_Problem<
+  TChem::KineticModelConstDataDevice,
+  TChem::KineticSurfModelConstDataDevice,
+  TChem::cstr_data_type>;
+
+/// lean methane in argon at 850K; the reactor content starts at
+/// temperature_init (same pressure and composition) so that both the
+/// transient run and the steady state solver land on the burning branch
+static inline void
+readTransientContStirredTankReactorSample(
+  const std::string& prefixPath,
+  const TChem::KineticModelConstDataDevice& kmcd,
+  const TChem::KineticSurfModelConstDataDevice& kmcdSurf,
+  const real_type temperature_init,
+  TChem::real_type_2d_view& inlet,
+  TChem::real_type_2d_view& state,
+  TChem::real_type_2d_view& siteFraction)
+{
+  const auto speciesNamesHost = Kokkos::create_mirror_view(kmcd.speciesNames);
+  const auto sMassHost = Kokkos::create_mirror_view(kmcd.sMass);
+  const auto surfSpeciesNamesHost =
+    Kokkos::create_mirror_view(kmcdSurf.speciesNames);
+  Kokkos::deep_copy(speciesNamesHost, kmcd.speciesNames);
+  Kokkos::deep_copy(sMassHost, kmcd.sMass);
+  Kokkos::deep_copy(surfSpeciesNamesHost, kmcdSurf.speciesNames);
+
+  int nBatch(0);
+  TChem::real_type_2d_view_host state_host, siteFraction_host;
+  TChem::Test::readSample(prefixPath + "sample.dat",
+                          speciesNamesHost,
+                          sMassHost,
+                          kmcd.nSpec,
+                          TChem::Impl::getStateVectorSize(kmcd.nSpec),
+                          state_host,
+                          nBatch);
+  TChem::Test::readSurfaceSample(prefixPath + "inputSurf.dat",
+                                 surfSpeciesNamesHost,
+                                 kmcdSurf.nSpec,
+                                 siteFraction_host,
+                                 nBatch);
+
+  inlet = TChem::real_type_2d_view(
+    "inlet", state_host.extent(0), state_host.extent(1));
+  Kokkos::deep_copy(inlet, state_host);
+
+  for (ordinal_type i = 0; i < nBatch; ++i) {
+    state_host(i, 0) *= state_host(i, 2) / temperature_init;
+    state_host(i, 2) = temperature_init;
+  }
+  state = TChem::real_type_2d_view(
+    "state", state_host.extent(0), state_host.extent(1));
+  siteFraction = TChem::real_type_2d_view(
+    "site fraction", siteFraction_host.extent(0), siteFraction_host.extent(1));
+  Kokkos::deep_copy(state, state_host);
+  Kokkos::deep_copy(siteFraction, siteFraction_host);
+}
+
+/// reactor fed with the first inlet sample; tau is the residence time at
+/// the inlet density. the catalytic area is zero so that the gas phase sets
+/// the ignition and extinction branches
+static inline TChem::cstr_data_type
+getTransientContStirredTankReactorData(
+  const TChem::KineticModelConstDataDevice& kmcd,
+  const TChem::real_type_2d_view& inlet,
+  const real_type tau)
+{
+  const ordinal_type nSpec = kmcd.nSpec;
+  const auto inlet_host = Kokkos::create_mirror_view(inlet);
+  Kokkos::deep_copy(inlet_host, inlet);
+
+  TChem::cstr_data_type cstr;
+  cstr.Vol = 1.347e-4;
+  cstr.Acat = 0;
+  cstr.mdotIn = inlet_host(0, 0) * cstr.Vol / tau;
+  cstr.pressure = inlet_host(0, 1);
+
+  cstr.Yi = TChem::real_type_1d_view("Mass fraction at inlet", nSpec);
+  {
+    const auto Yi_host = Kokkos::create_mirror_view(cstr.Yi);
+    for (ordinal_type k = 0; k < nSpec; ++k)
+      Yi_host(k) = inlet_host(0, k + 3);
+    Kokkos::deep_copy(cstr.Yi, Yi_host);
+  }
+  {
+    TChem::real_type_2d_view EnthalpyMass("EnthalpyMass", 1, nSpec);
+    TChem::real_type_1d_view EnthalpyMixMass("EnthalpyMass Mixture", 1);
+    TChem::EnthalpyMass::runDeviceBatch(
+      TChem::exec_space(), -1, -1, 1, inlet, EnthalpyMass, EnthalpyMixMass, kmcd);
+    const auto EnthalpyMixMass_host =
+      Kokkos::create_mirror_view(EnthalpyMixMass);
+    Kokkos::deep_copy(EnthalpyMixMass_host, EnthalpyMixMass);
+    cstr.EnthalpyIn = EnthalpyMixMass_host(0);
+  }
+  return cstr;
+}
+
+static inline typename TChem::UseThisTeamPolicy<TChem::exec_space>::type
+getTransientContStirredTankReactorPolicy(const ordinal_type nBatch,
+                                         const ordinal_type per_team_extent)
+{
+  using policy_type =
+    typename TChem::UseThisTeamPolicy<TChem::exec_space>::type;
+  policy_type policy(TChem::exec_space(), nBatch, Kokkos::AUTO());
+  const ordinal_type level = 1;
+  const ordinal_type per_team_scratch =
+    TChem::Scratch<TChem::real_type_1d_view>::shmem_size(per_team_extent);
+  policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+  return policy;
+}
+
+static inline TChem::real_type_1d_view
+getTransientContStirredTankReactorNewtonTolerance()
+{
+  TChem::real_type_1d_view tol_newton("tol newton", 2);
+  const auto tol_newton_host = Kokkos::create_mirror_view(tol_newton);
+  tol_newton_host(0) = 1e-12;
+  tol_newton_host(1) = 1e-8;
+  Kokkos::deep_copy(tol_newton, tol_newton_host);
+  return tol_newton;
+}
+
+/// state and siteFraction are overwritten with the solution at tend;
+/// returns false when the time integrator fails
+static inline bool
+advanceTransientContStirredTankReactor(
+  const TChem::KineticModelConstDataDevice& kmcd,
+  const TChem::KineticSurfModelConstDataDevice& kmcdSurf,
+  const TChem::cstr_data_type& cstr,
+  const real_type tend,
+  const TChem::real_type_2d_view& state,
+  const TChem::real_type_2d_view& siteFraction)
+{
+  const ordinal_type nBatch = state.extent(0);
+
+  const auto tol_newton = getTransientContStirredTankReactorNewtonTolerance();
+  TChem::real_type_2d_view tol_time(
+    "tol time", cstr_problem_type::getNumberOfTimeODEs(kmcd, kmcdSurf), 2);
+  {
+    const auto tol_time_host = Kokkos::create_mirror_view(tol_time);
+    for (ordinal_type i = 0, iend = tol_time.extent(0); i < iend; ++i) {
+      tol_time_host(i, 0) = 1e-12;
+      tol_time_host(i, 1) = 1e-8;
+    }
+    Kokkos::deep_copy(tol_time, tol_time_host);
+  }
+  TChem::real_type_2d_view fac(
+    "fac", nBatch, cstr_problem_type::getNumberOfEquations(kmcd, kmcdSurf));
+
+  TChem::time_advance_type tadv_default;
+  tadv_default._tbeg = 0;
+  tadv_default._tend = tend;
+  tadv_default._dt = 1e-10;
+  tadv_default._dtmin = 1e-10;
+  tadv_default._dtmax = tend / 100;
+  tadv_default._max_num_newton_iterations = 20;
+  tadv_default._num_time_iterations_per_interval = 100;
+
+  TChem::time_advance_type_1d_view tadv("tadv", nBatch);
+  Kokkos::deep_copy(tadv, tadv_default);
+  TChem::real_type_1d_view t("time", nBatch), dt("delta time", nBatch);
+
+  const auto tadv_host = Kokkos::create_mirror_view(tadv);
+  const auto t_host = Kokkos::create_mirror_view(t);
+  const auto dt_host = Kokkos::create_mirror_view(dt);
+
+  auto policy = getTransientContStirredTankReactorPolicy(
+    nBatch,
+    TChem::TransientContStirredTankReactor::getWorkSpaceSize(
+      kmcd, kmcdSurf, cstr));
+
+  const ordinal_type max_num_time_iterations(1000);
+  for (ordinal_type iter = 0; iter < max_num_time_iterations; ++iter) {
+    TChem::TransientContStirredTankReactor::runDeviceBatch(policy,
+                                                           tol_newton,
+                                                           tol_time,
+                                                           fac,
+                                                           tadv,
+                                                           state,
+                                                           siteFraction,
+                                                           t,
+                                                           dt,
+                                                           state,
+                                                           siteFraction,
+                                                           kmcd,
+                                                           kmcdSurf,
+                                                           cstr);
+    Kokkos::deep_copy(tadv_host, tadv);
+    Kokkos::deep_copy(t_host, t);
+    Kokkos::deep_copy(dt_host, dt);
+
+    /// carry over time and dt computed in this step
+    bool done(true);
+    for (ordinal_type i = 0; i < nBatch; ++i) {
+      if (dt_host(i) < 0)
+        return false;
+      tadv_host(i)._tbeg = t_host(i);
+      tadv_host(i)._dt = dt_host(i);
+      done = done && t_host(i) >= tend * (1 - 1e-12);
+    }
+    if (done)
+      return true;
+    Kokkos::deep_copy(tadv, tadv_host);
+  }
+  return false;
+}
+
+TEST(TransientContStirredTankReactor, steady_state_vs_transient)
+{
+  const std::string prefixPath("../example/data/plug-flow-reactor/X/");
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat",
+                              prefixPath + "chemSurf.inp",
+                              prefixPath + "thermSurf.dat");
+  const auto kmcd = kmd.createConstData<TChem::exec_space>();
+  const auto kmcdSurf = kmd.createConstSurfData<TChem::exec_space>();
+
+  const real_type temperature_init(2000), tau(1);
+  TChem::real_type_2d_view inlet, state, siteFraction;
+  readTransientContStirredTankReactorSample(
+    prefixPath, kmcd, kmcdSurf, temperature_init, inlet, state, siteFraction);
+  const auto cstr = getTransientContStirredTankReactorData(kmcd, inlet, tau);
+
+  const ordinal_type nBatch = state.extent(0), nSpec = kmcd.nSpec;
+
+  /// 50 residence times; the transient solution decays to the steady state
+  TChem::real_type_2d_view state_transient(
+    "state transient", nBatch, state.extent(1));
+  TChem::real_type_2d_view Z_transient(
+    "site fraction transient", nBatch, siteFraction.extent(1));
+  Kokkos::deep_copy(state_transient, state);
+  Kokkos::deep_copy(Z_transient, siteFraction);
+  ASSERT_TRUE(advanceTransientContStirredTankReactor(
+    kmcd, kmcdSurf, cstr, 50 * tau, state_transient, Z_transient));
+
+  /// steady state from the same initial guess
+  using steady_state_type = TChem::TransientContStirredTankReactorSteadyState;
+  TChem::real_type_2d_view state_steady(
+    "state steady", nBatch, state.extent(1));
+  TChem::real_type_2d_view Z_steady(
+    "site fraction steady", nBatch, siteFraction.extent(1));
+  TChem::ordinal_type_1d_view iter_count("iter count", nBatch);
+  TChem::ordinal_type_1d_view status("status", nBatch);
+  {
+    TChem::real_type_2d_view fac(
+      "fac", nBatch, cstr_problem_type::getNumberOfEquations(kmcd, kmcdSurf));
+    auto policy = getTransientContStirredTankReactorPolicy(
+      nBatch, steady_state_type::getWorkSpaceSize(kmcd, kmcdSurf, cstr));
+    steady_state_type::runDeviceBatch(
+      policy,
+      getTransientContStirredTankReactorNewtonTolerance(),
+      100,
+      1e-10,
+      1e3,
+      fac,
+      state,
+      siteFraction,
+      state_steady,
+      Z_steady,
+      iter_count,
+      status,
+      kmcd,
+      kmcdSurf,
+      cstr);
+  }
+
+  const auto inlet_host = Kokkos::create_mirror_view(inlet);
+  const auto transient_host = Kokkos::create_mirror_view(state_transient);
+  const auto steady_host = Kokkos::create_mirror_view(state_steady);
+  const auto status_host = Kokkos::create_mirror_view(status);
+  Kokkos::deep_copy(inlet_host, inlet);
+  Kokkos::deep_copy(transient_host, state_transient);
+  Kokkos::deep_copy(steady_host, state_steady);
+  Kokkos::deep_copy(status_host, status);
+
+  for (ordinal_type i = 0; i < nBatch; ++i) {
+    ASSERT_EQ(status_host(i),
+              ordinal_type(steady_state_type::status_type::Converged));
+
+    /// burning branch
+    const real_type temperature = transient_host(i, 2);
+    EXPECT_GT(temperature, inlet_host(i, 2) + 500);
+    EXPECT_NEAR(steady_host(i, 2), temperature, 1e-4 * temperature);
+    EXPECT_NEAR(
+      steady_host(i, 0), transient_host(i, 0), 1e-4 * transient_host(i, 0));
+    for (ordinal_type k = 0; k < nSpec; ++k)
+      EXPECT_NEAR(steady_host(i, k + 3), transient_host(i, k + 3), 1e-6);
+  }
+}
+
+TEST(TransientContStirredTankReactor, continuation_turning_point)
+{
+  const std::string prefixPath("../example/data/plug-flow-reactor/X/");
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat",
+                              prefixPath + "chemSurf.inp",
+                              prefixPath + "thermSurf.dat");
+  const auto kmcd = kmd.createConstData<TChem::exec_space>();
+  const auto kmcdSurf = kmd.createConstSurfData<TChem::exec_space>();
+
+  const real_type temperature_init(2000), tau(1);
+  TChem::real_type_2d_view inlet, state, siteFraction;
+  readTransientContStirredTankReactorSample(
+    prefixPath, kmcd, kmcdSurf, temperature_init, inlet, state, siteFraction);
+  const auto cstr = getTransientContStirredTankReactorData(kmcd, inlet, tau);
+
+  const ordinal_type nBatch = state.extent(0), stateVecDim = state.extent(1);
+
+  /// decreasing the residence time from the burning branch ends at the
+  /// extinction turning point; the path must go around it
+  using steady_state_type = TChem::TransientContStirredTankReactorSteadyState;
+  const ordinal_type num_steps(60);
+  TChem::real_type_3d_view state_path(
+    "state path", nBatch, num_steps, stateVecDim);
+  TChem::real_type_3d_view Z_path(
+    "site fraction path", nBatch, num_steps, kmcdSurf.nSpec);
+  TChem::real_type_2d_view mdot_path("mdot path", nBatch, num_steps);
+  TChem::ordinal_type_1d_view num_steps_out("num steps", nBatch);
+  TChem::ordinal_type_1d_view status("status", nBatch);
+  {
+    TChem::real_type_2d_view fac(
+      "fac", nBatch, cstr_problem_type::getNumberOfEquations(kmcd, kmcdSurf));
+    auto policy = getTransientContStirredTankReactorPolicy(
+      nBatch, steady_state_type::getWorkSpaceSize(kmcd, kmcdSurf, cstr));
+    steady_state_type::runDeviceBatchContinuation(
+      policy,
+      getTransientContStirredTankReactorNewtonTolerance(),
+      100,
+      1e-10,
+      1e3,
+      -0.1,
+      0.5,
+      fac,
+      state,
+      siteFraction,
+      state_path,
+      Z_path,
+      mdot_path,
+      num_steps_out,
+      status,
+      kmcd,
+      kmcdSurf,
+      cstr);
+  }
+
+  const auto state_path_host = Kokkos::create_mirror_view(state_path);
+  const auto mdot_path_host = Kokkos::create_mirror_view(mdot_path);
+  const auto num_steps_out_host = Kokkos::create_mirror_view(num_steps_out);
+  Kokkos::deep_copy(state_path_host, state_path);
+  Kokkos::deep_copy(mdot_path_host, mdot_path);
+  Kokkos::deep_copy(num_steps_out_host, num_steps_out);
+
+  for (ordinal_type i = 0; i < nBatch; ++i) {
+    const ordinal_type n = num_steps_out_host(i);
+    ASSERT_GT(n, 2);
+
+    /// the largest inlet flow rate is inside the path
+    ordinal_type j_turn(0);
+    for (ordinal_type j = 1; j < n; ++j)
+      if (mdot_path_host(i, j) > mdot_path_host(i, j_turn))
+        j_turn = j;
+    EXPECT_GT(j_turn, 0);
+    EXPECT_LT(j_turn, n - 1);
+
+    /// temperature keeps dropping past the turning point
+    EXPECT_LT(state_path_host(i, n - 1, 2), state_path_host(i, j_turn, 2));
+    for (ordinal_type j = 1; j < j_turn; ++j)
+      EXPECT_GT(mdot_path_host(i, j), mdot_path_host(i, j - 1));
+  }
+}
+
+TEST(SurfaceSteadyState, steady_state_vs_simple_surface)
+{
+  const std::string prefixPath("../example/data/plug-flow-reactor/X/");
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat",
+                              prefixPath + "chemSurf.inp",
+                              prefixPath + "thermSurf.dat");
+  const auto kmcd = kmd.createConstData<TChem::exec_space>();
+  const auto kmcdSurf = kmd.createConstSurfData<TChem::exec_space>();
+
+  /// frozen gas phase at 1200K
+  const real_type temperature(1200);
+  TChem::real_type_2d_view inlet, state, siteFraction;
+  readTransientContStirredTankReactorSample(
+    prefixPath, kmcd, kmcdSurf, temperature, inlet, state, siteFraction);
+  const ordinal_type nBatch = state.extent(0), nSite = kmcdSurf.nSpec;
+
+  using problem_type =
+    TChem::Impl::SimpleSurface_Problem<TChem::KineticModelConstDataDevice,
+                                       TChem::KineticSurfModelConstDataDevice>;
+  const auto tol_newton = getTransientContStirredTankReactorNewtonTolerance();
+
+  /// long time marching of the site fractions
+  const real_type tend(100);
+  TChem::real_type_2d_view Z_transient(
+    "site fraction transient", nBatch, nSite);
+  Kokkos::deep_copy(Z_transient, siteFraction);
+  {
+    TChem::real_type_2d_view tol_time(
+      "tol time", problem_type::getNumberOfTimeODEs(kmcdSurf), 2);
+    {
+      const auto tol_time_host = Kokkos::create_mirror_view(tol_time);
+      for (ordinal_type i = 0, iend = tol_time.extent(0); i < iend; ++i) {
+        tol_time_host(i, 0) = 1e-12;
+        tol_time_host(i, 1) = 1e-8;
+      }
+      Kokkos::deep_copy(tol_time, tol_time_host);
+    }
+    TChem::real_type_2d_view fac("fac", nBatch, nSite);
+
+    TChem::time_advance_type tadv_default;
+    tadv_default._tbeg = 0;
+    tadv_default._tend = tend;
+    tadv_default._dt = 1e-12;
+    tadv_default._dtmin = 1e-12;
+    tadv_default._dtmax = tend / 100;
+    tadv_default._max_num_newton_iterations = 20;
+    tadv_default._num_time_iterations_per_interval = 100;
+
+    TChem::time_advance_type_1d_view tadv("tadv", nBatch);
+    Kokkos::deep_copy(tadv, tadv_default);
+    TChem::real_type_1d_view t("time", nBatch), dt("delta time", nBatch);
+
+    const auto tadv_host = Kokkos::create_mirror_view(tadv);
+    const auto t_host = Kokkos::create_mirror_view(t);
+    const auto dt_host = Kokkos::create_mirror_view(dt);
+
+    auto policy = getTransientContStirredTankReactorPolicy(
+      nBatch, TChem::SimpleSurface::getWorkSpaceSize(kmcd, kmcdSurf));
+
+    bool done(false);
+    for (ordinal_type iter = 0; iter < 1000 && !done; ++iter) {
+      TChem::SimpleSurface::runDeviceBatch(policy,
+                                           tol_newton,
+                                           tol_time,
+                                           tadv,
+                                           state,
+                                           Z_transient,
+                                           t,
+                                           dt,
+                                           Z_transient,
+                                           fac,
+                                           kmcd,
+                                           kmcdSurf);
+      Kokkos::deep_copy(tadv_host, tadv);
+      Kokkos::deep_copy(t_host, t);
+      Kokkos::deep_copy(dt_host, dt);
+
+      /// carry over time and dt computed in this step
+      done = true;
+      for (ordinal_type i = 0; i < nBatch; ++i) {
+        ASSERT_GT(dt_host(i), real_type(0));
+        tadv_host(i)._tbeg = t_host(i);
+        tadv_host(i)._dt = dt_host(i);
+        done = done && t_host(i) >= tend * (1 - 1e-12);
+      }
+      Kokkos::deep_copy(tadv, tadv_host);
+    }
+    ASSERT_TRUE(done);
+  }
+
+  /// steady state from the same initial guess
+  TChem::real_type_2d_view Z_steady("site fraction steady", nBatch, nSite);
+  TChem::ordinal_type_1d_view iter_count("iter count", nBatch);
+  TChem::ordinal_type_1d_view status("status", nBatch);
+  {
+    TChem::real_type_2d_view fac("fac", nBatch, nSite);
+    auto policy = getTransientContStirredTankReactorPolicy(
+      nBatch, TChem::SurfaceSteadyState::getWorkSpaceSize(kmcd, kmcdSurf));
+    TChem::SurfaceSteadyState::runDeviceBatch(policy,
+                                              tol_newton,
+                                              1000,
+                                              1e-10,
+                                              1e3,
+                                              state,
+                                              siteFraction,
+                                              Z_steady,
+                                              fac,
+                                              iter_count,
+                                              status,
+                                              kmcd,
+                                              kmcdSurf);
+  }
+
+  const auto transient_host = Kokkos::create_mirror_view(Z_transient);
+  const auto steady_host = Kokkos::create_mirror_view(Z_steady);
+  const auto status_host = Kokkos::create_mirror_view(status);
+  Kokkos::deep_copy(transient_host, Z_transient);
+  Kokkos::deep_copy(steady_host, Z_steady);
+  Kokkos::deep_copy(status_host, status);
+
+  for (ordinal_type i = 0; i < nBatch; ++i) {
+    ASSERT_EQ(status_host(i),
+              ordinal_type(TChem::SurfaceSteadyState::status_type::Converged));
+
+    /// the site conservation row is algebraic
+    real_type Zsum(0);
+    for (ordinal_type k = 0; k < nSite; ++k)
+      Zsum += steady_host(i, k);
+    EXPECT_NEAR(Zsum, real_type(1), 1e-10);
+
+    for (ordinal_type k = 0; k < nSite; ++k)
+      EXPECT_NEAR(steady_host(i, k), transient_host(i, k), 1e-6)
+        << "sample " << i << " site " << k;
+  }
+}
+
+#endif
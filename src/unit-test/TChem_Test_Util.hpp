@@ -21,6 +21,11 @@ Sandia National Laboratories, Livermore, CA, USA
 #ifndef __TCHEM_TEST_UTIL_HPP__
 #define __TCHEM_TEST_UTIL_HPP__
 
+#include "TChem_Impl_DenseUTV.hpp"
+#include "TChem_KineticModelData.hpp"
+#include "TChem_Math.hpp"
+#include "TChem_SampleFileReader.hpp"
+#include "TChem_TrajectoryWriter.hpp"
 #include "TChem_Util.hpp"
 
 TEST(Util, std_vs_kokkos)
@@ -93,4 +98,418 @@ TEST(Util, std_vs_kokkos)
   }
 }
 
+TEST(Util, math_vs_libm)
+{
+  using math = TChem::Math<real_type>;
+
+  /// relative errors against libm; pow amplifies the error of log by y log(x)
+  const ordinal_type n(100000);
+  real_type err_exp(0), err_log(0), err_pow(0);
+  for (ordinal_type i = 0; i < n; ++i) {
+    const real_type s = real_type(i) / real_type(n - 1);
+    const real_type x = -700 + 1400 * s;
+    const real_type z = std::exp(-690 + 1380 * s);
+    const real_type y = -10 + 20 * s;
+
+    const real_type e_ref = std::exp(x), l_ref = std::log(z),
+                    p_ref = std::pow(z, y / 100);
+    err_exp = std::max(err_exp, std::abs(math::exp(x) - e_ref) / e_ref);
+    err_log = std::max(err_log,
+                       std::abs(math::log(z) - l_ref) /
+                         std::max(std::abs(l_ref), real_type(1)));
+    err_pow = std::max(err_pow, std::abs(math::pow(z, y / 100) - p_ref) / p_ref);
+  }
+  EXPECT_LT(err_exp, 1e-14);
+  EXPECT_LT(err_log, 1e-14);
+  EXPECT_LT(err_pow, 1e-12);
+
+  /// special values
+  const real_type inf = std::numeric_limits<real_type>::infinity();
+  EXPECT_EQ(math::exp(real_type(0)), real_type(1));
+  EXPECT_EQ(math::exp(real_type(1000)), inf);
+  EXPECT_EQ(math::exp(real_type(-1000)), real_type(0));
+  EXPECT_EQ(math::log(real_type(1)), real_type(0));
+  EXPECT_EQ(math::log(real_type(0)), -inf);
+  EXPECT_TRUE(std::isnan(math::log(real_type(-1))));
+  EXPECT_EQ(math::pow(real_type(3), real_type(0)), real_type(1));
+  EXPECT_TRUE(std::isnan(math::pow(real_type(-2), real_type(0.5))));
+
+  /// small integer exponents are products of x
+  EXPECT_EQ(math::pow(real_type(-2), real_type(3)), real_type(-8));
+  EXPECT_EQ(math::pow(real_type(10), real_type(2)), real_type(100));
+  EXPECT_EQ(math::pow(real_type(-3), real_type(4)), real_type(81));
+  EXPECT_EQ(math::pow(real_type(2), real_type(-2)), real_type(0.25));
+  EXPECT_EQ(math::pow(real_type(1.1), real_type(2)),
+            real_type(1.1) * real_type(1.1));
+  for (ordinal_type k = -15; k < 16; ++k) {
+    const real_type x(0.7), p_ref = std::pow(x, real_type(k));
+    EXPECT_NEAR(math::pow(x, real_type(k)), p_ref, 1e-14 * p_ref);
+  }
+}
+
+TEST(Util, dense_utv_mixed_precision)
+{
+  using policy_type = Kokkos::TeamPolicy<TChem::host_exec_space>;
+  using solver_type = TChem::Impl::DenseUTVMixedPrecision;
+
+  /// a diagonally dominant matrix (well conditioned) and the hilbert matrix
+  /// of order 4 (condition number about 1.6e4); the float factors solve
+  /// them to single precision and iterative refinement with residuals in
+  /// real_type recovers double precision
+  for (const bool is_hilbert : { false, true }) {
+    const ordinal_type n = is_hilbert ? 4 : 8;
+    real_type_2d_view_host A0("A0", n, n), A("A", n, n);
+    real_type_1d_view_host x_true("x true", n), x("x", n), b("b", n);
+    real_type_1d_view_host r("r", n), dx("dx", n);
+    real_type_1d_view_host w("w", solver_type::getWorkSpaceSize(n, n));
+    for (ordinal_type i = 0; i < n; ++i) {
+      for (ordinal_type j = 0; j < n; ++j)
+        A0(i, j) = real_type(1) / real_type(i + j + 1) +
+                   (!is_hilbert && i == j ? real_type(n) : real_type(0));
+      x_true(i) = real_type(1) + real_type(0.1) * i;
+    }
+    real_type norm_A(0), norm_b(0);
+    for (ordinal_type i = 0; i < n; ++i) {
+      real_type row_sum(0);
+      b(i) = 0;
+      for (ordinal_type j = 0; j < n; ++j) {
+        b(i) += A0(i, j) * x_true(j);
+        row_sum += std::abs(A0(i, j));
+      }
+      norm_A = std::max(norm_A, row_sum);
+      norm_b = std::max(norm_b, std::abs(b(i)));
+    }
+
+    /// r = b - A0 x in real_type; returns the max norm of the residual
+    auto compute_residual = [&]() {
+      real_type norm_r(0);
+      for (ordinal_type i = 0; i < n; ++i) {
+        r(i) = b(i);
+        for (ordinal_type j = 0; j < n; ++j)
+          r(i) -= A0(i, j) * x(j);
+        norm_r = std::max(norm_r, std::abs(r(i)));
+      }
+      return norm_r;
+    };
+    auto compute_error = [&]() {
+      real_type err(0);
+      for (ordinal_type i = 0; i < n; ++i)
+        err = std::max(err, std::abs(x(i) - x_true(i)) / x_true(i));
+      return err;
+    };
+
+    Kokkos::deep_copy(A, A0);
+    ordinal_type matrix_rank(0);
+    Kokkos::parallel_for(
+      policy_type(1, 1), [&](const typename policy_type::member_type& member) {
+        solver_type::team_factorize_and_solve(member, A, x, b, w, matrix_rank);
+      });
+    ASSERT_EQ(matrix_rank, n);
+    const real_type norm_r_single = compute_residual();
+    EXPECT_LT(compute_error(), is_hilbert ? 1e-2 : 1e-5);
+
+    /// the factors left in A and w are reused for the corrections
+    const ordinal_type max_num_refinements(10);
+    real_type norm_r(norm_r_single);
+    for (ordinal_type iter = 0; iter < max_num_refinements; ++iter) {
+      Kokkos::parallel_for(
+        policy_type(1, 1),
+        [&](const typename policy_type::member_type& member) {
+          solver_type::team_solve(member, A, dx, r, w, matrix_rank);
+        });
+      for (ordinal_type i = 0; i < n; ++i)
+        x(i) += dx(i);
+      norm_r = compute_residual();
+    }
+    const real_type eps = std::numeric_limits<real_type>::epsilon();
+    real_type norm_x(0);
+    for (ordinal_type i = 0; i < n; ++i)
+      norm_x = std::max(norm_x, std::abs(x(i)));
+    EXPECT_LT(norm_r, 10 * n * eps * (norm_A * norm_x + norm_b))
+      << (is_hilbert ? "hilbert" : "diagonally dominant");
+    EXPECT_LT(norm_r, 1e-6 * norm_r_single);
+    EXPECT_LT(compute_error(), is_hilbert ? 1e-10 : 1e-13);
+  }
+}
+
+TEST(Util, sample_file_reader)
+{
+  /// samples with mixed blanks, crlf and empty lines; enough rows to be
+  /// split in many chunks
+  const std::string filename("sample_file_reader.dat");
+  const ordinal_type n(1000), m(6);
+  {
+    std::ofstream file(filename);
+    file << "T P CH4 O2 N2 AR\n";
+    for (ordinal_type i = 0; i < n; ++i) {
+      for (ordinal_type j = 0; j < m; ++j)
+        file << (j == 0 ? "" : (i + j) % 2 ? " " : " \t ") << (i * m + j);
+      file << (i % 3 ? "\n" : "\r\n");
+      if (i % 7 == 0)
+        file << "  \n";
+    }
+  }
+
+  const TChem::Test::SampleFileReader reader(filename);
+  ASSERT_TRUE(reader.isOpen());
+  EXPECT_EQ(reader.getNumberOfSamples(), n);
+  ASSERT_EQ(ordinal_type(reader.getVariableNames().size()), m);
+  EXPECT_EQ(reader.getVariableNames()[2], std::string("CH4"));
+
+  std::vector<ordinal_type> columns(m);
+  for (ordinal_type j = 0; j < m; ++j)
+    columns[j] = m - 1 - j;
+  {
+    real_type_2d_view_host values("values", n, m);
+    reader.read(columns, values);
+    ordinal_type diff(0);
+    for (ordinal_type i = 0; i < n; ++i)
+      for (ordinal_type j = 0; j < m; ++j)
+        diff += values(i, m - 1 - j) != real_type(i * m + j);
+    EXPECT_EQ(diff, 0);
+  }
+  {
+    /// a window of samples read without kokkos kernels
+    const ordinal_type row_begin(n / 2 + 3), nrows(37);
+    real_type_2d_view_host values("values", nrows, m);
+    reader.read(columns, values, row_begin, false);
+    ordinal_type diff(0);
+    for (ordinal_type i = 0; i < nrows; ++i)
+      for (ordinal_type j = 0; j < m; ++j)
+        diff += values(i, m - 1 - j) != real_type((row_begin + i) * m + j);
+    EXPECT_EQ(diff, 0);
+  }
+  std::remove(filename.c_str());
+
+  /// readSample against a plain stream parse of the same file
+  std::string prefixPath="../example/data/ignition-zero-d/gri3.0/";
+  TChem::KineticModelData kmd(prefixPath + "chem.inp",
+                              prefixPath + "therm.dat");
+  const auto kmcd = kmd.createConstData<TChem::host_exec_space>();
+  const ordinal_type nSpec = kmcd.nSpec;
+
+  real_type_2d_view_host state;
+  int nBatch(0);
+  TChem::Test::readSample(prefixPath + "sample.dat",
+                          kmcd.speciesNames,
+                          kmcd.sMass,
+                          nSpec,
+                          TChem::Impl::getStateVectorSize(nSpec),
+                          state,
+                          nBatch);
+  ASSERT_EQ(nBatch, 1);
+
+  std::ifstream file(prefixPath + "sample.dat");
+  std::string line, name;
+  std::vector<std::string> names;
+  std::getline(file, line);
+  {
+    std::istringstream iss(line);
+    while (iss >> name)
+      names.push_back(name);
+  }
+  std::vector<real_type> values(names.size());
+  for (auto& v : values)
+    file >> v;
+
+  EXPECT_EQ(state(0, 2), values[0]);
+  EXPECT_EQ(state(0, 1), values[1]);
+  real_type Ysum(0);
+  for (ordinal_type sp = 2; sp < ordinal_type(names.size()); ++sp) {
+    for (ordinal_type k = 0; k < nSpec; ++k) {
+      if (names[sp] == std::string(&kmcd.speciesNames(k, 0))) {
+        EXPECT_EQ(state(0, k + 3), values[sp]);
+        Ysum += values[sp] / kmcd.sMass(k);
+      }
+    }
+  }
+  const real_type density = values[1] / (TChem::RUNIV * 1.0e3 * Ysum * values[0]);
+  EXPECT_NEAR(state(0, 0), density, 1e-14 * density);
+}
+
+TEST(Util, trajectory_writer)
+{
+  /// columns: iter, t, dt, state (3 + nSpec), site fractions and velocity
+  const ordinal_type nSpec(2), nSite(2), nstate(3 + nSpec);
+  std::vector<std::string> names = { "iter", "t", "dt" };
+  {
+    TChem::string_type_1d_view_host<TChem::LENGTHOFSPECNAME + 1> speciesNames(
+      "species", nSpec);
+    strcpy(&speciesNames(0, 0), "H2");
+    strcpy(&speciesNames(1, 0), "O2");
+    TChem::TrajectoryWriter::addStateVectorNames(names, speciesNames, nSpec);
+    strcpy(&speciesNames(0, 0), "PT(S)");
+    strcpy(&speciesNames(1, 0), "H(S)");
+    TChem::TrajectoryWriter::addSpeciesNames(names, speciesNames, nSite);
+  }
+  names.push_back("velocity");
+  const ordinal_type ncolumns(names.size());
+  ASSERT_EQ(ncolumns, 3 + nstate + nSite + 1);
+
+  /// value of a sample in a column is distinct over chunks and columns
+  auto value = [](const ordinal_type chunk,
+                  const ordinal_type column,
+                  const ordinal_type row) {
+    return real_type(1000 * chunk + 10 * column + row) + real_type(0.25);
+  };
+
+  const std::vector<ordinal_type> nrows = { 4, 1, 3 };
+  for (const bool use_background_thread : { false, true }) {
+    const std::string filename("trajectory_writer.bin");
+    {
+      TChem::TrajectoryWriter writer(filename, names, use_background_thread);
+      EXPECT_EQ(writer.getNumberOfColumns(), ncolumns);
+      for (ordinal_type c = 0; c < ordinal_type(nrows.size()); ++c) {
+        const ordinal_type n = nrows[c];
+        real_type_1d_view_host t("t", n), dt("dt", n), velocity("velocity", n);
+        real_type_2d_view_host state("state", n, nstate);
+        real_type_2d_view_host siteFraction("siteFraction", n, nSite);
+        for (ordinal_type i = 0; i < n; ++i) {
+          t(i) = value(c, 1, i);
+          dt(i) = value(c, 2, i);
+          for (ordinal_type k = 0; k < nstate; ++k)
+            state(i, k) = value(c, 3 + k, i);
+          for (ordinal_type k = 0; k < nSite; ++k)
+            siteFraction(i, k) = value(c, 3 + nstate + k, i);
+          velocity(i) = value(c, ncolumns - 1, i);
+        }
+        writer.append(c, t, dt, state, siteFraction, velocity);
+
+        /// a chunk without site fractions does not match the header and it
+        /// is not written
+        writer.append(c, t, dt, state, real_type_2d_view_host(), velocity);
+      }
+      writer.flush();
+    }
+
+    /// read the file back following the layout in TChem_TrajectoryWriter.hpp
+    FILE* fin = fopen(filename.c_str(), "rb");
+    ASSERT_TRUE(fin != nullptr);
+    char magic[8];
+    ASSERT_EQ(fread(magic, 1, 8, fin), size_t(8));
+    EXPECT_EQ(std::string(magic, 8), std::string("TCHEMTRJ"));
+    uint32_t version(0), ncolumns_in_file(0);
+    ASSERT_EQ(fread(&version, sizeof(uint32_t), 1, fin), size_t(1));
+    ASSERT_EQ(fread(&ncolumns_in_file, sizeof(uint32_t), 1, fin), size_t(1));
+    EXPECT_EQ(version, uint32_t(1));
+    ASSERT_EQ(ordinal_type(ncolumns_in_file), ncolumns);
+    for (ordinal_type k = 0; k < ncolumns; ++k) {
+      uint32_t len(0);
+      ASSERT_EQ(fread(&len, sizeof(uint32_t), 1, fin), size_t(1));
+      std::string name(len, ' ');
+      ASSERT_EQ(fread(&name[0], 1, len, fin), size_t(len));
+      EXPECT_EQ(name, names[k]);
+    }
+
+    /// chunks are columnar and written in the order of append
+    for (ordinal_type c = 0; c < ordinal_type(nrows.size()); ++c) {
+      uint64_t n(0);
+      ASSERT_EQ(fread(&n, sizeof(uint64_t), 1, fin), size_t(1));
+      ASSERT_EQ(ordinal_type(n), nrows[c]);
+      std::vector<double> values(size_t(ncolumns) * n);
+      ASSERT_EQ(fread(values.data(), sizeof(double), values.size(), fin),
+                values.size());
+      ordinal_type diff(0);
+      for (ordinal_type k = 0; k < ncolumns; ++k)
+        for (ordinal_type i = 0; i < nrows[c]; ++i)
+          diff += values[k * n + i] != (k == 0 ? real_type(c) : value(c, k, i));
+      EXPECT_EQ(diff, 0);
+    }
+    char extra;
+    EXPECT_EQ(fread(&extra, 1, 1, fin), size_t(0));
+    fclose(fin);
+    std::remove(filename.c_str());
+  }
+}
+
+#if defined(TCHEM_ENABLE_BENCH)
+TEST(Util, bench_csv_json_baseline)
+{
+  const std::string exec("../bench/tchem-bench.x");
+  const std::string outputCSV("bench-test.csv"), outputJSON("bench-test.json");
+  const std::string invoke(exec + " " + "--prefixPath=../bench/data/ " +
+                           "--gas-mechanisms=gri3.0 " +
+                           "--surface-mechanisms= " +
+                           "--entries=NetProductionRatePerMass " +
+                           "--batch-sizes=1,4 --repeats=1 " +
+                           "--output-csv=" + outputCSV + " " +
+                           "--output-json=" + outputJSON);
+  printf("testing : %s\n", invoke.c_str());
+  ASSERT_EQ(std::system(invoke.c_str()), 0);
+
+  /// one csv row per batch size with positive throughput
+  std::vector<std::vector<std::string>> rows;
+  {
+    std::ifstream file(outputCSV);
+    ASSERT_TRUE(file.is_open());
+    std::string line;
+    ASSERT_TRUE(bool(std::getline(file, line)));
+    EXPECT_EQ(line,
+              "entry,mechanism,exec_space,concurrency,batch_size,team_size,"
+              "vector_size,seconds,samples_per_sec,evals_per_sec,gflops");
+    while (std::getline(file, line)) {
+      std::vector<std::string> tokens;
+      std::istringstream iss(line);
+      std::string token;
+      while (std::getline(iss, token, ','))
+        tokens.push_back(token);
+      ASSERT_EQ(tokens.size(), size_t(11));
+      rows.push_back(tokens);
+    }
+  }
+  ASSERT_EQ(rows.size(), size_t(2));
+  for (ordinal_type i = 0; i < 2; ++i) {
+    EXPECT_EQ(rows[i][0], "NetProductionRatePerMass");
+    EXPECT_EQ(rows[i][1], "gri3.0");
+    EXPECT_EQ(std::atoi(rows[i][4].c_str()), i == 0 ? 1 : 4);
+    EXPECT_GT(std::atof(rows[i][8].c_str()), 0);
+  }
+
+  /// json holds the same records
+  {
+    std::ifstream file(outputJSON);
+    ASSERT_TRUE(file.is_open());
+    std::stringstream ss;
+    ss << file.rdbuf();
+    const std::string json = ss.str();
+    ordinal_type nentries(0);
+    for (size_t pos = json.find("\"entry\""); pos != std::string::npos;
+         pos = json.find("\"entry\"", pos + 1))
+      ++nentries;
+    EXPECT_EQ(nentries, 2);
+    EXPECT_NE(json.find("\"mechanism\": \"gri3.0\""), std::string::npos);
+  }
+
+  /// a baseline far faster than this run is a regression and fails the
+  /// executable; a far slower one passes
+  const std::string baselineCSV("bench-test-baseline.csv");
+  auto runWithBaseline = [&](const double scale) {
+    {
+      std::ofstream file(baselineCSV);
+      for (const auto& tokens : rows) {
+        for (size_t k = 0; k < tokens.size(); ++k) {
+          if (k > 0)
+            file << ",";
+          if (k == 8)
+            file << std::scientific
+                 << std::atof(tokens[k].c_str()) * scale;
+          else
+            file << tokens[k];
+        }
+        file << "\n";
+      }
+    }
+    const std::string invoke_baseline(invoke + " --baseline=" + baselineCSV);
+    printf("testing : %s\n", invoke_baseline.c_str());
+    return std::system(invoke_baseline.c_str());
+  };
+  EXPECT_NE(runWithBaseline(100.0), 0);
+  EXPECT_EQ(runWithBaseline(0.01), 0);
+
+  std::remove(outputCSV.c_str());
+  std::remove(outputJSON.c_str());
+  std::remove(baselineCSV.c_str());
+}
+#endif
+
 #endif